@@ -220,6 +220,7 @@
 #define PSIF_CC_MAX  PSIF_CC2_HET1 /*-  -*/
 
 #define PSIF_WK_PK          165  /*- File to contain wK pre-sorted integrals for PK -*/
+#define PSIF_SOLVER         166  /*- Davidson subspace vectors spilled to disk by the libfock solvers -*/
 
 #define PSIF_SCF_MOS           180  /*- Save SCF orbitals for re-use later as guess, etc. -*/
 #define PSIF_DFMP2_AIA         181  /*- Unfitted three-index MO ints for DFMP2 -*/
@@ -45,6 +45,7 @@ import psi4
 import driver_util
 import driver_cbs
 import driver_nbody
+import driver_findif
 
 from procedures import *
 import p4util
@@ -154,6 +155,10 @@ def energy(name, **kwargs):
     +-------------------------+---------------------------------------------------------------------------------------------------------------+
     | mp2                     | 2nd-order Moller-Plesset perturbation theory (MP2) :ref:`[manual] <sec:dfmp2>` :ref:`[details] <tlmp2>`       |
     +-------------------------+---------------------------------------------------------------------------------------------------------------+
+    | scs-mp2                 | spin-component scaled MP2 with density fitting :ref:`[manual] <sec:dfmp2>`                                    |
+    +-------------------------+---------------------------------------------------------------------------------------------------------------+
+    | sos-mp2                 | scaled opposite-spin MP2 with density fitting :ref:`[manual] <sec:dfmp2>`                                     |
+    +-------------------------+---------------------------------------------------------------------------------------------------------------+
     | mp3                     | 3rd-order Moller-Plesset perturbation theory (MP3) :ref:`[manual] <sec:occ_nonoo>` :ref:`[details] <tlmp3>`   |
     +-------------------------+---------------------------------------------------------------------------------------------------------------+
     | fno-mp3                 | MP3 with frozen natural orbitals :ref:`[manual] <sec:fnocc>`                                                  |
@@ -574,6 +579,8 @@ def gradient(name, **kwargs):
     opt_mode = kwargs.get('mode', 'continuous').lower()
     if opt_mode == 'continuous':
         pass
+    elif opt_mode == 'concurrent':
+        pass
     elif opt_mode == 'sow':
         if dertype == 1:
             raise ValidationError("""Optimize execution mode 'sow' not valid for analytic gradient calculation.""")
@@ -659,6 +666,14 @@ def gradient(name, **kwargs):
                 fmaster.write(("""retE, retwfn = optimize('%s', **kwargs)\n\n""" % (lowername)).encode('utf-8'))
                 fmaster.write(instructionsM.encode('utf-8'))
 
+        # Concurrent: reference in this process, the other displacements in worker processes
+        if opt_mode == 'concurrent':
+            def reference(mol):
+                E, wfn = energy(lowername, return_wfn=True, molecule=mol, **kwargs)
+                return wfn
+            energies, gradients, wfn = driver_findif.run_displacements('GRADIENT', 'energy', lowername,
+                displacements, moleculeclone, reference, **kwargs)
+
         for n, displacement in enumerate(displacements):
             rfile = 'OPT-%s-%s' % (opt_iter, n + 1)
 
@@ -860,7 +875,7 @@ def optimize(name, **kwargs):
         use keyword ``opt_func`` instead of ``func``.
 
     :type mode: string
-    :param mode: |dl| ``'continuous'`` |dr| || ``'sow'`` || ``'reap'``
+    :param mode: |dl| ``'continuous'`` |dr| || ``'concurrent'`` || ``'sow'`` || ``'reap'``
 
         For a finite difference of energies optimization, indicates whether
         the calculations required to complete the
@@ -869,6 +884,8 @@ def optimize(name, **kwargs):
         (``'sow'``/``'reap'``). For the latter, run an initial job with
         ``'sow'`` and follow instructions in its output file. For maximum
         flexibility, ``return_wfn`` is always on in ``'reap'`` mode.
+        ``'concurrent'`` runs the displacements as local psi4 processes,
+        ``fd_workers`` (default: the number of threads) at a time.
 
     :type dertype: :ref:`dertype <op_py_dertype>`
     :param dertype: ``'gradient'`` || ``'energy'``
@@ -981,7 +998,7 @@ def optimize(name, **kwargs):
 
     # are we in sow/reap mode?
     opt_mode = kwargs.get('mode', 'continuous').lower()
-    if opt_mode not in ['continuous', 'sow', 'reap']:
+    if opt_mode not in ['continuous', 'concurrent', 'sow', 'reap']:
         raise ValidationError("""Optimize execution mode '%s' not valid.""" % (opt_mode))
 
     optstash = p4util.OptionsState(
@@ -1018,7 +1035,7 @@ def optimize(name, **kwargs):
 
         # Use orbitals from previous iteration as a guess
         #   set within loop so that can be influenced by fns to optimize (e.g., cbs)
-        if (n > 1) and (opt_mode == 'continuous') and (not psi4.get_option('SCF', 'GUESS_PERSIST')):
+        if (n > 1) and (opt_mode in ['continuous', 'concurrent']) and (not psi4.get_option('SCF', 'GUESS_PERSIST')):
             psi4.set_local_option('SCF', 'GUESS', 'READ')
 
         # Before computing gradient, save previous molecule and wavefunction if this is an IRC optimization
@@ -1215,6 +1232,8 @@ def hessian(name, **kwargs):
     freq_mode = kwargs.pop('mode', 'continuous').lower()
     if freq_mode == 'continuous':
         pass
+    elif freq_mode == 'concurrent':
+        pass
     elif freq_mode == 'sow':
         if dertype == 2:
             raise ValidationError("""Frequency execution mode 'sow' not valid for analytic Hessian calculation.""")
@@ -1309,6 +1328,15 @@ def hessian(name, **kwargs):
                 fmaster.write(instructionsM.encode('utf-8'))
             psi4.print_out(instructionsM)
 
+        # Concurrent: reference in this process, the other displacements in worker processes
+        if freq_mode == 'concurrent':
+            def reference(mol):
+                G, wfn = gradient(lowername, molecule=mol, return_wfn=True, **kwargs)
+                return wfn
+            energies, gradients, wfn = driver_findif.run_displacements('HESSIAN', 'gradient', lowername,
+                displacements, moleculeclone, reference, **kwargs)
+            psi4.clean()
+
         for n, displacement in enumerate(displacements):
             rfile = 'FREQ-%s' % (n + 1)
 
@@ -1454,6 +1482,15 @@ def hessian(name, **kwargs):
                 fmaster.write(instructionsM.encode('utf-8'))
             psi4.print_out(instructionsM)
 
+        # Concurrent: reference in this process, the other displacements in worker processes
+        if freq_mode == 'concurrent':
+            def reference(mol):
+                E, wfn = energy(lowername, return_wfn=True, molecule=mol, **kwargs)
+                return wfn
+            energies, gradients, wfn = driver_findif.run_displacements('HESSIAN', 'energy', lowername,
+                displacements, moleculeclone, reference, **kwargs)
+            psi4.clean()
+
         for n, displacement in enumerate(displacements):
             rfile = 'FREQ-%s' % (n + 1)
 
@@ -1568,7 +1605,7 @@ def frequency(name, **kwargs):
         use keyword ``freq_func`` instead of ``func``.
 
     :type mode: string
-    :param mode: |dl| ``'continuous'`` |dr| || ``'sow'`` || ``'reap'``
+    :param mode: |dl| ``'continuous'`` |dr| || ``'concurrent'`` || ``'sow'`` || ``'reap'``
 
         For a finite difference of energies or gradients frequency, indicates
         whether the calculations required to complete the frequency are to be run
@@ -1576,6 +1613,8 @@ def frequency(name, **kwargs):
         embarrassingly parallel fashion (``'sow'``/``'reap'``)/ For the latter,
         run an initial job with ``'sow'`` and follow instructions in its output file.
         For maximum flexibility, ``return_wfn`` is always on in ``'reap'`` mode.
+        ``'concurrent'`` runs the displacements as local psi4 processes,
+        ``fd_workers`` (default: the number of threads) at a time.
 
     :type dertype: :ref:`dertype <op_py_dertype>`
     :param dertype: |dl| ``'hessian'`` |dr| || ``'gradient'`` || ``'energy'``
@@ -0,0 +1,218 @@
+#
+#@BEGIN LICENSE
+#
+# PSI4: an ab initio quantum chemistry software package
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along
+# with this program; if not, write to the Free Software Foundation, Inc.,
+# 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+#
+#@END LICENSE
+#
+
+"""Module with a local, concurrent executor for the displacements of
+finite-difference gradients and Hessians (``mode='concurrent'``).
+
+The displaced geometries are written out as sow-style input files and run
+by up to *fd_workers* psi4 processes at once, each with its share of the
+thread and memory budget. The undisplaced reference is computed first, in
+this process, and its SCF orbitals seed the guess of every worker. Results
+are read back with the sow/reap machinery, in displacement order.
+
+"""
+from __future__ import print_function
+from __future__ import absolute_import
+from __future__ import division
+import os
+import sys
+import time
+import shutil
+import subprocess
+import psi4
+import p4util
+from p4util.exceptions import *
+
+
+def _worker_budget(nworkers):
+    """Splits the threads and memory of this job among *nworkers* workers."""
+    nthread = max(1, psi4.nthread() // nworkers)
+    memory = int(psi4.get_memory() // nworkers)
+    return nthread, memory
+
+
+def _seed_orbitals(workdir):
+    """Copies the orbital file (180) of the calculation just run into
+    *workdir*, returning its path, or None if there is nothing to seed with
+    or the user chose a guess other than READ.
+
+    """
+    if psi4.has_option_changed('SCF', 'GUESS') and psi4.get_option('SCF', 'GUESS') != 'READ':
+        return None
+    guessfile = p4util.get_psifile(180)
+    if not os.path.isfile(guessfile):
+        return None
+    seed = os.path.join(workdir, 'reference.180')
+    shutil.copy(guessfile, seed)
+    return seed
+
+
+def _scf_convergence():
+    """Returns the (option, value) pairs of the SCF convergence criteria in
+    force. The driver tightens these as local SCF options for finite
+    differences, which format_options_for_input() does not carry over.
+
+    """
+    return [(opt, psi4.get_option('SCF', opt)) for opt in ['E_CONVERGENCE', 'D_CONVERGENCE']
+            if psi4.has_option_changed('SCF', opt)]
+
+
+def _write_worker_input(rfile, quantity, ptype, lowername, n, molecule, memory, seed, scf_convergence, **kwargs):
+    """Writes the input file *rfile*.in running displacement *n* of
+    *quantity* through *ptype* ('energy' or 'gradient'), with the SCF
+    convergence criteria *scf_convergence* from :py:func:`_scf_convergence`.
+
+    """
+    with open('%s.in' % (rfile), 'wb') as freagent:
+        freagent.write('# This is a psi4 input file auto-generated by the concurrent finite difference executor.\n\n'.encode('utf-8'))
+        freagent.write(p4util.format_molecule_for_input(molecule, forcexyz=True).encode('utf-8'))
+        freagent.write(p4util.format_options_for_input(molecule, **kwargs).encode('utf-8'))
+        for opt, val in scf_convergence:
+            freagent.write(("""psi4.set_local_option('SCF', '%s', %r)\n""" % (opt, val)).encode('utf-8'))
+        freagent.write(("""psi4.set_memory(%d)\n\n""" % (memory)).encode('utf-8'))
+        if seed is not None:
+            freagent.write("""import shutil\n""".encode('utf-8'))
+            freagent.write(("""shutil.copy('%s', p4util.get_psifile(180))\n""" % (seed)).encode('utf-8'))
+            freagent.write("""psi4.set_local_option('SCF', 'GUESS', 'READ')\n\n""".encode('utf-8'))
+        p4util.format_kwargs_for_input(freagent, **kwargs)
+        if ptype == 'energy':
+            freagent.write(("""electronic_energy = energy('%s', **kwargs)\n\n""" % (lowername)).encode('utf-8'))
+        else:
+            freagent.write(("""G, wfn = gradient('%s', return_wfn=True, **kwargs)\n\n""" % (lowername)).encode('utf-8'))
+            freagent.write(("""psi4.print_out('\\n%s RESULT: computation %d for item %d """ % (quantity, os.getpid(), n + 1)).encode('utf-8'))
+            freagent.write("""yields electronic gradient %r\\n' % (p4util.mat2arr(wfn.gradient())))\n\n""".encode('utf-8'))
+            freagent.write("""electronic_energy = psi4.get_variable('CURRENT ENERGY')\n\n""".encode('utf-8'))
+        freagent.write(("""psi4.print_out('\\n%s RESULT: computation %d for item %d """ % (quantity, os.getpid(), n + 1)).encode('utf-8'))
+        freagent.write("""yields electronic energy %20.12f\\n' % (electronic_energy))\n\n""".encode('utf-8'))
+
+
+def _psi4_executable():
+    """Returns the path of the psi4 binary running this process, so that
+    workers run the same build as the master. psi4 embeds its interpreter,
+    so :py:data:`sys.executable` is only used where it names psi4 itself;
+    failing both, the psi4 on the PATH is used.
+
+    """
+    candidates = [sys.executable]
+    if os.path.exists('/proc/self/exe'):
+        candidates.insert(0, os.path.realpath('/proc/self/exe'))
+    for exe in candidates:
+        if exe and os.path.splitext(os.path.basename(exe))[0] == 'psi4' and os.access(exe, os.X_OK):
+            return exe
+    return 'psi4'
+
+
+def run_displacements(quantity, ptype, lowername, displacements, molecule, reference, **kwargs):
+    """Computes the energies (*ptype* 'energy') or gradients (*ptype*
+    'gradient') at all *displacements* as generated by ``fd_geoms_1_0``,
+    ``fd_geoms_freq_0`` or ``fd_geoms_freq_1``, the last of which is the
+    reference geometry.
+
+    *reference* is called with *molecule* set to the reference geometry and
+    must run it in this process, returning its wavefunction. The other
+    displacements then run concurrently in worker processes, at most
+    *fd_workers* (kwarg, default: the number of threads) at a time, using
+    the *fd_executable* (kwarg, default: the running psi4 binary).
+
+    Returns (energies, gradients, wfn) in displacement order; gradients is
+    empty for *ptype* 'energy' and wfn is that of the reference.
+
+    """
+    ndisp = len(displacements)
+    nworkers = int(kwargs.pop('fd_workers', psi4.nthread()))
+    nworkers = max(1, min(nworkers, ndisp - 1))
+    executable = kwargs.pop('fd_executable', None) or _psi4_executable()
+    kwargs.pop('mode', None)
+    kwargs.pop('return_wfn', None)
+    nthread, memory = _worker_budget(nworkers)
+    scf_convergence = _scf_convergence()
+
+    # The reference geometry, in this process
+    psi4.print_out('\n')
+    p4util.banner('Loading displacement %d of %d' % (ndisp, ndisp))
+    molecule.set_geometry(displacements[-1])
+    wfn = reference(molecule)
+    reference_energy = psi4.get_variable('CURRENT ENERGY')
+    reference_gradient = wfn.gradient() if ptype == 'gradient' else None
+
+    workdir = os.path.abspath('%s-%d' % (quantity, os.getpid()))
+    if not os.path.isdir(workdir):
+        os.makedirs(workdir)
+    seed = _seed_orbitals(workdir)
+
+    psi4.print_out('\n  Running %d displacements with %d concurrent workers of %d threads and %d MiB each.\n' %
+        (ndisp - 1, nworkers, nthread, memory // (1024 * 1024)))
+    if seed is not None:
+        psi4.print_out('  Worker SCF guesses are read from the reference orbitals.\n')
+
+    rfiles = []
+    for n in range(ndisp - 1):
+        rfile = os.path.join(workdir, '%s-%d' % (quantity, n + 1))
+        molecule.set_geometry(displacements[n])
+        _write_worker_input(rfile, quantity, ptype, lowername, n, molecule, memory, seed, scf_convergence, **kwargs)
+        rfiles.append(rfile)
+    molecule.set_geometry(displacements[-1])
+
+    # Keep nworkers processes busy until all displacements are done
+    pending = list(range(ndisp - 1))
+    running = {}
+    failed = []
+    while pending or running:
+        while pending and len(running) < nworkers:
+            n = pending.pop(0)
+            scratch = rfiles[n] + '.scratch'
+            if not os.path.isdir(scratch):
+                os.makedirs(scratch)
+            running[n] = subprocess.Popen([executable, '-i', rfiles[n] + '.in', '-o', rfiles[n] + '.out',
+                                           '-n', str(nthread), '-s', scratch])
+        for n in list(running.keys()):
+            if running[n].poll() is not None:
+                if running[n].returncode != 0:
+                    failed.append(n + 1)
+                shutil.rmtree(rfiles[n] + '.scratch', ignore_errors=True)
+                del running[n]
+                print(""" %d""" % (n + 1), end='')
+                sys.stdout.flush()
+        time.sleep(0.1)
+    print('')
+
+    if failed:
+        raise ValidationError('Finite difference displacements %s failed; see the outputs in %s.' %
+            (', '.join([str(n) for n in sorted(failed)]), workdir))
+
+    energies = []
+    gradients = []
+    for n in range(ndisp - 1):
+        energies.append(p4util.extract_sowreap_from_output(rfiles[n], quantity, n, os.getpid(), True))
+        if ptype == 'gradient':
+            pygrad = p4util.extract_sowreap_from_output(rfiles[n], quantity, n, os.getpid(), True, label='electronic gradient')
+            p4mat = psi4.Matrix(molecule.natom(), 3)
+            p4mat.set(pygrad)
+            gradients.append(p4mat)
+    energies.append(reference_energy)
+    if ptype == 'gradient':
+        gradients.append(reference_gradient)
+
+    shutil.rmtree(workdir, ignore_errors=True)
+    psi4.set_variable('CURRENT ENERGY', reference_energy)
+
+    return (energies, gradients, wfn)
@@ -2534,8 +2534,9 @@ def run_adc(name, **kwargs):
     if ref_wfn is None:
         ref_wfn = scf_helper(name, **kwargs)
 
-    # Ensure IWL files have been written
-    proc_util.check_iwl_file_from_scf_type(psi4.get_option('SCF', 'SCF_TYPE'), ref_wfn)
+    # Ensure IWL files have been written, the DF algorithm needs none
+    if psi4.get_option('ADC', 'ADC_TYPE') != 'DF':
+        proc_util.check_iwl_file_from_scf_type(psi4.get_option('SCF', 'SCF_TYPE'), ref_wfn)
 
     return psi4.adc(ref_wfn)
 
@@ -2731,6 +2732,8 @@ def run_dfmp2(name, **kwargs):
     """
     optstash = p4util.OptionsState(
         ['DF_BASIS_MP2'],
+        ['DFMP2', 'MP2_SS_SCALE'],
+        ['DFMP2', 'MP2_OS_SCALE'],
         ['SCF', 'SCF_TYPE'])
 
     # Alter default algorithm
@@ -2738,6 +2741,16 @@ def run_dfmp2(name, **kwargs):
         psi4.set_local_option('SCF', 'SCF_TYPE', 'DF')
         psi4.print_out("""    SCF Algorithm Type (re)set to DF.\n""")
 
+    # SOS-MP2 drops the same-spin energy, which lets LAPLACE skip it altogether
+    if name == 'sos-mp2':
+        psi4.set_local_option('DFMP2', 'MP2_SS_SCALE', 0.0)
+        if not psi4.has_option_changed('DFMP2', 'MP2_OS_SCALE'):
+            psi4.set_local_option('DFMP2', 'MP2_OS_SCALE', 1.3)
+
+    if name == 'mp2' and psi4.get_option('DFMP2', 'DFMP2_ENERGY_ALGORITHM') == 'LAPLACE' and \
+       psi4.get_option('DFMP2', 'MP2_SS_SCALE') == 0.0:
+        raise ValidationError("""DFMP2_ENERGY_ALGORITHM LAPLACE with MP2_SS_SCALE = 0 does not compute the MP2 energy. Use energy('sos-mp2') or energy('scs-mp2') instead.""")
+
     # Bypass the scf call if a reference wavefunction is given
     ref_wfn = kwargs.get('ref_wfn', None)
     if ref_wfn is None:
@@ -2756,6 +2769,11 @@ def run_dfmp2(name, **kwargs):
     if name == 'scs-mp2':
         psi4.set_variable('CURRENT ENERGY', psi4.get_variable('SCS-MP2 TOTAL ENERGY'))
         psi4.set_variable('CURRENT CORRELATION ENERGY', psi4.get_variable('SCS-MP2 CORRELATION ENERGY'))
+    elif name == 'sos-mp2':
+        psi4.set_variable('SOS-MP2 TOTAL ENERGY', psi4.get_variable('SCS-MP2 TOTAL ENERGY'))
+        psi4.set_variable('SOS-MP2 CORRELATION ENERGY', psi4.get_variable('SCS-MP2 CORRELATION ENERGY'))
+        psi4.set_variable('CURRENT ENERGY', psi4.get_variable('SOS-MP2 TOTAL ENERGY'))
+        psi4.set_variable('CURRENT CORRELATION ENERGY', psi4.get_variable('SOS-MP2 CORRELATION ENERGY'))
     elif name == 'mp2':
         psi4.set_variable('CURRENT ENERGY', psi4.get_variable('MP2 TOTAL ENERGY'))
         psi4.set_variable('CURRENT CORRELATION ENERGY', psi4.get_variable('MP2 CORRELATION ENERGY'))
@@ -2764,6 +2782,49 @@ def run_dfmp2(name, **kwargs):
     return dfmp2_wfn
 
 
+def run_thcmp2(name, **kwargs):
+    """Function encoding sequence of PSI module calls for
+    a least-squares tensor-hypercontracted MP2 or SOS-MP2 calculation.
+
+    """
+    optstash = p4util.OptionsState(
+        ['THCMP2', 'THC_SAME_SPIN'],
+        ['SCF', 'SCF_TYPE'])
+
+    # Alter default algorithm
+    if not psi4.has_option_changed('SCF', 'SCF_TYPE'):
+        psi4.set_local_option('SCF', 'SCF_TYPE', 'DF')
+        psi4.print_out("""    SCF Algorithm Type (re)set to DF.\n""")
+
+    if psi4.get_global_option('REFERENCE') not in ['RHF', 'RKS']:
+        raise ValidationError("""THC-MP2 requires an RHF or RKS reference.""")
+
+    # Only thc-mp2 needs the O(N^4) same-spin exchange
+    psi4.set_local_option('THCMP2', 'THC_SAME_SPIN', name == 'thc-mp2')
+
+    # Bypass the scf call if a reference wavefunction is given
+    ref_wfn = kwargs.get('ref_wfn', None)
+    if ref_wfn is None:
+        ref_wfn = scf_helper(name, **kwargs)
+
+    psi4.print_out('\n')
+    p4util.banner('THCMP2')
+    psi4.print_out('\n')
+
+    thcmp2_wfn = psi4.thcmp2(ref_wfn)
+    thcmp2_wfn.compute_energy()
+
+    if name == 'thc-sos-mp2':
+        psi4.set_variable('CURRENT ENERGY', psi4.get_variable('SOS-MP2 TOTAL ENERGY'))
+        psi4.set_variable('CURRENT CORRELATION ENERGY', psi4.get_variable('SOS-MP2 CORRELATION ENERGY'))
+    else:
+        psi4.set_variable('CURRENT ENERGY', psi4.get_variable('MP2 TOTAL ENERGY'))
+        psi4.set_variable('CURRENT CORRELATION ENERGY', psi4.get_variable('MP2 CORRELATION ENERGY'))
+
+    optstash.restore()
+    return thcmp2_wfn
+
+
 def run_dmrgscf(name, **kwargs):
     """Function encoding sequence of PSI module calls for
     an DMRG calculation.
@@ -44,6 +44,8 @@ procedures = {
             'mp3'           : proc.select_mp3,
             'mp2.5'         : proc.select_mp2p5,
             'mp2'           : proc.select_mp2,
+            'scs-mp2'       : proc.run_dfmp2,
+            'sos-mp2'       : proc.run_dfmp2,
             'omp2'          : proc.select_omp2,
             'scs-omp2'      : proc.run_occ,
             'scs(n)-omp2'   : proc.run_occ,
@@ -59,6 +61,8 @@ procedures = {
             'olccd'         : proc.select_olccd,
             'omp2.5'        : proc.select_omp2p5,
             'dfocc'         : proc.run_dfocc,  # full control over dfocc
+            'thc-mp2'       : proc.run_thcmp2,
+            'thc-sos-mp2'   : proc.run_thcmp2,
             'qchf'          : proc.run_qchf,
             'ccd'           : proc.run_dfocc,
             'sapt0'         : proc.run_sapt,
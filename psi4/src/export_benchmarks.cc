@@ -26,6 +26,7 @@
  */
 
 #include "psi4/libmints/benchmark.h"
+#include "psi4/libdpd/dpd.h"
 #include "psi4/pybind11.h"
 
 void export_benchmarks(py::module& m)
@@ -33,7 +34,9 @@ void export_benchmarks(py::module& m)
     m.def("benchmark_blas1",     &psi::benchmark_blas1, "docstring");
     m.def("benchmark_blas2",     &psi::benchmark_blas2, "docstring");
     m.def("benchmark_blas3",     &psi::benchmark_blas3, "docstring");
+    m.def("benchmark_diagonalize", &psi::benchmark_diagonalize, "Times the Matrix::diagonalize eigensolvers");
     m.def("benchmark_disk",      &psi::benchmark_disk, "docstring");
     m.def("benchmark_math",      &psi::benchmark_math, "docstring");
     m.def("benchmark_integrals", &psi::benchmark_integrals, "docstring");
+    m.def("benchmark_dpd_sort",  &psi::benchmark_dpd_sort, "Times the in-core DPD buf4_sort kernels against memcpy");
 }
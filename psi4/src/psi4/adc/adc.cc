@@ -42,6 +42,7 @@ ADCWfn::ADCWfn(SharedWavefunction ref_wfn, Options& options) :
 
     shallow_copy(ref_wfn);
     reference_wavefunction_ = ref_wfn;
+    _ints = nullptr;
 
     char **irreps_      = molecule_->irrep_labels();
     aoccpi_             = new int[nirrep_];
@@ -135,7 +136,8 @@ ADCWfn::ADCWfn(SharedWavefunction ref_wfn, Options& options) :
 
     outfile->Printf( "\t==> Input Parameters <==\n");
     outfile->Printf( "\tNEWTON_CONV = %3g, NORM_TOL = %3g\n", conv_, norm_tol_);
-    outfile->Printf( "\tPOLE_MAX    = %3d, SEM_MAX  = %3d\n\n", pole_max_, sem_max_);
+    outfile->Printf( "\tPOLE_MAX    = %3d, SEM_MAX  = %3d\n", pole_max_, sem_max_);
+    outfile->Printf( "\tADC_TYPE    = %s\n\n", options_.get_str("ADC_TYPE").c_str());
 
     outfile->Printf( "\tNXS           = %d\n", nxs_);
 //    outfile->Printf( "\tIRREP_XYZ     = [");
@@ -33,6 +33,7 @@
 #include "psi4/libmints/wavefunction.h"
 #include "psi4/libdpd/dpd.h"
 #include "psi4/psifiles.h"
+#include <vector>
 
 #define ID(x) _ints->DPD_ID(x)
 
@@ -82,6 +83,19 @@ protected:
     void shift_denom2(int root, int irrep, double omega);
     void shift_denom4(int irrep, double omega);
 
+    // Density-fitted ADC(2), all quantities held in core
+    double df_compute_energy();
+    double df_init_tensors();
+    void df_prepare_tensors();
+    void df_amplitudes(int i, double *I, double *K, bool pr);
+    void df_construct_sigma(int irrep, double omega, SharedMatrix B, SharedMatrix S, bool cis);
+    void df_doubles_sigma(double omega, SharedMatrix B, SharedMatrix S, bool deriv);
+    void df_apply_L(SharedMatrix C, SharedMatrix S, double alpha);
+    double df_differentiate_omega(int irrep, double omega, SharedMatrix V);
+    void df_diagonalize(int irrep, int num_root, bool first, bool cis, double omega, std::vector<SharedMatrix> &V, double *eps);
+    void df_mask(int irrep, SharedMatrix B);
+    void amps_write(SharedMatrix B, int irrep, int length);
+
     // Number of the singly excited configurations
     int nxs_;
     // Number of singly occupied orbitals
@@ -128,6 +142,28 @@ protected:
     IntegralTransform *_ints;
     // Guesses for the correlated excitation energies, which are given as CIS/ADC(1) energies
     SharedVector omega_guess_;
+
+    // Number of active occupied, active virtual and auxiliary functions (DF)
+    int naocc_;
+    int navir_;
+    int nQ_;
+    // Irrep of each active occupied and virtual MO, in DPD order (DF)
+    std::vector<int> occsym_;
+    std::vector<int> virsym_;
+    // Three-index integrals b^Q_{ij}, b^Q_{ia} and b^Q_{ab}, stored Q x pq (DF)
+    SharedMatrix Bij_;
+    SharedMatrix Bia_;
+    SharedMatrix Bab_;
+    // Symmetrized 3h-3p intermediates and the diagonal of the frequency independent part (DF)
+    SharedMatrix Aoo_;
+    SharedMatrix Avv_;
+    SharedMatrix Dov_;
+    // rho_ii / 2, so that N_ij = 1 + pr_rho_[i] + pr_rho_[j] in the partial renormalization (DF)
+    std::vector<double> pr_rho_;
+    // CIS/ADC(1) eigenvectors of each irrep, used as the guess and for the rotation angle (DF)
+    std::vector<std::vector<SharedMatrix> > cis_vecs_;
+    // Number of threads used in the per-occupied loops of the sigma construction (DF)
+    int nthread_;
 };
 
 }}
@@ -84,6 +84,37 @@ ADCWfn::amps_write(dpdfile2 *B, int length, std::string out)
     free(t1stack);
 }
 
+void
+ADCWfn::amps_write(SharedMatrix B, int irrep, int length)
+{
+    struct onestack *t1stack;
+
+    t1stack = (struct onestack*)malloc(length*sizeof(struct onestack));
+    for(int m = 0; m < length; m++) { t1stack[m].value = 0; t1stack[m].i = 0; t1stack[m].a = 0; }
+
+    double **Bp = B->pointer();
+    int numt1 = nxspi_[irrep];
+    for(int i = 0;i < naocc_;i++){
+        for(int a = 0;a < navir_;a++){
+            if((occsym_[i] ^ virsym_[a]) != irrep) continue;
+            double value = Bp[i][a];
+            for(int m = 0;m < length;m++){
+                if((fabs(value)-fabs(t1stack[m].value)) > 1e-12){
+                    onestack_insert(t1stack, value, i, a, m, length);
+                    break;
+                }
+            }
+        }
+    }
+
+    for(int m = 0;m < ((numt1 < length) ? numt1 : length);m++){
+        if(fabs(t1stack[m].value) > 1e-6){
+            outfile->Printf( "\t        %3d %3d %20.10f\n", t1stack[m].i, t1stack[m].a, t1stack[m].value);
+        }
+    }
+    free(t1stack);
+}
+
 void
 ADCWfn::onestack_insert(struct onestack *stack, double value, int i, int a, int level, int stacklen)
 {
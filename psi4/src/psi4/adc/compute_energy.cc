@@ -52,6 +52,9 @@ ADCWfn::compute_energy()
     double *omega, omega_o, omega_diff, theta;
     dpdfile2 B, V;
 
+    if(options_.get_str("ADC_TYPE") == "DF")
+        return df_compute_energy();
+
     omega_guess_ = SharedVector(new Vector(nirrep_, rpi_));
 
     if(options_.get_str("REFERENCE") == "RHF"){
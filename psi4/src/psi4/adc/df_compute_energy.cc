@@ -0,0 +1,157 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2016 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "psi4/psi4-dec.h"
+#include "psi4/liboptions/liboptions.h"
+#include "psi4/libciomr/libciomr.h"
+#include "psi4/libqt/qt.h"
+#include "psi4/physconst.h"
+#include "psi4/adc/adc.h"
+#include "psi4/libmints/molecule.h"
+#include <cmath>
+#include <sstream>
+
+namespace psi{ namespace adc {
+
+//
+//  Driver of the density-fitted ADC(2). The Newton-Raphson search of each pole is the same as
+//  in compute_energy, but the block-Davidson subspace is carried over from one Newton step to
+//  the next, and no integral transformation, DPD sort or four-index file is involved.
+//
+
+double
+ADCWfn::df_compute_energy()
+{
+    double corr_energy, omega_o, omega_diff, theta, denom;
+    double *omega;
+
+    omega_guess_ = SharedVector(new Vector(nirrep_, rpi_));
+
+    timer_on("DF-ADC: Setup");
+    corr_energy = df_init_tensors();
+    df_prepare_tensors();
+    timer_off("DF-ADC: Setup");
+
+    // Now we got all ingredients to set up Newton-Raphson and block-Davidson procedures.
+    // The secular equation to solve is written as A^{eff}_{SS}(\omega)V_S = V_S\Omega,
+    // where subscript S stands for the singly excited manifold.
+
+    if(!options_.get_bool("PR"))
+        outfile->Printf( "\t==> DF-ADC(2) Computation <==\n\n");
+    else
+        outfile->Printf( "\t==> DF-PR-ADC(2) Computation <==\n\n");
+
+    std::string state_top = "ADC ROOT ";
+    char **irrep_      = molecule_->irrep_labels();
+
+    for(int irrep = 0;irrep < nirrep_;irrep++){
+        if(rpi_[irrep]){
+            omega = init_array(rpi_[irrep]);
+            for(int root = 0;root < rpi_[irrep];root++){
+                omega_o = omega_guess_->get(irrep, root);
+                bool first = true;
+                std::ostringstream oss;
+
+                // The CIS vectors start the Ritz space of the first Newton step, the
+                // eigenvectors of the previous step are reused afterwards.
+                std::vector<SharedMatrix> V;
+                for(int k = 0;k <= root;k++) V.push_back(cis_vecs_[irrep][k]->clone());
+
+                for(int iter = 1;iter <= pole_max_;iter++){
+                    df_diagonalize(irrep, root+1, first, false, omega_o, V, omega);
+                    first = false;
+                    denom = 1 - df_differentiate_omega(irrep, omega_o, V[root]);
+                    omega_diff = (omega_o-omega[root]) / denom;
+                    if(DEBUG_)  printf("%e, %10.7f\n", omega_diff, 1/denom);
+                    if(fabs(omega_diff) < conv_){
+                        poles_[irrep][root].iter          = iter;
+                        poles_[irrep][root].iter_value    = omega[root];
+                        poles_[irrep][root].renorm_factor = 1/denom;
+
+                        outfile->Printf( "->\t%d%3s state   : %10.7f (a.u.), %10.7f (eV)\n", root+1, irrep_[irrep], omega[root], omega[root]*pc_hartree2ev);
+                        outfile->Printf( "\tNon-iterative: %10.7f (a.u.), %10.7f (eV)\n", poles_[irrep][root].ps_value, poles_[irrep][root].ps_value*pc_hartree2ev);
+                        outfile->Printf( "\t         Occ Vir        Coefficient\n");
+                        outfile->Printf( "\t---------------------------------------------\n");
+                        int nprint;
+                        if(nxspi_[irrep] < num_amps_) nprint = nxspi_[irrep];
+                        else nprint = num_amps_;
+                        amps_write(V[root], irrep, nprint);
+                        outfile->Printf( "\n");
+                        outfile->Printf( "\tConverged in %3d iteration.\n", iter);
+                        outfile->Printf( "\tSquared norm of the S component: %10.7f\n", poles_[irrep][root].renorm_factor);
+
+                        double overlap = cis_vecs_[irrep][root]->vector_dot(V[root]);
+                        if(overlap >  1.0) overlap =  1.0;
+                        if(overlap < -1.0) overlap = -1.0;
+                        theta = acos(overlap) * 180.0 / pc_pi;
+                        if((180.0-fabs(theta)) < theta) theta = 180.0 - fabs(theta);
+                        poles_[irrep][root].rot_angle = theta;
+                        outfile->Printf( "\tThe S vector is rotated up to %6.3f (deg.)\n", theta);
+                        if(theta > ANGL_TOL_)
+                            outfile->Printf( "\t#WARNING: Strongly rotated from the CIS state!\n");
+                        outfile->Printf( "\n");
+
+                        /*- Process::environment.globals["ADC ROOT n s EXCITATION ENERGY"] -*/
+                        oss << state_top << root + 1 << " " << irrep_[irrep] << " EXCITATION ENERGY";
+                        Process::environment.globals[oss.str()] = omega[root];
+                        /*- Process::environment.globals["ADC ROOT n s CORRELATION ENERGY"] -*/
+                        oss.str(std::string());
+                        oss << state_top << root + 1 << " " << irrep_[irrep] << " CORRELATION ENERGY";
+                        Process::environment.globals[oss.str()] = omega[root] + corr_energy;
+                        /*- Process::environment.globals["ADC ROOT n s TOTAL ENERGY"] -*/
+                        oss.str(std::string());
+                        oss << state_top << root + 1 << " " << irrep_[irrep] << " TOTAL ENERGY";
+                        Process::environment.globals[oss.str()] = omega[root] + energy_ + corr_energy;
+
+                        break;
+                    }
+                    else
+                        omega_o -= omega_diff;
+                }
+
+            }
+            free(omega);
+        }
+    }
+
+    energy_ += corr_energy;
+    Process::environment.globals["MP2 CORRELATION ENERGY"] = corr_energy;
+    Process::environment.globals["MP2 TOTAL ENERGY"] = energy_;
+    Process::environment.globals["CURRENT CORRELATION ENERGY"] = corr_energy;
+    Process::environment.globals["CURRENT ENERGY"] = energy_;
+    outfile->Printf( "->\tCorresponding GS total energy (a.u.) = %20.14f\n", energy_);
+
+    Bij_.reset();
+    Bia_.reset();
+    Bab_.reset();
+    cis_vecs_.clear();
+    release_mem();
+
+    return energy_;
+}
+
+}} // End Namespaces
@@ -0,0 +1,254 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2016 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "psi4/psi4-dec.h"
+#include "psi4/liboptions/liboptions.h"
+#include "psi4/libqt/qt.h"
+#include "psi4/adc/adc.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace psi{ namespace adc{
+
+//
+//  The sigma vector of the DF-ADC(2) response matrix is assembled from the three-index
+//  integrals only. Every term of rhf_construct_sigma has a counterpart here:
+//
+//  D, E : The same 3h-3p intermediates as DOV and EOV, contracted with the MP1 amplitudes
+//         which are rebuilt for one occupied index at a time.
+//  T    : T^Q_{ia} = \sum_c b_{ic} b^Q_{ca} - \sum_j b^Q_{ij} b_{ja}, so that
+//         ZOOVV_{ijab} = \sum_Q b^Q_{ia} T^Q_{jb}.
+//  W    : The 2h-2p intermediate BOOVV for a fixed i, never stored for all i.
+//  M    : M^Q_{ia} = \sum_{jb} W_{ijab} b^Q_{jb}, which carries the 2h-2p block back to the S manifold.
+//
+
+void
+ADCWfn::df_mask(int irrep, SharedMatrix B)
+{
+    double **Bp = B->pointer();
+    for(int i = 0;i < naocc_;i++)
+        for(int a = 0;a < navir_;a++)
+            if((occsym_[i] ^ virsym_[a]) != irrep) Bp[i][a] = 0.0;
+}
+
+void
+ADCWfn::df_apply_L(SharedMatrix C, SharedMatrix S, double alpha)
+{
+    int nocc = naocc_;
+    int nvir = navir_;
+    int nov  = nocc * nvir;
+    double **Cp   = C->pointer();
+    double **Biap = Bia_->pointer();
+
+    // S_{ia} <-- 2 alpha \sum_{jb} (ia|jb) c_{jb}
+    std::vector<double> g(nQ_);
+    C_DGEMV('N', nQ_, nov, 1.0, Biap[0], nov, Cp[0], 1, 0.0, g.data(), 1);
+    C_DGEMV('T', nQ_, nov, 2.0 * alpha, Biap[0], nov, g.data(), 1, 1.0, S->pointer()[0], 1);
+
+    // S_{ia} <-- - alpha \sum_{Qj} (\sum_b b^Q_{ib} c_{jb}) b^Q_{ja}
+    std::vector<SharedMatrix> St, Pt;
+    for(int t = 0;t < nthread_;t++){
+        St.push_back(SharedMatrix(new Matrix("S temp", nocc, nvir)));
+        Pt.push_back(SharedMatrix(new Matrix("P temp", nocc, nocc)));
+    }
+#pragma omp parallel for schedule(static) num_threads(nthread_)
+    for(int Q = 0;Q < nQ_;Q++){
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        double **Pp = Pt[thread]->pointer();
+        C_DGEMM('N', 'T', nocc, nocc, nvir, 1.0, Biap[Q], nvir, Cp[0], nvir, 0.0, Pp[0], nocc);
+        C_DGEMM('N', 'N', nocc, nvir, nocc, -alpha, Pp[0], nocc, Biap[Q], nvir, 1.0, St[thread]->pointer()[0], nvir);
+    }
+    for(int t = 0;t < nthread_;t++) S->add(St[t]);
+}
+
+void
+ADCWfn::df_construct_sigma(int irrep, double omega, SharedMatrix B, SharedMatrix S, bool cis)
+{
+    bool do_pr = options_.get_bool("PR");
+    int nocc = naocc_;
+    int nvir = navir_;
+    int nov  = nocc * nvir;
+    double **bp   = B->pointer();
+    double **sp   = S->pointer();
+    double **Bijp = Bij_->pointer();
+    double **Babp = Bab_->pointer();
+
+    // CIS term: \sigma_{ia} <-- (e_a - e_i) b_{ia} + \sum_{jb} (2 (ia|jb) - (ij|ab)) b_{jb}
+    for(int i = 0;i < nocc;i++)
+        for(int a = 0;a < nvir;a++)
+            sp[i][a] = (avire_[a] - aocce_[i]) * bp[i][a];
+
+    std::vector<double> g(nQ_);
+    C_DGEMV('N', nQ_, nov, 1.0, Bia_->pointer()[0], nov, bp[0], 1, 0.0, g.data(), 1);
+    C_DGEMV('T', nQ_, nov, 2.0, Bia_->pointer()[0], nov, g.data(), 1, 1.0, sp[0], 1);
+
+    std::vector<SharedMatrix> St, Xt;
+    for(int t = 0;t < nthread_;t++){
+        St.push_back(SharedMatrix(new Matrix("S temp", nocc, nvir)));
+        Xt.push_back(SharedMatrix(new Matrix("X temp", nocc, nvir)));
+    }
+#pragma omp parallel for schedule(static) num_threads(nthread_)
+    for(int Q = 0;Q < nQ_;Q++){
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        double **Xp = Xt[thread]->pointer();
+        // X^Q_{ja} = \sum_b b_{jb} b^Q_{ba}, \sigma_{ia} <-- - \sum_j b^Q_{ij} X^Q_{ja}
+        C_DGEMM('N', 'N', nocc, nvir, nvir, 1.0, bp[0], nvir, Babp[Q], nvir, 0.0, Xp[0], nvir);
+        C_DGEMM('N', 'N', nocc, nvir, nocc, -1.0, Bijp[Q], nocc, Xp[0], nvir, 1.0, St[thread]->pointer()[0], nvir);
+    }
+    for(int t = 0;t < nthread_;t++) S->add(St[t]);
+    St.clear();
+    Xt.clear();
+
+    if(cis){
+        df_mask(irrep, S);
+        return;
+    }
+
+    // \sigma_{ia} <-- \sum_j AOO_{ij} b_{ja} + \sum_b b_{ib} AVV_{ba}
+    C_DGEMM('N', 'N', nocc, nvir, nocc, 1.0, Aoo_->pointer()[0], nocc, bp[0], nvir, 1.0, sp[0], nvir);
+    C_DGEMM('N', 'N', nocc, nvir, nvir, 1.0, bp[0], nvir, Avv_->pointer()[0], nvir, 1.0, sp[0], nvir);
+
+    // D_{ia} <-- \sum_{jb} (2 <ij|ab> - <ij|ba>) b_{jb}
+    SharedMatrix D(new Matrix("DOV", nocc, nvir));
+    df_apply_L(B, D, 1.0);
+    double **Dp = D->pointer();
+
+    // E_{ia} <-- \sum_{jb} (2 K_{ijab} - K_{ijba}) b_{jb}
+    // \sigma_{ia} <-- 0.5 \sum_{jb} (2 K_{ijab} - K_{ijba}) D_{jb}
+    SharedMatrix E(new Matrix("EOV", nocc, nvir));
+    double **Ep = E->pointer();
+    timer_on("DF-ADC: 3h-3p");
+#pragma omp parallel num_threads(nthread_)
+    {
+    std::vector<double> I((size_t)nov * nvir);
+    std::vector<double> K((size_t)nov * nvir);
+#pragma omp for schedule(dynamic)
+    for(int i = 0;i < nocc;i++){
+        df_amplitudes(i, I.data(), K.data(), do_pr);
+        C_DGEMV('N', nvir, nov, 1.0, K.data(), nov, bp[0], 1, 0.0, Ep[i], 1);
+        C_DGEMV('N', nvir, nov, 0.5, K.data(), nov, Dp[0], 1, 1.0, sp[i], 1);
+    }
+    }
+    timer_off("DF-ADC: 3h-3p");
+
+    // \sigma_{ia} <-- 0.5 \sum_{jb} (2 <ij|ab> - <ij|ba>) E_{jb}
+    df_apply_L(E, S, 0.5);
+
+    df_doubles_sigma(omega, B, S, false);
+    df_mask(irrep, S);
+}
+
+void
+ADCWfn::df_doubles_sigma(double omega, SharedMatrix B, SharedMatrix S, bool deriv)
+{
+    int nocc = naocc_;
+    int nvir = navir_;
+    int nov  = nocc * nvir;
+    double **bp   = B->pointer();
+    double **Bijp = Bij_->pointer();
+    double **Biap = Bia_->pointer();
+    double **Babp = Bab_->pointer();
+
+    // T^Q_{ia} <-- \sum_c b_{ic} b^Q_{ca} - \sum_j b^Q_{ij} b_{ja}
+    SharedMatrix T(new Matrix("T^Q_ia", nQ_, nov));
+    double **Tp = T->pointer();
+#pragma omp parallel for schedule(static) num_threads(nthread_)
+    for(int Q = 0;Q < nQ_;Q++){
+        C_DGEMM('N', 'N', nocc, nvir, nvir,  1.0, bp[0], nvir, Babp[Q], nvir, 0.0, Tp[Q], nvir);
+        C_DGEMM('N', 'N', nocc, nvir, nocc, -1.0, Bijp[Q], nocc, bp[0], nvir, 1.0, Tp[Q], nvir);
+    }
+
+    SharedMatrix M(new Matrix("M^Q_ia", nQ_, nov));
+    double **Mp = M->pointer();
+    timer_on("DF-ADC: 2h-2p");
+#pragma omp parallel num_threads(nthread_)
+    {
+    std::vector<double> U((size_t)nov * nvir);
+    std::vector<double> W((size_t)nov * nvir);
+#pragma omp for schedule(dynamic)
+    for(int i = 0;i < nocc;i++){
+        // U_{a,jb} <-- ZOOVV_{ijab} + ZOOVV_{jiba} = \sum_Q (b^Q_{ia} T^Q_{jb} + T^Q_{ia} b^Q_{jb})
+        C_DGEMM('T', 'N', nvir, nov, nQ_, 1.0, &Biap[0][i*nvir], nov, Tp[0], nov, 0.0, U.data(), nov);
+        C_DGEMM('T', 'N', nvir, nov, nQ_, 1.0, &Tp[0][i*nvir], nov, Biap[0], nov, 1.0, U.data(), nov);
+        // W_{a,jb} <-- (2 U_{ijab} - U_{ijba}) / (\omega+e_i-e_a+e_j-e_b), or the derivative
+        // - (2 U_{ijab} - U_{ijba}) / (\omega+e_i-e_a+e_j-e_b)^2 with respect to \omega
+        for(int a = 0;a < nvir;a++){
+            for(int j = 0;j < nocc;j++){
+                double wij = omega + aocce_[i] + aocce_[j] - avire_[a];
+                for(int b = 0;b < nvir;b++){
+                    double d = 1.0 / (wij - avire_[b]);
+                    if(deriv) d = - d * d;
+                    W[a*nov+j*nvir+b] = (2.0 * U[a*nov+j*nvir+b] - U[b*nov+j*nvir+a]) * d;
+                }
+            }
+        }
+        // M^Q_{ia} <-- \sum_{jb} W_{ijab} b^Q_{jb}
+        C_DGEMM('N', 'T', nQ_, nvir, nov, 1.0, Biap[0], nov, W.data(), nov, 0.0, &Mp[0][i*nvir], nov);
+    }
+    }
+    timer_off("DF-ADC: 2h-2p");
+    T.reset();
+
+    // \sigma_{ia} <-- \sum_{jbc} B_{ijbc} <ja|cb>  - \sum_{jkb} <kj|bi> B_{jkab}
+    //              =  \sum_{Qb} M^Q_{ib} b^Q_{ba} - \sum_{Qj} b^Q_{ij} M^Q_{ja}
+    std::vector<SharedMatrix> St;
+    for(int t = 0;t < nthread_;t++) St.push_back(SharedMatrix(new Matrix("S temp", nocc, nvir)));
+#pragma omp parallel for schedule(static) num_threads(nthread_)
+    for(int Q = 0;Q < nQ_;Q++){
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        double **Sp = St[thread]->pointer();
+        C_DGEMM('N', 'N', nocc, nvir, nvir,  1.0, Mp[Q], nvir, Babp[Q], nvir, 1.0, Sp[0], nvir);
+        C_DGEMM('N', 'N', nocc, nvir, nocc, -1.0, Bijp[Q], nocc, Mp[Q], nvir, 1.0, Sp[0], nvir);
+    }
+    for(int t = 0;t < nthread_;t++) S->add(St[t]);
+}
+
+double
+ADCWfn::df_differentiate_omega(int irrep, double omega, SharedMatrix V)
+{
+    int nocc = naocc_;
+    int nvir = navir_;
+
+    // \frac{\partial \omega^{eigen}}{\partial omega} = V^t\frac{\partial A(\omega)}{\partial \omega}V
+    SharedMatrix D(new Matrix("dV", nocc, nvir));
+    df_doubles_sigma(omega, V, D, true);
+    df_mask(irrep, D);
+
+    return D->vector_dot(V);
+}
+
+}} // End Namespaces
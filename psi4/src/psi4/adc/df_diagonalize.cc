@@ -0,0 +1,221 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2016 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "psi4/psi4-dec.h"
+#include "psi4/libparallel/ParallelPrinter.h"
+#include "psi4/libqt/qt.h"
+#include "psi4/libciomr/libciomr.h"
+#include <cmath>
+#include <algorithm>
+#include "adc.h"
+
+namespace psi{ namespace adc{
+
+//
+//  In-core counterpart of rhf_diagonalize for the DF-ADC(2) response matrix. The trial and
+//  sigma vectors of the Ritz space are kept as O x V matrices, so that a collapse of the
+//  subspace costs no additional sigma construction.
+//
+//  B: Basis of Ritz space.
+//  S: Sigma vectors for the response matrix with OV indices.
+//  F: The correction vectors for the basis of Ritz space.
+//  V: Guess vectors on entry, converged eigenvectors on exit.
+//
+
+static bool
+schmidt_add(std::vector<SharedMatrix> &B, SharedMatrix F, double norm_tol)
+{
+    for(size_t I = 0;I < B.size();I++)
+        F->axpy(-F->vector_dot(B[I]), B[I]);
+    double norm = sqrt(F->vector_dot(F));
+    if(norm < norm_tol) return false;
+    F->scale(1.0/norm);
+    B.push_back(F);
+    return true;
+}
+
+void
+ADCWfn::df_diagonalize(int irrep, int num_root, bool first, bool cis, double omega, std::vector<SharedMatrix> &V, double *eps)
+{
+    int nocc = naocc_;
+    int nvir = navir_;
+    int iter, length, prev_length, maxdim, converged;
+    double **G, **Alpha, *lambda, *lambda_o, *residual_norm;
+    double **Dp = Dov_->pointer();
+    std::vector<SharedMatrix> B, S;
+
+    if(num_root > nxspi_[irrep])
+        throw PSIEXCEPTION("ADC: more roots requested than singly excited configurations in the irrep.");
+    maxdim = 10 * num_root;
+    if(maxdim > nxspi_[irrep]) maxdim = nxspi_[irrep];
+
+    // Orthonormalized guesses, completed by unit vectors on the smallest diagonal elements
+    for(size_t k = 0;k < V.size() && (int)B.size() < num_root;k++)
+        schmidt_add(B, V[k]->clone(), norm_tol_);
+    if((int)B.size() < num_root){
+        std::vector<std::pair<double, int> > diag;
+        for(int i = 0;i < nocc;i++)
+            for(int a = 0;a < nvir;a++)
+                if((occsym_[i] ^ virsym_[a]) == irrep) diag.push_back(std::make_pair(Dp[i][a], i*nvir+a));
+        std::sort(diag.begin(), diag.end());
+        for(size_t n = 0;n < diag.size() && (int)B.size() < num_root;n++){
+            SharedMatrix F(new Matrix("F", nocc, nvir));
+            F->pointer()[0][diag[n].second] = 1.0;
+            schmidt_add(B, F, norm_tol_);
+        }
+    }
+
+    G             = block_matrix(maxdim, maxdim);
+    Alpha         = block_matrix(maxdim, maxdim);
+    lambda        = init_array(maxdim);
+    lambda_o      = init_array(maxdim);
+    residual_norm = init_array(num_root);
+
+    std::shared_ptr<OutFile> printer(new OutFile("iter.dat",APPEND));
+
+    timer_on("SEM");
+    iter = 0;
+    prev_length = 0;
+    length = B.size();
+    while(iter < sem_max_){
+        printer->Printf("\niter = %d, dim = %d\n", iter, length);
+
+        // Evaluating the sigma vectors
+        timer_on("Sigma construction");
+        for(int I = prev_length;I < length;I++){
+            SharedMatrix sig(new Matrix("S", nocc, nvir));
+            df_construct_sigma(irrep, omega, B[I], sig, cis);
+            S.push_back(sig);
+        }
+        timer_off("Sigma construction");
+
+        // Making so called Davidson mini-Hamiltonian, or Rayleigh matrix
+        for(int I = prev_length;I < length;I++){
+            for(int J = 0;J <= I;J++){
+                double sum = B[J]->vector_dot(S[I]);
+                G[I][J] = G[J][I] = sum;
+            }
+        }
+        if(first && !iter) poles_[irrep][num_root-1].ps_value = G[num_root-1][num_root-1];
+
+        double **Gcopy = block_matrix(length, length);
+        for(int I = 0;I < length;I++)
+            for(int J = 0;J < length;J++)
+                Gcopy[I][J] = G[I][J];
+        sq_rsp(length, length, Gcopy, lambda, 1, Alpha, 1e-12);
+        free_block(Gcopy);
+        prev_length = length;
+
+        // Constructing the corretion vectors
+        std::vector<SharedMatrix> F;
+        converged = 0;
+        printer->Printf("Root          Eigenvalue   Delta     Res_Norm     Conv?\n");
+        printer->Printf("----     ---------------- -------    --------- ----------\n");
+        for(int k = 0;k < num_root;k++){
+            SharedMatrix f(new Matrix("F", nocc, nvir));
+            for(int I = 0;I < length;I++){
+                f->axpy(Alpha[I][k], S[I]);
+                f->axpy(-Alpha[I][k]*lambda[k], B[I]);
+            }
+            residual_norm[k] = sqrt(f->vector_dot(f));
+            double diff = fabs(lambda[k]-lambda_o[k]);
+            bool conv = (diff < conv_ && residual_norm[k] < norm_tol_);
+            if(conv) converged++;
+            else F.push_back(f);
+            printer->Printf("%3d  %20.14f %4.3e   %4.3e     %1s\n", k, lambda[k], diff, residual_norm[k], conv ? "Y" : "N");
+            lambda_o[k] = lambda[k];
+
+            double **fp = f->pointer();
+            for(int i = 0;i < nocc;i++){
+                for(int a = 0;a < nvir;a++){
+                    double denom = lambda[k] - Dp[i][a];
+                    fp[i][a] = (fabs(denom) > 1e-6 ? fp[i][a] / denom : 0.0);
+                }
+            }
+            df_mask(irrep, f);
+        }
+        if(converged == num_root){
+            printer->Printf("Davidson algorithm converged in %d iterations for %dth root.\n", iter, num_root-1);
+            break;
+        }
+
+        // Subspace too large: collapse onto the current Ritz vectors, sigma vectors included
+        if(length + (int)F.size() > maxdim){
+            printer->Printf( "Subspace too large:maxdim = %d, L = %d\n", maxdim, length);
+            printer->Printf( "Collapsing eigenvectors.\n");
+            std::vector<SharedMatrix> Bn, Sn;
+            for(int k = 0;k < num_root;k++){
+                SharedMatrix b(new Matrix("B", nocc, nvir));
+                SharedMatrix s(new Matrix("S", nocc, nvir));
+                for(int I = 0;I < length;I++){
+                    b->axpy(Alpha[I][k], B[I]);
+                    s->axpy(Alpha[I][k], S[I]);
+                }
+                Bn.push_back(b);
+                Sn.push_back(s);
+            }
+            B = Bn;
+            S = Sn;
+            for(int k = 0;k < num_root;k++){
+                for(int l = 0;l < num_root;l++) G[k][l] = Alpha[k][l] = 0.0;
+                G[k][k] = lambda[k];
+                Alpha[k][k] = 1.0;
+            }
+            length = prev_length = num_root;
+        }
+
+        // Expand the Ritz space by orthogonalizing {F} to {B} according to Gram-Schmidt procedure
+        for(size_t k = 0;k < F.size() && length < maxdim;k++)
+            if(schmidt_add(B, F[k], norm_tol_)) length++;
+        if(length == prev_length){
+            printer->Printf("No new vectors could be added to the Ritz space.\n");
+            break;
+        }
+        iter++;
+    }
+    timer_off("SEM");
+
+    if(converged < num_root)
+        outfile->Printf( "\t#WARNING: Davidson procedure did not converge in irrep %d!\n", irrep);
+
+    V.clear();
+    for(int k = 0;k < num_root;k++){
+        eps[k] = lambda[k];
+        SharedMatrix v(new Matrix("V", nocc, nvir));
+        for(int I = 0;I < prev_length;I++)
+            v->axpy(Alpha[I][k], B[I]);
+        V.push_back(v);
+    }
+
+    free_block(G);
+    free_block(Alpha);
+    free(lambda);
+    free(lambda_o);
+    free(residual_norm);
+}
+
+}} // End Namespaces
@@ -0,0 +1,231 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2016 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "psi4/psi4-dec.h"
+#include "psi4/liboptions/liboptions.h"
+#include "psi4/libmints/basisset.h"
+#include "psi4/libmints/molecule.h"
+#include "psi4/libthce/thce.h"
+#include "psi4/libthce/lreri.h"
+#include "psi4/libqt/qt.h"
+#include "psi4/libciomr/libciomr.h"
+#include "psi4/physconst.h"
+#include "psi4/adc/adc.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace psi{ namespace adc {
+
+//
+//  Bij, Bia, Bab : Fitted three-index integrals b^Q_{pq} = \sum_P (pq|P)[J^{-1/2}]_{PQ}, so that
+//                  (pq|rs) = \sum_Q b^Q_{pq} b^Q_{rs}. No four-index quantity is stored; the (ia|jb)
+//                  block needed for a given occupied index i is rebuilt on the fly.
+//  I, K          : (ia|jb) and 2 K_{ijab} - K_{ijba} for a fixed i, both laid out as [a][jb].
+//
+
+void
+ADCWfn::df_amplitudes(int i, double *I, double *K, bool pr)
+{
+    int nocc = naocc_;
+    int nvir = navir_;
+    int nov  = nocc * nvir;
+    double **Biap = Bia_->pointer();
+
+    // I_{a,jb} <-- \sum_Q b^Q_{ia} b^Q_{jb}
+    C_DGEMM('T', 'N', nvir, nov, nQ_, 1.0, &Biap[0][i*nvir], nov, Biap[0], nov, 0.0, I, nov);
+
+    // K_{a,jb} <-- (2 (ia|jb) - (ib|ja)) / (e_i + e_j - e_a - e_b) [/ N_ij]
+    for(int a = 0;a < nvir;a++){
+        for(int j = 0;j < nocc;j++){
+            double scale = (pr ? 1.0 / (1.0 + pr_rho_[i] + pr_rho_[j]) : 1.0);
+            double eij = aocce_[i] + aocce_[j] - avire_[a];
+            for(int b = 0;b < nvir;b++){
+                K[a*nov+j*nvir+b] = scale * (2.0 * I[a*nov+j*nvir+b] - I[b*nov+j*nvir+a]) / (eij - avire_[b]);
+            }
+        }
+    }
+}
+
+double
+ADCWfn::df_init_tensors()
+{
+    double ePR2, sq_norm, energy;
+
+    // Active MO dimensions and irrep labels in DPD order
+    occsym_.clear();
+    virsym_.clear();
+    for(int h = 0;h < nirrep_;h++){
+        for(int i = 0;i < aoccpi_[h];i++) occsym_.push_back(h);
+        for(int a = 0;a < avirpi_[h];a++) virsym_.push_back(h);
+    }
+    naocc_ = occsym_.size();
+    navir_ = virsym_.size();
+    int nocc = naocc_;
+    int nvir = navir_;
+    int nov  = nocc * nvir;
+
+    std::shared_ptr<BasisSet> auxiliary = BasisSet::pyconstruct_auxiliary(molecule_,
+        "DF_BASIS_ADC", options_.get_str("DF_BASIS_ADC"), "RIFIT", options_.get_str("BASIS"));
+    nQ_ = auxiliary->nbf();
+
+    // The three-index integrals and two Q x OV work arrays are held in core, and every
+    // thread needs two OVV buffers in the loops over the occupied index.
+    int nthread = 1;
+#ifdef _OPENMP
+    nthread = omp_get_max_threads();
+#endif
+    long int mem        = (long int)(Process::environment.get_memory() / 8L);
+    long int core       = (long int)nQ_ * ((long int)nocc * nocc + 3L * nov + (long int)nvir * nvir);
+    long int per_thread = 2L * nov * nvir;
+    if(core + per_thread > mem)
+        throw PSIEXCEPTION("DF-ADC(2): not enough memory to hold the three-index integrals in core.");
+    nthread_ = ((mem - core) / per_thread < nthread ? (int)((mem - core) / per_thread) : nthread);
+
+    outfile->Printf( "\n\t==> DF-ADC(2) Setup <==\n\n");
+    outfile->Printf( "\tNAOCC = %5d, NAVIR = %5d, NAUX = %5d\n", nocc, nvir, nQ_);
+    outfile->Printf( "\tMemory for DF tensors (MB) = %10.1f\n", core * 8.0 / (1024.0 * 1024.0));
+    outfile->Printf( "\tThreads in occupied loops  = %10d\n\n", nthread_);
+
+    // Active occupied and virtual MOs in the AO basis, blocked by irreps
+    int nao = AO2SO_->rowspi()[0];
+    SharedMatrix AO_C(new Matrix("AO_C", nao, nocc + nvir));
+    double **AO_Cp = AO_C->pointer();
+    for(int h = 0, ooff = 0, voff = nocc;h < nirrep_;h++){
+        int hnso = AO2SO_->colspi()[h];
+        if(hnso){
+            double **Up = AO2SO_->pointer(h);
+            double **Cp = Ca_->pointer(h);
+            if(aoccpi_[h])
+                C_DGEMM('N', 'N', nao, aoccpi_[h], hnso, 1.0, Up[0], hnso, &Cp[0][frzcpi_[h]], nmopi_[h],
+                        0.0, &AO_Cp[0][ooff], nocc + nvir);
+            if(avirpi_[h])
+                C_DGEMM('N', 'N', nao, avirpi_[h], hnso, 1.0, Up[0], hnso, &Cp[0][doccpi_[h]], nmopi_[h],
+                        0.0, &AO_Cp[0][voff], nocc + nvir);
+        }
+        ooff += aoccpi_[h];
+        voff += avirpi_[h];
+    }
+
+    std::shared_ptr<DFERI> dferi = DFERI::build(basisset_, auxiliary, options_);
+    dferi->set_C(AO_C);
+    dferi->add_space("o", 0, nocc);
+    dferi->add_space("v", nocc, nocc + nvir);
+    dferi->add_pair_space("Bij", "o", "o");
+    dferi->add_pair_space("Bia", "o", "v");
+    dferi->add_pair_space("Bab", "v", "v");
+    dferi->print_header();
+    dferi->compute();
+    std::map<std::string, std::shared_ptr<Tensor> >& dfints = dferi->ints();
+
+    // (pq|Q) on disk --> b^Q_{pq} in core
+    const char *keys[3] = {"Bij", "Bia", "Bab"};
+    size_t npair[3] = {(size_t)nocc * nocc, (size_t)nov, (size_t)nvir * nvir};
+    SharedMatrix *targets[3] = {&Bij_, &Bia_, &Bab_};
+    for(int n = 0;n < 3;n++){
+        SharedMatrix T(new Matrix(keys[n], npair[n], nQ_));
+        FILE *fh = dfints[keys[n]]->file_pointer();
+        fseek(fh, 0L, SEEK_SET);
+        if(npair[n]){
+            size_t statusvalue = fread(T->pointer()[0], sizeof(double), npair[n] * nQ_, fh);
+            if(statusvalue != npair[n] * nQ_)
+                throw PSIEXCEPTION("DF-ADC: Unable to read the " + std::string(keys[n]) + " integrals.");
+        }
+        *(targets[n]) = T->transpose();
+        (*(targets[n]))->set_name(keys[n]);
+    }
+    dferi.reset();
+
+    // MP1 amplitudes are never stored: the pair energies e_ij and squared norms n_ij of the
+    // MP1 wavefunction suffice for the MP2, PR-MP2 energies and the diagonal of RHO_OO.
+    SharedMatrix Eij(new Matrix("Pair energies", nocc, nocc));
+    SharedMatrix Nij(new Matrix("Pair norms", nocc, nocc));
+    double **Eijp = Eij->pointer();
+    double **Nijp = Nij->pointer();
+
+    timer_on("DF-ADC: MP2");
+#pragma omp parallel num_threads(nthread_)
+    {
+    std::vector<double> I((size_t)nov * nvir);
+    std::vector<double> K((size_t)nov * nvir);
+#pragma omp for schedule(dynamic)
+    for(int i = 0;i < nocc;i++){
+        df_amplitudes(i, I.data(), K.data(), false);
+        for(int j = 0;j < nocc;j++){
+            double e = 0.0, n = 0.0;
+            for(int a = 0;a < nvir;a++){
+                for(int b = 0;b < nvir;b++){
+                    double v = I[a*nov+j*nvir+b] * K[a*nov+j*nvir+b];
+                    e += v;
+                    n += v / (aocce_[i] + aocce_[j] - avire_[a] - avire_[b]);
+                }
+            }
+            Eijp[i][j] = e;
+            Nijp[i][j] = n;
+        }
+    }
+    }
+    timer_off("DF-ADC: MP2");
+
+    // RHO_OO_{ii} = \sum_{kab} K_{ikab} (2 K_{ikab} - K_{ikba})
+    pr_rho_.assign(nocc, 0.0);
+    for(int i = 0;i < nocc;i++)
+        for(int j = 0;j < nocc;j++)
+            pr_rho_[i] += 0.5 * Nijp[i][j];
+
+    energy = 0.0;
+    sq_norm = 1.0;
+    ePR2 = 0.0;
+    double sq_norm_pr = 1.0;
+    for(int i = 0;i < nocc;i++){
+        for(int j = 0;j < nocc;j++){
+            double Nrm = 1.0 + pr_rho_[i] + pr_rho_[j];
+            energy     += Eijp[i][j];
+            sq_norm    += Nijp[i][j];
+            ePR2       += Eijp[i][j] / Nrm;
+            sq_norm_pr += Nijp[i][j] / (Nrm * Nrm);
+        }
+    }
+
+    bool do_pr = options_.get_bool("PR");
+
+    outfile->Printf( "\n\t==> Ground State <==\n");
+    if(!do_pr) outfile->Printf( "->");
+    outfile->Printf( "\tMP2 energy    = %20.14f\n", energy);
+    outfile->Printf( "\t[Squared-norm of MP1 wavefunction    = %10.7f]\n", sq_norm);
+    // Partially renormalized MP2 energy and the MP1 wavefunction
+    // Reference: IJQC 78 (2000) 226, CPL 443 (2007) 389.
+    if(do_pr) outfile->Printf( "->");
+    outfile->Printf( "\tPR-MP2 energy = %20.14f\n", ePR2);
+    outfile->Printf( "\t[Squared-norm of PR-MP1 wavefunction = %10.7f]\n\n", sq_norm_pr);
+
+    if(do_pr) energy = ePR2;
+
+    return energy;
+}
+
+}} // End Namespaces
@@ -0,0 +1,141 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2016 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include "psi4/psi4-dec.h"
+#include "psi4/liboptions/liboptions.h"
+#include "psi4/libmints/molecule.h"
+#include "psi4/libqt/qt.h"
+#include "psi4/libciomr/libciomr.h"
+#include "psi4/physconst.h"
+#include "psi4/adc/adc.h"
+
+//
+//  DOV : Diagonal elements of the frequency independent part of the response matrix,
+//        used as the preconditioner of the block-Davidson procedure.
+//  AOO : Symmetrized 3h-3p intermediate with OO indices, as in rhf_prepare_tensors.
+//  AVV : Symmetrized 3h-3p intermediate with VV indices, as in rhf_prepare_tensors.
+//  N   : N^Q_{ia} = \sum_{jb} (2K_{ijab} - K_{ijba}) b^Q_{jb}, from which both AOO and AVV follow.
+//
+
+namespace psi{ namespace adc{
+
+void
+ADCWfn::df_prepare_tensors()
+{
+    bool do_pr = options_.get_bool("PR");
+    int nocc = naocc_;
+    int nvir = navir_;
+    int nov  = nocc * nvir;
+    double **Bijp = Bij_->pointer();
+    double **Biap = Bia_->pointer();
+    double **Babp = Bab_->pointer();
+    char **irrep_ = molecule_->irrep_labels();
+
+    outfile->Printf( "\t==> CIS/ADC(1) Level <==\n\n");
+
+    // D_{ia} <-- e_a - e_i + 2 (ia|ia) - (ii|aa)
+    Dov_ = SharedMatrix(new Matrix("DOV", nocc, nvir));
+    double **Dp = Dov_->pointer();
+    for(int i = 0;i < nocc;i++)
+        for(int a = 0;a < nvir;a++)
+            Dp[i][a] = avire_[a] - aocce_[i];
+    for(int Q = 0;Q < nQ_;Q++){
+        for(int i = 0;i < nocc;i++){
+            for(int a = 0;a < nvir;a++){
+                double bia = Biap[Q][i*nvir+a];
+                Dp[i][a] += 2.0 * bia * bia - Bijp[Q][i*nocc+i] * Babp[Q][a*nvir+a];
+            }
+        }
+    }
+
+    // CIS calculation for obtaining the guess energy and vector
+    // for the second order calculation, by the same block-Davidson
+    // procedure as the ADC(2) one with the frequency dependent part switched off.
+    cis_vecs_.assign(nirrep_, std::vector<SharedMatrix>());
+    for(int h = 0;h < nirrep_;h++){
+        if(!rpi_[h]) continue;
+        double *omega = init_array(rpi_[h]);
+        df_diagonalize(h, rpi_[h], false, true, 0.0, cis_vecs_[h], omega);
+        for(int root = 0;root < rpi_[h];root++){
+            omega_guess_->set(h, root, omega[root]);
+            outfile->Printf( "\t%d%3s state: %10.7f (a.u.), %10.7f (eV)\n", root+1, irrep_[h], omega[root], omega[root]*pc_hartree2ev);
+            outfile->Printf( "\t---------------------------------------------\n");
+            int nprint;
+            if(nxspi_[h] < num_amps_) nprint = nxspi_[h];
+            else nprint = num_amps_;
+            amps_write(cis_vecs_[h][root], h, nprint);
+            outfile->Printf( "\n");
+        }
+        free(omega);
+    }
+
+    // N^Q_{ia} <-- \sum_{jb} (2K_{ijab} - K_{ijba}) b^Q_{jb}
+    SharedMatrix N(new Matrix("N^Q_ia", nQ_, nov));
+    double **Np = N->pointer();
+    timer_on("DF-ADC: AOO/AVV");
+#pragma omp parallel num_threads(nthread_)
+    {
+    std::vector<double> I((size_t)nov * nvir);
+    std::vector<double> K((size_t)nov * nvir);
+#pragma omp for schedule(dynamic)
+    for(int i = 0;i < nocc;i++){
+        df_amplitudes(i, I.data(), K.data(), do_pr);
+        C_DGEMM('N', 'T', nQ_, nvir, nov, 1.0, Biap[0], nov, K.data(), nov, 0.0, &Np[0][i*nvir], nov);
+    }
+    }
+    timer_off("DF-ADC: AOO/AVV");
+
+    // XOO_{ij} <-- - \sum_{Qa} N^Q_{ia} b^Q_{ja}
+    SharedMatrix Xoo(new Matrix("XOO", nocc, nocc));
+    double **Xoop = Xoo->pointer();
+    for(int Q = 0;Q < nQ_;Q++)
+        C_DGEMM('N', 'T', nocc, nocc, nvir, -1.0, Np[Q], nvir, Biap[Q], nvir, 1.0, Xoop[0], nocc);
+    // XVV_{ab} <-- - \sum_{Qi} N^Q_{ia} b^Q_{ib}
+    SharedMatrix Xvv(new Matrix("XVV", nvir, nvir));
+    double **Xvvp = Xvv->pointer();
+    C_DGEMM('T', 'N', nvir, nvir, nQ_ * nocc, -1.0, Np[0], nvir, Biap[0], nvir, 0.0, Xvvp[0], nvir);
+    N.reset();
+
+    // AOO_{ij} <-- ((XOO)_{ij} + (XOO)_{ji}) / 2, AVV_{ab} <-- ((XVV)_{ab} + (XVV)_{ba}) / 2
+    Aoo_ = SharedMatrix(new Matrix("AOO", nocc, nocc));
+    Avv_ = SharedMatrix(new Matrix("AVV", nvir, nvir));
+    double **Aoop = Aoo_->pointer();
+    double **Avvp = Avv_->pointer();
+    for(int i = 0;i < nocc;i++)
+        for(int j = 0;j < nocc;j++)
+            Aoop[i][j] = (occsym_[i] == occsym_[j]) ? 0.5 * (Xoop[i][j] + Xoop[j][i]) : 0.0;
+    for(int a = 0;a < nvir;a++)
+        for(int b = 0;b < nvir;b++)
+            Avvp[a][b] = (virsym_[a] == virsym_[b]) ? 0.5 * (Xvvp[a][b] + Xvvp[b][a]) : 0.0;
+
+    // D_{ia} <-- D_{ia} + AOO_{ii} + AVV_{aa}
+    for(int i = 0;i < nocc;i++)
+        for(int a = 0;a < nvir;a++)
+            Dp[i][a] += Aoop[i][i] + Avvp[a][a];
+}
+
+}} // End Namespaces
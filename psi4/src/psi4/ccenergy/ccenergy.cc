@@ -124,7 +124,7 @@ double CCEnergyWavefunction::compute_energy()
         spaces.push_back(moinfo_.bvirtpi);
         spaces.push_back(moinfo_.bvir_sym);
         delete[] dpd_list[0];
-        dpd_list[0] = new DPD(0, moinfo_.nirreps, params_.memory, 0, cachefiles,
+        dpd_list[0] = new DPD(0, moinfo_.nirreps, params_.memory, params_.cachetype, cachefiles,
                               cachelist, NULL, 4, spaces);
         dpd_set_default(0);
 
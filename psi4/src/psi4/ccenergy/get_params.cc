@@ -110,11 +110,12 @@ void CCEnergyWavefunction::get_params(Options &options)
   cachetype = options.get_str("CACHETYPE");
   if(cachetype == "LOW") params_.cachetype = 1;
   else if(cachetype == "LRU") params_.cachetype = 0;
+  else if(cachetype == "COST") params_.cachetype = 2;
   else
     throw PsiException("Error in input: invalid CACHETYPE", __FILE__, __LINE__);
 
 
- if(params_.ref == 2) /* No LOW cacheing yet for UHF references */
+ if(params_.ref == 2 && params_.cachetype == 1) /* No LOW cacheing yet for UHF references */
     params_.cachetype = 0;
 
   params_.nthreads = Process::environment.get_n_threads();
@@ -203,7 +204,7 @@ void CCEnergyWavefunction::get_params(Options &options)
   outfile->Printf( "    ABCD            =     %s\n", params_.abcd.c_str());
   outfile->Printf( "    Cache Level     =     %1d\n", params_.cachelev);
   outfile->Printf( "    Cache Type      =    %4s\n",
-      params_.cachetype ? "LOW" : "LRU");
+      params_.cachetype == 2 ? "COST" : (params_.cachetype ? "LOW" : "LRU"));
   outfile->Printf( "    Print Level     =     %1d\n",  params_.print);
   outfile->Printf( "    Num. of threads =     %d\n",  params_.nthreads);
   outfile->Printf( "    # Amps to Print =     %1d\n",  params_.num_amps);
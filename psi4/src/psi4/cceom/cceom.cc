@@ -101,7 +101,7 @@ PsiReturnType cceom(std::shared_ptr<Wavefunction> ref_wfn, Options &options)
     spaces.push_back(moinfo.bocc_sym);
     spaces.push_back(moinfo.bvirtpi);
     spaces.push_back(moinfo.bvir_sym);
-    dpd_init(0, moinfo.nirreps, params.memory, 0, cachefiles, cachelist, NULL, 4, spaces);
+    dpd_init(0, moinfo.nirreps, params.memory, params.cachetype == 2 ? 2 : 0, cachefiles, cachelist, NULL, 4, spaces);
   }
   else { /* RHF or ROHF */
     cachelist = cacheprep_rhf(params.cachelev, cachefiles);
@@ -112,7 +112,7 @@ PsiReturnType cceom(std::shared_ptr<Wavefunction> ref_wfn, Options &options)
     spaces.push_back(moinfo.occ_sym);
     spaces.push_back(moinfo.virtpi);
     spaces.push_back(moinfo.vir_sym);
-    dpd_init(0, moinfo.nirreps, params.memory, 0, cachefiles, cachelist, NULL, 2, spaces);
+    dpd_init(0, moinfo.nirreps, params.memory, params.cachetype == 2 ? 2 : 0, cachefiles, cachelist, NULL, 2, spaces);
   }
 
   if(params.local) local_init();
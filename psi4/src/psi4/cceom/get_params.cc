@@ -93,7 +93,8 @@ void get_params(Options &options)
   std::string cachetype = options.get_str("CACHETYPE");
   if(cachetype == "LOW") params.cachetype = 1;
   else if(cachetype == "LRU") params.cachetype = 0;
-  if(params.ref == 2) /* No LRU cacheing yet for UHF references */
+  else if(cachetype == "COST") params.cachetype = 2;
+  if(params.ref == 2 && params.cachetype == 1) /* No LOW cacheing yet for UHF references */
     params.cachetype = 0;
 
   params.nthreads = Process::environment.get_n_threads();
@@ -130,7 +131,8 @@ void get_params(Options &options)
   outfile->Printf( "\tMemory (Mbytes) =  %5.1f\n",params.memory/1e6);
   outfile->Printf( "\tABCD            =     %s\n", params.abcd.c_str());
   outfile->Printf( "\tCache Level     =    %1d\n", params.cachelev);
-  outfile->Printf( "\tCache Type      =    %4s\n", params.cachetype ? "LOW" : "LRU");
+  outfile->Printf( "\tCache Type      =    %4s\n",
+      params.cachetype == 2 ? "COST" : (params.cachetype ? "LOW" : "LRU"));
   if (params.wfn == "EOM_CC3") outfile->Printf( "\tT3 Ws incore  =    %4s\n", params.t3_Ws_incore ? "Yes" : "No");
   outfile->Printf( "\tNum. of threads =     %d\n",params.nthreads);
   outfile->Printf( "\tLocal CC        =     %s\n", params.local ? "Yes" : "No");
@@ -35,7 +35,9 @@
 #include "psi4/libdpd/dpd.h"
 #include "psi4/libpsi4util/exception.h"
 #include "psi4/libqt/qt.h"
+#include "psi4/libparallel/task_queue.h"
 #include <pthread.h>
+#include <vector>
 
 #include "MOInfo.h"
 #include "Params.h"
@@ -55,7 +57,7 @@ pthread_mutex_t mut = PTHREAD_MUTEX_INITIALIZER;
 struct thread_data {
  dpdfile2 *fIJ; dpdfile2 *fAB; dpdfile2 *fIA; dpdfile2 *T1;
  dpdbuf4 *T2; dpdbuf4 *Eints; dpdbuf4 *Dints; dpdbuf4 *Fints_local;
- double *ET_local; int Gi; int Gj; int Gk; int first_ijk; int last_ijk;
+ double *ET_local; int thread; int **ijk; TaskQueue *tasks;
 };
 
 void *ET_RHF_thread(void *thread_data);
@@ -63,7 +65,8 @@ void *ET_RHF_thread(void *thread_data);
 double ET_RHF(void)
 {
   int i,j,k,I,J,K,Gi,Gj,Gk, h, nirreps, cnt;
-  int nijk, nthreads, thread, *ijk_part, errcod;
+  int nijk, nthreads, thread, errcod;
+  int Gd, Gjk, Gik, Gij, Gijk, **ijk;
   int *occpi, *virtpi, *occ_off, *vir_off;
   double ET, *ET_array;
   dpdfile2 fIJ, fAB, fIA, T1;
@@ -152,7 +155,6 @@ double ET_RHF(void)
   for (thread=0; thread<nthreads;++thread)
     global_dpd_->buf4_init(&(Fints_array[thread]), PSIF_CC_FINTS, 0, 10, 5, 10, 5, 0, "F <ia|bc>");
   ET_array = (double *) malloc(nthreads*sizeof(double));
-  ijk_part = new int [nthreads];
 
   for (thread=0;thread<nthreads;++thread) {
     thread_data_array[thread].fIJ = &fIJ;
@@ -183,73 +185,70 @@ double ET_RHF(void)
         }
   printer->Printf( "Total number of IJK combinations =: %d\n", nijk);
 
-  ET = 0.0;
-  for(Gi=0; Gi < nirreps; Gi++) {
-    for(Gj=0; Gj < nirreps; Gj++) {
-      for(Gk=0; Gk < nirreps; Gk++) {
+  /* Every IJK of every irrep triple is one task, its cost estimated by the
+     F*T2 contractions that build W: sum over Gd of (ab pairs) x c x d */
+  ijk = init_int_matrix(nijk, 6);
+  std::vector<double> cost(nijk);
+  std::vector<double> pairpi(nirreps, 0.0);
+  for(h=0; h < nirreps; h++)
+    for(Gd=0; Gd < nirreps; Gd++)
+      pairpi[h] += (double) virtpi[Gd] * virtpi[Gd ^ h];
 
-        nijk = 0; // total number of ijk for these irreps
+  cnt = 0;
+  for(Gi=0; Gi < nirreps; Gi++)
+    for(Gj=0; Gj < nirreps; Gj++)
+      for(Gk=0; Gk < nirreps; Gk++) {
+        Gjk = Gj ^ Gk; Gik = Gi ^ Gk; Gij = Gi ^ Gj;
+        double ijk_cost = 0.0;
+        for(Gd=0; Gd < nirreps; Gd++)
+          ijk_cost += virtpi[Gd] * (pairpi[Gi ^ Gd] * virtpi[Gjk ^ Gd] +
+                                    pairpi[Gj ^ Gd] * virtpi[Gik ^ Gd] +
+                                    pairpi[Gk ^ Gd] * virtpi[Gij ^ Gd]);
         for(i=0; i < occpi[Gi]; i++) {
           I = occ_off[Gi] + i;
           for(j=0; j < occpi[Gj]; j++) {
             J = occ_off[Gj] + j;
             for(k=0; k < occpi[Gk]; k++) {
               K = occ_off[Gk] + k;
-              if(I >= J && J >= K) nijk++;
+              if(I >= J && J >= K) {
+                ijk[cnt][0] = Gi; ijk[cnt][1] = Gj; ijk[cnt][2] = Gk;
+                ijk[cnt][3] = i;  ijk[cnt][4] = j;  ijk[cnt][5] = k;
+                cost[cnt] = ijk_cost;
+                cnt++;
+              }
             }
           }
         }
-        printer->Printf( "Num. of IJK with (Gi,Gj,Gk)=(%d,%d,%d) =: %d\n",
-          Gi, Gj, Gk, nijk);
-        if (nijk == 0) continue;
-
-        for (thread=0; thread<nthreads;++thread) {
-          thread_data_array[thread].Gi = Gi;
-          thread_data_array[thread].Gj = Gj;
-          thread_data_array[thread].Gk = Gk;
-          ET_array[thread] = 0.0;
-          ijk_part[thread] = nijk / nthreads; // number of ijk for each thread
-          if (thread < (nijk % nthreads)) ++ijk_part[thread];
-        }
-
-        cnt = 0;
-        for (thread=0; thread<nthreads; ++thread) {
-          if (!ijk_part[thread]) continue;  // there are more threads than nijk
-          thread_data_array[thread].first_ijk = cnt;
-          cnt += ijk_part[thread];
-          thread_data_array[thread].last_ijk = cnt-1;
-        }
-
-        /* execute threads */
-        for (thread=0; thread<nthreads;++thread) {
-          if (!ijk_part[thread]) continue;
-          printer->Printf("    thread %d: first_ijk=%d,  last_ijk=%d\n", thread,
-            thread_data_array[thread].first_ijk, thread_data_array[thread].last_ijk);
-        }
-
-        for (thread=0;thread<nthreads;++thread) {
-          if (!ijk_part[thread]) continue;
-          errcod = pthread_create(&(p_thread[thread]), NULL, ET_RHF_thread,
-                   (void *) &thread_data_array[thread]);
-          if (errcod) {
-            throw PsiException("pthread_create in ET_RHF()",__FILE__,__LINE__);
-          }
-        }
+      }
+
+  /* One team of threads works through all tasks, largest first, stealing
+     from each other once their own share runs out */
+  TaskQueue tasks(cost, nthreads);
+  for (thread=0; thread<nthreads;++thread) {
+    thread_data_array[thread].thread = thread;
+    thread_data_array[thread].ijk = ijk;
+    thread_data_array[thread].tasks = &tasks;
+    ET_array[thread] = 0.0;
+  }
 
-        for (thread=0; thread<nthreads;++thread) {
-          if (!ijk_part[thread]) continue;
-          errcod = pthread_join(p_thread[thread], NULL);
-          if (errcod) {
-            throw PsiException("pthread_join in ET_RHF() failed",__FILE__,__LINE__);
-          }
-        }
+  for (thread=0;thread<nthreads;++thread) {
+    errcod = pthread_create(&(p_thread[thread]), NULL, ET_RHF_thread,
+             (void *) &thread_data_array[thread]);
+    if (errcod) {
+      throw PsiException("pthread_create in ET_RHF()",__FILE__,__LINE__);
+    }
+  }
 
-        for (thread=0;thread<nthreads;++thread)
-          ET += ET_array[thread];
+  for (thread=0; thread<nthreads;++thread) {
+    errcod = pthread_join(p_thread[thread], NULL);
+    if (errcod) {
+      throw PsiException("pthread_join in ET_RHF() failed",__FILE__,__LINE__);
+    }
+  }
 
-      } /* Gk */
-    } /* Gj */
-  } /* Gi */
+  ET = 0.0;
+  for (thread=0;thread<nthreads;++thread)
+    ET += ET_array[thread];
 
 
   for(h=0; h < nirreps; h++) {
@@ -276,7 +275,7 @@ double ET_RHF(void)
 
   free(Fints_array);
   free(ET_array);
-  delete [] ijk_part;
+  free_int_matrix(ijk);
 
   free(thread_data_array);
   free(p_thread);
@@ -293,7 +292,8 @@ double ET_RHF(void)
 
 void* ET_RHF_thread(void* thread_data_in)
 {
-  int h, nirreps, cnt_ijk;
+  int h, nirreps;
+  size_t task;
   int Gp, p, nump;
   int nrows, ncols, nlinks;
   int Gijk, Gid, Gkd, Gjd, Gil, Gkl, Gjl;
@@ -313,7 +313,6 @@ void* ET_RHF_thread(void* thread_data_in)
   double ***W0, ***W1, ***V, ***X, ***Y, ***Z;
   dpdbuf4 *T2, *Eints, *Dints, *Fints;
   dpdfile2 *fIJ, *fAB, *fIA, *T1;
-  int nijk, nthreads, first_ijk, last_ijk, thr_id;
   struct thread_data *data;
 
   nirreps = moinfo.nirreps;
@@ -331,11 +330,6 @@ void* ET_RHF_thread(void* thread_data_in)
   Dints = data->Dints;
   Fints = data->Fints_local;
   ET_local  = data->ET_local; // pointer to where thread E goes
-  Gi        =  data->Gi;
-  Gj        =  data->Gj;
-  Gk        =  data->Gk;
-  first_ijk = data->first_ijk;
-  last_ijk  = data->last_ijk;
 
   W0 = (double ***) malloc(nirreps * sizeof(double **));
   W1 = (double ***) malloc(nirreps * sizeof(double **));
@@ -344,24 +338,21 @@ void* ET_RHF_thread(void* thread_data_in)
   Y = (double ***) malloc(nirreps * sizeof(double **));
   Z = (double ***) malloc(nirreps * sizeof(double **));
 
-  Gkj = Gjk = Gk ^ Gj;
-  Gji = Gij = Gi ^ Gj;
-  Gik = Gki = Gi ^ Gk;
-  Gijk = Gi ^ Gj ^ Gk;
-
-  cnt_ijk = -1;
-  for(i=0; i < occpi[Gi]; i++) {
-    I = occ_off[Gi] + i;
-    for(j=0; j < occpi[Gj]; j++) {
-      J = occ_off[Gj] + j;
-      for(k=0; k < occpi[Gk]; k++) {
-        K = occ_off[Gk] + k;
-        if(I >= J && J >= K) {
-
-          ++cnt_ijk;
-          /* check to see if this ijk is for this thread */
-          if ( (cnt_ijk < first_ijk) || (cnt_ijk > last_ijk))
-             continue;
+  while (data->tasks->next(data->thread, task)) {
+          Gi = data->ijk[task][0];
+          Gj = data->ijk[task][1];
+          Gk = data->ijk[task][2];
+          i  = data->ijk[task][3];
+          j  = data->ijk[task][4];
+          k  = data->ijk[task][5];
+          I = occ_off[Gi] + i;
+          J = occ_off[Gj] + j;
+          K = occ_off[Gk] + k;
+
+          Gkj = Gjk = Gk ^ Gj;
+          Gji = Gij = Gi ^ Gj;
+          Gik = Gki = Gi ^ Gk;
+          Gijk = Gi ^ Gj ^ Gk;
 
           ij = T2->params->rowidx[I][J];
           ji = T2->params->rowidx[J][I];
@@ -950,10 +941,7 @@ void* ET_RHF_thread(void* thread_data_in)
                 }
                 // timer_off("malloc");
 
-              }
-            } /* k */
-          } /* j */
-        } /* i */
+  } /* ijk */
 
   pthread_exit(NULL);
 }
@@ -4352,7 +4352,8 @@ double CIvect::ssq(struct stringwr *alplist, struct stringwr *betlist,
    int ij, ji, i1, j1, i2, j2;
    double tval, Ms, S2, smin_spls = 0.0;
 
-   int Iacnt, Jbcnt, *Iaij, *Ibij;
+   int Iacnt, Jbcnt;
+   unsigned short *Iaij, *Ibij;
    unsigned int *Iaridx, *Ibridx;
    signed char *Iasgn, *Ibsgn;
 
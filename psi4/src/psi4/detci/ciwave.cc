@@ -70,13 +70,13 @@ void CIWavefunction::common_init() {
     sme_first_call_ = 1;
     MCSCF_Parameters_ = new mcscf_params();
     CIblks_ = new ci_blks();
-    SigmaData_ = new sigma_data();
     CalcInfo_ = new calcinfo();
     Parameters_ = new params();
     H0block_ = new H_zero_block();
 
     // CI Params
     get_parameters(options_); /* get running params (convergence, etc)    */
+    SigmaData_ = new sigma_data[Parameters_->nthreads]();
     get_mo_info();            /* read DOCC, SOCC, frozen, nmo, etc        */
     set_ras_parameters();     /* set fermi levels and the like            */
 
@@ -444,7 +444,7 @@ void CIWavefunction::cleanup(void) {
 
     // Free objects built in common_init
     if (CalcInfo_->sigma_initialized) sigma_free();
-    delete SigmaData_;
+    delete[] SigmaData_;
 
     free_int_matrix(CIblks_->decode);
     free(CIblks_->first_iablk);
@@ -367,6 +367,7 @@ private:
           int *vu, int maxnvect);
 
     /// => Sigma Calculations <= //
+    /// Sigma scratch, one per thread (Parameters_->nthreads)
     struct sigma_data *SigmaData_;
     void sigma_init(CIvect& C, CIvect &S);
     void sigma_free(void);
@@ -383,7 +384,7 @@ private:
           double **cmat, double **smat, double *oei, double *tei, int fci,
           int cblock, int sblock, int nas, int nbs, int sac, int sbc,
           int cac, int cbc, int cnas, int cnbs, int cnac, int cnbc,
-          int sbirr, int cbirr, int Ms0);
+          int sbirr, int cbirr, int Ms0, int thread);
     void sigma_get_contrib(struct stringwr **alplist, struct stringwr **betlist,
           CIvect &C, CIvect &S, int **s1_contrib, int **s2_contrib,
           int **s3_contrib);
@@ -85,7 +85,7 @@ void s1_block_vfci(struct stringwr **alplist, struct stringwr **betlist,
   unsigned int Ia_idx, Ib_idx, Kb_idx, Jb_idx;
   unsigned int Ibcnt, Kbcnt, Kb_list, Ib_ex, Kb_ex;
   unsigned int *Ibridx, *Kbridx;
-  int *Ibij, *Kbij;
+  unsigned short *Ibij, *Kbij;
   signed char *Ibsgn, *Kbsgn;
   int ij, kl, ijkl;
   double Kb_sgn, Jb_sgn;
@@ -181,7 +181,7 @@ void s1_block_vras(struct stringwr **alplist, struct stringwr **betlist,
   unsigned int Ia_idx, Ib_idx, Kb_idx, Jb_idx;
   unsigned int Ibcnt, Kbcnt, Kb_list, Ib_ex, Kb_ex;
   unsigned int *Ibridx, *Kbridx;
-  int *Ibij, *Kbij, *Iboij, *Kboij;
+  unsigned short *Ibij, *Kbij, *Iboij, *Kboij;
   signed char *Ibsgn, *Kbsgn;
   int ij, kl, ijkl, oij, okl;
   double Kb_sgn, Jb_sgn;
@@ -67,7 +67,7 @@ void s2_block_vfci(struct stringwr **alplist, struct stringwr **betlist,
   unsigned int Ia_idx, Ib_idx, Ka_idx, Ja_idx;
   unsigned int Iacnt, Kacnt, Ka_list, Ia_ex, Ka_ex;
   unsigned int *Iaridx, *Karidx;
-  int *Iaij, *Kaij;
+  unsigned short *Iaij, *Kaij;
   signed char *Iasgn, *Kasgn;
   int ij, kl, ijkl;
   double Ka_sgn, Ja_sgn;
@@ -163,7 +163,7 @@ void s2_block_vras(struct stringwr **alplist, struct stringwr **betlist,
   unsigned int Ia_idx, Ib_idx, Ka_idx, Ja_idx;
   unsigned int Iacnt, Kacnt, Ka_list, Ia_ex, Ka_ex;
   unsigned int *Iaridx, *Karidx;
-  int *Iaij, *Kaij, *Iaoij, *Kaoij;
+  unsigned short *Iaij, *Kaij, *Iaoij, *Kaoij;
   signed char *Iasgn, *Kasgn;
   int ij, kl, ijkl, oij, okl;
   double Ka_sgn, Ja_sgn;
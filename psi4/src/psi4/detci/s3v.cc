@@ -64,7 +64,8 @@ void s3_block_vdiag(struct stringwr *alplist, struct stringwr *betlist,
   unsigned int Ia_ex;
   int ij, i, j, t, kl, I, J, RJ;
   double tval, VS, *CprimeI0, *CI0;
-  int jlen, Jacnt, *Iaij, Ia_idx;
+  int jlen, Jacnt, Ia_idx;
+  unsigned short *Iaij;
   unsigned int *Iaridx;
   signed char *Iasgn;
   double *Tptr;
@@ -144,7 +145,8 @@ void s3_block_v(struct stringwr *alplist, struct stringwr *betlist, double **C,
   unsigned int Ia_ex;
   int ij, i, j, kl, ijkl, I, J, RJ;
   double tval, VS, *CprimeI0, *CI0;
-  int jlen, Ia_idx, Jacnt, *Iaij;
+  int jlen, Ia_idx, Jacnt;
+  unsigned short *Iaij;
   unsigned int *Iaridx;
   signed char *Iasgn;
   double *Tptr;
@@ -170,7 +172,6 @@ void s3_block_v(struct stringwr *alplist, struct stringwr *betlist, double **C,
         }
       }
 
-      timer_on("CIWave: s3_mt");
       for (Ia = alplist, Ia_idx = 0; Ia_idx < nas; Ia_idx++, Ia++) {
         /* loop over excitations E^a_{kl} from |A(I_a)> */
         Jacnt = Ia->cnt[Ja_list];
@@ -204,7 +205,6 @@ void s3_block_v(struct stringwr *alplist, struct stringwr *betlist, double **C,
         }
 
       } /* end loop over Ia */
-      timer_off("CIWave: s3_mt");
 
     } /* end loop over j */
   }   /* end loop over i */
@@ -213,7 +213,7 @@ void s3_block_v(struct stringwr *alplist, struct stringwr *betlist, double **C,
 int form_ilist(struct stringwr *alplist, int Ja_list, int nas, int kl, int *L,
                int *R, double *Sgn) {
   int inum = 0, Ia_idx, Ia_ex, Iacnt, ij;
-  int *Iaij;
+  unsigned short *Iaij;
   struct stringwr *Ia;
   unsigned int *Iaridx;
   signed char *Iasgn;
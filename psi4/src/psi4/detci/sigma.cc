@@ -45,9 +45,16 @@
 #include <cstdlib>
 #include <cmath>
 #include <cstring>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include "psi4/libciomr/libciomr.h"
 #include "psi4/libqt/qt.h"
 #include "psi4/libmints/vector.h"
+#include "psi4/libparallel/process.h"
 #include "structs.h"
 #include "civect.h"
 #include "ciwave.h"
@@ -124,19 +131,83 @@ extern void s3_block_vdiag_rotf(int *Cnt[2], int **Ij[2], int **Ridx[2],
    int norbs, int *orbsym);
 
 
+/*
+** sigma_scratch_init() / sigma_scratch_free()
+**
+** Allocate and free the work arrays one thread needs in sigma_block():
+** F, V, Sgn, L, R and, for on-the-fly replacement lists, the J arrays
+** and Toccs.
+*/
+static void sigma_scratch_init(struct sigma_data *SD, int max_dim, int repl_otf,
+   struct olsen_graph *AlphaG)
+{
+   int i, j, nsingles;
+
+   SD->max_dim = max_dim;
+   SD->F = init_array(max_dim);
+   SD->Sgn = init_array(max_dim);
+   SD->V = init_array(max_dim);
+   SD->L = init_int_array(max_dim);
+   SD->R = init_int_array(max_dim);
+
+   if (repl_otf) {
+      max_dim += AlphaG->num_el_expl;
+      nsingles = AlphaG->num_el_expl * AlphaG->num_orb;
+      for (i=0; i<2; i++) {
+         SD->Jcnt[i] = init_int_array(max_dim);
+         SD->Jij[i] = init_int_matrix(max_dim, nsingles);
+         SD->Joij[i] = init_int_matrix(max_dim, nsingles);
+         SD->Jridx[i] = init_int_matrix(max_dim, nsingles);
+         SD->Jsgn[i] = (signed char **) malloc (max_dim * sizeof(signed char *));
+         for (j=0; j<max_dim; j++) {
+            SD->Jsgn[i][j] = (signed char *) malloc (nsingles *
+               sizeof(signed char));
+            }
+         }
+
+      SD->Toccs = (unsigned char **) malloc (sizeof(unsigned char *) * nsingles);
+      }
+}
+
+static void sigma_scratch_free(struct sigma_data *SD, int repl_otf,
+   struct olsen_graph *AlphaG)
+{
+   free(SD->F);
+   free(SD->Sgn);
+   free(SD->V);
+   free(SD->L);
+   free(SD->R);
+   if (repl_otf) {
+      for (int i=0; i<2; i++) {
+         free(SD->Jcnt[i]);
+         free_int_matrix(SD->Jij[i]);
+         free_int_matrix(SD->Joij[i]);
+         free_int_matrix(SD->Jridx[i]);
+         for (int j=0; j<SD->max_dim+AlphaG->num_el_expl; j++) {
+            free(SD->Jsgn[i][j]);
+         }
+         free(SD->Jsgn[i]);
+      }
+      free(SD->Toccs);
+   }
+}
 
 /*
 ** sigma_init()
 **
 ** This function initializes all the globals associated with calculating
-** the sigma vector.
+** the sigma vector.  SigmaData_[0] serves all three icore paths; threads
+** 1..nthreads-1 get their own scratch for the threaded block loops of
+** sigma_b() and sigma_c().  That scratch holds up to three C-block sized
+** buffers per thread, so the thread count is capped to keep it within half
+** of the memory left over by the in-core C and S buffers.
 **
 */
 void CIWavefunction::sigma_init(CIvect& C, CIvect &S)
 {
-   int i,j;
+   int i;
    int maxcols=0, maxrows=0;
-   int nsingles, max_dim=0;
+   int max_dim=0;
    unsigned long int bufsz=0;
 
    SigmaData_->transp_tmp = NULL;
@@ -148,41 +219,37 @@ void CIWavefunction::sigma_init(CIvect& C, CIvect &S)
       return;
       }
 
+   if (Parameters_->nthreads > 1) {
+      unsigned long int maxbuf = 0;
+      for (i=0; i<C.buf_per_vect_; i++)
+         if (C.buf_size_[i] > maxbuf) maxbuf = C.buf_size_[i];
+      int nscratch = 1 + (Parameters_->bendazzoli ? 1 : 0) +
+         (((C.icore_==2 && C.Ms0_ && CalcInfo_->ref_sym != 0) || (C.icore_==0 && C.Ms0_)) ? 1 : 0);
+      double thread_bytes = 8.0 * nscratch * C.get_max_blk_size();
+      double free_bytes = 0.5 * ((double) Process::environment.get_memory() - 16.0 * maxbuf);
+      int max_threads = 1;
+      if (thread_bytes > 0.0 && free_bytes > 0.0)
+         max_threads = 1 + (int) std::min(free_bytes / thread_bytes, (double) Parameters_->nthreads);
+      if (max_threads < Parameters_->nthreads) {
+         outfile->Printf("\n   Sigma scratch of %.1f MiB per thread limits CI_NUM_THREADS from %d to %d.\n",
+                         thread_bytes / 1048576.0, Parameters_->nthreads, max_threads);
+         Parameters_->nthreads = max_threads;
+      }
+   }
+
    for (i=0; i<C.num_blocks_; i++) {
       if (C.Ib_size_[i] > max_dim) max_dim = C.Ib_size_[i];
       if (C.Ia_size_[i] > max_dim) max_dim = C.Ia_size_[i];
       }
-   SigmaData_->max_dim = max_dim;
-   SigmaData_->F = init_array(max_dim);
-
-   SigmaData_->Sgn = init_array(max_dim);
-   SigmaData_->V = init_array(max_dim);
-   SigmaData_->L = init_int_array(max_dim);
-   SigmaData_->R = init_int_array(max_dim);
-
-   if (Parameters_->repl_otf) {
-      max_dim += AlphaG_->num_el_expl;
-      nsingles = AlphaG_->num_el_expl * AlphaG_->num_orb;
-      for (i=0; i<2; i++) {
-         SigmaData_->Jcnt[i] = init_int_array(max_dim);
-         SigmaData_->Jij[i] = init_int_matrix(max_dim, nsingles);
-         SigmaData_->Joij[i] = init_int_matrix(max_dim, nsingles);
-         SigmaData_->Jridx[i] = init_int_matrix(max_dim, nsingles);
-         SigmaData_->Jsgn[i] = (signed char **) malloc (max_dim * sizeof(signed char *));
-         for (j=0; j<max_dim; j++) {
-            SigmaData_->Jsgn[i][j] = (signed char *) malloc (nsingles *
-               sizeof(signed char));
-            }
-         }
-
-      SigmaData_->Toccs = (unsigned char **) malloc (sizeof(unsigned char *) * nsingles);
+   for (i=0; i<Parameters_->nthreads; i++)
+      sigma_scratch_init(&SigmaData_[i], max_dim, Parameters_->repl_otf, AlphaG_);
 
-      /* test out the on-the-fly replacement routines */
-      /*
+   /* test out the on-the-fly replacement routines */
+   /*
+   if (Parameters_->repl_otf)
       b2brepl_test(Occs_,SigmaData_->Jcnt[0],SigmaData_->Jij[0],
                    SigmaData_->Joij[0],SigmaData_->Jridx[0],SigmaData_->Jsgn[0],AlphaG);
-      */
-      }
+   */
 
    /* figure out which C blocks contribute to s */
    s1_contrib_ = init_int_matrix(S.num_blocks_, C.num_blocks_);
@@ -249,31 +316,44 @@ void CIWavefunction::sigma_init(CIvect& C, CIvect &S)
      }
    }
 
+   /* the other threads never alias cprime onto transp_tmp */
+   for (i=1; i<Parameters_->nthreads; i++) {
+     struct sigma_data *SD = &SigmaData_[i];
+     SD->transp_tmp = NULL;
+     SD->sprime = NULL;
+     if (SigmaData_->transp_tmp != NULL) {
+       SD->transp_tmp = (double **) malloc (maxrows * sizeof(double *));
+       SD->transp_tmp[0] = init_array(bufsz);
+     }
+     SD->cprime = (double **) malloc (maxrows * sizeof(double *));
+     SD->cprime[0] = init_array(bufsz);
+     if (Parameters_->bendazzoli) {
+       SD->sprime = (double **) malloc (maxrows * sizeof(double *));
+       SD->sprime[0] = init_array(bufsz);
+     }
+   }
+
    CalcInfo_->sigma_initialized = 1;
 }
 
 void CIWavefunction::sigma_free()
 {
-   free(SigmaData_->F);
-   free(SigmaData_->Sgn);
-   free(SigmaData_->V);
-   free(SigmaData_->L);
-   free(SigmaData_->R);
-   if (Parameters_->repl_otf) {
-      for (int i=0; i<2; i++) {
-         free(SigmaData_->Jcnt[i]);
-         free_int_matrix(SigmaData_->Jij[i]);
-         free_int_matrix(SigmaData_->Joij[i]);
-         free_int_matrix(SigmaData_->Jridx[i]);
-         for (int j=0; j<SigmaData_->max_dim; j++) {
-            free(SigmaData_->Jsgn[i][j]);
-         }
-         free(SigmaData_->Jsgn[i]);
+   for (int i=0; i<Parameters_->nthreads; i++)
+      sigma_scratch_free(&SigmaData_[i], Parameters_->repl_otf, AlphaG_);
+   for (int i=1; i<Parameters_->nthreads; i++) {
+      struct sigma_data *SD = &SigmaData_[i];
+      if (SD->transp_tmp != NULL) {
+         free(SD->transp_tmp[0]);
+         free(SD->transp_tmp);
+      }
+      free(SD->cprime[0]);
+      free(SD->cprime);
+      if (SD->sprime != NULL) {
+         free(SD->sprime[0]);
+         free(SD->sprime);
       }
    }
 // DGAS: Not sure how to free these yet
-//      SigmaData_->Toccs = (unsigned char **) malloc (sizeof(unsigned char *) * nsingles);
-//unsigned char **SigmaData_->Toccs;
 //double **SigmaData_->transp_tmp, **SigmaData_->cprime, **SigmaData_->sprime;
 }
 
@@ -396,7 +476,7 @@ void CIWavefunction::sigma_a(struct stringwr **alplist, struct stringwr **betlis
             sigma_block(alplist, betlist, C.blocks_[cblock], S.blocks_[sblock],
                oei, tei, fci, cblock, sblock, nas, nbs, sac, sbc, cac, cbc,
                cnas, cnbs, C.num_alpcodes_, C.num_betcodes_, sbirr, cbirr,
-               S.Ms0_);
+               S.Ms0_, 0);
             did_sblock = 1;
             }
 
@@ -414,7 +494,7 @@ void CIWavefunction::sigma_a(struct stringwr **alplist, struct stringwr **betlis
             sigma_block(alplist, betlist, C.blocks_[cblock2], S.blocks_[sblock],
                oei, tei, fci, cblock2, sblock, nas, nbs, sac, sbc,
                cbc, cac, cnbs, cnas, C.num_alpcodes_, C.num_betcodes_, sbirr,
-               cairr, S.Ms0_);
+               cairr, S.Ms0_, 0);
             did_sblock = 1;
             }
 
@@ -464,11 +544,8 @@ void CIWavefunction::sigma_b(struct stringwr **alplist, struct stringwr **betlis
       CIvect& C, CIvect& S, double *oei, double *tei, int fci, int ivec)
 {
 
-   int sblock, cblock;  /* id of sigma and C blocks */
+   int sblock;  /* id of sigma block */
    int sac, sbc, nas, nbs;
-   int cac, cbc, cnas, cnbs;
-   int sbirr, cbirr;
-   int did_sblock = 0;
    int phase;
 
    if (!Parameters_->Ms0) phase = 1;
@@ -477,44 +554,71 @@ void CIWavefunction::sigma_b(struct stringwr **alplist, struct stringwr **betlis
    S.zero();
    C.read(C.cur_vect_, 0);
 
-   /* loop over unique sigma subblocks */
+   /* unique sigma subblocks, largest first so the threads stay balanced */
+   std::vector<std::pair<unsigned long int, int> > order;
    for (sblock=0; sblock<S.num_blocks_; sblock++) {
       //if (Parameters_->cc && !cc_reqd_sblocks[sblock]) continue;
-      did_sblock = 0;
-      sac = S.Ia_code_[sblock];
-      sbc = S.Ib_code_[sblock];
       nas = S.Ia_size_[sblock];
       nbs = S.Ib_size_[sblock];
       if (nas==0 || nbs==0) continue;
-      if (S.Ms0_ && sbc > sac) continue;
-      sbirr = sbc / BetaG_->subgr_per_irrep;
-      if (SigmaData_->sprime != NULL) set_row_ptrs(nas, nbs, SigmaData_->sprime);
-
-      for (cblock=0; cblock<C.num_blocks_; cblock++) {
+      if (S.Ms0_ && S.Ib_code_[sblock] > S.Ia_code_[sblock]) continue;
+      order.push_back(std::make_pair((unsigned long int) nas * nbs, sblock));
+      }
+   std::stable_sort(order.begin(), order.end(),
+      [](const std::pair<unsigned long int, int>& a,
+         const std::pair<unsigned long int, int>& b) { return a.first > b.first; });
+   std::vector<int> did_sblock(S.num_blocks_, 0);
+
+   /* each sigma block is owned by one thread and gathers its C blocks in
+      the serial order, so the result does not depend on the thread count */
+   #pragma omp parallel for schedule(dynamic) num_threads(Parameters_->nthreads)
+   for (int n=0; n<(int) order.size(); n++) {
+      int thread = 0;
+      #ifdef _OPENMP
+         thread = omp_get_thread_num();
+      #endif
+      struct sigma_data *SD = &SigmaData_[thread];
+      int sblk = order[n].second;
+      int ssac = S.Ia_code_[sblk];
+      int ssbc = S.Ib_code_[sblk];
+      int snas = S.Ia_size_[sblk];
+      int snbs = S.Ib_size_[sblk];
+      int sbirr = ssbc / BetaG_->subgr_per_irrep;
+      if (SD->sprime != NULL) set_row_ptrs(snas, snbs, SD->sprime);
+
+      for (int cblock=0; cblock<C.num_blocks_; cblock++) {
          if (C.check_zero_block(cblock)) continue;
-         cac = C.Ia_code_[cblock];
-         cbc = C.Ib_code_[cblock];
-         cnas = C.Ia_size_[cblock];
-         cnbs = C.Ib_size_[cblock];
-         cbirr = cbc / BetaG_->subgr_per_irrep;
-         if (s1_contrib_[sblock][cblock] || s2_contrib_[sblock][cblock] ||
-             s3_contrib_[sblock][cblock]) {
-            if (SigmaData_->cprime != NULL) set_row_ptrs(cnas, cnbs, SigmaData_->cprime);
-            sigma_block(alplist, betlist, C.blocks_[cblock], S.blocks_[sblock],
-               oei, tei, fci, cblock, sblock, nas, nbs, sac, sbc,
+         int cac = C.Ia_code_[cblock];
+         int cbc = C.Ib_code_[cblock];
+         int cnas = C.Ia_size_[cblock];
+         int cnbs = C.Ib_size_[cblock];
+         int cbirr = cbc / BetaG_->subgr_per_irrep;
+         if (s1_contrib_[sblk][cblock] || s2_contrib_[sblk][cblock] ||
+             s3_contrib_[sblk][cblock]) {
+            if (SD->cprime != NULL) set_row_ptrs(cnas, cnbs, SD->cprime);
+            sigma_block(alplist, betlist, C.blocks_[cblock], S.blocks_[sblk],
+               oei, tei, fci, cblock, sblk, snas, snbs, ssac, ssbc,
                cac, cbc, cnas, cnbs, C.num_alpcodes_, C.num_betcodes_, sbirr,
-               cbirr, S.Ms0_);
-            did_sblock = 1;
+               cbirr, S.Ms0_, thread);
+            did_sblock[sblk] = 1;
             }
          } /* end loop over c blocks */
+      } /* end loop over sigma blocks */
 
-      if (did_sblock) S.set_zero_block(sblock, 0);
+   for (int n=0; n<(int) order.size(); n++) {
+      sblock = order[n].second;
+      sac = S.Ia_code_[sblock];
+      sbc = S.Ib_code_[sblock];
+      nas = S.Ia_size_[sblock];
+      nbs = S.Ib_size_[sblock];
+
+      if (did_sblock[sblock]) S.set_zero_block(sblock, 0);
 
       if (S.Ms0_ && (sac==sbc))
          transp_sigma(S.blocks_[sblock], nas, nbs, phase);
       H0block_gather(S.blocks_[sblock], sac, sbc, 1, Parameters_->Ms0,
          phase);
-      } /* end loop over sigma blocks */
+      }
 
       if (S.Ms0_) {
          if ((int) Parameters_->S % 2) S.symmetrize(-1.0, 0);
@@ -549,14 +653,11 @@ void CIWavefunction::sigma_c(struct stringwr **alplist, struct stringwr **betlis
 {
 
    int buf, cbuf;
-   int sblock, cblock, cblock2;  /* id of sigma and C blocks */
+   int sblock;                   /* id of sigma block */
    int sairr;                    /* irrep of alpha string for sigma block */
    int cairr;                    /* irrep of alpha string for C block */
    int sbirr, cbirr;
-   int i,j,k;
    int sac, sbc, nas, nbs;
-   int cac, cbc, cnas, cnbs;
-   int did_sblock = 0;
    int phase;
 
    if (!Parameters_->Ms0) phase = 1;
@@ -567,62 +668,83 @@ void CIWavefunction::sigma_c(struct stringwr **alplist, struct stringwr **betlis
       sairr = S.buf2blk_[buf];
       sbirr = sairr ^ CalcInfo_->ref_sym;
       S.zero();
+
+      /* sigma subblocks of this irrep, largest first for thread balance */
+      std::vector<std::pair<unsigned long int, int> > order;
+      for (sblock=S.first_ablk_[sairr];sblock<=S.last_ablk_[sairr];sblock++){
+         if (S.Ms0_ && (S.Ia_code_[sblock] < S.Ib_code_[sblock])) continue;
+         order.push_back(std::make_pair((unsigned long int) S.Ia_size_[sblock] *
+            S.Ib_size_[sblock], sblock));
+         }
+      std::stable_sort(order.begin(), order.end(),
+         [](const std::pair<unsigned long int, int>& a,
+            const std::pair<unsigned long int, int>& b) { return a.first > b.first; });
+      std::vector<int> did_sblock(S.num_blocks_, 0);
+
       for (cbuf=0; cbuf<C.buf_per_vect_; cbuf++) {
          C.read(C.cur_vect_, cbuf); /* go ahead and assume it will contrib */
          cairr = C.buf2blk_[cbuf];
          cbirr = cairr ^ CalcInfo_->ref_sym;
 
-         for (sblock=S.first_ablk_[sairr];sblock<=S.last_ablk_[sairr];sblock++){
-            sac = S.Ia_code_[sblock];
-            sbc = S.Ib_code_[sblock];
-            nas = S.Ia_size_[sblock];
-            nbs = S.Ib_size_[sblock];
-            did_sblock = 0;
-
-            if (S.Ms0_ && (sac < sbc)) continue;
-            if (SigmaData_->sprime != NULL) set_row_ptrs(nas, nbs, SigmaData_->sprime);
-
-            for (cblock=C.first_ablk_[cairr]; cblock <= C.last_ablk_[cairr];
+         /* one thread per sigma block, C blocks in serial order within it */
+         #pragma omp parallel for schedule(dynamic) num_threads(Parameters_->nthreads)
+         for (int n=0; n<(int) order.size(); n++) {
+            int thread = 0;
+            #ifdef _OPENMP
+               thread = omp_get_thread_num();
+            #endif
+            struct sigma_data *SD = &SigmaData_[thread];
+            int sblk = order[n].second;
+            int ssac = S.Ia_code_[sblk];
+            int ssbc = S.Ib_code_[sblk];
+            int snas = S.Ia_size_[sblk];
+            int snbs = S.Ib_size_[sblk];
+
+            if (SD->sprime != NULL) set_row_ptrs(snas, snbs, SD->sprime);
+
+            for (int cblock=C.first_ablk_[cairr]; cblock <= C.last_ablk_[cairr];
                   cblock++) {
 
-               cac = C.Ia_code_[cblock];
-               cbc = C.Ib_code_[cblock];
-               cnas = C.Ia_size_[cblock];
-               cnbs = C.Ib_size_[cblock];
+               int cac = C.Ia_code_[cblock];
+               int cbc = C.Ib_code_[cblock];
+               int cnas = C.Ia_size_[cblock];
+               int cnbs = C.Ib_size_[cblock];
 
-               if ((s1_contrib_[sblock][cblock] || s2_contrib_[sblock][cblock] ||
-                    s3_contrib_[sblock][cblock]) &&
+               if ((s1_contrib_[sblk][cblock] || s2_contrib_[sblk][cblock] ||
+                    s3_contrib_[sblk][cblock]) &&
                     !C.check_zero_block(cblock)) {
-      if (SigmaData_->cprime != NULL) set_row_ptrs(cnas, cnbs, SigmaData_->cprime);
+      if (SD->cprime != NULL) set_row_ptrs(cnas, cnbs, SD->cprime);
                   sigma_block(alplist, betlist, C.blocks_[cblock],
-                     S.blocks_[sblock], oei, tei, fci, cblock,
-                     sblock, nas, nbs, sac, sbc, cac, cbc, cnas, cnbs,
-                     C.num_alpcodes_, C.num_betcodes_, sbirr, cbirr, S.Ms0_);
-                  did_sblock = 1;
+                     S.blocks_[sblk], oei, tei, fci, cblock,
+                     sblk, snas, snbs, ssac, ssbc, cac, cbc, cnas, cnbs,
+                     C.num_alpcodes_, C.num_betcodes_, sbirr, cbirr, S.Ms0_,
+                     thread);
+                  did_sblock[sblk] = 1;
                   }
 
                if (C.buf_offdiag_[cbuf]) {
-                  cblock2 = C.decode_[cbc][cac];
-                  if ((s1_contrib_[sblock][cblock2] ||
-                       s2_contrib_[sblock][cblock2] ||
-                       s3_contrib_[sblock][cblock2]) &&
+                  int cblock2 = C.decode_[cbc][cac];
+                  if ((s1_contrib_[sblk][cblock2] ||
+                       s2_contrib_[sblk][cblock2] ||
+                       s3_contrib_[sblk][cblock2]) &&
                       !C.check_zero_block(cblock2)) {
-                     C.transp_block(cblock, SigmaData_->transp_tmp);
-         if (SigmaData_->cprime != NULL) set_row_ptrs(cnbs, cnas, SigmaData_->cprime);
-                     sigma_block(alplist, betlist, SigmaData_->transp_tmp,S.blocks_[sblock],
-                        oei, tei, fci, cblock2, sblock, nas, nbs, sac, sbc,
+                     C.transp_block(cblock, SD->transp_tmp);
+         if (SD->cprime != NULL) set_row_ptrs(cnbs, cnas, SD->cprime);
+                     sigma_block(alplist, betlist, SD->transp_tmp,S.blocks_[sblk],
+                        oei, tei, fci, cblock2, sblk, snas, snbs, ssac, ssbc,
                         cbc, cac, cnbs, cnas, C.num_alpcodes_, C.num_betcodes_,
-                        sbirr, cairr, S.Ms0_);
-                     did_sblock = 1;
+                        sbirr, cairr, S.Ms0_, thread);
+                     did_sblock[sblk] = 1;
                      }
                   }
                } /* end loop over C blocks in this irrep */
-
-            if (did_sblock) S.set_zero_block(sblock, 0);
             } /* end loop over sblock */
 
          } /* end loop over cbuf */
 
+      for (sblock=S.first_ablk_[sairr];sblock<=S.last_ablk_[sairr];sblock++)
+         if (did_sblock[sblock]) S.set_zero_block(sblock, 0);
+
       /* transpose the diagonal sigma subblocks in this irrep */
       for (sblock=S.first_ablk_[sairr];sblock<=S.last_ablk_[sairr];sblock++){
          sac = S.Ia_code_[sblock];
@@ -652,38 +774,45 @@ void CIWavefunction::sigma_c(struct stringwr **alplist, struct stringwr **betlis
 /*
 ** sigma_block()
 **
-** Calculate the contribution to sigma block sblock from C block cblock
+** Calculate the contribution to sigma block sblock from C block cblock,
+** using the scratch arrays of thread.  The timers are not thread-safe and
+** are only switched on outside of a parallel region.
 **
 */
 void CIWavefunction::sigma_block(struct stringwr **alplist, struct stringwr **betlist,
       double **cmat, double **smat, double *oei, double *tei, int fci,
       int cblock, int sblock, int nas, int nbs, int sac, int sbc,
       int cac, int cbc, int cnas, int cnbs, int cnac, int cnbc,
-      int sbirr, int cbirr, int Ms0)
+      int sbirr, int cbirr, int Ms0, int thread)
 {
+   struct sigma_data *SD = &SigmaData_[thread];
+   bool timed = true;
+   #ifdef _OPENMP
+      timed = !omp_in_parallel();
+   #endif
 
    /* SIGMA2 CONTRIBUTION */
   if (s2_contrib_[sblock][cblock]) {
 
-    timer_on("CIWave: s2");
+    if (timed) timer_on("CIWave: s2");
 
       if (fci) {
-          s2_block_vfci(alplist, betlist, cmat, smat, oei, tei, SigmaData_->F, cnac,
+          s2_block_vfci(alplist, betlist, cmat, smat, oei, tei, SD->F, cnac,
                             nas, nbs, sac, cac, cnas);
         }
       else {
           if (Parameters_->repl_otf) {
-              s2_block_vras_rotf(SigmaData_->Jcnt, SigmaData_->Jij, SigmaData_->Joij,
-                                 SigmaData_->Jridx, SigmaData_->Jsgn,
-                                 SigmaData_->Toccs, cmat, smat, oei, tei, SigmaData_->F, cnac,
+              s2_block_vras_rotf(SD->Jcnt, SD->Jij, SD->Joij,
+                                 SD->Jridx, SD->Jsgn,
+                                 SD->Toccs, cmat, smat, oei, tei, SD->F, cnac,
                                  nas, nbs, sac, cac, cnas, AlphaG_, BetaG_, CalcInfo_, Occs_);
             }
           else {
               s2_block_vras(alplist, betlist, cmat, smat,
-                            oei, tei, SigmaData_->F, cnac, nas, nbs, sac, cac, cnas);
+                            oei, tei, SD->F, cnac, nas, nbs, sac, cac, cnas);
             }
         }
-    timer_off("CIWave: s2");
+    if (timed) timer_off("CIWave: s2");
 
     } /* end sigma2 */
 
@@ -696,28 +825,28 @@ void CIWavefunction::sigma_block(struct stringwr **alplist, struct stringwr **be
 
    /* SIGMA1 CONTRIBUTION */
    if (!Ms0 || (sac != sbc)) {
-    timer_on("CIWave: s1");
+    if (timed) timer_on("CIWave: s1");
 
       if (s1_contrib_[sblock][cblock]) {
           if (fci) {
-             s1_block_vfci(alplist, betlist, cmat, smat, oei, tei, SigmaData_->F, cnbc,
+             s1_block_vfci(alplist, betlist, cmat, smat, oei, tei, SD->F, cnbc,
                                 nas, nbs, sbc, cbc, cnbs);
             }
          else {
             if (Parameters_->repl_otf) {
-               s1_block_vras_rotf(SigmaData_->Jcnt, SigmaData_->Jij, SigmaData_->Joij,
-                  SigmaData_->Jridx, SigmaData_->Jsgn,
-                  SigmaData_->Toccs, cmat, smat, oei, tei, SigmaData_->F, cnbc, nas, nbs,
+               s1_block_vras_rotf(SD->Jcnt, SD->Jij, SD->Joij,
+                  SD->Jridx, SD->Jsgn,
+                  SD->Toccs, cmat, smat, oei, tei, SD->F, cnbc, nas, nbs,
                   sbc, cbc, cnbs, BetaG_, CalcInfo_, Occs_);
                }
             else {
-               s1_block_vras(alplist, betlist, cmat, smat, oei, tei, SigmaData_->F, cnbc,
+               s1_block_vras(alplist, betlist, cmat, smat, oei, tei, SD->F, cnbc,
                   nas, nbs, sbc, cbc, cnbs);
                }
             }
          }
 
-      timer_off("CIWave: s1");
+      if (timed) timer_off("CIWave: s1");
    } /* end sigma1 */
 
    if (Parameters_->print_lvl > 3) {
@@ -728,59 +857,59 @@ void CIWavefunction::sigma_block(struct stringwr **alplist, struct stringwr **be
 
    /* SIGMA3 CONTRIBUTION */
    if (s3_contrib_[sblock][cblock]) {
-      timer_on("CIWave: s3");
+      if (timed) timer_on("CIWave: s3");
 
       /* zero_mat(smat, nas, nbs); */
 
       if (!Ms0 || (sac != sbc)) {
          if (Parameters_->repl_otf) {
-            b2brepl(Occs_[sac], SigmaData_->Jcnt[0], SigmaData_->Jij[0],
-               SigmaData_->Joij[0], SigmaData_->Jridx[0],
-               SigmaData_->Jsgn[0], AlphaG_, sac, cac, nas, CalcInfo_);
-            b2brepl(Occs_[sbc], SigmaData_->Jcnt[1], SigmaData_->Jij[1],
-                    SigmaData_->Joij[1], SigmaData_->Jridx[1],
-                    SigmaData_->Jsgn[1], BetaG_, sbc, cbc, nbs, CalcInfo_);
-            s3_block_vrotf(SigmaData_->Jcnt, SigmaData_->Jij, SigmaData_->Jridx,
-                           SigmaData_->Jsgn, cmat, smat, tei, nas, nbs,
-                           cnas, sbc, cac, cbc, sbirr, cbirr, SigmaData_->cprime,
-                           SigmaData_->F, SigmaData_->V, SigmaData_->Sgn, SigmaData_->L,
-                           SigmaData_->R, CalcInfo_->num_ci_orbs,
+            b2brepl(Occs_[sac], SD->Jcnt[0], SD->Jij[0],
+               SD->Joij[0], SD->Jridx[0],
+               SD->Jsgn[0], AlphaG_, sac, cac, nas, CalcInfo_);
+            b2brepl(Occs_[sbc], SD->Jcnt[1], SD->Jij[1],
+                    SD->Joij[1], SD->Jridx[1],
+                    SD->Jsgn[1], BetaG_, sbc, cbc, nbs, CalcInfo_);
+            s3_block_vrotf(SD->Jcnt, SD->Jij, SD->Jridx,
+                           SD->Jsgn, cmat, smat, tei, nas, nbs,
+                           cnas, sbc, cac, cbc, sbirr, cbirr, SD->cprime,
+                           SD->F, SD->V, SD->Sgn, SD->L,
+                           SD->R, CalcInfo_->num_ci_orbs,
                            CalcInfo_->orbsym + CalcInfo_->num_drc_orbs);
             }
          else {
             s3_block_v(alplist[sac], betlist[sbc], cmat, smat, tei,
                nas, nbs, cnas, sbc, cac, cbc, sbirr, cbirr,
-               SigmaData_->cprime, SigmaData_->F, SigmaData_->V,
-               SigmaData_->Sgn, SigmaData_->L, SigmaData_->R,
+               SD->cprime, SD->F, SD->V,
+               SD->Sgn, SD->L, SD->R,
                CalcInfo_->num_ci_orbs, CalcInfo_->orbsym + CalcInfo_->num_drc_orbs);
             }
          }
 
       else if (Parameters_->bendazzoli) {
          s3_block_bz(sac, sbc, cac, cbc, nas, nbs, cnas, tei, cmat, smat,
-            SigmaData_->cprime, SigmaData_->sprime, CalcInfo_, OV_);
+            SD->cprime, SD->sprime, CalcInfo_, OV_);
          }
 
       else {
          if (Parameters_->repl_otf) {
-            b2brepl(Occs_[sac], SigmaData_->Jcnt[0], SigmaData_->Jij[0],
-                    SigmaData_->Joij[0], SigmaData_->Jridx[0],
-                    SigmaData_->Jsgn[0], AlphaG_, sac, cac, nas, CalcInfo_);
-            b2brepl(Occs_[sbc], SigmaData_->Jcnt[1], SigmaData_->Jij[1],
-                    SigmaData_->Joij[1], SigmaData_->Jridx[1],
-                    SigmaData_->Jsgn[1], BetaG_, sbc, cbc, nbs, CalcInfo_);
-            s3_block_vdiag_rotf(SigmaData_->Jcnt, SigmaData_->Jij, SigmaData_->Jridx,
-                                SigmaData_->Jsgn, cmat, smat, tei, nas, nbs, cnas, sbc,
-                                cac, cbc, sbirr, cbirr, SigmaData_->cprime, SigmaData_->F,
-                                SigmaData_->V, SigmaData_->Sgn, SigmaData_->L,
-                                SigmaData_->R, CalcInfo_->num_ci_orbs,
+            b2brepl(Occs_[sac], SD->Jcnt[0], SD->Jij[0],
+                    SD->Joij[0], SD->Jridx[0],
+                    SD->Jsgn[0], AlphaG_, sac, cac, nas, CalcInfo_);
+            b2brepl(Occs_[sbc], SD->Jcnt[1], SD->Jij[1],
+                    SD->Joij[1], SD->Jridx[1],
+                    SD->Jsgn[1], BetaG_, sbc, cbc, nbs, CalcInfo_);
+            s3_block_vdiag_rotf(SD->Jcnt, SD->Jij, SD->Jridx,
+                                SD->Jsgn, cmat, smat, tei, nas, nbs, cnas, sbc,
+                                cac, cbc, sbirr, cbirr, SD->cprime, SD->F,
+                                SD->V, SD->Sgn, SD->L,
+                                SD->R, CalcInfo_->num_ci_orbs,
                                 CalcInfo_->orbsym + CalcInfo_->num_drc_orbs);
             }
          else {
             s3_block_vdiag(alplist[sac], betlist[sbc], cmat, smat, tei, nas, nbs,
-                           cnas, sbc, cac, cbc, sbirr, cbirr, SigmaData_->cprime,
-                           SigmaData_->F, SigmaData_->V, SigmaData_->Sgn,
-                           SigmaData_->L, SigmaData_->R, CalcInfo_->num_ci_orbs,
+                           cnas, sbc, cac, cbc, sbirr, cbirr, SD->cprime,
+                           SD->F, SD->V, SD->Sgn,
+                           SD->L, SD->R, CalcInfo_->num_ci_orbs,
                            CalcInfo_->orbsym + CalcInfo_->num_drc_orbs);
             }
          }
@@ -791,7 +920,7 @@ void CIWavefunction::sigma_block(struct stringwr **alplist, struct stringwr **be
         print_mat(smat, nas, nbs, "outfile");
       }
 
-      timer_off("CIWave: s3");
+      if (timed) timer_off("CIWave: s3");
 
       } /* end sigma3 */
 }
@@ -83,6 +83,7 @@ void og_form_repinfo(struct stringwr *string, int num_ci_orbs,
       struct olsen_graph *Graph, int first_orb_active);
 void init_stringwr_temps(int nel, int num_ci_orbs, int nsym);
 void free_stringwr_temps(int nsym);
+void stringlist_compact(struct stringwr *strlist, int nstr, int nlists);
 
 
 /*
@@ -103,6 +104,11 @@ void stringlist(struct olsen_graph *Graph, struct stringwr **slist, int repl_otf
    ncodes = Graph->subgr_per_irrep;
    nirreps = Graph->nirreps;
 
+   /* occupations are stored as unsigned char, and ij, oij as 16 bits */
+   if (Graph->num_orb > 256)
+      throw PsiException("(stringlist): DETCI supports at most 256 CI orbitals",
+         __FILE__,__LINE__);
+
    outarr = init_int_matrix(nel_expl, Graph->max_str_per_irrep);
    occs = init_int_array(nel_expl);
 
@@ -156,6 +162,10 @@ void stringlist(struct olsen_graph *Graph, struct stringwr **slist, int repl_otf
                nel_expl, Graph->num_orb, subgraph, Graph,
                Graph->num_expl_cor_orbs, repl_otf);
          }
+
+         if (!repl_otf)
+            stringlist_compact(slist[listnum], subgraph->num_strings,
+               nirreps * ncodes);
       } /* end loop over subgraph codes */
    } /* end loop over irreps */
 
@@ -380,8 +390,8 @@ void og_form_repinfo(struct stringwr *string, int num_ci_orbs,
 
    /* now write the info in the T matrices */
    string->cnt = init_int_array(nlists);
-   string->ij = (int **) malloc(sizeof(int *) * nlists);
-   string->oij = (int **) malloc(sizeof(int *) * nlists);
+   string->ij = (unsigned short **) malloc(sizeof(unsigned short *) * nlists);
+   string->oij = (unsigned short **) malloc(sizeof(unsigned short *) * nlists);
    string->ridx = (unsigned int **) malloc(sizeof(unsigned int *) * nlists);
    string->sgn = (signed char **) malloc(sizeof(signed char *) * nlists);
 
@@ -393,8 +403,10 @@ void og_form_repinfo(struct stringwr *string, int num_ci_orbs,
       string->ridx[i] = NULL;
       string->sgn[i] = NULL;
       if (cnt) {
-         string->ij[i] = init_int_array(cnt);
-         string->oij[i] = init_int_array(cnt);
+         string->ij[i] = (unsigned short *) malloc(cnt *
+            sizeof(unsigned short));
+         string->oij[i] = (unsigned short *) malloc(cnt *
+            sizeof(unsigned short));
          string->ridx[i] = (unsigned int *) malloc(cnt *
             sizeof(unsigned int));
          string->sgn[i] = (signed char *) malloc(cnt *
@@ -405,8 +417,8 @@ void og_form_repinfo(struct stringwr *string, int num_ci_orbs,
                ij = Tij[i][l];
                if (ij <= q) { q = ij; p = l; }
                }
-            string->ij[i][k] = Tij[i][p];
-            string->oij[i][k] = Toij[i][p];
+            string->ij[i][k] = (unsigned short) Tij[i][p];
+            string->oij[i][k] = (unsigned short) Toij[i][p];
             string->ridx[i][k] = Tidx[i][p];
             string->sgn[i][k] = Tsgn[i][p];
             Tij[i][p] = MAXIJ;
@@ -418,6 +430,84 @@ void og_form_repinfo(struct stringwr *string, int num_ci_orbs,
 }
 
 
+/*
+** stringlist_compact(): Moves the replacement info of the nstr strings of
+**    one list, built string by string in og_form_repinfo(), into one slab
+**    per field (CSR-like, ordered by target list and then by string) and
+**    frees the per-string arrays.  The stringwr pointers are rebound into
+**    the slabs, so readers are unaffected, but a sweep over the strings of
+**    a list for a fixed target list now reads memory contiguously.
+*/
+void stringlist_compact(struct stringwr *strlist, int nstr, int nlists)
+{
+   int I, J, k, cnt;
+   unsigned long int tot, off;
+   int *cnt_slab;
+   unsigned short **ijp, **oijp, *ij_slab, *oij_slab;
+   unsigned int **ridxp, *ridx_slab;
+   signed char **sgnp, *sgn_slab;
+
+   if (nstr == 0) return;
+
+   for (I=0, tot=0; I<nstr; I++)
+      for (J=0; J<nlists; J++) tot += strlist[I].cnt[J];
+
+   cnt_slab = init_int_array(nstr * nlists);
+   ijp = (unsigned short **) malloc(sizeof(unsigned short *) * nstr * nlists);
+   oijp = (unsigned short **) malloc(sizeof(unsigned short *) * nstr * nlists);
+   ridxp = (unsigned int **) malloc(sizeof(unsigned int *) * nstr * nlists);
+   sgnp = (signed char **) malloc(sizeof(signed char *) * nstr * nlists);
+   ij_slab = (unsigned short *) malloc(sizeof(unsigned short) * (tot ? tot : 1));
+   oij_slab = (unsigned short *) malloc(sizeof(unsigned short) * (tot ? tot : 1));
+   ridx_slab = (unsigned int *) malloc(sizeof(unsigned int) * (tot ? tot : 1));
+   sgn_slab = (signed char *) malloc(sizeof(signed char) * (tot ? tot : 1));
+   if (ijp == NULL || oijp == NULL || ridxp == NULL || sgnp == NULL ||
+       ij_slab == NULL || oij_slab == NULL || ridx_slab == NULL ||
+       sgn_slab == NULL) {
+      throw PsiException("(stringlist_compact): Malloc error",__FILE__,__LINE__);
+      }
+
+   for (J=0, off=0; J<nlists; J++) {
+      for (I=0; I<nstr; I++) {
+         cnt = strlist[I].cnt[J];
+         cnt_slab[I * nlists + J] = cnt;
+         ijp[I * nlists + J] = NULL;
+         oijp[I * nlists + J] = NULL;
+         ridxp[I * nlists + J] = NULL;
+         sgnp[I * nlists + J] = NULL;
+         if (!cnt) continue;
+         ijp[I * nlists + J] = ij_slab + off;
+         oijp[I * nlists + J] = oij_slab + off;
+         ridxp[I * nlists + J] = ridx_slab + off;
+         sgnp[I * nlists + J] = sgn_slab + off;
+         for (k=0; k<cnt; k++, off++) {
+            ij_slab[off] = strlist[I].ij[J][k];
+            oij_slab[off] = strlist[I].oij[J][k];
+            ridx_slab[off] = strlist[I].ridx[J][k];
+            sgn_slab[off] = strlist[I].sgn[J][k];
+            }
+         free(strlist[I].ij[J]);
+         free(strlist[I].oij[J]);
+         free(strlist[I].ridx[J]);
+         free(strlist[I].sgn[J]);
+         }
+      }
+
+   for (I=0; I<nstr; I++) {
+      free(strlist[I].cnt);
+      free(strlist[I].ij);
+      free(strlist[I].oij);
+      free(strlist[I].ridx);
+      free(strlist[I].sgn);
+      strlist[I].cnt = cnt_slab + I * nlists;
+      strlist[I].ij = ijp + I * nlists;
+      strlist[I].oij = oijp + I * nlists;
+      strlist[I].ridx = ridxp + I * nlists;
+      strlist[I].sgn = sgnp + I * nlists;
+      }
+}
+
+
 void init_stringwr_temps(int nel, int num_ci_orbs, int nsym)
 {
    int maxcnt, i, j;
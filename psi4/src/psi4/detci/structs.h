@@ -102,10 +102,17 @@ typedef unsigned long int BIGINT;
 #define LEININGER                  4
 #define Z_HD_KAVE                  5
 
+/*
+** A string and its single replacements into each string list.  The
+** replacement arrays of all strings of one list live in one slab per
+** field (see stringlist_compact()), ordered by target list and then by
+** string, so ij[J] of consecutive strings are adjacent in memory.  Orbital
+** indices are unsigned char, so ij and oij (< 256^2) fit in 16 bits.
+*/
 struct stringwr {
    unsigned char *occs;
-   int **ij;
-   int **oij;
+   unsigned short **ij;
+   unsigned short **oij;
    unsigned int **ridx;
    signed char **sgn;
    int *cnt;
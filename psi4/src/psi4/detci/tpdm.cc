@@ -465,7 +465,8 @@ void CIWavefunction::tpdm_block(struct stringwr **alplist,
   signed char *Jbsgn, *Jasgn, *Kbsgn, *Kasgn;
   unsigned int *Jbridx, *Jaridx, *Kbridx, *Karidx;
   double C1, C2, Ib_sgn, Ia_sgn, Kb_sgn, Ka_sgn, tval;
-  int i, j, k, l, ij, kl, ijkl, oij, okl, *Jboij, *Jaoij, *Kboij, *Kaoij;
+  int i, j, k, l, ij, kl, ijkl, oij, okl;
+  unsigned short *Jboij, *Jaoij, *Kboij, *Kaoij;
 
   /* loop over Ia in Ia_list */
   if (Ia_list == Ja_list) {
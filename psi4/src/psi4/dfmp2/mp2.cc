@@ -25,6 +25,7 @@
  * @END LICENSE
  */
 
+#include <algorithm>
 #include "mp2.h"
 #include "corr_grad.h"
 #include "psi4/lib3index/3index.h"
@@ -37,6 +38,7 @@
 #include "psi4/libqt/qt.h"
 #include "psi4/libpsio/psio.hpp"
 #include "psi4/libpsio/psio.h"
+#include "psi4/libpsio/aiohandler.h"
 #include "psi4/psi4-dec.h"
 #include "psi4/physconst.h"
 #include "psi4/psifiles.h"
@@ -183,6 +185,10 @@ void DFMP2::common_init()
     sss_ = options_.get_double("MP2_SS_SCALE");
     oss_ = options_.get_double("MP2_OS_SCALE");
 
+    // Without the same-spin term, the Laplace-factored energy is O(N^4) SOS-MP2
+    laplace_ = (options_.get_str("DFMP2_ENERGY_ALGORITHM") == "LAPLACE");
+    same_spin_ = !(laplace_ && sss_ == 0.0);
+
     ribasis_ = BasisSet::pyconstruct_auxiliary(molecule_,
         "DF_BASIS_MP2", options_.get_str("DF_BASIS_MP2"),
         "RIFIT", options_.get_str("BASIS"));
@@ -548,10 +554,13 @@ void DFMP2::apply_gamma(unsigned int file, ULI naux, ULI nia)
     if (doubles < 1L * Jmem) {
         throw PSIEXCEPTION("DFMP2: More memory required for gamma");
     }
-    ULI rem = (doubles - Jmem) / 2L;
+    // Two (G,B) buffer pairs: one being contracted, one being read
+    ULI rem = (doubles - Jmem) / 4L;
     ULI max_nia = (rem / naux);
     max_nia = (max_nia > nia ? nia : max_nia);
     max_nia = (max_nia < 1L ? 1L : max_nia);
+    ULI nblock = (nia + max_nia - 1L) / max_nia;
+    max_nia = (nia + nblock - 1L) / nblock;
 
     // Block sizing
     std::vector<ULI> ia_starts;
@@ -565,18 +574,23 @@ void DFMP2::apply_gamma(unsigned int file, ULI naux, ULI nia)
     }
     //block_status(ia_starts, __FILE__,__LINE__);
 
-    // Tensor blocks
-    SharedMatrix Aia(new Matrix("Aia", max_nia, naux));
-    SharedMatrix Qia(new Matrix("Qia", max_nia, naux));
+    // Tensor blocks, double buffered
+    SharedMatrix Aia[2];
+    SharedMatrix Qia[2];
+    for (int buf = 0; buf < 2; buf++) {
+        Aia[buf] = SharedMatrix(new Matrix("Aia", max_nia, naux));
+        Qia[buf] = SharedMatrix(new Matrix("Qia", max_nia, naux));
+    }
     SharedMatrix G(new Matrix("g", naux, naux));
-    double** Aiap = Aia->pointer();
-    double** Qiap = Qia->pointer();
     double** Gp   = G->pointer();
 
-    // Loop through blocks
+    // Loop through blocks, reading block + 1 while block is contracted
     psio_->open(file, PSIO_OPEN_OLD);
+    std::shared_ptr<AIOHandler> aio(new AIOHandler(psio_));
     psio_address next_AIA = PSIO_ZERO;
     psio_address next_QIA = PSIO_ZERO;
+    aio->read(file,"(G|ia)",(char*)Aia[0]->pointer()[0],sizeof(double)*(ia_starts[1]-ia_starts[0])*naux,PSIO_ZERO,&next_AIA);
+    aio->read(file,"(B|ia)",(char*)Qia[0]->pointer()[0],sizeof(double)*(ia_starts[1]-ia_starts[0])*naux,PSIO_ZERO,&next_QIA);
     for (int block = 0; block < ia_starts.size() - 1; block++) {
 
         // Sizing
@@ -584,15 +598,21 @@ void DFMP2::apply_gamma(unsigned int file, ULI naux, ULI nia)
         ULI ia_stop  = ia_starts[block+1];
         ULI ncols = ia_stop - ia_start;
 
-        // Read Gia
+        // Wait for Gia and Cia
         timer_on("DFMP2 Gia Read");
-        psio_->read(file,"(G|ia)",(char*)Aiap[0],sizeof(double)*ncols*naux,next_AIA,&next_AIA);
+        aio->synchronize();
         timer_off("DFMP2 Gia Read");
 
-        // Read Cia
-        timer_on("DFMP2 Cia Read");
-        psio_->read(file,"(B|ia)",(char*)Qiap[0],sizeof(double)*ncols*naux,next_QIA,&next_QIA);
-        timer_off("DFMP2 Cia Read");
+        // Start on the next Gia and Cia
+        if (block + 2 < ia_starts.size()) {
+            ULI nnext = ia_starts[block+2] - ia_stop;
+            psio_address start = psio_get_address(PSIO_ZERO,sizeof(double)*ia_stop*naux);
+            aio->read(file,"(G|ia)",(char*)Aia[(block+1)%2]->pointer()[0],sizeof(double)*nnext*naux,start,&next_AIA);
+            aio->read(file,"(B|ia)",(char*)Qia[(block+1)%2]->pointer()[0],sizeof(double)*nnext*naux,start,&next_QIA);
+        }
+
+        double** Aiap = Aia[block%2]->pointer();
+        double** Qiap = Qia[block%2]->pointer();
 
         // g_PQ = G_ia^P C_ia^Q
         timer_on("DFMP2 g");
@@ -606,11 +626,13 @@ void DFMP2::apply_gamma(unsigned int file, ULI naux, ULI nia)
 }
 void DFMP2::apply_G_transpose(unsigned int file, ULI naux, ULI nia)
 {
-    // Memory constraints
+    // Memory constraints: two Gia read buffers and one transpose buffer
     ULI doubles = (ULI) (options_.get_double("DFMP2_MEM_FACTOR") * (memory_ / 8L));
-    ULI max_nia = (doubles / naux);
+    ULI max_nia = (doubles / (3L * naux));
     max_nia = (max_nia > nia ? nia : max_nia);
     max_nia = (max_nia < 1L ? 1L : max_nia);
+    ULI nblock = (nia + max_nia - 1L) / max_nia;
+    max_nia = (nia + nblock - 1L) / nblock;
 
     // Block sizing
     std::vector<ULI> ia_starts;
@@ -638,11 +660,16 @@ void DFMP2::apply_G_transpose(unsigned int file, ULI naux, ULI nia)
 
     // Tensor blocks
     SharedMatrix Aia(new Matrix("Aia", naux, max_nia));
-    SharedMatrix Qia(new Matrix("Qia", max_nia, naux));
+    SharedMatrix Qia[2];
+    for (int buf = 0; buf < 2; buf++) {
+        Qia[buf] = SharedMatrix(new Matrix("Qia", max_nia, naux));
+    }
     double** Aiap = Aia->pointer();
-    double** Qiap = Qia->pointer();
 
-    // Loop through blocks
+    // Loop through blocks. All I/O goes through the AIO thread, in order:
+    // the read of block + 1 and the writes of block overlap the transposes.
+    std::shared_ptr<AIOHandler> aio(new AIOHandler(psio_));
+    aio->read(file,"(G|ia)",(char*)Qia[0]->pointer()[0],sizeof(double)*(ia_starts[1]-ia_starts[0])*naux,PSIO_ZERO,&next_QIA);
     for (int block = 0; block < ia_starts.size() - 1; block++) {
 
         // Sizing
@@ -650,11 +677,20 @@ void DFMP2::apply_G_transpose(unsigned int file, ULI naux, ULI nia)
         ULI ia_stop  = ia_starts[block+1];
         ULI ncols = ia_stop - ia_start;
 
-        // Read Gia
+        // Wait for Gia (and for the previous block's writes out of Aia)
         timer_on("DFMP2 Gia Read");
-        psio_->read(file,"(G|ia)",(char*)Qiap[0],sizeof(double)*ncols*naux,next_QIA,&next_QIA);
+        aio->synchronize();
         timer_off("DFMP2 Gia Read");
 
+        // Start on the next Gia
+        if (block + 2 < ia_starts.size()) {
+            ULI nnext = ia_starts[block+2] - ia_stop;
+            aio->read(file,"(G|ia)",(char*)Qia[(block+1)%2]->pointer()[0],sizeof(double)*nnext*naux,
+                psio_get_address(PSIO_ZERO,sizeof(double)*ia_stop*naux),&next_QIA);
+        }
+
+        double** Qiap = Qia[block%2]->pointer();
+
         // Transpose
         for (int Q = 0; Q < naux; Q++) {
             C_DCOPY(ncols, &Qiap[0][Q], naux, Aiap[Q], 1);
@@ -663,11 +699,12 @@ void DFMP2::apply_G_transpose(unsigned int file, ULI naux, ULI nia)
         // Write Gia^\dagger
         timer_on("DFMP2 aiG Write");
         for (ULI Q = 0; Q < naux; Q++) {
-            next_AIA = psio_get_address(PSIO_ZERO,sizeof(double)*(Q*nia+ia_start));
-            psio_->write(file,"(G|ia) T",(char*)Aiap[Q],sizeof(double)*ncols,next_AIA,&next_AIA);
+            aio->write(file,"(G|ia) T",(char*)Aiap[Q],sizeof(double)*ncols,
+                psio_get_address(PSIO_ZERO,sizeof(double)*(Q*nia+ia_start)),&next_AIA);
         }
         timer_off("DFMP2 aiG Write");
     }
+    aio->synchronize();
     psio_->close(file, 1);
 }
 void DFMP2::apply_B_transpose(unsigned int file, ULI naux, ULI naocc, ULI navir)
@@ -718,6 +755,161 @@ void DFMP2::apply_B_transpose(unsigned int file, ULI naux, ULI naocc, ULI navir)
     }
     psio_->close(file, 1);
 }
+SharedMatrix DFMP2::form_laplace_norms(unsigned int file, ULI naux, ULI naocc, ULI navir)
+{
+    SharedMatrix norms(new Matrix("(ia|ia)", naocc, navir));
+    double** normsp = norms->pointer();
+
+    // Memory constraints
+    ULI doubles = ((ULI) (options_.get_double("DFMP2_MEM_FACTOR") * memory_ / 8L));
+    ULI max_i = doubles / (navir * naux);
+    max_i = (max_i > naocc ? naocc : max_i);
+    max_i = (max_i < 1L ? 1L : max_i);
+
+    SharedMatrix Qia(new Matrix("Qia", max_i * navir, naux));
+    double** Qiap = Qia->pointer();
+
+    psio_->open(file, PSIO_OPEN_OLD);
+    psio_address next_AIA = PSIO_ZERO;
+    for (ULI istart = 0L; istart < naocc; istart += max_i) {
+        ULI ni = (istart + max_i > naocc ? naocc - istart : max_i);
+
+        timer_on("DFMP2 Qia Read");
+        psio_->read(file,"(Q|ia)",(char*)Qiap[0],sizeof(double)*(ni * navir * naux),next_AIA,&next_AIA);
+        timer_off("DFMP2 Qia Read");
+
+        #pragma omp parallel for
+        for (long int ia = 0L; ia < ni * navir; ia++) {
+            normsp[0][istart * navir + ia] = C_DDOT(naux,Qiap[ia],1,Qiap[ia],1);
+        }
+    }
+    psio_->close(file, 1);
+
+    return norms;
+}
+std::vector<double> DFMP2::form_laplace_sums(SharedMatrix dop, SharedMatrix dvp, SharedMatrix norms)
+{
+    int nvector = dop->rowspi()[0];
+    int naocc = dop->colspi()[0];
+    int navir = dvp->colspi()[0];
+    double** normsp = norms->pointer();
+
+    std::vector<double> sums(nvector, 0.0);
+    for (int w = 0; w < nvector; w++) {
+        double* op = dop->pointer()[w];
+        double* vp = dvp->pointer()[w];
+        for (int i = 0; i < naocc; i++) {
+            sums[w] += op[i] * C_DDOT(navir,vp,1,normsp[i],1);
+        }
+    }
+
+    return sums;
+}
+void DFMP2::form_laplace_screening(SharedMatrix dop, SharedMatrix dvp, SharedMatrix norms,
+    const std::vector<double>& partner, const std::string& label,
+    std::vector<ULI>& istarts, std::vector<ULI>& astops)
+{
+    int nvector = dop->rowspi()[0];
+    int naocc = dop->colspi()[0];
+    int navir = dvp->colspi()[0];
+    double** normsp = norms->pointer();
+    double cutoff = options_.get_double("DFMP2_LAPLACE_CUTOFF");
+
+    // By Schwarz, the (ia|jb)^2 tau^w_ia tau^w_jb neglected with a set of ia is at
+    // most partner[w] \sum_ia tau^w_ia (ia|ia). The weights grow with the occupied
+    // and decay with the virtual orbital energies, so the lowest occupieds and the
+    // highest virtuals go first, each with half of the cutoff.
+    istarts.resize(nvector);
+    astops.resize(nvector);
+    std::vector<double> R(naocc);
+    std::vector<double> C(navir);
+    for (int w = 0; w < nvector; w++) {
+        double* op = dop->pointer()[w];
+        double* vp = dvp->pointer()[w];
+
+        for (int i = 0; i < naocc; i++) {
+            R[i] = op[i] * C_DDOT(navir,vp,1,normsp[i],1);
+        }
+        ULI istart = 0L;
+        double neglected = 0.0;
+        while (istart < naocc && (neglected + R[istart]) * partner[w] < 0.5 * cutoff) {
+            neglected += R[istart];
+            istart++;
+        }
+
+        for (int a = 0; a < navir; a++) {
+            C[a] = 0.0;
+            for (int i = istart; i < naocc; i++) {
+                C[a] += op[i] * normsp[i][a];
+            }
+            C[a] *= vp[a];
+        }
+        ULI astop = navir;
+        neglected = 0.0;
+        while (astop > 0L && (neglected + C[astop-1]) * partner[w] < 0.5 * cutoff) {
+            neglected += C[astop-1];
+            astop--;
+        }
+
+        istarts[w] = istart;
+        astops[w] = astop;
+    }
+
+    outfile->Printf("  ==> Laplace Screening%s <==\n\n", label.c_str());
+    outfile->Printf("    Cutoff = %11.3E\n\n", cutoff);
+    outfile->Printf("    %5s %11s %11s %11s\n", "Point", "Occupied", "Virtual", "Pairs [%]");
+    for (int w = 0; w < nvector; w++) {
+        ULI ni = naocc - istarts[w];
+        ULI na = astops[w];
+        outfile->Printf("    %5d %5lu/%5d %5lu/%5d %11.2f\n", w + 1, ni, naocc, na, navir,
+            100.0 * ni * na / (double) (naocc * (ULI) navir));
+    }
+    outfile->Printf("\n");
+}
+void DFMP2::apply_laplace(unsigned int file, ULI naux, ULI naocc, ULI navir,
+    double* dop, double* dvp, ULI istart, ULI astop, ULI reserved, SharedMatrix PQ)
+{
+    PQ->zero();
+    if (istart >= naocc || astop == 0L) return;
+    double** PQp = PQ->pointer();
+
+    // Memory constraints
+    ULI doubles = ((ULI) (options_.get_double("DFMP2_MEM_FACTOR") * memory_ / 8L));
+    ULI remainder = (doubles > reserved ? doubles - reserved : 0L);
+    ULI max_i = remainder / (navir * naux);
+    max_i = (max_i > naocc - istart ? naocc - istart : max_i);
+    max_i = (max_i < 1L ? 1L : max_i);
+
+    SharedMatrix Qia(new Matrix("Qia", max_i * navir, naux));
+    double** Qiap = Qia->pointer();
+
+    psio_->open(file, PSIO_OPEN_OLD);
+    psio_address next_AIA = psio_get_address(PSIO_ZERO,sizeof(double)*(istart * navir * naux));
+    for (ULI block_start = istart; block_start < naocc; block_start += max_i) {
+        ULI ni = (block_start + max_i > naocc ? naocc - block_start : max_i);
+
+        timer_on("DFMP2 Qia Read");
+        psio_->read(file,"(Q|ia)",(char*)Qiap[0],sizeof(double)*(ni * navir * naux),next_AIA,&next_AIA);
+        timer_off("DFMP2 Qia Read");
+
+        // Pack the unscreened rows to the front, weighted by tau^1/2
+        ULI nrows = 0L;
+        for (ULI i = 0; i < ni; i++) {
+            for (ULI a = 0; a < astop; a++) {
+                if (nrows != i * navir + a) {
+                    ::memcpy((void*) Qiap[nrows], (void*) Qiap[i * navir + a], sizeof(double) * naux);
+                }
+                C_DSCAL(naux,sqrt(dop[i + block_start] * dvp[a]),Qiap[nrows],1);
+                nrows++;
+            }
+        }
+
+        timer_on("DFMP2 Laplace PQ");
+        C_DGEMM('T','N',naux,naux,nrows,1.0,Qiap[0],naux,Qiap[0],naux,1.0,PQp[0],naux);
+        timer_off("DFMP2 Laplace PQ");
+    }
+    psio_->close(file, 1);
+}
 void DFMP2::print_energies()
 {
     energies_["Correlation Energy"] = energies_["Opposite-Spin Energy"] + energies_["Same-Spin Energy"] + energies_["Singles Energy"];
@@ -733,10 +925,17 @@ void DFMP2::print_energies()
     outfile->Printf( "\t-----------------------------------------------------------\n");
     outfile->Printf( "\t %-25s = %24.16f [Eh]\n", "Reference Energy",         energies_["Reference Energy"]);
     outfile->Printf( "\t %-25s = %24.16f [Eh]\n", "Singles Energy",           energies_["Singles Energy"]);
-    outfile->Printf( "\t %-25s = %24.16f [Eh]\n", "Same-Spin Energy",         energies_["Same-Spin Energy"]);
-    outfile->Printf( "\t %-25s = %24.16f [Eh]\n", "Opposite-Spin Energy",     energies_["Opposite-Spin Energy"]);
-    outfile->Printf( "\t %-25s = %24.16f [Eh]\n", "Correlation Energy",       energies_["Correlation Energy"]);
-    outfile->Printf( "\t %-25s = %24.16f [Eh]\n", "Total Energy",             energies_["Total Energy"]);
+    if (same_spin_) {
+        outfile->Printf( "\t %-25s = %24.16f [Eh]\n", "Same-Spin Energy",         energies_["Same-Spin Energy"]);
+        outfile->Printf( "\t %-25s = %24.16f [Eh]\n", "Opposite-Spin Energy",     energies_["Opposite-Spin Energy"]);
+        outfile->Printf( "\t %-25s = %24.16f [Eh]\n", "Correlation Energy",       energies_["Correlation Energy"]);
+        outfile->Printf( "\t %-25s = %24.16f [Eh]\n", "Total Energy",             energies_["Total Energy"]);
+    } else {
+        outfile->Printf( "\t %-25s = %24s [Eh]\n",    "Same-Spin Energy",         "(not computed)");
+        outfile->Printf( "\t %-25s = %24.16f [Eh]\n", "Opposite-Spin Energy",     energies_["Opposite-Spin Energy"]);
+        outfile->Printf( "\t %-25s = %24s [Eh]\n",    "Correlation Energy",       "(not computed)");
+        outfile->Printf( "\t %-25s = %24s [Eh]\n",    "Total Energy",             "(not computed)");
+    }
     outfile->Printf( "\t-----------------------------------------------------------\n");
     outfile->Printf( "\t ================> DF-SCS-MP2 Energies <================== \n");
     outfile->Printf( "\t-----------------------------------------------------------\n");
@@ -750,6 +949,17 @@ void DFMP2::print_energies()
     outfile->Printf( "\n");
 
 
+    // Only the scaled energies are complete without the same-spin term
+    if (!same_spin_) {
+        Process::environment.globals["CURRENT ENERGY"] = energies_["SCS Total Energy"];
+        Process::environment.globals["CURRENT CORRELATION ENERGY"] = energies_["SCS Correlation Energy"];
+        Process::environment.globals["MP2 SINGLES ENERGY"] = energies_["Singles Energy"];
+        Process::environment.globals["MP2 OPPOSITE-SPIN CORRELATION ENERGY"] = energies_["Opposite-Spin Energy"];
+        Process::environment.globals["SCS-MP2 TOTAL ENERGY"] = energies_["SCS Total Energy"];
+        Process::environment.globals["SCS-MP2 CORRELATION ENERGY"] = energies_["SCS Correlation Energy"];
+        return;
+    }
+
     Process::environment.globals["CURRENT ENERGY"] = energies_["Total Energy"];
     Process::environment.globals["CURRENT CORRELATION ENERGY"] = energies_["Correlation Energy"];
     Process::environment.globals["MP2 TOTAL ENERGY"] = energies_["Total Energy"];
@@ -1007,6 +1217,15 @@ void RDFMP2::form_Qia_transpose()
 }
 void RDFMP2::form_energy()
 {
+    // The RHF same-spin term needs every (ia|jb), so the Laplace factorization only pays without it
+    if (laplace_ && !same_spin_) {
+        form_energy_laplace();
+        return;
+    } else if (laplace_) {
+        outfile->Printf("  DFMP2_ENERGY_ALGORITHM LAPLACE needs MP2_SS_SCALE = 0 for an RHF reference.\n");
+        outfile->Printf("  Using the canonical algorithm.\n\n");
+    }
+
     // Energy registers
     double e_ss = 0.0;
     double e_os = 0.0;
@@ -1029,11 +1248,16 @@ void RDFMP2::form_energy()
     if (doubles < nthread * Iab_memory) {
         throw PSIEXCEPTION("DFMP2: Insufficient memory for Iab buffers. Reduce OMP Threads or increase memory.");
     }
+    // Three Qia slots: the i block, the j block, and the one being read
     ULI remainder = doubles - nthread * Iab_memory;
-    ULI max_i = remainder / (2L * Qa_memory);
+    ULI max_i = remainder / (3L * Qa_memory);
     max_i = (max_i > naocc? naocc : max_i);
     max_i = (max_i < 1L ? 1L : max_i);
 
+    // Even out the blocks, so no small tail block stalls the pipeline
+    ULI nblock = (naocc + max_i - 1L) / max_i;
+    max_i = (naocc + nblock - 1L) / nblock;
+
     // Blocks
     std::vector<ULI> i_starts;
     i_starts.push_back(0L);
@@ -1046,11 +1270,21 @@ void RDFMP2::form_energy()
     }
     //block_status(i_starts, __FILE__,__LINE__);
 
+    // Block pairs in pipeline order: (i,i) then (i,j) for j < i. Each pair
+    // needs exactly one new block from disk, j (or i itself for (i,i)).
+    std::vector<std::pair<int,int> > pairs;
+    for (int block_i = 0; block_i < i_starts.size() - 1; block_i++) {
+        pairs.push_back(std::make_pair(block_i, block_i));
+        for (int block_j = 0; block_j < block_i; block_j++) {
+            pairs.push_back(std::make_pair(block_i, block_j));
+        }
+    }
+
     // Tensor blocks
-    SharedMatrix Qia (new Matrix("Qia", max_i * (ULI) navir, naux));
-    SharedMatrix Qjb (new Matrix("Qjb", max_i * (ULI) navir, naux));
-    double** Qiap = Qia->pointer();
-    double** Qjbp = Qjb->pointer();
+    std::vector<SharedMatrix> Qslot;
+    for (int slot = 0; slot < 3; slot++) {
+        Qslot.push_back(SharedMatrix(new Matrix("Qia", max_i * (ULI) navir, naux)));
+    }
 
     std::vector<SharedMatrix> Iab;
     for (int i = 0; i < nthread; i++) {
@@ -1060,69 +1294,79 @@ void RDFMP2::form_energy()
     double* eps_aoccp = eps_aocc_->pointer();
     double* eps_avirp = eps_avir_->pointer();
 
-    // Loop through pairs of blocks
+    // Loop through pairs of blocks, reading the next block while this one is contracted
     psio_->open(PSIF_DFMP2_AIA,PSIO_OPEN_OLD);
+    std::shared_ptr<AIOHandler> aio(new AIOHandler(psio_));
     psio_address next_AIA = PSIO_ZERO;
-    for (int block_i = 0; block_i < i_starts.size() - 1; block_i++) {
+
+    int slot_i = 0;
+    int slot_j = 0;
+    int slot_next = 0;
+    ULI nfirst = i_starts[1] - i_starts[0];
+    aio->read(PSIF_DFMP2_AIA,"(Q|ia)",(char*)Qslot[slot_next]->pointer()[0],sizeof(double)*(nfirst * navir * naux),PSIO_ZERO,&next_AIA);
+
+    for (int pair = 0; pair < pairs.size(); pair++) {
+
+        int block_i = pairs[pair].first;
+        int block_j = pairs[pair].second;
 
         // Sizing
         ULI istart = i_starts[block_i];
         ULI istop  = i_starts[block_i+1];
         ULI ni     = istop - istart;
+        ULI jstart = i_starts[block_j];
+        ULI jstop  = i_starts[block_j+1];
+        ULI nj     = jstop - jstart;
 
-        // Read iaQ chunk
+        // Wait for this pair's block
         timer_on("DFMP2 Qia Read");
-        next_AIA = psio_get_address(PSIO_ZERO,sizeof(double)*(istart * navir * naux));
-        psio_->read(PSIF_DFMP2_AIA,"(Q|ia)",(char*)Qiap[0],sizeof(double)*(ni * navir * naux),next_AIA,&next_AIA);
+        aio->synchronize();
         timer_off("DFMP2 Qia Read");
+        if (block_i == block_j) slot_i = slot_next;
+        slot_j = slot_next;
 
-        for (int block_j = 0; block_j <= block_i; block_j++) {
-
-            // Sizing
-            ULI jstart = i_starts[block_j];
-            ULI jstop  = i_starts[block_j+1];
-            ULI nj     = jstop - jstart;
+        // Start reading the next pair's block into the free slot
+        if (pair + 1 < pairs.size()) {
+            int block_n = pairs[pair+1].second;
+            ULI nstart = i_starts[block_n];
+            ULI nn     = i_starts[block_n+1] - nstart;
+            for (slot_next = 0; slot_next == slot_i || slot_next == slot_j; slot_next++);
+            aio->read(PSIF_DFMP2_AIA,"(Q|ia)",(char*)Qslot[slot_next]->pointer()[0],sizeof(double)*(nn * navir * naux),
+                psio_get_address(PSIO_ZERO,sizeof(double)*(nstart * navir * naux)),&next_AIA);
+        }
 
-            // Read iaQ chunk (if unique)
-            timer_on("DFMP2 Qia Read");
-            if (block_i == block_j) {
-                ::memcpy((void*) Qjbp[0], (void*) Qiap[0], sizeof(double)*(ni * navir * naux));
-            } else {
-                next_AIA = psio_get_address(PSIO_ZERO,sizeof(double)*(jstart * navir * naux));
-                psio_->read(PSIF_DFMP2_AIA,"(Q|ia)",(char*)Qjbp[0],sizeof(double)*(nj * navir * naux),next_AIA,&next_AIA);
-            }
-            timer_off("DFMP2 Qia Read");
+        double** Qiap = Qslot[slot_i]->pointer();
+        double** Qjbp = Qslot[slot_j]->pointer();
 
-            #pragma omp parallel for schedule(dynamic) num_threads(nthread) reduction(+: e_ss, e_os)
-            for (long int ij = 0L; ij < ni * nj; ij++) {
+        #pragma omp parallel for schedule(dynamic) num_threads(nthread) reduction(+: e_ss, e_os)
+        for (long int ij = 0L; ij < ni * nj; ij++) {
 
-                // Sizing
-                ULI i = ij / nj + istart;
-                ULI j = ij % nj + jstart;
-                if (j > i) continue;
+            // Sizing
+            ULI i = ij / nj + istart;
+            ULI j = ij % nj + jstart;
+            if (j > i) continue;
 
-                double perm_factor = (i == j ? 1.0 : 2.0);
+            double perm_factor = (i == j ? 1.0 : 2.0);
 
-                // Which thread is this?
-                int thread = 0;
-                #ifdef _OPENMP
-                    thread = omp_get_thread_num();
-                #endif
-                double** Iabp = Iab[thread]->pointer();
+            // Which thread is this?
+            int thread = 0;
+            #ifdef _OPENMP
+                thread = omp_get_thread_num();
+            #endif
+            double** Iabp = Iab[thread]->pointer();
 
-                // Form the integral block (ia|jb) = (ia|Q)(Q|jb)
-                C_DGEMM('N','T',navir,navir,naux,1.0,Qiap[(i-istart)*navir],naux,Qjbp[(j-jstart)*navir],naux,0.0,Iabp[0],navir);
+            // Form the integral block (ia|jb) = (ia|Q)(Q|jb)
+            C_DGEMM('N','T',navir,navir,naux,1.0,Qiap[(i-istart)*navir],naux,Qjbp[(j-jstart)*navir],naux,0.0,Iabp[0],navir);
 
-                // Add the MP2 energy contributions
-                for (int a = 0; a < navir; a++) {
-                    for (int b = 0; b < navir; b++) {
-                        double iajb = Iabp[a][b];
-                        double ibja = Iabp[b][a];
-                        double denom = - perm_factor / (eps_avirp[a] + eps_avirp[b] - eps_aoccp[i] - eps_aoccp[j]);
+            // Add the MP2 energy contributions
+            for (int a = 0; a < navir; a++) {
+                for (int b = 0; b < navir; b++) {
+                    double iajb = Iabp[a][b];
+                    double ibja = Iabp[b][a];
+                    double denom = - perm_factor / (eps_avirp[a] + eps_avirp[b] - eps_aoccp[i] - eps_aoccp[j]);
 
-                        e_ss += (iajb*iajb - iajb*ibja) * denom;
-                        e_os += (iajb*iajb) * denom;
-                    }
+                    e_ss += (iajb*iajb - iajb*ibja) * denom;
+                    e_os += (iajb*iajb) * denom;
                 }
             }
         }
@@ -1132,6 +1376,52 @@ void RDFMP2::form_energy()
     energies_["Same-Spin Energy"] = e_ss;
     energies_["Opposite-Spin Energy"] = e_os;
 }
+void RDFMP2::form_energy_laplace()
+{
+    // Sizing
+    int naux  = ribasis_->nbf();
+    int naocc = Caocc_->colspi()[0];
+    int navir = Cavir_->colspi()[0];
+
+    // Memory
+    ULI PQ_memory = naux * (ULI) naux;
+    ULI doubles = ((ULI) (options_.get_double("DFMP2_MEM_FACTOR") * memory_ / 8L));
+    if (doubles < PQ_memory + navir * (ULI) naux) {
+        throw PSIEXCEPTION("DFMP2: Insufficient memory for Laplace (P|Q) buffers. Increase memory.");
+    }
+
+    // 1/(e_a + e_b - e_i - e_j) = \sum_w tau^w_ia tau^w_jb
+    std::shared_ptr<LaplaceDenominator> denom(new LaplaceDenominator(eps_aocc_,eps_avir_,
+        options_.get_double("DFMP2_LAPLACE_DELTA")));
+    SharedMatrix dop = denom->denominator_occ();
+    SharedMatrix dvp = denom->denominator_vir();
+    int nvector = denom->nvector();
+
+    // Either side of (ia|jb) may be neglected, hence the factor of two
+    SharedMatrix norms = form_laplace_norms(PSIF_DFMP2_AIA, naux, naocc, navir);
+    std::vector<double> partner = form_laplace_sums(dop, dvp, norms);
+    for (int w = 0; w < nvector; w++) {
+        partner[w] *= 2.0;
+    }
+    std::vector<ULI> istarts;
+    std::vector<ULI> astops;
+    form_laplace_screening(dop, dvp, norms, partner, "", istarts, astops);
+
+    // E_os = - \sum_w \sum_PQ [(P|ia) tau^w_ia (ia|Q)]^2
+    double e_os = 0.0;
+    SharedMatrix PQ(new Matrix("(P|Q)^w", naux, naux));
+    for (int w = 0; w < nvector; w++) {
+        apply_laplace(PSIF_DFMP2_AIA, naux, naocc, navir, dop->pointer()[w], dvp->pointer()[w],
+            istarts[w], astops[w], PQ_memory, PQ);
+        e_os -= PQ->vector_dot(PQ);
+    }
+
+    psio_->open(PSIF_DFMP2_AIA,PSIO_OPEN_OLD);
+    psio_->close(PSIF_DFMP2_AIA,0);
+
+    energies_["Same-Spin Energy"] = 0.0;
+    energies_["Opposite-Spin Energy"] = e_os;
+}
 void RDFMP2::form_Pab()
 {
     // Energy registers
@@ -3172,7 +3462,7 @@ void UDFMP2::form_energy()
     double e_ss = 0.0;
     double e_os = 0.0;
 
-    /* => AA Terms <= */ {
+    /* => AA Terms <= */ if (same_spin_) {
 
     // Sizing
     int naux  = ribasis_->nbf();
@@ -3293,7 +3583,7 @@ void UDFMP2::form_energy()
 
     /* End AA Terms */ }
 
-    /* => BB Terms <= */ {
+    /* => BB Terms <= */ if (same_spin_) {
 
     // Sizing
     int naux  = ribasis_->nbf();
@@ -3414,7 +3704,10 @@ void UDFMP2::form_energy()
 
     /* End BB Terms */ }
 
-    /* => AB Terms <= */ {
+    /* => AB Terms <= */ if (laplace_) {
+        form_energy_laplace();
+        e_os = energies_["Opposite-Spin Energy"];
+    } else {
 
     // Sizing
     int naux  = ribasis_->nbf();
@@ -3547,6 +3840,99 @@ void UDFMP2::form_energy()
     energies_["Same-Spin Energy"] = e_ss;
     energies_["Opposite-Spin Energy"] = e_os;
 }
+void UDFMP2::form_energy_laplace()
+{
+    // Sizing
+    int naux  = ribasis_->nbf();
+    int naocc_a = Caocc_a_->colspi()[0];
+    int navir_a = Cavir_a_->colspi()[0];
+    int naocc_b = Caocc_b_->colspi()[0];
+    int navir_b = Cavir_b_->colspi()[0];
+    int navir = (navir_a > navir_b ? navir_a : navir_b);
+
+    // Memory
+    ULI PQ_memory = naux * (ULI) naux;
+    ULI doubles = ((ULI) (options_.get_double("DFMP2_MEM_FACTOR") * memory_ / 8L));
+    if (doubles < 2L * PQ_memory + navir * (ULI) naux) {
+        throw PSIEXCEPTION("DFMP2: Insufficient memory for Laplace (P|Q) buffers. Increase memory.");
+    }
+
+    // One quadrature must cover both spins: build it on the merged, sorted orbital energies
+    std::vector<std::pair<double, int> > occ;
+    std::vector<std::pair<double, int> > vir;
+    for (int i = 0; i < naocc_a; i++) occ.push_back(std::make_pair(eps_aocc_a_->get(0,i), i));
+    for (int i = 0; i < naocc_b; i++) occ.push_back(std::make_pair(eps_aocc_b_->get(0,i), naocc_a + i));
+    for (int a = 0; a < navir_a; a++) vir.push_back(std::make_pair(eps_avir_a_->get(0,a), a));
+    for (int a = 0; a < navir_b; a++) vir.push_back(std::make_pair(eps_avir_b_->get(0,a), navir_a + a));
+    std::sort(occ.begin(), occ.end());
+    std::sort(vir.begin(), vir.end());
+
+    SharedVector eps_occ(new Vector("Merged Active Occupied Eigenvalues", naocc_a + naocc_b));
+    SharedVector eps_vir(new Vector("Merged Active Virtual Eigenvalues", navir_a + navir_b));
+    for (int i = 0; i < naocc_a + naocc_b; i++) eps_occ->set(0, i, occ[i].first);
+    for (int a = 0; a < navir_a + navir_b; a++) eps_vir->set(0, a, vir[a].first);
+
+    // 1/(e_a + e_B - e_i - e_J) = \sum_w tau^w_ia tau^w_JB
+    std::shared_ptr<LaplaceDenominator> denom(new LaplaceDenominator(eps_occ,eps_vir,
+        options_.get_double("DFMP2_LAPLACE_DELTA")));
+    int nvector = denom->nvector();
+    double** dop = denom->denominator_occ()->pointer();
+    double** dvp = denom->denominator_vir()->pointer();
+
+    SharedMatrix dop_a(new Matrix("Alpha Occupied Laplace Delta Tensor", nvector, naocc_a));
+    SharedMatrix dop_b(new Matrix("Beta Occupied Laplace Delta Tensor", nvector, naocc_b));
+    SharedMatrix dvp_a(new Matrix("Alpha Virtual Laplace Delta Tensor", nvector, navir_a));
+    SharedMatrix dvp_b(new Matrix("Beta Virtual Laplace Delta Tensor", nvector, navir_b));
+    for (int w = 0; w < nvector; w++) {
+        for (int i = 0; i < naocc_a + naocc_b; i++) {
+            int index = occ[i].second;
+            if (index < naocc_a) {
+                dop_a->set(0, w, index, dop[w][i]);
+            } else {
+                dop_b->set(0, w, index - naocc_a, dop[w][i]);
+            }
+        }
+        for (int a = 0; a < navir_a + navir_b; a++) {
+            int index = vir[a].second;
+            if (index < navir_a) {
+                dvp_a->set(0, w, index, dvp[w][a]);
+            } else {
+                dvp_b->set(0, w, index - navir_a, dvp[w][a]);
+            }
+        }
+    }
+
+    // The alpha ia are bounded against all beta JB, and vice versa
+    SharedMatrix norms_a = form_laplace_norms(PSIF_DFMP2_AIA, naux, naocc_a, navir_a);
+    SharedMatrix norms_b = form_laplace_norms(PSIF_DFMP2_QIA, naux, naocc_b, navir_b);
+    std::vector<double> sums_a = form_laplace_sums(dop_a, dvp_a, norms_a);
+    std::vector<double> sums_b = form_laplace_sums(dop_b, dvp_b, norms_b);
+    std::vector<ULI> istarts_a;
+    std::vector<ULI> astops_a;
+    std::vector<ULI> istarts_b;
+    std::vector<ULI> astops_b;
+    form_laplace_screening(dop_a, dvp_a, norms_a, sums_b, " (Alpha)", istarts_a, astops_a);
+    form_laplace_screening(dop_b, dvp_b, norms_b, sums_a, " (Beta)", istarts_b, astops_b);
+
+    // E_os = - \sum_w \sum_PQ [(P|ia) tau^w_ia (ia|Q)] [(P|JB) tau^w_JB (JB|Q)]
+    double e_os = 0.0;
+    SharedMatrix PQa(new Matrix("(P|Q)^w Alpha", naux, naux));
+    SharedMatrix PQb(new Matrix("(P|Q)^w Beta", naux, naux));
+    for (int w = 0; w < nvector; w++) {
+        apply_laplace(PSIF_DFMP2_AIA, naux, naocc_a, navir_a, dop_a->pointer()[w], dvp_a->pointer()[w],
+            istarts_a[w], astops_a[w], 2L * PQ_memory, PQa);
+        apply_laplace(PSIF_DFMP2_QIA, naux, naocc_b, navir_b, dop_b->pointer()[w], dvp_b->pointer()[w],
+            istarts_b[w], astops_b[w], 2L * PQ_memory, PQb);
+        e_os -= PQa->vector_dot(PQb);
+    }
+
+    psio_->open(PSIF_DFMP2_AIA,PSIO_OPEN_OLD);
+    psio_->open(PSIF_DFMP2_QIA,PSIO_OPEN_OLD);
+    psio_->close(PSIF_DFMP2_AIA,0);
+    psio_->close(PSIF_DFMP2_QIA,0);
+
+    energies_["Opposite-Spin Energy"] = e_os;
+}
 void UDFMP2::form_Pab()
 {
     throw PSIEXCEPTION("UDFMP2: Gradients not yet implemented");
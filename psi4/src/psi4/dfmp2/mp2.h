@@ -53,6 +53,10 @@ protected:
     double sss_;
     // Opposite-spin scale
     double oss_;
+    // Form the opposite-spin energy from a Laplace-factored denominator?
+    bool laplace_;
+    // Is the same-spin energy computed? (Not for Laplace SOS-MP2)
+    bool same_spin_;
 
     void common_init();
     // Common printing of energies/SCS
@@ -109,6 +113,21 @@ protected:
     // Form a transposed copy of iaQ
     virtual void apply_B_transpose(unsigned int file, unsigned long int naux, unsigned long int naocc, unsigned long int navir);
 
+    // => Laplace-factored opposite-spin energy, tau^w_ia = o^w_i v^w_a <= //
+
+    // Form the (ia|ia) diagonal of a disk entry Qia tensor
+    SharedMatrix form_laplace_norms(unsigned int file, unsigned long int naux, unsigned long int naocc, unsigned long int navir);
+    // Form the sums S^w = \sum_ia tau^w_ia (ia|ia), bounding each quadrature point
+    std::vector<double> form_laplace_sums(SharedMatrix dop, SharedMatrix dvp, SharedMatrix norms);
+    // Choose the unscreened occupieds [istart, naocc) and virtuals [0, astop) of each quadrature point
+    void form_laplace_screening(SharedMatrix dop, SharedMatrix dvp, SharedMatrix norms,
+        const std::vector<double>& partner, const std::string& label,
+        std::vector<unsigned long int>& istarts, std::vector<unsigned long int>& astops);
+    // Form (P|Q)^w = (P|ia) tau^w_ia (ia|Q) over the unscreened ia of one quadrature point
+    void apply_laplace(unsigned int file, unsigned long int naux, unsigned long int naocc, unsigned long int navir,
+        double* dop, double* dvp, unsigned long int istart, unsigned long int astop,
+        unsigned long int reserved, SharedMatrix PQ);
+
     // Debugging-routine: prints block sizing
     void block_status(std::vector<int> inds, const char* file, int line);
     void block_status(std::vector<unsigned long int> inds, const char* file, int line);
@@ -152,6 +171,8 @@ protected:
     virtual void form_Qia_transpose();
     // Form the energy contributions
     virtual void form_energy();
+    // Form the opposite-spin energy contribution by Laplace quadrature
+    virtual void form_energy_laplace();
     // Form the energy contributions and gradients
     virtual void form_Pab();
     // Form the energy contributions and gradients
@@ -208,6 +229,8 @@ protected:
     virtual void form_Qia_transpose();
     // Form the energy contributions
     virtual void form_energy();
+    // Form the opposite-spin energy contribution by Laplace quadrature
+    virtual void form_energy_laplace();
     // Form the energy contributions and gradients
     virtual void form_Pab();
     // Form the energy contributions and gradients
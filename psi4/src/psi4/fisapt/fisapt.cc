@@ -3043,13 +3043,35 @@ void FISAPT::fexch()
     std::shared_ptr<Matrix> E_exch3(new Matrix("E_exch [a <x-x> b]", na, nb));
     double** E_exch3p = E_exch3->pointer();
 
+    // Blocks of a, with all of their (ab|Q) and (ba|Q) slices in core
+
+    long int rem = doubles_ - (nr + ns + na + nb) * (long int) nQ;
+    long int max_a = rem / (2L * nb * nQ);
+    max_a = (max_a > na ? na : max_a);
+    if (max_a < 1L) {
+        throw PSIEXCEPTION("Too little memory for FISAPT::fexch");
+    }
+
+    std::shared_ptr<Matrix> BabQ(new Matrix("BabQ",max_a*nb,nQ));
+    std::shared_ptr<Matrix> BbaQ(new Matrix("BbaQ",nb*max_a,nQ));
+    double** BabQp = BabQ->pointer();
+    double** BbaQp = BbaQ->pointer();
+
     fseek(Babf,0L,SEEK_SET);
-    for (int a = 0; a < na; a++) {
-        size_t statusvalue=fread(TbQp[0],sizeof(double),nb*nQ,Babf);
+    for (int astart = 0; astart < na; astart += max_a) {
+        int nablock = (astart + max_a >= na ? na - astart : max_a);
+        size_t statusvalue=fread(BabQp[0],sizeof(double),nablock*nb*(size_t)nQ,Babf);
         for (int b = 0; b < nb; b++) {
-            fseek(Bbaf,(b*na+a)*(size_t)nQ*sizeof(double),SEEK_SET);
-            statusvalue=fread(TaQp[0],sizeof(double),nQ,Bbaf);
-            E_exch3p[a][b] -= 2.0 * C_DDOT(nQ,TbQp[b],1,TaQp[0],1);
+            fseek(Bbaf,(b*(size_t)na+astart)*(size_t)nQ*sizeof(double),SEEK_SET);
+            statusvalue=fread(BbaQp[b*nablock],sizeof(double),nablock*(size_t)nQ,Bbaf);
+        }
+
+        long int nab = nablock * (long int) nb;
+        #pragma omp parallel for schedule(static)
+        for (long int ab = 0L; ab < nab; ab++) {
+            int a = ab / nb;
+            int b = ab % nb;
+            E_exch3p[a + astart][b] -= 2.0 * C_DDOT(nQ,BabQp[a*nb+b],1,BbaQp[b*nablock+a],1);
         }
     }
 
@@ -3216,35 +3238,58 @@ void FISAPT::find()
     double** RaCp = matrices_["Vlocc0A"]->pointer();
     double** RbDp = matrices_["Vlocc0B"]->pointer();
 
+    // The ESPs of the local orbitals are assembled in core, a block of
+    // sources at a time, so that each block is written out in one piece
+
     FILE* Absf = AbsT->file_pointer();
-    fseek(Absf,0L,SEEK_SET);
     std::shared_ptr<Matrix> TsQ(new Matrix("TsQ",ns,nQ));
-    std::shared_ptr<Matrix> T1As(new Matrix("T1As",na,ns));
     double** TsQp = TsQ->pointer();
-    double** T1Asp = T1As->pointer();
-    for (size_t b = 0; b < nb; b++) {
-        size_t statusvalue=fread(TsQp[0],sizeof(double),ns*nQ,Absf);
-        C_DGEMM('N','T',na,ns,nQ,2.0,RaCp[0],nQ,TsQp[0],nQ,0.0,T1Asp[0],ns);
-        for (size_t a = 0; a < na; a++) {
-            fseek(WAbsf,nA*nb*ns*sizeof(double) + a*nb*ns*sizeof(double) + b*ns*sizeof(double),SEEK_SET);
-            fwrite(T1Asp[a],sizeof(double),ns,WAbsf);
+
+    long int max_a = (doubles_ - ns * (long int) nQ) / (nb * (long int) ns);
+    max_a = (max_a > na ? na : max_a);
+    if (max_a < 1L) {
+        throw PSIEXCEPTION("Too little memory for FISAPT::find");
+    }
+    std::shared_ptr<Matrix> T1Abs(new Matrix("T1Abs",max_a,nb*(size_t)ns));
+    double** T1Absp = T1Abs->pointer();
+
+    for (size_t astart = 0; astart < na; astart += max_a) {
+        size_t nablock = (astart + max_a >= na ? na - astart : max_a);
+        fseek(Absf,0L,SEEK_SET);
+        for (size_t b = 0; b < nb; b++) {
+            size_t statusvalue=fread(TsQp[0],sizeof(double),ns*nQ,Absf);
+            C_DGEMM('N','T',nablock,ns,nQ,2.0,RaCp[astart],nQ,TsQp[0],nQ,0.0,&T1Absp[0][b*ns],nb*ns);
         }
+        fseek(WAbsf,nA*nb*ns*sizeof(double) + astart*nb*ns*sizeof(double),SEEK_SET);
+        fwrite(T1Absp[0],sizeof(double),nablock*nb*ns,WAbsf);
     }
+    T1Abs.reset();
+    TsQ.reset();
 
     FILE* Aarf = AarT->file_pointer();
-    fseek(Aarf,0L,SEEK_SET);
     std::shared_ptr<Matrix> TrQ(new Matrix("TrQ",nr,nQ));
-    std::shared_ptr<Matrix> T1Br(new Matrix("T1Br",nb,nr));
     double** TrQp = TrQ->pointer();
-    double** T1Brp = T1Br->pointer();
-    for (size_t a = 0; a < na; a++) {
-        size_t statusvalue=fread(TrQp[0],sizeof(double),nr*nQ,Aarf);
-        C_DGEMM('N','T',nb,nr,nQ,2.0,RbDp[0],nQ,TrQp[0],nQ,0.0,T1Brp[0],nr);
-        for (size_t b = 0; b < nb; b++) {
-            fseek(WBarf,nB*na*nr*sizeof(double) + b*na*nr*sizeof(double) + a*nr*sizeof(double),SEEK_SET);
-            fwrite(T1Brp[b],sizeof(double),nr,WBarf);
+
+    long int max_b = (doubles_ - nr * (long int) nQ) / (na * (long int) nr);
+    max_b = (max_b > nb ? nb : max_b);
+    if (max_b < 1L) {
+        throw PSIEXCEPTION("Too little memory for FISAPT::find");
+    }
+    std::shared_ptr<Matrix> T1Bar(new Matrix("T1Bar",max_b,na*(size_t)nr));
+    double** T1Barp = T1Bar->pointer();
+
+    for (size_t bstart = 0; bstart < nb; bstart += max_b) {
+        size_t nbblock = (bstart + max_b >= nb ? nb - bstart : max_b);
+        fseek(Aarf,0L,SEEK_SET);
+        for (size_t a = 0; a < na; a++) {
+            size_t statusvalue=fread(TrQp[0],sizeof(double),nr*nQ,Aarf);
+            C_DGEMM('N','T',nbblock,nr,nQ,2.0,RbDp[bstart],nQ,TrQp[0],nQ,0.0,&T1Barp[0][a*nr],na*nr);
         }
+        fseek(WBarf,nB*na*nr*sizeof(double) + bstart*na*nr*sizeof(double),SEEK_SET);
+        fwrite(T1Barp[0],sizeof(double),nbblock*na*nr,WBarf);
     }
+    T1Bar.reset();
+    TrQ.reset();
 
     // ==> Stack Variables <== //
 
@@ -3386,85 +3431,153 @@ void FISAPT::find()
     double sIndu_AB = 0.0;
     double sIndu_BA = 0.0;
 
+    // ==> Uncoupled Blocking <== //
+
+    // Sources are read a block at a time and worked on concurrently,
+    // each thread with its own amplitude buffers
+
+    bool do_ssapt = options_.get_bool("sSAPT0_SCALE");
+
+    int nT = 1;
+    #ifdef _OPENMP
+        nT = omp_get_max_threads();
+    #endif
+
+    double** UAp = Uocc_A->pointer();
+    double** UBp = Uocc_B->pointer();
+
+    std::vector<std::shared_ptr<Matrix> > xAT;
+    std::vector<std::shared_ptr<Matrix> > x2AT;
+    std::vector<std::shared_ptr<Matrix> > xBT;
+    std::vector<std::shared_ptr<Matrix> > x2BT;
+    for (int t = 0; t < nT; t++) {
+        xAT.push_back(std::shared_ptr<Matrix>(new Matrix("xA",na,nr)));
+        x2AT.push_back(std::shared_ptr<Matrix>(new Matrix("x2A",na,nr)));
+        xBT.push_back(std::shared_ptr<Matrix>(new Matrix("xB",nb,ns)));
+        x2BT.push_back(std::shared_ptr<Matrix>(new Matrix("x2B",nb,ns)));
+    }
+
+    long int rem = doubles_ - 2L * nT * (na * (long int) nr + nb * (long int) ns);
+    long int max_B = rem / (na * (long int) nr);
+    long int max_A = rem / (nb * (long int) ns);
+    max_B = (max_B > nB + nb ? nB + nb : max_B);
+    max_A = (max_A > nA + na ? nA + na : max_A);
+    if (max_B < 1L || max_A < 1L) {
+        throw PSIEXCEPTION("Too little memory for FISAPT::find");
+    }
+
     // ==> A <- B Uncoupled <== //
 
+    std::shared_ptr<Matrix> wBblock(new Matrix("wB",max_B*na,nr));
+    double** wBblockp = wBblock->pointer();
+
     fseek(WBarf,0L,SEEK_SET);
-    for (int B = 0; B < nB + nb; B++) {
+    for (int Bstart = 0; Bstart < nB + nb; Bstart += max_B) {
+        int nBblock = (Bstart + max_B >= nB + nb ? nB + nb - Bstart : max_B);
 
-        // ESP
-        size_t statusvalue=fread(wBp[0],sizeof(double),na*nr,WBarf);
+        // ESPs
+        size_t statusvalue=fread(wBblockp[0],sizeof(double),nBblock*(size_t)na*nr,WBarf);
 
-        // Uncoupled amplitude
-        for (int a = 0; a < na; a++) {
-            for (int r = 0; r < nr; r++) {
-                xAp[a][r] = wBp[a][r] / (eap[a] - erp[r]);
-            }
-        }
+        #pragma omp parallel for schedule(dynamic) reduction(+: Ind20u_AB, ExchInd20u_AB, sExchInd20u_AB, sIndu_AB, Indu_AB)
+        for (int B2 = 0; B2 < nBblock; B2++) {
+            int B = Bstart + B2;
 
-        // Backtransform the amplitude to LO
-        std::shared_ptr<Matrix> x2A = Matrix::doublet(Uocc_A,xA,true,false);
-        double** x2Ap = x2A->pointer();
+            int thread = 0;
+            #ifdef _OPENMP
+                thread = omp_get_thread_num();
+            #endif
 
-        // Zip up the Ind20 contributions
-        for (int a = 0; a < na; a++) {
-            double Jval = 2.0 * C_DDOT(nr,x2Ap[a],1,wBTp[a],1);
-            double Kval = 2.0 * C_DDOT(nr,x2Ap[a],1,uBTp[a],1);
-            Ind20u_AB_termsp[a][B] = Jval;
-            Ind20u_AB += Jval;
-            ExchInd20u_AB_termsp[a][B] = Kval;
-            ExchInd20u_AB += Kval;
-            if (options_.get_bool("sSAPT0_SCALE")) {
-                sExchInd20u_AB_termsp[a][B] = Kval;
-                sExchInd20u_AB += Kval;
-                sIndu_AB_termsp[a][B] = Jval + Kval;
-                sIndu_AB += Jval + Kval;
+            double** wBp2 = &wBblockp[B2*(size_t)na];
+            double** xAp2 = xAT[thread]->pointer();
+            double** x2Ap = x2AT[thread]->pointer();
+
+            // Uncoupled amplitude
+            for (int a = 0; a < na; a++) {
+                for (int r = 0; r < nr; r++) {
+                    xAp2[a][r] = wBp2[a][r] / (eap[a] - erp[r]);
+                }
             }
 
-            Indu_AB_termsp[a][B] = Jval + Kval;
-            Indu_AB += Jval + Kval;
-        }
+            // Backtransform the amplitude to LO
+            C_DGEMM('T','N',na,nr,na,1.0,UAp[0],na,xAp2[0],nr,0.0,x2Ap[0],nr);
 
+            // Zip up the Ind20 contributions
+            for (int a = 0; a < na; a++) {
+                double Jval = 2.0 * C_DDOT(nr,x2Ap[a],1,wBTp[a],1);
+                double Kval = 2.0 * C_DDOT(nr,x2Ap[a],1,uBTp[a],1);
+                Ind20u_AB_termsp[a][B] = Jval;
+                Ind20u_AB += Jval;
+                ExchInd20u_AB_termsp[a][B] = Kval;
+                ExchInd20u_AB += Kval;
+                if (do_ssapt) {
+                    sExchInd20u_AB_termsp[a][B] = Kval;
+                    sExchInd20u_AB += Kval;
+                    sIndu_AB_termsp[a][B] = Jval + Kval;
+                    sIndu_AB += Jval + Kval;
+                }
+
+                Indu_AB_termsp[a][B] = Jval + Kval;
+                Indu_AB += Jval + Kval;
+            }
+        }
     }
+    wBblock.reset();
 
     // ==> B <- A Uncoupled <== //
 
+    std::shared_ptr<Matrix> wAblock(new Matrix("wA",max_A*nb,ns));
+    double** wAblockp = wAblock->pointer();
+
     fseek(WAbsf,0L,SEEK_SET);
-    for (int A = 0; A < nA + na; A++) {
+    for (int Astart = 0; Astart < nA + na; Astart += max_A) {
+        int nAblock = (Astart + max_A >= nA + na ? nA + na - Astart : max_A);
 
-        // ESP
-        size_t statusvalue=fread(wAp[0],sizeof(double),nb*ns,WAbsf);
+        // ESPs
+        size_t statusvalue=fread(wAblockp[0],sizeof(double),nAblock*(size_t)nb*ns,WAbsf);
 
-        // Uncoupled amplitude
-        for (int b = 0; b < nb; b++) {
-            for (int s = 0; s < ns; s++) {
-                xBp[b][s] = wAp[b][s] / (ebp[b] - esp[s]);
+        #pragma omp parallel for schedule(dynamic) reduction(+: Ind20u_BA, ExchInd20u_BA, sExchInd20u_BA, sIndu_BA, Indu_BA)
+        for (int A2 = 0; A2 < nAblock; A2++) {
+            int A = Astart + A2;
+
+            int thread = 0;
+            #ifdef _OPENMP
+                thread = omp_get_thread_num();
+            #endif
+
+            double** wAp2 = &wAblockp[A2*(size_t)nb];
+            double** xBp2 = xBT[thread]->pointer();
+            double** x2Bp = x2BT[thread]->pointer();
+
+            // Uncoupled amplitude
+            for (int b = 0; b < nb; b++) {
+                for (int s = 0; s < ns; s++) {
+                    xBp2[b][s] = wAp2[b][s] / (ebp[b] - esp[s]);
+                }
             }
-        }
 
-        // Backtransform the amplitude to LO
-        std::shared_ptr<Matrix> x2B = Matrix::doublet(Uocc_B,xB,true,false);
-        double** x2Bp = x2B->pointer();
+            // Backtransform the amplitude to LO
+            C_DGEMM('T','N',nb,ns,nb,1.0,UBp[0],nb,xBp2[0],ns,0.0,x2Bp[0],ns);
 
-        // Zip up the Ind20 contributions
-        for (int b = 0; b < nb; b++) {
-            double Jval = 2.0 * C_DDOT(ns,x2Bp[b],1,wATp[b],1);
-            double Kval = 2.0 * C_DDOT(ns,x2Bp[b],1,uATp[b],1);
-            Ind20u_BA_termsp[A][b] = Jval;
-            Ind20u_BA += Jval;
-            ExchInd20u_BA_termsp[A][b] = Kval;
-            ExchInd20u_BA += Kval;
-            if (options_.get_bool("sSAPT0_SCALE")) {
-                sExchInd20u_BA_termsp[A][b] = Kval;
-                sExchInd20u_BA += Kval;
-                sIndu_BA_termsp[A][b] = Jval + Kval;
-                sIndu_BA += Jval + Kval;
+            // Zip up the Ind20 contributions
+            for (int b = 0; b < nb; b++) {
+                double Jval = 2.0 * C_DDOT(ns,x2Bp[b],1,wATp[b],1);
+                double Kval = 2.0 * C_DDOT(ns,x2Bp[b],1,uATp[b],1);
+                Ind20u_BA_termsp[A][b] = Jval;
+                Ind20u_BA += Jval;
+                ExchInd20u_BA_termsp[A][b] = Kval;
+                ExchInd20u_BA += Kval;
+                if (do_ssapt) {
+                    sExchInd20u_BA_termsp[A][b] = Kval;
+                    sExchInd20u_BA += Kval;
+                    sIndu_BA_termsp[A][b] = Jval + Kval;
+                    sIndu_BA += Jval + Kval;
+                }
+                Indu_BA_termsp[A][b] = Jval + Kval;
+                Indu_BA += Jval + Kval;
             }
-            Indu_BA_termsp[A][b] = Jval + Kval;
-            Indu_BA += Jval + Kval;
         }
-
     }
-
+    wAblock.reset();
 
     double Ind20u = Ind20u_AB + Ind20u_BA;
     outfile->Printf("    Ind20,u (A<-B)      = %18.12lf [Eh]\n",Ind20u_AB);
@@ -4022,8 +4135,17 @@ void FISAPT::fdisp()
 
     // => Blocking <= //
 
+    // Each task covers one r and a chunk of nsb s, so that the amplitudes
+    // and their LO transforms are formed by GEMMs of useful size
+    long int nsb = nQ / (nb > 0 ? nb : 1);
+    nsb = (nsb > ns ? ns : nsb);
+    long int max_nsb = doubles_ / (16L * nT * na * nb);
+    nsb = (nsb > max_nsb ? max_nsb : nsb);
+    nsb = (nsb < 1L ? 1L : nsb);
+
     long int overhead = 0L;
-    overhead += 5L * nT * na * nb;
+    overhead += 4L * nT * na * nb * nsb;
+    overhead += 3L * nT * na * nb;
     overhead += 2L * na * ns + 2L * nb * nr + 2L * na * nr + 2L * nb * ns;
     long int rem = doubles_ - overhead;
 
@@ -4053,17 +4175,17 @@ void FISAPT::fdisp()
 
     // => Thread Work Arrays <= //
 
-    std::vector<std::shared_ptr<Matrix> > Tab;
-    std::vector<std::shared_ptr<Matrix> > Vab;
-    std::vector<std::shared_ptr<Matrix> > T2ab;
-    std::vector<std::shared_ptr<Matrix> > V2ab;
-    std::vector<std::shared_ptr<Matrix> > Iab;
+    // All are (a,s,b) over one s chunk, except for the (s,a,b) exchange
+    // intermediate, which is staged in Iasb
+    std::vector<std::shared_ptr<Matrix> > Tasb;
+    std::vector<std::shared_ptr<Matrix> > Vasb;
+    std::vector<std::shared_ptr<Matrix> > T2asb;
+    std::vector<std::shared_ptr<Matrix> > Iasb;
     for (int t = 0; t < nT; t++) {
-        Tab.push_back(std::shared_ptr<Matrix>(new Matrix("Tab",na,nb)));
-        Vab.push_back(std::shared_ptr<Matrix>(new Matrix("Vab",na,nb)));
-        T2ab.push_back(std::shared_ptr<Matrix>(new Matrix("T2ab",na,nb)));
-        V2ab.push_back(std::shared_ptr<Matrix>(new Matrix("V2ab",na,nb)));
-        Iab.push_back(std::shared_ptr<Matrix>(new Matrix("Iab",na,nb)));
+        Tasb.push_back(std::shared_ptr<Matrix>(new Matrix("Tasb",na,nsb*nb)));
+        Vasb.push_back(std::shared_ptr<Matrix>(new Matrix("Vasb",na,nsb*nb)));
+        T2asb.push_back(std::shared_ptr<Matrix>(new Matrix("T2asb",na,nsb*nb)));
+        Iasb.push_back(std::shared_ptr<Matrix>(new Matrix("Iasb",na,nsb*nb)));
     }
 
     // => Pointers <= //
@@ -4183,8 +4305,9 @@ void FISAPT::fdisp()
 
     // ==> Master Loop <== //
 
+    bool do_ssapt = options_.get_bool("sSAPT0_SCALE");
     double scale = 1.0;
-    if (options_.get_bool("sSAPT0_SCALE")) {
+    if (do_ssapt) {
         scale = sSAPT0_scale_;
     }
 
@@ -4212,12 +4335,15 @@ void FISAPT::fdisp()
             statusvalue=fread(Casp[0],sizeof(double),nsblock*naQ,Casf);
             statusvalue=fread(Dbsp[0],sizeof(double),nsblock*nbQ,Dbsf);
 
-            long int nrs = nrblock * nsblock;
+            long int nschunk = (nsblock + nsb - 1) / nsb;
+            long int ntask = nrblock * nschunk;
 
             #pragma omp parallel for schedule(dynamic) reduction(+: Disp20, ExchDisp20, sExchDisp20)
-            for (long int rs = 0L; rs < nrs; rs++) {
-                int r = rs / nsblock;
-                int s = rs % nsblock;
+            for (long int task = 0L; task < ntask; task++) {
+                int r = task / nschunk;
+                int s0 = (task % nschunk) * nsb;
+                int nsc = (s0 + nsb >= nsblock ? nsblock - s0 : nsb);
+                int nsbc = nsc * nb;
 
                 int thread = 0;
                 #ifdef _OPENMP
@@ -4228,30 +4354,39 @@ void FISAPT::fdisp()
                 double** E_exch_disp20Tp = E_exch_disp20_threads[thread]->pointer();
                 double** sE_exch_disp20Tp = sE_exch_disp20_threads[thread]->pointer();
 
-                double** Tabp  = Tab[thread]->pointer();
-                double** Vabp  = Vab[thread]->pointer();
-                double** T2abp = T2ab[thread]->pointer();
-                double** V2abp = V2ab[thread]->pointer();
-                double** Iabp  = Iab[thread]->pointer();
+                // Row strides below are nsbc, the packed width of this chunk
+                double* Tp  = Tasb[thread]->pointer()[0];
+                double* Vp  = Vasb[thread]->pointer()[0];
+                double* T2p = T2asb[thread]->pointer()[0];
+                double* Ip  = Iasb[thread]->pointer()[0];
 
                 // => Amplitudes, Disp20 <= //
 
-                C_DGEMM('N','T',na,nb,nQ,1.0,Aarp[(r)*na],nQ,Absp[(s)*nb],nQ,0.0,Vabp[0],nb);
+                C_DGEMM('N','T',na,nsbc,nQ,1.0,Aarp[(r)*na],nQ,Absp[(s0)*nb],nQ,0.0,Vp,nsbc);
                 for (int a = 0; a < na; a++) {
-                    for (int b = 0; b < nb; b++) {
-                        Tabp[a][b] = Vabp[a][b] / (eap[a] + ebp[b] - erp[r + rstart] - esp[s + sstart]);
+                    for (int s = 0; s < nsc; s++) {
+                        double* Vsp = &Vp[a*(size_t)nsbc + s*nb];
+                        double* Tsp = &Tp[a*(size_t)nsbc + s*nb];
+                        double eas = eap[a] - erp[r + rstart] - esp[s0 + s + sstart];
+                        for (int b = 0; b < nb; b++) {
+                            Tsp[b] = Vsp[b] / (eas + ebp[b]);
+                        }
                     }
                 }
 
-                C_DGEMM('N','N',na,nb,nb,1.0,Tabp[0],nb,UBp[0],nb,0.0,Iabp[0],nb);
-                C_DGEMM('T','N',na,nb,na,1.0,UAp[0],na,Iabp[0],nb,0.0,T2abp[0],nb);
-                C_DGEMM('N','N',na,nb,nb,1.0,Vabp[0],nb,UBp[0],nb,0.0,Iabp[0],nb);
-                C_DGEMM('T','N',na,nb,na,1.0,UAp[0],na,Iabp[0],nb,0.0,V2abp[0],nb);
+                C_DGEMM('N','N',na*nsc,nb,nb,1.0,Tp,nb,UBp[0],nb,0.0,Ip,nb);
+                C_DGEMM('T','N',na,nsbc,na,1.0,UAp[0],na,Ip,nsbc,0.0,T2p,nsbc);
+                C_DGEMM('N','N',na*nsc,nb,nb,1.0,Vp,nb,UBp[0],nb,0.0,Ip,nb);
+                C_DGEMM('T','N',na,nsbc,na,1.0,UAp[0],na,Ip,nsbc,0.0,Tp,nsbc);
 
                 for (int a = 0; a < na; a++) {
-                    for (int b = 0; b < nb; b++) {
-                        E_disp20Tp[a][b] += 4.0 * T2abp[a][b] * V2abp[a][b];
-                        Disp20 += 4.0 * T2abp[a][b] * V2abp[a][b];
+                    for (int s = 0; s < nsc; s++) {
+                        double* T2sp = &T2p[a*(size_t)nsbc + s*nb];
+                        double* V2sp = &Tp[a*(size_t)nsbc + s*nb];
+                        for (int b = 0; b < nb; b++) {
+                            E_disp20Tp[a][b] += 4.0 * T2sp[b] * V2sp[b];
+                            Disp20 += 4.0 * T2sp[b] * V2sp[b];
+                        }
                     }
                 }
 
@@ -4259,27 +4394,45 @@ void FISAPT::fdisp()
 
                 // > Q1-Q3 < //
 
-                C_DGEMM('N','T',na,nb,nQ,1.0,Basp[(s)*na],nQ,Bbrp[(r)*nb],nQ,0.0,Vabp[0],nb);
-                C_DGEMM('N','T',na,nb,nQ,1.0,Casp[(s)*na],nQ,Cbrp[(r)*nb],nQ,1.0,Vabp[0],nb);
-                C_DGEMM('N','T',na,nb,nQ,1.0,Aarp[(r)*na],nQ,Dbsp[(s)*nb],nQ,1.0,Vabp[0],nb);
-                C_DGEMM('N','T',na,nb,nQ,1.0,Darp[(r)*na],nQ,Absp[(s)*nb],nQ,1.0,Vabp[0],nb);
+                C_DGEMM('N','T',na,nsbc,nQ,1.0,Aarp[(r)*na],nQ,Dbsp[(s0)*nb],nQ,0.0,Vp,nsbc);
+                C_DGEMM('N','T',na,nsbc,nQ,1.0,Darp[(r)*na],nQ,Absp[(s0)*nb],nQ,1.0,Vp,nsbc);
+                C_DGEMM('N','T',nsc*na,nb,nQ,1.0,Basp[(s0)*na],nQ,Bbrp[(r)*nb],nQ,0.0,Ip,nb);
+                C_DGEMM('N','T',nsc*na,nb,nQ,1.0,Casp[(s0)*na],nQ,Cbrp[(r)*nb],nQ,1.0,Ip,nb);
 
                 // > V,J,K < //
 
-                C_DGER(na,nb,1.0,&Sasp[0][s + sstart], ns,&Qbrp[0][r + rstart], nr,Vabp[0],nb);
-                C_DGER(na,nb,1.0,&Qasp[0][s + sstart], ns,&Sbrp[0][r + rstart], nr,Vabp[0],nb);
-                C_DGER(na,nb,1.0,&Qarp[0][r + rstart], nr,&SAbsp[0][s + sstart],ns,Vabp[0],nb);
-                C_DGER(na,nb,1.0,&SBarp[0][r + rstart],nr,&Qbsp[0][s + sstart], ns,Vabp[0],nb);
+                for (int a = 0; a < na; a++) {
+                    for (int s = 0; s < nsc; s++) {
+                        int sabs = s0 + s + sstart;
+                        double* Wsp = &Vp[a*(size_t)nsbc + s*nb];
+                        double* Xsp = &Ip[(s*(size_t)na + a)*nb];
+                        double Sas_val = Sasp[a][sabs];
+                        double Qas_val = Qasp[a][sabs];
+                        double Qar_val = Qarp[a][r + rstart];
+                        double SBar_val = SBarp[a][r + rstart];
+                        for (int b = 0; b < nb; b++) {
+                            Wsp[b] += Xsp[b] +
+                                Sas_val * Qbrp[b][r + rstart] +
+                                Qas_val * Sbrp[b][r + rstart] +
+                                Qar_val * SAbsp[b][sabs] +
+                                SBar_val * Qbsp[b][sabs];
+                        }
+                    }
+                }
 
-                C_DGEMM('N','N',na,nb,nb,1.0,Vabp[0],nb,UBp[0],nb,0.0,Iabp[0],nb);
-                C_DGEMM('T','N',na,nb,na,1.0,UAp[0],na,Iabp[0],nb,0.0,V2abp[0],nb);
+                C_DGEMM('N','N',na*nsc,nb,nb,1.0,Vp,nb,UBp[0],nb,0.0,Ip,nb);
+                C_DGEMM('T','N',na,nsbc,na,1.0,UAp[0],na,Ip,nsbc,0.0,Tp,nsbc);
 
                 for (int a = 0; a < na; a++) {
-                    for (int b = 0; b < nb; b++) {
-                        E_exch_disp20Tp[a][b] -= 2.0 * T2abp[a][b] * V2abp[a][b];
-                        if (options_.get_bool("sSAPT0_SCALE")) sE_exch_disp20Tp[a][b] -= scale * 2.0 * T2abp[a][b] * V2abp[a][b];
-                        ExchDisp20 -= 2.0 * T2abp[a][b] * V2abp[a][b];
-                        sExchDisp20 -= scale * 2.0 * T2abp[a][b] * V2abp[a][b];
+                    for (int s = 0; s < nsc; s++) {
+                        double* T2sp = &T2p[a*(size_t)nsbc + s*nb];
+                        double* V2sp = &Tp[a*(size_t)nsbc + s*nb];
+                        for (int b = 0; b < nb; b++) {
+                            E_exch_disp20Tp[a][b] -= 2.0 * T2sp[b] * V2sp[b];
+                            if (do_ssapt) sE_exch_disp20Tp[a][b] -= scale * 2.0 * T2sp[b] * V2sp[b];
+                            ExchDisp20 -= 2.0 * T2sp[b] * V2sp[b];
+                            sExchDisp20 -= scale * 2.0 * T2sp[b] * V2sp[b];
+                        }
                     }
                 }
             }
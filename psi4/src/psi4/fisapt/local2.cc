@@ -259,11 +259,33 @@ std::map<std::string, std::shared_ptr<Matrix> > IBOLocalizer2::localize_task(
 
     if (power != 2 && power != 4) throw PSIEXCEPTION("IAO: Invalid metric power.");
 
+    // Group the rotations into rounds of disjoint (i,j) pairs, which touch
+    // different rows of L and U and may therefore be applied concurrently
+    std::vector<std::vector<int> > rounds;
+    std::vector<std::vector<bool> > round_used;
+    for (int ind = 0; ind < rot_inds.size(); ind++) {
+        int i = rot_inds[ind].first;
+        int j = rot_inds[ind].second;
+        int round = 0;
+        for (; round < rounds.size(); round++) {
+            if (!round_used[round][i] && !round_used[round][j]) break;
+        }
+        if (round == rounds.size()) {
+            rounds.push_back(std::vector<int>());
+            round_used.push_back(std::vector<bool>(nocc, false));
+        }
+        rounds[round].push_back(ind);
+        round_used[round][i] = true;
+        round_used[round][j] = true;
+    }
+    round_used.clear();
+
     outfile->Printf( "    @IBO %4s: %24s %14s\n", "Iter", "Metric", "Gradient");
 
     for (int iter = 1; iter <= maxiter; iter++) {
 
         double metric = 0.0;
+        #pragma omp parallel for schedule(dynamic) reduction(+: metric)
         for (int i = 0; i < nocc; i++) {
             for (int A = 0; A < minao_inds.size(); A++) {
                 double Lval = 0.0;
@@ -277,40 +299,45 @@ std::map<std::string, std::shared_ptr<Matrix> > IBOLocalizer2::localize_task(
         metric = pow(metric, 1.0 / power);
 
         double gradient = 0.0;
-        for (int ind = 0; ind < rot_inds.size(); ind++) {
-            int i = rot_inds[ind].first;
-            int j = rot_inds[ind].second;
-
-            double Aij = 0.0;
-            double Bij = 0.0;
-            for (int A = 0; A < minao_inds.size(); A++) {
-                double Qii = 0.0;
-                double Qij = 0.0;
-                double Qjj = 0.0;
-                for (int m = 0; m < minao_inds[A].size(); m++) {
-                    int mind = minao_inds[A][m];
-                    Qii += Lp[i][mind] * Lp[i][mind];
-                    Qij += Lp[i][mind] * Lp[j][mind];
-                    Qjj += Lp[j][mind] * Lp[j][mind];
-                }
-                if (power == 2) {
-                    Aij += 4.0 * Qij * Qij - (Qii - Qjj) * (Qii - Qjj);
-                    Bij += 4.0 * Qij * (Qii - Qjj);
-                } else {
-                    Aij += (-1.0) * Qii * Qii * Qii * Qii - Qjj * Qjj * Qjj * Qjj + 6.0 * (Qii * Qii + Qjj * Qjj) * Qij * Qij + Qii * Qii * Qii * Qjj + Qii * Qjj * Qjj * Qjj;
-                    Bij += 4.0 * Qij * (Qii * Qii * Qii - Qjj * Qjj * Qjj);
+        for (int round = 0; round < rounds.size(); round++) {
+            const std::vector<int>& pairs = rounds[round];
+            int npairs = pairs.size();
+            #pragma omp parallel for schedule(dynamic) reduction(+: gradient)
+            for (int k = 0; k < npairs; k++) {
+                int i = rot_inds[pairs[k]].first;
+                int j = rot_inds[pairs[k]].second;
+
+                double Aij = 0.0;
+                double Bij = 0.0;
+                for (int A = 0; A < minao_inds.size(); A++) {
+                    double Qii = 0.0;
+                    double Qij = 0.0;
+                    double Qjj = 0.0;
+                    for (int m = 0; m < minao_inds[A].size(); m++) {
+                        int mind = minao_inds[A][m];
+                        Qii += Lp[i][mind] * Lp[i][mind];
+                        Qij += Lp[i][mind] * Lp[j][mind];
+                        Qjj += Lp[j][mind] * Lp[j][mind];
+                    }
+                    if (power == 2) {
+                        Aij += 4.0 * Qij * Qij - (Qii - Qjj) * (Qii - Qjj);
+                        Bij += 4.0 * Qij * (Qii - Qjj);
+                    } else {
+                        Aij += (-1.0) * Qii * Qii * Qii * Qii - Qjj * Qjj * Qjj * Qjj + 6.0 * (Qii * Qii + Qjj * Qjj) * Qij * Qij + Qii * Qii * Qii * Qjj + Qii * Qjj * Qjj * Qjj;
+                        Bij += 4.0 * Qij * (Qii * Qii * Qii - Qjj * Qjj * Qjj);
+                    }
                 }
-            }
 
-            double phi = 0.25 * atan2(Bij, -Aij);
-            double c = cos(phi);
-            double s = sin(phi);
+                double phi = 0.25 * atan2(Bij, -Aij);
+                double c = cos(phi);
+                double s = sin(phi);
 
-            C_DROT(nmin,Lp[i],1,Lp[j],1,c,s);
-            C_DROT(nocc,Up[i],1,Up[j],1,c,s);
+                C_DROT(nmin,Lp[i],1,Lp[j],1,c,s);
+                C_DROT(nocc,Up[i],1,Up[j],1,c,s);
 
-            gradient += Bij * Bij;
+                gradient += Bij * Bij;
 
+            }
         }
         gradient = sqrt(gradient);
 
@@ -740,10 +740,15 @@ void CoupledCluster::AllocateMemory() {
     }
     if (options_.get_bool("COMPUTE_TRIPLES") || options_.get_bool("COMPUTE_MP4_TRIPLES")){
        double tempmem = 8.*(2L*o*o*v*v+o*o*o*v+o*v+3L*v*v*v*nthreads);
-       if (tempmem > memory) {
+       // the regular (t) runs fewer concurrent ijk tasks when not all fit
+       double minmem = 8.*(2L*o*o*v*v+o*o*o*v+o*v+3L*v*v*v);
+       if (minmem > memory) {
           outfile->Printf("\n        <<< warning! >>> switched to low-memory (t) algorithm\n\n");
+       }else if (tempmem > memory) {
+          outfile->Printf("\n        <<< warning! >>> fewer threads for (t) due to memory limitations\n\n");
+          tempmem = memory;
        }
-       if (tempmem > memory || options_.get_bool("TRIPLES_LOW_MEMORY")){
+       if (minmem > memory || options_.get_bool("TRIPLES_LOW_MEMORY")){
           isLowMemory = true;
           tempmem = 8.*(2L*o*o*v*v+o*o*o*v+o*v+5L*o*o*o*nthreads);
        }
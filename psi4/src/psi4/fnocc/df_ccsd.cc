@@ -626,10 +626,14 @@ void DFCoupledCluster::AllocateMemory() {
       outfile->Printf("\n");
       outfile->Printf("        (T) part (regular algorithm):    %9.2lf mb\n",
           mem_t/1024./1024.);
-      if (mem_t > memory) {
+      // the regular (t) runs fewer concurrent ijk tasks when not all fit
+      double min_t = 8.*(2L*o*o*v*v+1L*o*o*o*v+o*v+3L*v*v*v);
+      if (min_t > memory) {
           outfile->Printf("        <<< warning! >>> switched to low-memory (t) algorithm\n\n");
+      }else if (mem_t > memory) {
+          outfile->Printf("        <<< warning! >>> fewer threads for (t) due to memory limitations\n\n");
       }
-      if (mem_t > memory || options_.get_bool("TRIPLES_LOW_MEMORY")){
+      if (min_t > memory || options_.get_bool("TRIPLES_LOW_MEMORY")){
          isLowMemory = true;
          mem_t = 8.*(2L*o*o*v*v+o*o*o*v+o*v+5L*o*o*o*nthreads);
          outfile->Printf("        (T) part (low-memory alg.):      %9.2lf mb\n\n",mem_t/1024./1024.);
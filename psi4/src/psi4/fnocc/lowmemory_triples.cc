@@ -29,6 +29,7 @@
 #include"blas.h"
 #include "psi4/libmints/wavefunction.h"
 #include"psi4/libqt/qt.h"
+#include "psi4/libparallel/task_queue.h"
 #ifdef _OPENMP
    #include<omp.h>
 #endif
@@ -247,18 +248,25 @@ PsiReturnType CoupledCluster::lowmemory_triples() {
       mypsio[i]->open(PSIF_DCC_ABCI4,PSIO_OPEN_OLD);
   }
 
+  // every abc costs the same; the queue still evens out the tail by stealing
+  std::vector<double> cost(nabc,1.0);
+  TaskQueue tasks(cost,nthreads);
+  long int ndone = 0;
+
   if (threaded){
-     #pragma omp parallel for schedule (dynamic) num_threads(nthreads)
-     for (long int ind=0; ind<nabc; ind++){
+     #pragma omp parallel num_threads(nthreads)
+     {
+     int thread = 0;
+     #ifdef _OPENMP
+         thread = omp_get_thread_num();
+     #endif
+
+     size_t ind;
+     while (tasks.next(thread,ind)){
          long int a = abc[ind][0];
          long int b = abc[ind][1];
          long int c = abc[ind][2];
 
-         int thread = 0;
-         #ifdef _OPENMP
-             thread = omp_get_thread_num();
-         #endif
-
          //std::shared_ptr<PSIO> mypsio(new PSIO());
          //mypsio->open(PSIF_DCC_ABCI4,PSIO_OPEN_OLD);
          psio_address addr = psio_get_address(PSIO_ZERO,(b*vvo+c*vo)*sizeof(double));
@@ -458,26 +466,30 @@ PsiReturnType CoupledCluster::lowmemory_triples() {
          etrip[thread] += tripval*abcfac;
 
          // print out update
+         long int done;
+         #pragma omp atomic capture
+         done = ++ndone;
          if (thread==0){
             int print = 0;
             stop = time(NULL);
-            if ((double)ind/nabc >= 0.1 && !pct10){      pct10 = 1; print=1;}
-            else if ((double)ind/nabc >= 0.2 && !pct20){ pct20 = 1; print=1;}
-            else if ((double)ind/nabc >= 0.3 && !pct30){ pct30 = 1; print=1;}
-            else if ((double)ind/nabc >= 0.4 && !pct40){ pct40 = 1; print=1;}
-            else if ((double)ind/nabc >= 0.5 && !pct50){ pct50 = 1; print=1;}
-            else if ((double)ind/nabc >= 0.6 && !pct60){ pct60 = 1; print=1;}
-            else if ((double)ind/nabc >= 0.7 && !pct70){ pct70 = 1; print=1;}
-            else if ((double)ind/nabc >= 0.8 && !pct80){ pct80 = 1; print=1;}
-            else if ((double)ind/nabc >= 0.9 && !pct90){ pct90 = 1; print=1;}
+            if ((double)done/nabc >= 0.1 && !pct10){      pct10 = 1; print=1;}
+            else if ((double)done/nabc >= 0.2 && !pct20){ pct20 = 1; print=1;}
+            else if ((double)done/nabc >= 0.3 && !pct30){ pct30 = 1; print=1;}
+            else if ((double)done/nabc >= 0.4 && !pct40){ pct40 = 1; print=1;}
+            else if ((double)done/nabc >= 0.5 && !pct50){ pct50 = 1; print=1;}
+            else if ((double)done/nabc >= 0.6 && !pct60){ pct60 = 1; print=1;}
+            else if ((double)done/nabc >= 0.7 && !pct70){ pct70 = 1; print=1;}
+            else if ((double)done/nabc >= 0.8 && !pct80){ pct80 = 1; print=1;}
+            else if ((double)done/nabc >= 0.9 && !pct90){ pct90 = 1; print=1;}
             if (print){
-               outfile->Printf("              %3.1lf  %8d s\n",100.0*ind/nabc,(int)stop-(int)start);
+               outfile->Printf("              %3.1lf  %8d s\n",100.0*done/nabc,(int)stop-(int)start);
 
             }
          }
          //mypsio->close(PSIF_DCC_ABCI4,1);
          //mypsio.reset();
      }
+     }
   }
   else{
      outfile->Printf("on the to do pile!\n");
@@ -29,6 +29,7 @@
 #include"blas.h"
 #include "psi4/libmints/wavefunction.h"
 #include"psi4/libqt/qt.h"
+#include "psi4/libparallel/task_queue.h"
 #ifdef _OPENMP
    #include<omp.h>
 #endif
@@ -94,10 +95,23 @@ PsiReturnType CoupledCluster::triples(){
   // CDS // memory -= 8L*(2L*o*o*v*v+o*o*o*v+o*v+3L*nthreads*v*v*v);
   long int memory_reqd = 8L*(2L*vvoo+vooo+vo+3L*nthreads*vvv);
 
+  // each concurrent ijk task needs three v^3 buffers: run as many as fit ...
+  long int memory_task = 8L*3L*vvv;
+  long int memory_base = memory_reqd - nthreads*memory_task;
+  if (memory_reqd > memory) {
+     long int ntasks = (memory - memory_base) / memory_task;
+     nthreads = ntasks < 1 ? 1 : ntasks;
+     memory_reqd = memory_base + nthreads*memory_task;
+  }
+  // ... and hold as many occupied slices of (ab|ci) in core as the rest allows
+  long int nincore = memory > memory_reqd ? (memory - memory_reqd) / (8L*vvv) : 0L;
+  if (nincore > o) nincore = o;
+
   outfile->Printf("        num_threads:              %9i\n",nthreads);
   outfile->Printf("        available memory:      %9.2lf mb\n",(double)memory/1024./1024.);
   outfile->Printf("        memory requirements:   %9.2lf mb\n",
            (double)memory_reqd/1024./1024.);
+  outfile->Printf("        (ab|ci) slices in core:   %9ld of %ld\n",nincore,o);
   outfile->Printf("\n");
 
 
@@ -143,6 +157,15 @@ PsiReturnType CoupledCluster::triples(){
   psio->read_entry(PSIF_DCC_IJAK,"E2ijak",(char*)&E2ijak[0],vooo*sizeof(double));
   psio->close(PSIF_DCC_IJAK,1);
 
+  double *E2abci_incore = NULL;
+  if (nincore > 0) {
+     E2abci_incore = (double*)malloc(nincore*vvv*sizeof(double));
+     psio->open(PSIF_DCC_ABCI,PSIO_OPEN_OLD);
+     psio_address addr = PSIO_ZERO;
+     psio->read(PSIF_DCC_ABCI,"E2abci",(char*)&E2abci_incore[0],nincore*vvv*sizeof(double),addr,&addr);
+     psio->close(PSIF_DCC_ABCI,1);
+  }
+
   double *tempt = (double*)malloc(vvoo*sizeof(double));
 
   // first-order amplitudes for mp4
@@ -173,30 +196,41 @@ PsiReturnType CoupledCluster::triples(){
   int pct10,pct20,pct30,pct40,pct50,pct60,pct70,pct80,pct90;
   pct10=pct20=pct30=pct40=pct50=pct60=pct70=pct80=pct90=0;
 
-  /**
-    *  if there is enough memory to explicitly thread, do so
-    */
-  #pragma omp parallel for schedule (dynamic) num_threads(nthreads)
+  // the flops are the same for every ijk; what differs is how many of
+  // its three (ab|ci) slices come from disk (a double read ~ 100 flops)
+  std::vector<double> cost(nijk);
   for (long int ind=0; ind<nijk; ind++){
+      cost[ind] = 12.0*v + 100.0*((ijk[ind][0]>=nincore)+(ijk[ind][1]>=nincore)+(ijk[ind][2]>=nincore));
+  }
+  TaskQueue tasks(cost,nthreads);
+  long int ndone = 0;
+
+  #pragma omp parallel num_threads(nthreads)
+  {
+  int thread = 0;
+  #ifdef _OPENMP
+      thread = omp_get_thread_num();
+  #endif
+
+  std::shared_ptr<PSIO> mypsio(new PSIO());
+  mypsio->open(PSIF_DCC_ABCI,PSIO_OPEN_OLD);
+
+  size_t ind;
+  while (tasks.next(thread,ind)){
       long int i = ijk[ind][0];
       long int j = ijk[ind][1];
       long int k = ijk[ind][2];
 
-      int thread = 0;
-      #ifdef _OPENMP
-          thread = omp_get_thread_num();
-      #endif
-
-      std::shared_ptr<PSIO> mypsio(new PSIO());
-      mypsio->open(PSIF_DCC_ABCI,PSIO_OPEN_OLD);
-
-      psio_address addr = psio_get_address(PSIO_ZERO,k*vvv*sizeof(double));
-      mypsio->read(PSIF_DCC_ABCI,"E2abci",(char*)&E2abci[thread][0],vvv*sizeof(double),addr,&addr);
-      F_DGEMM('t','t',vv,v,v,1.0,E2abci[thread],v,tempt+j*vvo+i*vv,v,0.0,Z[thread],v*v);
+      double *abci = k < nincore ? E2abci_incore+k*vvv : E2abci[thread];
+      if (k >= nincore) {
+         psio_address addr = psio_get_address(PSIO_ZERO,k*vvv*sizeof(double));
+         mypsio->read(PSIF_DCC_ABCI,"E2abci",(char*)&E2abci[thread][0],vvv*sizeof(double),addr,&addr);
+      }
+      F_DGEMM('t','t',vv,v,v,1.0,abci,v,tempt+j*vvo+i*vv,v,0.0,Z[thread],v*v);
       F_DGEMM('n','t',v,vv,o,-1.0,E2ijak+j*o*o*v+k*o*v,v,tempt+i*vvo,vv,1.0,Z[thread],v);
 
       //(ab)(ij)
-      F_DGEMM('t','t',vv,v,v,1.0,E2abci[thread],v,tempt+i*vvo+j*vv,v,0.0,Z2[thread],v*v);
+      F_DGEMM('t','t',vv,v,v,1.0,abci,v,tempt+i*vvo+j*vv,v,0.0,Z2[thread],v*v);
       F_DGEMM('n','t',v,vv,o,-1.0,E2ijak+i*o*o*v+k*o*v,v,tempt+j*vvo,vv,1.0,Z2[thread],v);
       for (long int a=0; a<v; a++){
           for (long int b=0; b<v; b++){
@@ -205,9 +239,12 @@ PsiReturnType CoupledCluster::triples(){
       }
 
       //(bc)(jk)
-      addr = psio_get_address(PSIO_ZERO,(long int)j*vvv*sizeof(double));
-      mypsio->read(PSIF_DCC_ABCI,"E2abci",(char*)&E2abci[thread][0],vvv*sizeof(double),addr,&addr);
-      F_DGEMM('t','t',vv,v,v,1.0,E2abci[thread],v,tempt+k*v*v*o+i*v*v,v,0.0,Z2[thread],v*v);
+      abci = j < nincore ? E2abci_incore+j*vvv : E2abci[thread];
+      if (j >= nincore) {
+         psio_address addr = psio_get_address(PSIO_ZERO,j*vvv*sizeof(double));
+         mypsio->read(PSIF_DCC_ABCI,"E2abci",(char*)&E2abci[thread][0],vvv*sizeof(double),addr,&addr);
+      }
+      F_DGEMM('t','t',vv,v,v,1.0,abci,v,tempt+k*v*v*o+i*v*v,v,0.0,Z2[thread],v*v);
       F_DGEMM('n','t',v,vv,o,-1.0,E2ijak+k*voo+j*vo,v,tempt+i*vvo,vv,1.0,Z2[thread],v);
       for (long int a=0; a<v; a++){
           for (long int b=0; b<v; b++){
@@ -216,7 +253,7 @@ PsiReturnType CoupledCluster::triples(){
       }
 
       //(ikj)(acb)
-      F_DGEMM('t','t',vv,v,v,1.0,E2abci[thread],v,tempt+i*vvo+k*vv,v,0.0,Z2[thread],vv);
+      F_DGEMM('t','t',vv,v,v,1.0,abci,v,tempt+i*vvo+k*vv,v,0.0,Z2[thread],vv);
       F_DGEMM('n','t',v,vv,o,-1.0,E2ijak+i*voo+j*vo,v,tempt+k*vvo,vv,1.0,Z2[thread],v);
       for (long int a=0; a<v; a++){
           for (long int b=0; b<v; b++){
@@ -225,9 +262,12 @@ PsiReturnType CoupledCluster::triples(){
       }
 
       //(ac)(ik)
-      addr = psio_get_address(PSIO_ZERO,i*vvv*sizeof(double));
-      mypsio->read(PSIF_DCC_ABCI,"E2abci",(char*)&E2abci[thread][0],vvv*sizeof(double),addr,&addr);
-      F_DGEMM('t','t',vv,v,v,1.0,E2abci[thread],v,tempt+j*vvo+k*vv,v,0.0,Z2[thread],vv);
+      abci = i < nincore ? E2abci_incore+i*vvv : E2abci[thread];
+      if (i >= nincore) {
+         psio_address addr = psio_get_address(PSIO_ZERO,i*vvv*sizeof(double));
+         mypsio->read(PSIF_DCC_ABCI,"E2abci",(char*)&E2abci[thread][0],vvv*sizeof(double),addr,&addr);
+      }
+      F_DGEMM('t','t',vv,v,v,1.0,abci,v,tempt+j*vvo+k*vv,v,0.0,Z2[thread],vv);
       F_DGEMM('n','t',v,vv,o,-1.0,E2ijak+j*voo+i*vo,v,tempt+k*vvo,vv,1.0,Z2[thread],v);
       for (long int a=0; a<v; a++){
           for (long int b=0; b<v; b++){
@@ -236,7 +276,7 @@ PsiReturnType CoupledCluster::triples(){
       }
 
       //(ijk)(abc)
-      F_DGEMM('t','t',vv,v,v,1.0,E2abci[thread],v,tempt+k*vvo+j*vv,v,0.0,Z2[thread],vv);
+      F_DGEMM('t','t',vv,v,v,1.0,abci,v,tempt+k*vvo+j*vv,v,0.0,Z2[thread],vv);
       F_DGEMM('n','t',v,vv,o,-1.0,E2ijak+k*voo+i*vo,v,tempt+j*vvo,vv,1.0,Z2[thread],v);
       for (long int a=0; a<v; a++){
           for (long int b=0; b<v; b++){
@@ -337,25 +377,29 @@ PsiReturnType CoupledCluster::triples(){
       }
       etrip[thread] += tripval*ijkfac;
       // print out update
+      long int done;
+      #pragma omp atomic capture
+      done = ++ndone;
       if (thread==0){
          int print = 0;
          stop = time(NULL);
-         if ((double)ind/nijk >= 0.1 && !pct10){      pct10 = 1; print=1;}
-         else if ((double)ind/nijk >= 0.2 && !pct20){ pct20 = 1; print=1;}
-         else if ((double)ind/nijk >= 0.3 && !pct30){ pct30 = 1; print=1;}
-         else if ((double)ind/nijk >= 0.4 && !pct40){ pct40 = 1; print=1;}
-         else if ((double)ind/nijk >= 0.5 && !pct50){ pct50 = 1; print=1;}
-         else if ((double)ind/nijk >= 0.6 && !pct60){ pct60 = 1; print=1;}
-         else if ((double)ind/nijk >= 0.7 && !pct70){ pct70 = 1; print=1;}
-         else if ((double)ind/nijk >= 0.8 && !pct80){ pct80 = 1; print=1;}
-         else if ((double)ind/nijk >= 0.9 && !pct90){ pct90 = 1; print=1;}
+         if ((double)done/nijk >= 0.1 && !pct10){      pct10 = 1; print=1;}
+         else if ((double)done/nijk >= 0.2 && !pct20){ pct20 = 1; print=1;}
+         else if ((double)done/nijk >= 0.3 && !pct30){ pct30 = 1; print=1;}
+         else if ((double)done/nijk >= 0.4 && !pct40){ pct40 = 1; print=1;}
+         else if ((double)done/nijk >= 0.5 && !pct50){ pct50 = 1; print=1;}
+         else if ((double)done/nijk >= 0.6 && !pct60){ pct60 = 1; print=1;}
+         else if ((double)done/nijk >= 0.7 && !pct70){ pct70 = 1; print=1;}
+         else if ((double)done/nijk >= 0.8 && !pct80){ pct80 = 1; print=1;}
+         else if ((double)done/nijk >= 0.9 && !pct90){ pct90 = 1; print=1;}
          if (print){
-            outfile->Printf("              %3.1lf  %8d s\n",100.0*ind/nijk,(int)stop-(int)start);
+            outfile->Printf("              %3.1lf  %8d s\n",100.0*done/nijk,(int)stop-(int)start);
 
          }
       }
-      mypsio->close(PSIF_DCC_ABCI,1);
-      mypsio.reset();
+  }
+  mypsio->close(PSIF_DCC_ABCI,1);
+  mypsio.reset();
   }
 
   double myet = 0.0;
@@ -392,6 +436,7 @@ PsiReturnType CoupledCluster::triples(){
   free(Z);
   free(Z2);
   free(E2abci);
+  if (E2abci_incore != NULL) free(E2abci_incore);
   free(etrip);
   delete[] name;
   delete[] space;
@@ -0,0 +1,194 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2016 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/*! \file
+    \ingroup DPD
+    \brief Throughput benchmark of the in-core buf4_sort kernels
+*/
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+#include "psi4/libciomr/libciomr.h"
+#include "psi4/libpsio/psio.h"
+#include "psi4/libpsi4util/libpsi4util.h"
+#include "psi4/libparallel/process.h"
+#include "dpd.h"
+
+namespace psi {
+
+/* benchmark_dpd_sort(): Times buf4_sort() for a set of representative
+** index permutations of an (n x n | n x n) C1 buffer, n = 2^1..2^N (so
+** n^2 x n^2 = 2^4N doubles at the largest size), and compares their
+** throughput to a memcpy() of the same number of doubles.
+** Both buffers are held in the DPD cache so that no disk I/O is timed.
+** This sets up (and closes) DPD instance 0, so it must not be called
+** while another module owns it.
+*/
+void benchmark_dpd_sort(int N, double min_time)
+{
+    outfile->Printf( "\n");
+    outfile->Printf( "                              ------------------------------- \n");
+    outfile->Printf( "                              ======> DPD SORT BENCHMARKS <== \n");
+    outfile->Printf( "                              ------------------------------- \n");
+    outfile->Printf( "\n");
+
+    outfile->Printf( "  Parameters:\n");
+    outfile->Printf( "   -Minimum runtime (per operation, per size): %14.10f [s].\n", min_time);
+    outfile->Printf( "   -Maximum dimension exponent N: %d. Buffers are D^2 x D^2 = 2^4N doubles in size. The D\n", N);
+    outfile->Printf( "        value is reported below\n");
+    outfile->Printf( "\n");
+
+    std::vector<std::string> ops;
+    std::map<std::string, enum indices> sorts;
+    std::map<std::string, std::vector<double> > timings;
+
+    ops.push_back("memcpy");
+    sorts["pqsr"] = pqsr; ops.push_back("pqsr");
+    sorts["qprs"] = qprs; ops.push_back("qprs");
+    sorts["rspq"] = rspq; ops.push_back("rspq");
+    sorts["prqs"] = prqs; ops.push_back("prqs");
+    sorts["psqr"] = psqr; ops.push_back("psqr");
+    sorts["srqp"] = srqp; ops.push_back("srqp");
+    for (size_t op = 0; op < ops.size(); op++)
+        timings[ops[op]].resize(N);
+
+    int *cachefiles = init_int_array(PSIO_MAXUNIT);
+    cachefiles[PSIF_CC_TMP] = 1;
+
+    int dim = 1;
+    for (int k = 0; k < N; k++) {
+
+        dim *= 2;
+        unsigned long int full_dim = dim * (unsigned long int) dim * dim * dim;
+
+        double T;
+        unsigned long int rounds;
+        Timer* qq;
+
+        // memcpy of the same size
+        double* A = init_array(full_dim);
+        double* B = init_array(full_dim);
+        T = 0.0;
+        rounds = 0L;
+        qq = new Timer();
+        while (T < min_time) {
+            ::memcpy((void*) B, (void*) A, full_dim * sizeof(double));
+            T = qq->get();
+            rounds++;
+        }
+        delete qq;
+        timings["memcpy"][k] = T / (double) rounds;
+        free(A);
+        free(B);
+
+        // One irrep, one orbital space of dim orbitals; pair 0 is the full pq space
+        int *orbspi = init_int_array(1);
+        int *orbsym = init_int_array(dim);
+        orbspi[0] = dim;
+        std::vector<int*> spaces;
+        spaces.push_back(orbspi);
+        spaces.push_back(orbsym);
+        int **cachelist = init_int_matrix(5, 5);
+        cachelist[0][0] = 1;
+
+        dpd_init(0, 1, Process::environment.get_memory(), 0, cachefiles, cachelist,
+                 NULL, 1, spaces);
+        psio_open(PSIF_CC_TMP, PSIO_OPEN_NEW);
+
+        dpdbuf4 In;
+        global_dpd_->buf4_init(&In, PSIF_CC_TMP, 0, 0, 0, 0, 0, 0, "Sort Benchmark In");
+        global_dpd_->buf4_mat_irrep_init(&In, 0);
+        for (int pq = 0; pq < In.params->rowtot[0]; pq++)
+            for (int rs = 0; rs < In.params->coltot[0]; rs++)
+                In.matrix[0][pq][rs] = (double) (pq - rs);
+        global_dpd_->buf4_mat_irrep_wrt(&In, 0);
+        global_dpd_->buf4_mat_irrep_close(&In, 0);
+
+        for (size_t op = 1; op < ops.size(); op++) {
+            T = 0.0;
+            rounds = 0L;
+            qq = new Timer();
+            while (T < min_time) {
+                global_dpd_->buf4_sort(&In, PSIF_CC_TMP, sorts[ops[op]], 0, 0, "Sort Benchmark Out");
+                T = qq->get();
+                rounds++;
+            }
+            delete qq;
+            timings[ops[op]][k] = T / (double) rounds;
+        }
+
+        global_dpd_->buf4_close(&In);
+        dpd_close(0);
+        psio_close(PSIF_CC_TMP, 0);
+
+        free_int_matrix(cachelist);
+        free(orbspi);
+        free(orbsym);
+    }
+    free(cachefiles);
+
+    outfile->Printf( "DPD Sort Throughput [GB/s]:\n\n");
+    dim = 1;
+    outfile->Printf( "Operation  ");
+    for (int k = 0; k < N; k++) {
+        dim *= 2;
+        outfile->Printf( "  %9d", dim);
+    }
+    outfile->Printf( "\n");
+    for (size_t s = 0; s < ops.size(); s++) {
+        outfile->Printf( "%-11s", ops[s].c_str());
+        dim = 1;
+        for (int k = 0; k < N; k++) {
+            dim *= 2;
+            unsigned long int full_dim = dim * (unsigned long int) dim * dim * dim;
+            outfile->Printf( "  %9.3f", full_dim * sizeof(double) / timings[ops[s]][k] / 1.0E9);
+        }
+        outfile->Printf( "\n");
+    }
+    outfile->Printf( "\n");
+
+    outfile->Printf( "DPD Sort Time Relative to memcpy:\n\n");
+    dim = 1;
+    outfile->Printf( "Operation  ");
+    for (int k = 0; k < N; k++) {
+        dim *= 2;
+        outfile->Printf( "  %9d", dim);
+    }
+    outfile->Printf( "\n");
+    for (size_t s = 1; s < ops.size(); s++) {
+        outfile->Printf( "%-11s", ops[s].c_str());
+        for (int k = 0; k < N; k++)
+            outfile->Printf( "  %9.2f", timings[ops[s]][k] / timings["memcpy"][k]);
+        outfile->Printf( "\n");
+    }
+    outfile->Printf( "\n");
+}
+
+}
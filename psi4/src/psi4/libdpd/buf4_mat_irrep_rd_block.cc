@@ -535,4 +535,35 @@ int DPD::buf4_mat_irrep_rd_block(dpdbuf4 *Buf, int irrep, int start_pq,
 
 }
 
+/* dpd_buf4_mat_irrep_rd_block_aio_ok(): Returns 1 if blocks of the
+** buffer are straight copies of rows of its file on disk (no permutational
+** unpacking or antisymmetrization), so that they can be read with
+** dpd_buf4_mat_irrep_rd_block_aio().
+*/
+int DPD::buf4_mat_irrep_rd_block_aio_ok(dpdbuf4 *Buf)
+{
+    if(Buf->file.incore || Buf->anti) return 0;
+
+    return (Buf->params->perm_pq == Buf->file.params->perm_pq) &&
+           (Buf->params->perm_rs == Buf->file.params->perm_rs) &&
+           (Buf->params->peq == Buf->file.params->peq) &&
+           (Buf->params->res == Buf->file.params->res);
+}
+
+/* dpd_buf4_mat_irrep_rd_block_aio(): Asynchronous counterpart of
+** dpd_buf4_mat_irrep_rd_block() that reads into the caller-supplied
+** block rather than Buf->matrix[irrep].  Only valid when
+** dpd_buf4_mat_irrep_rd_block_aio_ok() is true.
+*/
+unsigned long int DPD::buf4_mat_irrep_rd_block_aio(dpdbuf4 *Buf, int irrep, int start_pq,
+                                                   int num_pq, double **block, AIOHandler *aio,
+                                                   psio_address *next_address)
+{
+    if(!buf4_mat_irrep_rd_block_aio_ok(Buf))
+        dpd_error("dpd_buf4_mat_irrep_rd_block_aio: buffer is not a direct image of its file", "outfile");
+
+    return file4_mat_irrep_rd_block_aio(&(Buf->file), irrep, start_pq, num_pq,
+                                        block, aio, next_address);
+}
+
 }
@@ -109,13 +109,74 @@ namespace psi {
 ** spqr: IC     ** sprq: IC
 ** -RAK, Nov. 2005*/
 
+/*
+** buf4_sort_incore(): The in-core kernel shared by all sorting patterns.
+** The template arguments are the positions, within the target's (p,q,r,s),
+** of the four orbitals that index the source, i.e.
+**
+**   Out[pq][rs] = In[o[I]o[J]][o[K]o[L]],  o = {p,q,r,s}
+**
+** so each pattern gets its own index map resolved at compile time.  The
+** target irrep blocks are swept in DPD_SORT_TILE x DPD_SORT_TILE tiles,
+** which keeps the strided source reads of bra-ket transposing sorts in
+** cache, and the tiles are distributed over OpenMP threads.
+*/
+#define DPD_SORT_TILE 64
+
+template <int I, int J, int K, int L>
+static void buf4_sort_incore(dpdbuf4 *InBuf, dpdbuf4 *OutBuf)
+{
+    int h, nirreps, my_irrep, r_irrep;
+    int rowtot, coltot, nrowtiles, ncoltiles, tile;
+    dpdparams4 *In, *Out;
+
+    In = InBuf->params;
+    Out = OutBuf->params;
+    nirreps = Out->nirreps;
+    my_irrep = OutBuf->file.my_irrep;
+
+    for(h=0; h < nirreps; h++) {
+        r_irrep = h^my_irrep;
+        rowtot = Out->rowtot[h];
+        coltot = Out->coltot[r_irrep];
+        if(!rowtot || !coltot) continue;
+
+        nrowtiles = (rowtot + DPD_SORT_TILE - 1)/DPD_SORT_TILE;
+        ncoltiles = (coltot + DPD_SORT_TILE - 1)/DPD_SORT_TILE;
+
+#pragma omp parallel for schedule(dynamic)
+        for(tile=0; tile < nrowtiles*ncoltiles; tile++) {
+            int pq, rs, pq_start, pq_stop, rs_start, rs_stop, o[4];
+            double **X = OutBuf->matrix[h];
+
+            pq_start = (tile / ncoltiles) * DPD_SORT_TILE;
+            rs_start = (tile % ncoltiles) * DPD_SORT_TILE;
+            pq_stop = (pq_start + DPD_SORT_TILE < rowtot) ? pq_start + DPD_SORT_TILE : rowtot;
+            rs_stop = (rs_start + DPD_SORT_TILE < coltot) ? rs_start + DPD_SORT_TILE : coltot;
+
+            for(pq=pq_start; pq < pq_stop; pq++) {
+                o[0] = Out->roworb[h][pq][0];
+                o[1] = Out->roworb[h][pq][1];
+                for(rs=rs_start; rs < rs_stop; rs++) {
+                    o[2] = Out->colorb[r_irrep][rs][0];
+                    o[3] = Out->colorb[r_irrep][rs][1];
+
+                    X[pq][rs] = InBuf->matrix[In->psym[o[I]]^In->qsym[o[J]]]
+                                             [In->rowidx[o[I]][o[J]]]
+                                             [In->colidx[o[K]][o[L]]];
+                }
+            }
+        }
+    }
+}
+
 int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                     int pqnum, int rsnum, const char *label)
 {
-    int h,nirreps, row, col, my_irrep, r_irrep;
-    int p, q, r, s, P, Q, R, S, pq, rs, sr, pr, qs, qp, rq, qr, ps, sp, rp, sq;
+    int h,nirreps, my_irrep;
+    int p, q, r, s, pq, rs, sr, pr, qs, qp, qr, ps;
     int PQ, RS;
-    int Gp, Gq, Gr, Gs, Gpq, Grs, Gpr, Gqs, Grq, Gqr, Gps, Gsp, Grp, Gsq;
+    int Gp, Gq, Gr, Gs, Gpq, Grs, Gpr, Gps;
     dpdbuf4 OutBuf;
     int incore;
     long int rowtot, coltot, core_total, maxrows;
@@ -205,27 +266,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 #endif
 
         /* p->p; q->q; s->r; r->s = pqsr */
-        if(incore) {
-            for(h=0; h < nirreps; h++) {
-                r_irrep = h^my_irrep;
-
-                for(pq=0; pq < OutBuf.params->rowtot[h]; pq++) {
-                    p = OutBuf.params->roworb[h][pq][0];
-                    q = OutBuf.params->roworb[h][pq][1];
-
-                    row = InBuf->params->rowidx[p][q];
-
-                    for(rs=0; rs < OutBuf.params->coltot[r_irrep]; rs++) {
-                        r = OutBuf.params->colorb[r_irrep][rs][0];
-                        s = OutBuf.params->colorb[r_irrep][rs][1];
-
-                        sr = InBuf->params->colidx[s][r];
-
-                        OutBuf.matrix[h][pq][rs] = InBuf->matrix[h][row][sr];
-                    }
-                }
-            }
-        }
+        if(incore) buf4_sort_incore<0,1,3,2>(InBuf, &OutBuf);
         else { /* out-of-core pqsr -> pqrs */
 
             for(Gpq=0; Gpq < nirreps; Gpq++) {
@@ -295,43 +336,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 #endif
 
         /* p->p; r->q; q->r; s->s = prqs */
-        if(incore) {
-            for(h=0; h < nirreps; h++) {
-                r_irrep = h^my_irrep;
-
-                for(Gp=0; Gp < nirreps; Gp++) {
-                    Gq = Gp^h;
-                    for(Gr=0; Gr < nirreps; Gr++) {
-                        Gs = Gr^r_irrep;
-
-                        /* Irreps on the source */
-                        Gpr = Gp^Gr;  Gqs = Gq^Gs;
-
-                        for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
-                            P = OutBuf.params->poff[Gp] + p;
-                            for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
-                                Q = OutBuf.params->qoff[Gq] + q;
-                                pq = OutBuf.params->rowidx[P][Q];
-
-                                for(r=0; r < OutBuf.params->rpi[Gr]; r++) {
-                                    R = OutBuf.params->roff[Gr] + r;
-                                    pr = InBuf->params->rowidx[P][R];
-
-                                    for(s=0; s < OutBuf.params->spi[Gs]; s++) {
-                                        S = OutBuf.params->soff[Gs] + s;
-                                        rs = OutBuf.params->colidx[R][S];
-                                        qs = InBuf->params->colidx[Q][S];
-
-                                        OutBuf.matrix[h][pq][rs] = InBuf->matrix[Gpr][pr][qs];
-
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        if(incore) buf4_sort_incore<0,2,1,3>(InBuf, &OutBuf);
         else { /* pqrs <- prqs */
 
             for(Gpq=0; Gpq < nirreps; Gpq++) {
@@ -527,41 +532,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
         /* p->p; r->q; s->r; q->s = psqr */
 
-        if(incore) {
-            for(h=0; h < nirreps; h++) {
-                r_irrep = h^my_irrep;
-
-                for(Gp=0; Gp < nirreps; Gp++) {
-                    Gq = Gp^h;
-                    for(Gr=0; Gr < nirreps; Gr++) {
-                        Gs = Gr^r_irrep;
-
-                        Gps = Gp^Gs;  Gqr = Gq^Gr;
-
-                        for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
-                            P = OutBuf.params->poff[Gp] + p;
-                            for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
-                                Q = OutBuf.params->qoff[Gq] + q;
-                                pq = OutBuf.params->rowidx[P][Q];
-
-                                for(r=0; r < OutBuf.params->rpi[Gr]; r++) {
-                                    R = OutBuf.params->roff[Gr] + r;
-                                    qr = InBuf->params->colidx[Q][R];
-
-                                    for(s=0; s < OutBuf.params->spi[Gs]; s++) {
-                                        S = OutBuf.params->soff[Gs] + s;
-                                        rs = OutBuf.params->colidx[R][S];
-                                        ps = InBuf->params->rowidx[P][S];
-
-                                        OutBuf.matrix[h][pq][rs] = InBuf->matrix[Gps][ps][qr];
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        if(incore) buf4_sort_incore<0,3,1,2>(InBuf, &OutBuf);
         else {
             for(Gpq=0; Gpq < nirreps; Gpq++) {
                 Grs = Gpq^my_irrep;
@@ -758,42 +729,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
         /* p->p; s->q; q->r; r->s = prsq */
 
-        if(incore) {
-            for(h=0; h < nirreps; h++) {
-                r_irrep = h^my_irrep;
-
-                for(Gp=0; Gp < nirreps; Gp++) {
-                    Gq = Gp^h;
-                    for(Gr=0; Gr < nirreps; Gr++) {
-                        Gs = Gr^r_irrep;
-
-                        Gpr = Gp^Gr;  Gsq = Gs^Gq;
-
-                        for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
-                            P = OutBuf.params->poff[Gp] + p;
-                            for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
-                                Q = OutBuf.params->qoff[Gq] + q;
-                                pq = OutBuf.params->rowidx[P][Q];
-
-                                for(r=0; r < OutBuf.params->rpi[Gr]; r++) {
-                                    R = OutBuf.params->roff[Gr] + r;
-                                    pr = InBuf->params->rowidx[P][R];
-
-                                    for(s=0; s < OutBuf.params->spi[Gs]; s++) {
-                                        S = OutBuf.params->soff[Gs] + s;
-                                        rs = OutBuf.params->colidx[R][S];
-                                        sq = InBuf->params->colidx[S][Q];
-
-                                        OutBuf.matrix[h][pq][rs] = InBuf->matrix[Gpr][pr][sq];
-
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        if(incore) buf4_sort_incore<0,2,3,1>(InBuf, &OutBuf);
         else {
             outfile->Printf( "LIBDPD: Out-of-core algorithm not yet coded for psqr sort.\n");
             dpd_error("buf4_sort", "outfile");
@@ -812,42 +748,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
         /* p->p; s->q; r->r; q->s = psrq */
 
-        if(incore) {
-            for(h=0; h < nirreps; h++) {
-                r_irrep = h^my_irrep;
-
-                for(Gp=0; Gp < nirreps; Gp++) {
-                    Gq = Gp^h;
-                    for(Gr=0; Gr < nirreps; Gr++) {
-                        Gs = Gr^r_irrep;
-
-                        Gps = Gp^Gs;  Grq = Gr^Gq;
-
-                        for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
-                            P = OutBuf.params->poff[Gp] + p;
-                            for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
-                                Q = OutBuf.params->qoff[Gq] + q;
-                                pq = OutBuf.params->rowidx[P][Q];
-
-                                for(r=0; r < OutBuf.params->rpi[Gr]; r++) {
-                                    R = OutBuf.params->roff[Gr] + r;
-                                    rq = InBuf->params->colidx[R][Q];
-
-                                    for(s=0; s < OutBuf.params->spi[Gs]; s++) {
-                                        S = OutBuf.params->soff[Gs] + s;
-                                        rs = OutBuf.params->colidx[R][S];
-                                        ps = InBuf->params->rowidx[P][S];
-
-                                        OutBuf.matrix[h][pq][rs] = InBuf->matrix[Gps][ps][rq];
-
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        if(incore) buf4_sort_incore<0,3,2,1>(InBuf, &OutBuf);
         else {
             outfile->Printf( "LIBDPD: Out-of-core algorithm not yet coded for psrq sort.\n");
             dpd_error("buf4_sort", "outfile");
@@ -866,27 +767,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
         /* q->p; p->q; r->r; s->s = qprs */
 
-        if(incore) {
-            for(h=0; h < nirreps; h++) {
-                r_irrep = h^my_irrep;
-
-                for(pq=0; pq < OutBuf.params->rowtot[h]; pq++) {
-                    p = OutBuf.params->roworb[h][pq][0];
-                    q = OutBuf.params->roworb[h][pq][1];
-                    qp = InBuf->params->rowidx[q][p];
-
-                    for(rs=0; rs < OutBuf.params->coltot[r_irrep]; rs++) {
-                        r = OutBuf.params->colorb[r_irrep][rs][0];
-                        s = OutBuf.params->colorb[r_irrep][rs][1];
-
-                        col = InBuf->params->colidx[r][s];
-
-                        OutBuf.matrix[h][pq][rs] = InBuf->matrix[h][qp][col];
-                    }
-                }
-
-            }
-        }
+        if(incore) buf4_sort_incore<1,0,2,3>(InBuf, &OutBuf);
         else {
             for(Gpq=0; Gpq < nirreps; Gpq++) {
                 Grs = Gpq ^ my_irrep;
@@ -994,26 +875,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
         /* q->p; p->q; s->r; r->s = qpsr */
 
-        if(incore) {
-            for(h=0; h < nirreps; h++) {
-                r_irrep = h^my_irrep;
-
-                for(pq=0; pq < OutBuf.params->rowtot[h]; pq++) {
-                    p = OutBuf.params->roworb[h][pq][0];
-                    q = OutBuf.params->roworb[h][pq][1];
-                    qp = InBuf->params->rowidx[q][p];
-
-                    for(rs=0; rs < OutBuf.params->coltot[r_irrep]; rs++) {
-                        r = OutBuf.params->colorb[r_irrep][rs][0];
-                        s = OutBuf.params->colorb[r_irrep][rs][1];
-                        sr = InBuf->params->colidx[s][r];
-
-                        OutBuf.matrix[h][pq][rs] = InBuf->matrix[h][qp][sr];
-                    }
-                }
-
-            }
-        }
+        if(incore) buf4_sort_incore<1,0,3,2>(InBuf, &OutBuf);
         else {
 
             for(Gpq=0; Gpq < nirreps; Gpq++) {
@@ -1154,42 +1016,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
         /* q->p; r->q; p->r; s->s = rpqs */
 
-        if(incore) {
-            for(h=0; h < nirreps; h++) {
-                r_irrep = h^my_irrep;
-
-                for(Gp=0; Gp < nirreps; Gp++) {
-                    Gq = Gp^h;
-                    for(Gr=0; Gr < nirreps; Gr++) {
-                        Gs = Gr^r_irrep;
-
-                        Grp = Gr^Gp; Gqs = Gq^Gs;
-
-                        for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
-                            P = OutBuf.params->poff[Gp] + p;
-                            for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
-                                Q = OutBuf.params->qoff[Gq] + q;
-                                pq = OutBuf.params->rowidx[P][Q];
-
-                                for(r=0; r < OutBuf.params->rpi[Gr]; r++) {
-                                    R = OutBuf.params->roff[Gr] + r;
-                                    rp = InBuf->params->rowidx[R][P];
-
-                                    for(s=0; s < OutBuf.params->spi[Gs]; s++) {
-                                        S = OutBuf.params->soff[Gs] + s;
-                                        rs = OutBuf.params->colidx[R][S];
-                                        qs = InBuf->params->colidx[Q][S];
-
-                                        OutBuf.matrix[h][pq][rs] = InBuf->matrix[Grp][rp][qs];
-
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        if(incore) buf4_sort_incore<2,0,1,3>(InBuf, &OutBuf);
         else {
             outfile->Printf( "LIBDPD: Out-of-core algorithm not yet coded for qrps sort.\n");
             dpd_error("buf4_sort", "outfile");
@@ -1208,42 +1035,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
         /* q->p; r->q; s->r; p->s = spqr */
 
-        if(incore) {
-            for(h=0; h < nirreps; h++) {
-                r_irrep = h^my_irrep;
-
-                for(Gp=0; Gp < nirreps; Gp++) {
-                    Gq = Gp^h;
-                    for(Gr=0; Gr < nirreps; Gr++) {
-                        Gs = Gr^r_irrep;
-
-                        Gsp = Gs^Gp; Gqr = Gq^Gr;
-
-                        for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
-                            P = OutBuf.params->poff[Gp] + p;
-                            for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
-                                Q = OutBuf.params->qoff[Gq] + q;
-                                pq = OutBuf.params->rowidx[P][Q];
-
-                                for(r=0; r < OutBuf.params->rpi[Gr]; r++) {
-                                    R = OutBuf.params->roff[Gr] + r;
-                                    qr = InBuf->params->colidx[Q][R];
-
-                                    for(s=0; s < OutBuf.params->spi[Gs]; s++) {
-                                        S = OutBuf.params->soff[Gs] + s;
-                                        rs = OutBuf.params->colidx[R][S];
-                                        sp = InBuf->params->rowidx[S][P];
-
-                                        OutBuf.matrix[h][pq][rs] = InBuf->matrix[Gsp][sp][qr];
-
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        if(incore) buf4_sort_incore<3,0,1,2>(InBuf, &OutBuf);
         else {
             outfile->Printf( "LIBDPD: Out-of-core algorithm not yet coded for qrsp sort.\n");
             dpd_error("buf4_sort", "outfile");
@@ -1261,42 +1053,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
         /* q->p; s->q; p->r; r->s = rpsq */
 
-        if(incore) {
-            for(h=0; h < nirreps; h++) {
-                r_irrep = h^my_irrep;
-
-                for(Gp=0; Gp < nirreps; Gp++) {
-                    Gq = Gp^h;
-                    for(Gr=0; Gr < nirreps; Gr++) {
-                        Gs = Gr^r_irrep;
-
-                        Grp = Gr^Gp; Gsq = Gs^Gq;
-
-                        for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
-                            P = OutBuf.params->poff[Gp] + p;
-                            for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
-                                Q = OutBuf.params->qoff[Gq] + q;
-                                pq = OutBuf.params->rowidx[P][Q];
-
-                                for(r=0; r < OutBuf.params->rpi[Gr]; r++) {
-                                    R = OutBuf.params->roff[Gr] + r;
-                                    rp = InBuf->params->rowidx[R][P];
-
-                                    for(s=0; s < OutBuf.params->spi[Gs]; s++) {
-                                        S = OutBuf.params->soff[Gs] + s;
-                                        rs = OutBuf.params->colidx[R][S];
-                                        sq = InBuf->params->colidx[S][Q];
-
-                                        OutBuf.matrix[h][pq][rs] = InBuf->matrix[Grp][rp][sq];
-
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        if(incore) buf4_sort_incore<2,0,3,1>(InBuf, &OutBuf);
         else {
             outfile->Printf( "LIBDPD: Out-of-core algorithm not yet coded for qspr sort.\n");
             dpd_error("buf4_sort", "outfile");
@@ -1314,42 +1071,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 #endif
 
         /* q->p; s->q; r->r; p->s = sprq */
-        if(incore) {
-            for(h=0; h < nirreps; h++) {
-                r_irrep = h^my_irrep;
-
-                for(Gp=0; Gp < nirreps; Gp++) {
-                    Gq = Gp^h;
-                    for(Gr=0; Gr < nirreps; Gr++) {
-                        Gs = Gr^r_irrep;
-
-                        Gsp = Gs^Gp; Grq = Gr^Gq;
-
-                        for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
-                            P = OutBuf.params->poff[Gp] + p;
-                            for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
-                                Q = OutBuf.params->qoff[Gq] + q;
-                                pq = OutBuf.params->rowidx[P][Q];
-
-                                for(r=0; r < OutBuf.params->rpi[Gr]; r++) {
-                                    R = OutBuf.params->roff[Gr] + r;
-                                    rq = InBuf->params->colidx[R][Q];
-
-                                    for(s=0; s < OutBuf.params->spi[Gs]; s++) {
-                                        S = OutBuf.params->soff[Gs] + s;
-                                        rs = OutBuf.params->colidx[R][S];
-                                        sp = InBuf->params->rowidx[S][P];
-
-                                        OutBuf.matrix[h][pq][rs] = InBuf->matrix[Gsp][sp][rq];
-
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        if(incore) buf4_sort_incore<3,0,2,1>(InBuf, &OutBuf);
         else {
             outfile->Printf( "LIBDPD: Out-of-core algorithm not yet coded for qsrp sort.\n");
             dpd_error("buf4_sort", "outfile");
@@ -1368,42 +1090,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
         /* r->p; q->q; p->r; s->s = rqps */
 
-        if(incore) {
-            for(h=0; h < nirreps; h++) {
-                r_irrep = h^my_irrep;
-
-                for(Gp=0; Gp < nirreps; Gp++) {
-                    Gq = Gp^h;
-                    for(Gr=0; Gr < nirreps; Gr++) {
-                        Gs = Gr^r_irrep;
-
-                        Grq = Gr^Gq; Gps = Gp^Gs;
-
-                        for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
-                            P = OutBuf.params->poff[Gp] + p;
-                            for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
-                                Q = OutBuf.params->qoff[Gq] + q;
-                                pq = OutBuf.params->rowidx[P][Q];
-
-                                for(r=0; r < OutBuf.params->rpi[Gr]; r++) {
-                                    R = OutBuf.params->roff[Gr] + r;
-                                    rq = InBuf->params->rowidx[R][Q];
-
-                                    for(s=0; s < OutBuf.params->spi[Gs]; s++) {
-                                        S = OutBuf.params->soff[Gs] + s;
-                                        rs = OutBuf.params->colidx[R][S];
-                                        ps = InBuf->params->colidx[P][S];
-
-                                        OutBuf.matrix[h][pq][rs] = InBuf->matrix[Grq][rq][ps];
-
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        if(incore) buf4_sort_incore<2,1,0,3>(InBuf, &OutBuf);
         else {
             outfile->Printf( "LIBDPD: Out-of-core algorithm not yet coded for rqps sort.\n");
             dpd_error("buf4_sort", "outfile");
@@ -1422,42 +1109,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
         /* r->p; q->q; s->r; p->s = sqpr */
 
-        if(incore) {
-            for(h=0; h < nirreps; h++) {
-                r_irrep = h^my_irrep;
-
-                for(Gp=0; Gp < nirreps; Gp++) {
-                    Gq = Gp^h;
-                    for(Gr=0; Gr < nirreps; Gr++) {
-                        Gs = Gr^r_irrep;
-
-                        Gsq = Gs^Gq;  Gpr = Gp^Gr;
-
-                        for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
-                            P = OutBuf.params->poff[Gp] + p;
-                            for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
-                                Q = OutBuf.params->qoff[Gq] + q;
-                                pq = OutBuf.params->rowidx[P][Q];
-
-                                for(r=0; r < OutBuf.params->rpi[Gr]; r++) {
-                                    R = OutBuf.params->roff[Gr] + r;
-                                    pr = InBuf->params->colidx[P][R];
-
-                                    for(s=0; s < OutBuf.params->spi[Gs]; s++) {
-                                        S = OutBuf.params->soff[Gs] + s;
-                                        rs = OutBuf.params->colidx[R][S];
-                                        sq = InBuf->params->rowidx[S][Q];
-
-                                        OutBuf.matrix[h][pq][rs] = InBuf->matrix[Gsq][sq][pr];
-
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        if(incore) buf4_sort_incore<3,1,0,2>(InBuf, &OutBuf);
         else {
             outfile->Printf( "LIBDPD: Out-of-core algorithm not yet coded for rqsp sort.\n");
             dpd_error("buf4_sort", "outfile");
@@ -1476,42 +1128,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
         /* r->p; p->q; q->r; s->s = qrps */
 
-        if(incore) {
-            for(h=0; h < nirreps; h++) {
-                r_irrep = h^my_irrep;
-
-                for(Gp=0; Gp < nirreps; Gp++) {
-                    Gq = Gp^h;
-                    for(Gr=0; Gr < nirreps; Gr++) {
-                        Gs = Gr^r_irrep;
-
-                        Gqr = Gq^Gr;  Gps = Gp^Gs;
-
-                        for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
-                            P = OutBuf.params->poff[Gp] + p;
-                            for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
-                                Q = OutBuf.params->qoff[Gq] + q;
-                                pq = OutBuf.params->rowidx[P][Q];
-
-                                for(r=0; r < OutBuf.params->rpi[Gr]; r++) {
-                                    R = OutBuf.params->roff[Gr] + r;
-                                    qr = InBuf->params->rowidx[Q][R];
-
-                                    for(s=0; s < OutBuf.params->spi[Gs]; s++) {
-                                        S = OutBuf.params->soff[Gs] + s;
-                                        rs = OutBuf.params->colidx[R][S];
-                                        ps = InBuf->params->colidx[P][S];
-
-                                        OutBuf.matrix[h][pq][rs] = InBuf->matrix[Gqr][qr][ps];
-
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        if(incore) buf4_sort_incore<1,2,0,3>(InBuf, &OutBuf);
         else {
             outfile->Printf( "LIBDPD: Out-of-core algorithm not yet coded for rpqs sort.\n");
             dpd_error("buf4_sort", "outfile");
@@ -1530,42 +1147,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
         /* r->p; p->q; s->r; q->s = qspr */
 
-        if(incore) {
-            for(h=0; h < nirreps; h++) {
-                r_irrep = h^my_irrep;
-
-                for(Gp=0; Gp < nirreps; Gp++) {
-                    Gq = Gp^h;
-                    for(Gr=0; Gr < nirreps; Gr++) {
-                        Gs = Gr^r_irrep;
-
-                        Gqs = Gq^Gs;  Gpr = Gp^Gr;
-
-                        for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
-                            P = OutBuf.params->poff[Gp] + p;
-                            for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
-                                Q = OutBuf.params->qoff[Gq] + q;
-                                pq = OutBuf.params->rowidx[P][Q];
-
-                                for(r=0; r < OutBuf.params->rpi[Gr]; r++) {
-                                    R = OutBuf.params->roff[Gr] + r;
-                                    pr = InBuf->params->colidx[P][R];
-
-                                    for(s=0; s < OutBuf.params->spi[Gs]; s++) {
-                                        S = OutBuf.params->soff[Gs] + s;
-                                        rs = OutBuf.params->colidx[R][S];
-                                        qs = InBuf->params->rowidx[Q][S];
-
-                                        OutBuf.matrix[h][pq][rs] = InBuf->matrix[Gqs][qs][pr];
-
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        if(incore) buf4_sort_incore<1,3,0,2>(InBuf, &OutBuf);
         else {
             outfile->Printf( "LIBDPD: Out-of-core algorithm not yet coded for rpsq sort.\n");
             dpd_error("buf4_sort", "outfile");
@@ -1584,28 +1166,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
         /* r->p; s->q; q->r; p->s = srpq */
 
-        if(incore) {
-            for(h=0; h < nirreps; h++) {
-                r_irrep = h^my_irrep;
-
-                for(pq=0; pq < OutBuf.params->rowtot[h]; pq++) {
-                    p = OutBuf.params->roworb[h][pq][0];
-                    q = OutBuf.params->roworb[h][pq][1];
-
-                    col = InBuf->params->colidx[p][q];
-
-                    for(rs=0; rs < OutBuf.params->coltot[r_irrep]; rs++) {
-                        r = OutBuf.params->colorb[r_irrep][rs][0];
-                        s = OutBuf.params->colorb[r_irrep][rs][1];
-
-                        row = InBuf->params->rowidx[s][r];
-
-                        OutBuf.matrix[h][pq][rs] = InBuf->matrix[h][row][col];
-
-                    }
-                }
-            }
-        }
+        if(incore) buf4_sort_incore<3,2,0,1>(InBuf, &OutBuf);
         else {
             outfile->Printf( "LIBDPD: Out-of-core algorithm not yet coded for rsqp sort.\n");
             dpd_error("buf4_sort", "outfile");
@@ -1624,28 +1185,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
         /* r->p; s->q; p->r; q->s = rspq */
 
-        if(incore) {
-            for(h=0; h < nirreps; h++) {
-                r_irrep = h^my_irrep;
-
-                for(pq=0; pq < OutBuf.params->rowtot[h]; pq++) {
-                    p = OutBuf.params->roworb[h][pq][0];
-                    q = OutBuf.params->roworb[h][pq][1];
-
-                    col = InBuf->params->colidx[p][q];
-
-                    for(rs=0; rs < OutBuf.params->coltot[r_irrep]; rs++) {
-                        r = OutBuf.params->colorb[r_irrep][rs][0];
-                        s = OutBuf.params->colorb[r_irrep][rs][1];
-
-                        row = InBuf->params->rowidx[r][s];
-
-                        OutBuf.matrix[h][pq][rs] = InBuf->matrix[r_irrep][row][col];
-
-                    }
-                }
-            }
-        }
+        if(incore) buf4_sort_incore<2,3,0,1>(InBuf, &OutBuf);
         else {
             for(Gpq=0; Gpq < nirreps; Gpq++) {
                 Grs = Gpq ^ my_irrep;
@@ -1721,42 +1261,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
         /* s->p; q->q; r->r; p->s = sqrp */
 
-        if(incore) {
-            for(h=0; h < nirreps; h++) {
-                r_irrep = h^my_irrep;
-
-                for(Gp=0; Gp < nirreps; Gp++) {
-                    Gq = Gp^h;
-                    for(Gr=0; Gr < nirreps; Gr++) {
-                        Gs = Gr^r_irrep;
-
-                        Gsq = Gs^Gq;  Grp = Gr^Gp;
-
-                        for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
-                            P = OutBuf.params->poff[Gp] + p;
-                            for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
-                                Q = OutBuf.params->qoff[Gq] + q;
-                                pq = OutBuf.params->rowidx[P][Q];
-
-                                for(r=0; r < OutBuf.params->rpi[Gr]; r++) {
-                                    R = OutBuf.params->roff[Gr] + r;
-                                    rp = InBuf->params->colidx[R][P];
-
-                                    for(s=0; s < OutBuf.params->spi[Gs]; s++) {
-                                        S = OutBuf.params->soff[Gs] + s;
-                                        rs = OutBuf.params->colidx[R][S];
-                                        sq = InBuf->params->rowidx[S][Q];
-
-                                        OutBuf.matrix[h][pq][rs] = InBuf->matrix[Gsq][sq][rp];
-
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        if(incore) buf4_sort_incore<3,1,2,0>(InBuf, &OutBuf);
         else {
             outfile->Printf( "LIBDPD: Out-of-core algorithm not yet coded for sqrp sort.\n");
             dpd_error("buf4_sort", "outfile");
@@ -1780,28 +1285,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
         /* s->p; r->q; q->r; p->s = srqp */
 
-        if(incore) {
-            for(h=0; h < nirreps; h++) {
-                r_irrep = h^my_irrep;
-
-                for(pq=0; pq < OutBuf.params->rowtot[h]; pq++) {
-                    p = OutBuf.params->roworb[h][pq][0];
-                    q = OutBuf.params->roworb[h][pq][1];
-
-                    col = InBuf->params->colidx[q][p];
-
-                    for(rs=0; rs < OutBuf.params->coltot[r_irrep]; rs++) {
-                        r = OutBuf.params->colorb[r_irrep][rs][0];
-                        s = OutBuf.params->colorb[r_irrep][rs][1];
-
-                        row = InBuf->params->rowidx[s][r];
-
-                        OutBuf.matrix[h][pq][rs] = InBuf->matrix[r_irrep][row][col];
-
-                    }
-                }
-            }
-        }
+        if(incore) buf4_sort_incore<3,2,1,0>(InBuf, &OutBuf);
         else {
             outfile->Printf( "LIBDPD: Out-of-core algorithm not yet coded for srqp sort.\n");
             dpd_error("buf4_sort", "outfile");
@@ -1819,28 +1303,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
         /* s->p; r->q; p->r; q->s = rsqp */
 
-        if(incore) {
-            for(h=0; h < nirreps; h++) {
-                r_irrep = h^my_irrep;
-
-                for(pq=0; pq < OutBuf.params->rowtot[h]; pq++) {
-                    p = OutBuf.params->roworb[h][pq][0];
-                    q = OutBuf.params->roworb[h][pq][1];
-
-                    col = InBuf->params->colidx[q][p];
-
-                    for(rs=0; rs < OutBuf.params->coltot[r_irrep]; rs++) {
-                        r = OutBuf.params->colorb[r_irrep][rs][0];
-                        s = OutBuf.params->colorb[r_irrep][rs][1];
-
-                        row = InBuf->params->rowidx[r][s];
-
-                        OutBuf.matrix[h][pq][rs] = InBuf->matrix[h][row][col];
-
-                    }
-                }
-            }
-        }
+        if(incore) buf4_sort_incore<2,3,1,0>(InBuf, &OutBuf);
         else {
             outfile->Printf( "LIBDPD: Out-of-core algorithm not yet coded for srpq sort.\n");
             dpd_error("buf4_sort", "outfile");
@@ -1859,42 +1322,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
         /* s->p; p->q; q->r; r->s = qrsp */
 
-        if(incore) {
-            for(h=0; h < nirreps; h++) {
-                r_irrep = h^my_irrep;
-
-                for(Gp=0; Gp < nirreps; Gp++) {
-                    Gq = Gp^h;
-                    for(Gr=0; Gr < nirreps; Gr++) {
-                        Gs = Gr^r_irrep;
-
-                        Gqr = Gq^Gr;  Gsp = Gs^Gp;
-
-                        for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
-                            P = OutBuf.params->poff[Gp] + p;
-                            for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
-                                Q = OutBuf.params->qoff[Gq] + q;
-                                pq = OutBuf.params->rowidx[P][Q];
-
-                                for(r=0; r < OutBuf.params->rpi[Gr]; r++) {
-                                    R = OutBuf.params->roff[Gr] + r;
-                                    qr = InBuf->params->rowidx[Q][R];
-
-                                    for(s=0; s < OutBuf.params->spi[Gs]; s++) {
-                                        S = OutBuf.params->soff[Gs] + s;
-                                        rs = OutBuf.params->colidx[R][S];
-                                        sp = InBuf->params->colidx[S][P];
-
-                                        OutBuf.matrix[h][pq][rs] = InBuf->matrix[Gqr][qr][sp];
-
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        if(incore) buf4_sort_incore<1,2,3,0>(InBuf, &OutBuf);
         else {
             outfile->Printf( "LIBDPD: Out-of-core algorithm not yet coded for spqr sort.\n");
             dpd_error("buf4_sort", "outfile");
@@ -1913,42 +1341,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
         /* s->p; p->q; r->r; q->s = qsrp */
 
-        if(incore) {
-            for(h=0; h < nirreps; h++) {
-                r_irrep = h^my_irrep;
-
-                for(Gp=0; Gp < nirreps; Gp++) {
-                    Gq = Gp^h;
-                    for(Gr=0; Gr < nirreps; Gr++) {
-                        Gs = Gr^r_irrep;
-
-                        Gqs = Gq^Gs;  Grp = Gr^Gp;
-
-                        for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
-                            P = OutBuf.params->poff[Gp] + p;
-                            for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
-                                Q = OutBuf.params->qoff[Gq] + q;
-                                pq = OutBuf.params->rowidx[P][Q];
-
-                                for(r=0; r < OutBuf.params->rpi[Gr]; r++) {
-                                    R = OutBuf.params->roff[Gr] + r;
-                                    rp = InBuf->params->colidx[R][P];
-
-                                    for(s=0; s < OutBuf.params->spi[Gs]; s++) {
-                                        S = OutBuf.params->soff[Gs] + s;
-                                        rs = OutBuf.params->colidx[R][S];
-                                        qs = InBuf->params->rowidx[Q][S];
-
-                                        OutBuf.matrix[h][pq][rs] = InBuf->matrix[Gqs][qs][rp];
-
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        if(incore) buf4_sort_incore<1,3,2,0>(InBuf, &OutBuf);
         else {
             outfile->Printf( "LIBDPD: Out-of-core algorithm not yet coded for sprq sort.\n");
             dpd_error("buf4_sort", "outfile");
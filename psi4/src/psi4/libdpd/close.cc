@@ -42,6 +42,7 @@ DPD::~DPD()
     /*  dpd_file2_cache_print(stdout); */
     file2_cache_close();
     /*  dpd_file4_cache_print(stdout);*/
+    file4_cache_print_stats("outfile");
     file4_cache_close();
 
     if(params4)
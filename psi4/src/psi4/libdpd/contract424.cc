@@ -32,6 +32,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cmath>
+#include <vector>
 #include "psi4/libqt/qt.h"
 #include "dpd.h"
 
@@ -260,7 +261,9 @@ int DPD::contract424(dpdbuf4 *X, dpdfile2 *Y, dpdbuf4 *Z, int sum_X,
                                 Zmat[Hz], numrows[Hz], numlinks[Hy^symlink],
                             numcols[Hz], alpha, 1.0);
                 }
-            else
+            else {
+                /* Each sub-irrep writes its own block of Z, so they may run concurrently */
+                std::vector<dpdgemm> gemms;
                 for(Hz=0; Hz < nirreps; Hz++) {
                     if      (!Xtrans && !Ytrans) {Hx=Hz;       Hy = Hz^GX; }
                     else if (!Xtrans &&  Ytrans) {Hx=Hz;       Hy = Hz^GX^GY; }
@@ -275,32 +278,15 @@ int DPD::contract424(dpdbuf4 *X, dpdfile2 *Y, dpdbuf4 *Z, int sum_X,
                     }
 #endif
                     if(numrows[Hz] && numcols[Hz] && numlinks[Hy^symlink]) {
-                        if(!Xtrans && !Ytrans) {
-                            C_DGEMM('n','n',numrows[Hz], numcols[Hz], numlinks[Hy^symlink],
-                                    alpha, &(Xmat[Hz][0][0]), numlinks[Hy^symlink],
-                                    &(Y->matrix[Hy][0][0]), numcols[Hz], 1.0,
-                                    &(Zmat[Hz][0][0]), numcols[Hz]);
-                        }
-                        else if(Xtrans && !Ytrans) {
-                            C_DGEMM('t','n',numrows[Hz], numcols[Hz], numlinks[Hy^symlink],
-                                    alpha, &(Xmat[Hz][0][0]), numrows[Hz],
-                                    &(Y->matrix[Hy][0][0]), numcols[Hz], 1.0,
-                                    &(Zmat[Hz][0][0]), numcols[Hz]);
-                        }
-                        else if(!Xtrans && Ytrans) {
-                            C_DGEMM('n','t',numrows[Hz], numcols[Hz], numlinks[Hy^symlink],
-                                    alpha, &(Xmat[Hz][0][0]), numlinks[Hy^symlink],
-                                    &(Y->matrix[Hy][0][0]), numlinks[Hy^symlink], 1.0,
-                                    &(Zmat[Hz][0][0]), numcols[Hz]);
-                        }
-                        else {
-                            C_DGEMM('t','t',numrows[Hz], numcols[Hz], numlinks[Hy^symlink],
-                                    alpha, &(Xmat[Hz][0][0]), numrows[Hz],
-                                    &(Y->matrix[Hy][0][0]), numlinks[Hy^symlink], 1.0,
-                                    &(Zmat[Hz][0][0]), numcols[Hz]);
-                        }
+                        gemms.push_back(dpdgemm(Xtrans?'t':'n', Ytrans?'t':'n',
+                                                numrows[Hz], numcols[Hz], numlinks[Hy^symlink], alpha,
+                                                &(Xmat[Hz][0][0]), Xtrans ? numrows[Hz] : numlinks[Hy^symlink],
+                                                &(Y->matrix[Hy][0][0]), Ytrans ? numlinks[Hy^symlink] : numcols[Hz], 1.0,
+                                                &(Zmat[Hz][0][0]), numcols[Hz]));
                     }
                 }
+                gemm_blocks(gemms);
+            }
 
             if(sum_X == 0) buf4_mat_irrep_close(X, hxbuf);
             else if(sum_X == 1) trans4_mat_irrep_close(&Xt, hxbuf);
@@ -32,6 +32,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cmath>
+#include <vector>
 #include "psi4/libqt/qt.h"
 #include "dpd.h"
 
@@ -248,7 +249,9 @@ int DPD::contract442(dpdbuf4 *X, dpdbuf4 *Y, dpdfile2 *Z, int target_X,
                             numlinks[Hx], Z->params->coltot[Hz^GZ],
                         alpha, 1.0);
             }
-        else
+        else {
+            /* Each sub-irrep writes its own block of Z, so they may run concurrently */
+            std::vector<dpdgemm> gemms;
             for(Hx=0; Hx < nirreps; Hx++) {
 #ifdef DPD_DEBUG
                 if((xrow[Hx] != zrow[Hx]) || (ycol[Hx] != zcol[Hx]) ||
@@ -268,30 +271,12 @@ int DPD::contract442(dpdbuf4 *X, dpdbuf4 *Y, dpdfile2 *Z, int target_X,
                 if(Z->params->rowtot[Hz] &&
                         Z->params->coltot[Hz^GZ] &&
                         numlinks[Hx]) {
-                    if(!Xtrans && !Ytrans) {
-                        C_DGEMM('n','n',Z->params->rowtot[Hz],Z->params->coltot[Hz^GZ],
-                                numlinks[Hx],alpha,&(Xmat[Hx][0][0]),numlinks[Hx],
-                                &(Ymat[Hy][0][0]),Z->params->coltot[Hz^GZ],1.0,
-                                &(Z->matrix[Hz][0][0]),Z->params->coltot[Hz^GZ]);
-                    }
-                    else if(Xtrans && !Ytrans) {
-                        C_DGEMM('t','n',Z->params->rowtot[Hz],Z->params->coltot[Hz^GZ],
-                                numlinks[Hx],alpha,&(Xmat[Hx][0][0]),Z->params->rowtot[Hz],
-                                &(Ymat[Hy][0][0]),Z->params->coltot[Hz^GZ],1.0,
-                                &(Z->matrix[Hz][0][0]),Z->params->coltot[Hz^GZ]);
-                    }
-                    else if(!Xtrans && Ytrans) {
-                        C_DGEMM('n','t',Z->params->rowtot[Hz],Z->params->coltot[Hz^GZ],
-                                numlinks[Hx],alpha,&(Xmat[Hx][0][0]),numlinks[Hx],
-                                &(Ymat[Hy][0][0]),numlinks[Hx],1.0,
-                                &(Z->matrix[Hz][0][0]),Z->params->coltot[Hz^GZ]);
-                    }
-                    else {
-                        C_DGEMM('t','t',Z->params->rowtot[Hz],Z->params->coltot[Hz^GZ],
-                                numlinks[Hx],alpha,&(Xmat[Hx][0][0]),Z->params->rowtot[Hz],
-                                &(Ymat[Hy][0][0]),numlinks[Hx],1.0,
-                                &(Z->matrix[Hz][0][0]),Z->params->coltot[Hz^GZ]);
-                    }
+                    gemms.push_back(dpdgemm(Xtrans?'t':'n', Ytrans?'t':'n',
+                                            Z->params->rowtot[Hz], Z->params->coltot[Hz^GZ],
+                                            numlinks[Hx], alpha,
+                                            &(Xmat[Hx][0][0]), Xtrans ? Z->params->rowtot[Hz] : numlinks[Hx],
+                                            &(Ymat[Hy][0][0]), Ytrans ? numlinks[Hx] : Z->params->coltot[Hz^GZ], 1.0,
+                                            &(Z->matrix[Hz][0][0]), Z->params->coltot[Hz^GZ]));
                 }
                 /*
         newmm(Xmat[Hx], Xtrans, Ymat[Hy], Ytrans,
@@ -300,6 +285,8 @@ int DPD::contract442(dpdbuf4 *X, dpdbuf4 *Y, dpdfile2 *Z, int target_X,
             alpha, 1.0);
         */
             }
+            gemm_blocks(gemms);
+        }
 
         if(target_X == 0) buf4_mat_irrep_close(X, hxbuf);
         else if(target_X == 1) trans4_mat_irrep_close(&Xt, hxbuf);
@@ -31,8 +31,13 @@
 */
 #include <cstdio>
 #include <cmath>
+#include <algorithm>
+#include <vector>
 #include "psi4/libqt/qt.h"
+#include "psi4/libparallel/process.h"
 #include "psi4/libpsio/psio.h"
+#include "psi4/libpsio/psio.hpp"
+#include "psi4/libpsio/aiohandler.h"
 #include "dpd.h"
 
 namespace psi {
@@ -59,9 +64,11 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z,
 {
     int n, Hx, Hy, Hz, GX, GY, GZ, nirreps, Xtrans, Ytrans, *numlinks, symlink;
     long int size_Y, size_Z, size_file_X_row;
-    int incore, nbuckets;
+    int incore, nbuckets, prefetch;
     long int memoryd, core, rows_per_bucket, rows_left, memtotal;
-    int nrows, ncols, nlinks;
+    int nrows, ncols, nlinks, bucket_rows;
+    double **Xnext;
+    psio_address next_address;
 #if DPD_DEBUG
     int *xrow, *xcol, *yrow, *ycol, *zrow, *zcol;
     double byte_conv;
@@ -93,6 +100,56 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z,
     }
 #endif
 
+    /* With several threads and room for every irrep block of X, Y, and Z
+       at once, read them all, let gemm_blocks() run the per-irrep GEMMs
+       side by side, and write them back.  The I/O itself stays serial. */
+    if(nirreps > 1 && Process::environment.get_n_threads() > 1) {
+        std::vector<int> Hys(nirreps), Hzs(nirreps);
+        long int memneeded = 0;
+        for(Hx=0; Hx < nirreps; Hx++) {
+            if      ((!Xtrans)&&(!Ytrans))  {Hy = Hx^GX;    Hz = Hx;    }
+            else if ((!Xtrans)&&( Ytrans))  {Hy = Hx^GX^GY; Hz = Hx;    }
+            else if (( Xtrans)&&(!Ytrans))  {Hy = Hx;       Hz = Hx^GX; }
+            else /* (( Xtrans)&&( Ytrans))*/{Hy = Hx^GY;    Hz = Hx^GX; }
+            Hys[Hx] = Hy; Hzs[Hx] = Hz;
+            memneeded += ((long) X->params->rowtot[Hx]) * ((long) X->params->coltot[Hx^GX]);
+            memneeded += ((long) Y->params->rowtot[Hy]) * ((long) Y->params->coltot[Hy^GY]);
+            memneeded += ((long) Z->params->rowtot[Hz]) * ((long) Z->params->coltot[Hz^GZ]);
+        }
+
+        if(memneeded <= dpd_memfree()) {
+            std::vector<dpdgemm> gemms;
+            for(Hx=0; Hx < nirreps; Hx++) {
+                Hy = Hys[Hx]; Hz = Hzs[Hx];
+                buf4_mat_irrep_init(X, Hx);
+                buf4_mat_irrep_rd(X, Hx);
+                buf4_mat_irrep_init(Y, Hy);
+                buf4_mat_irrep_rd(Y, Hy);
+                buf4_mat_irrep_init(Z, Hz);
+                if(fabs(beta) > 0.0) buf4_mat_irrep_rd(Z, Hz);
+
+                if(Z->params->rowtot[Hz] && Z->params->coltot[Hz^GZ] && numlinks[Hx^symlink])
+                    gemms.push_back(dpdgemm(Xtrans?'t':'n', Ytrans?'t':'n',
+                                            Z->params->rowtot[Hz], Z->params->coltot[Hz^GZ],
+                                            numlinks[Hx^symlink], alpha,
+                                            &(X->matrix[Hx][0][0]), X->params->coltot[Hx^GX],
+                                            &(Y->matrix[Hy][0][0]), Y->params->coltot[Hy^GY], beta,
+                                            &(Z->matrix[Hz][0][0]), Z->params->coltot[Hz^GZ]));
+            }
+
+            gemm_blocks(gemms);
+
+            for(Hx=0; Hx < nirreps; Hx++) {
+                Hy = Hys[Hx]; Hz = Hzs[Hx];
+                buf4_mat_irrep_close(X, Hx);
+                buf4_mat_irrep_wrt(Z, Hz);
+                buf4_mat_irrep_close(Y, Hy);
+                buf4_mat_irrep_close(Z, Hz);
+            }
+
+            return 0;
+        }
+    }
 
     for(Hx=0; Hx < nirreps; Hx++) {
 
@@ -106,6 +163,7 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z,
         size_file_X_row = ((long) X->file.params->coltot[0]); /* need room for a row of the X->file */
 
         memoryd = dpd_memfree() - (size_Y + size_Z + size_file_X_row);
+        prefetch = 0;
 
         if(X->params->rowtot[Hx] && X->params->coltot[Hx^GX]) {
 
@@ -126,6 +184,17 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z,
 
             incore = 1;
             if(nbuckets > 1) incore = 0;
+
+            /* If the X buckets come straight off disk, split the memory
+               between two of them so the next bucket can be read while
+               the current one is being contracted. */
+            if(!incore && buf4_mat_irrep_rd_block_aio_ok(X) && rows_per_bucket > 1) {
+                prefetch = 1;
+                rows_per_bucket /= 2;
+                nbuckets = (int) ceil((double) X->params->rowtot[Hx]/
+                                      (double) rows_per_bucket);
+                rows_left = X->params->rowtot[Hx] % rows_per_bucket;
+            }
         }
         else incore = 1;
 
@@ -196,15 +265,33 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z,
             buf4_mat_irrep_init(Z, Hz);
             if(fabs(beta) > 0.0) buf4_mat_irrep_rd(Z, Hz);
 
+            std::shared_ptr<AIOHandler> aio;
+            if(prefetch) {
+                Xnext = dpd_block_matrix(rows_per_bucket, X->params->coltot[Hx^GX]);
+                aio = std::make_shared<AIOHandler>(_default_psio_lib_);
+                buf4_mat_irrep_rd_block_aio(X, Hx, 0, rows_per_bucket, Xnext,
+                                            aio.get(), &next_address);
+            }
+
             for(n=0; n < nbuckets; n++) {
 
-                if(n < (nbuckets-1))
-                    buf4_mat_irrep_rd_block(X, Hx, n*rows_per_bucket, rows_per_bucket);
+                bucket_rows = (n < (nbuckets-1) || !rows_left) ? rows_per_bucket : rows_left;
+
+                if(prefetch) {
+                    /* Bucket n is now in Xnext; start reading bucket n+1 */
+                    aio->synchronize();
+                    std::swap(X->matrix[Hx], Xnext);
+                    if(n < (nbuckets-1)) {
+                        int next_rows = (n < (nbuckets-2) || !rows_left) ? rows_per_bucket : rows_left;
+                        buf4_mat_irrep_rd_block_aio(X, Hx, (n+1)*rows_per_bucket, next_rows,
+                                                    Xnext, aio.get(), &next_address);
+                    }
+                }
                 else
-                    buf4_mat_irrep_rd_block(X, Hx, n*rows_per_bucket, rows_left);
+                    buf4_mat_irrep_rd_block(X, Hx, n*rows_per_bucket, bucket_rows);
 
                 if(!Xtrans && Ytrans) {
-                    nrows = n < (nbuckets-1) ? rows_per_bucket : rows_left;
+                    nrows = bucket_rows;
                     ncols = Z->params->coltot[Hz^GZ];
                     nlinks = numlinks[Hx^symlink];
                     if(nrows && ncols && nlinks)
@@ -220,7 +307,7 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z,
           thereafter. */
                     nrows = Z->params->rowtot[Hz];
                     ncols = Z->params->coltot[Hz^GZ];
-                    nlinks = n < (nbuckets-1) ? rows_per_bucket : rows_left;
+                    nlinks = bucket_rows;
                     if(nrows && ncols && nlinks)
                         C_DGEMM('t', 'n', nrows, ncols, nlinks,
                                 alpha, &(X->matrix[Hx][0][0]), X->params->coltot[Hx^GX],
@@ -229,6 +316,9 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z,
                 }
             }
 
+            if(prefetch)
+                free_dpd_block(Xnext, rows_per_bucket, X->params->coltot[Hx^GX]);
+
             buf4_mat_irrep_close_block(X, Hx, rows_per_bucket);
 
             buf4_mat_irrep_close(Y, Hy);
@@ -42,6 +42,7 @@
  #include <memory>
  PRAGMA_WARNING_POP
 #include <vector>
+#include <unordered_map>
 #include "psi4/psi4-dec.h"
 
 // Testing -TDC
@@ -49,6 +50,8 @@
 
 namespace psi {
 
+class AIOHandler;
+
 #define T3_TIMER_ON (0)
 
 #define DPD_BIGNUM 2147483647 /* the four-byte signed int limit */
@@ -118,6 +121,26 @@ struct dpdtrans4 {
     dpdbuf4 buf;
 };
 
+/* One C_DGEMM call of a contraction, arguments in C_DGEMM order; see DPD::gemm_blocks() */
+struct dpdgemm {
+    dpdgemm(char ta, char tb, int mm, int nn, int kk, double a,
+            double *AA, int la, double *BB, int lb, double b, double *CC, int lc):
+        transa(ta), transb(tb), m(mm), n(nn), k(kk), alpha(a),
+        A(AA), lda(la), B(BB), ldb(lb), beta(b), C(CC), ldc(lc)
+    {
+    }
+    char transa, transb;
+    int m, n, k;
+    double alpha;
+    double *A;
+    int lda;
+    double *B;
+    int ldb;
+    double beta;
+    double *C;
+    int ldc;
+};
+
 struct dpdparams2 {
     int nirreps;      /* No. of irreps */
     int pnum;
@@ -160,6 +183,8 @@ struct dpd_file4_cache_entry {
     unsigned int access;                /* access time */
     unsigned int usage;                 /* number of accesses */
     unsigned int priority;              /* priority level */
+    unsigned int loads;                 /* no. of times this file4 has been read into cache */
+    double cost_base;                   /* cost-cache aging floor at last access */
     int lock;                           /* auto-deletion allowed? */
     int clean;                          /* has this file4 changed? */
     dpd_file4_cache_entry *next; /* pointer to next cache entry */
@@ -227,7 +252,11 @@ struct dpd_gbl {
         file4_cache_most_recent(0),
         file4_cache_least_recent(1),
         file4_cache_lru_del(0),
-        file4_cache_low_del(0)
+        file4_cache_low_del(0),
+        file4_cache_cost_del(0),
+        file4_cache_hits(0),
+        file4_cache_misses(0),
+        file4_cache_cost_floor(0.0)
     {}
     dpd_file2_cache_entry *file2_cache;
     dpd_file4_cache_entry *file4_cache;
@@ -235,7 +264,15 @@ struct dpd_gbl {
     unsigned int file4_cache_least_recent;
     unsigned int file4_cache_lru_del;
     unsigned int file4_cache_low_del;
-    int cachetype;
+    unsigned int file4_cache_cost_del;
+    unsigned long int file4_cache_hits;
+    unsigned long int file4_cache_misses;
+    double file4_cache_cost_floor;
+    /* Hashed index of file4_cache, keyed by file4_cache_key() */
+    std::unordered_map<std::string, dpd_file4_cache_entry*> file4_cache_index;
+    /* No. of times each file4 has been read into cache (survives eviction) */
+    std::unordered_map<std::string, unsigned int> file4_cache_loads;
+    int cachetype;      /* 0 = LRU, 1 = LOW (static priority), 2 = COST */
     int *cachefiles;
     int **cachelist;
     dpd_file4_cache_entry *file4_cache_priority;
@@ -306,6 +343,7 @@ public:
     int contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z,
                     int target_X, int target_Y, double alpha, double beta);
     int contract444_df(dpdbuf4 *B, dpdbuf4 *tau_in, dpdbuf4 *tau_out, double alpha, double beta);
+    int gemm_blocks(std::vector<dpdgemm> &gemms);
 
     /* Need to consolidate these routines into one general function */
     int dot23(dpdfile2 *T, dpdbuf4 *I, dpdfile2 *Z,
@@ -357,6 +395,10 @@ public:
     int file4_print(dpdfile4 *File, std::string OutFileRMR);
     int file4_mat_irrep_rd_block(dpdfile4 *File, int irrep, int start_pq,
                                  int num_pq);
+    psio_address file4_mat_irrep_block_address(dpdfile4 *File, int irrep, int start_pq);
+    unsigned long int file4_mat_irrep_rd_block_aio(dpdfile4 *File, int irrep, int start_pq,
+                                                   int num_pq, double **block, AIOHandler *aio,
+                                                   psio_address *next_address);
     int file4_mat_irrep_wrt_block(dpdfile4 *File, int irrep, int start_pq,
                                   int num_pq);
 
@@ -404,6 +446,10 @@ public:
     int buf4_mat_irrep_close_block(dpdbuf4 *Buf, int irrep, int num_pq);
     int buf4_mat_irrep_rd_block(dpdbuf4 *Buf, int irrep, int start_pq,
                                 int num_pq);
+    int buf4_mat_irrep_rd_block_aio_ok(dpdbuf4 *Buf);
+    unsigned long int buf4_mat_irrep_rd_block_aio(dpdbuf4 *Buf, int irrep, int start_pq,
+                                                  int num_pq, double **block, AIOHandler *aio,
+                                                  psio_address *next_address);
     int buf4_mat_irrep_wrt_block(dpdbuf4 *Buf, int irrep, int start_pq,
                                  int num_pq);
     int buf4_dump(dpdbuf4 *DPDBuf, struct iwlbuf *IWLBuf,
@@ -429,13 +475,17 @@ public:
     int file2_cache_add(dpdfile2 *File);
     int file2_cache_del(dpdfile2 *File);
     int file4_cache_del_low(void);
+    dpd_file4_cache_entry* file4_cache_find_cost(void);
+    int file4_cache_del_cost(void);
     void file2_cache_dirty(dpdfile2 *File);
 
     void file4_cache_init(void);
     void file4_cache_close(void);
     void file4_cache_print(std::string OutFileRMR);
     void file4_cache_print_screen(void);
+    void file4_cache_print_stats(std::string OutFileRMR);
     int file4_cache_get_priority(dpdfile4 *File);
+    int file4_cache_admit(dpdfile4 *File);
 
     dpd_file4_cache_entry* file4_cache_scan(int filenum, int irrep, int pqnum, int rsnum, const char *label, int dpdnum);
     dpd_file4_cache_entry* file4_cache_last(void);
@@ -532,6 +582,7 @@ extern int dpd_init(int dpd_num, int nirreps, long int memory, int cachetype,
 extern int dpd_close(int dpd_num);
 extern long int dpd_memfree(void);
 extern void dpd_memset(long int memory);
+extern void benchmark_dpd_sort(int N, double min_time);
 
 
 }// Namespace psi
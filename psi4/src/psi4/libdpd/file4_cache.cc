@@ -37,6 +37,15 @@
 #include "psi4/libparallel/ParallelPrinter.h"
 namespace psi {
 
+/* Key for the hashed file4 cache index */
+static std::string file4_cache_key(int filenum, int irrep, int pqnum, int rsnum,
+                                   const char *label, int dpdnum)
+{
+    char key[PSIO_KEYLEN + 64];
+    sprintf(key, "%d:%d:%d:%d:%d:%s", dpdnum, filenum, irrep, pqnum, rsnum, label);
+    return std::string(key);
+}
+
 void DPD::file4_cache_init(void)
 {
     dpd_main.file4_cache = NULL;
@@ -44,6 +53,10 @@ void DPD::file4_cache_init(void)
     dpd_main.file4_cache_least_recent = 1;
     dpd_main.file4_cache_lru_del = 0;
     dpd_main.file4_cache_low_del = 0;
+    dpd_main.file4_cache_cost_del = 0;
+    dpd_main.file4_cache_cost_floor = 0.0;
+    dpd_main.file4_cache_index.clear();
+    dpd_main.file4_cache_loads.clear();
 }
 
 void DPD::file4_cache_close(void)
@@ -62,8 +75,8 @@ void DPD::file4_cache_close(void)
         dpd_set_default(this_entry->dpdnum);
 
         /* Clean out each file4_cache entry */
-        file4_init(&Outfile, this_entry->filenum, this_entry->irrep,
-                   this_entry->pqnum, this_entry->rsnum, this_entry->label);
+        file4_init_nocache(&Outfile, this_entry->filenum, this_entry->irrep,
+                           this_entry->pqnum, this_entry->rsnum, this_entry->label);
 
         next_entry = this_entry->next;
 
@@ -86,34 +99,27 @@ DPD::file4_cache_scan(int filenum, int irrep, int pqnum, int rsnum, const char *
     timer_on("file4_cache");
 #endif
 
-    this_entry = dpd_main.file4_cache;
+    std::unordered_map<std::string, dpd_file4_cache_entry*>::iterator it =
+            dpd_main.file4_cache_index.find(file4_cache_key(filenum, irrep, pqnum, rsnum, label, dpdnum));
 
-    while(this_entry != NULL) {
-        if(this_entry->filenum == filenum      &&
-                this_entry->irrep == irrep          &&
-                this_entry->pqnum == pqnum          &&
-                this_entry->rsnum == rsnum          &&
-                this_entry->dpdnum == dpdnum &&
-                !strcmp(this_entry->label,label)) {
 #ifdef DPD_TIMER
-            timer_off("file4_cache");
+    timer_off("file4_cache");
 #endif
-            /* increment the access timers */
-            dpd_main.file4_cache_most_recent++;
-            this_entry->access = dpd_main.file4_cache_most_recent;
 
-            /* increment the usage counter */
-            this_entry->usage++;
+    if(it == dpd_main.file4_cache_index.end()) return(NULL);
 
-            return(this_entry);
-        }
+    this_entry = it->second;
 
-        this_entry = this_entry->next;
-    }
+    /* increment the access timers */
+    dpd_main.file4_cache_most_recent++;
+    this_entry->access = dpd_main.file4_cache_most_recent;
+
+    /* increment the usage counter */
+    this_entry->usage++;
+
+    /* reset the aging floor for the cost-based cache */
+    this_entry->cost_base = dpd_main.file4_cache_cost_floor;
 
-#ifdef DPD_TIMER
-    timer_off("file4_cache");
-#endif
     return(this_entry);
 }
 
@@ -184,6 +190,15 @@ int DPD::file4_cache_add(dpdfile4 *File, unsigned int priority)
         if(this_entry->last != NULL) this_entry->last->next = this_entry;
         else dpd_main.file4_cache = this_entry;
 
+        std::string key = file4_cache_key(this_entry->filenum, this_entry->irrep,
+                                          this_entry->pqnum, this_entry->rsnum,
+                                          this_entry->label, this_entry->dpdnum);
+        dpd_main.file4_cache_index[key] = this_entry;
+
+        /* count the number of times this file4 has had to be (re)read */
+        this_entry->loads = ++dpd_main.file4_cache_loads[key];
+        this_entry->cost_base = dpd_main.file4_cache_cost_floor;
+
         /* increment the access timers */
         dpd_main.file4_cache_most_recent++;
         this_entry->access = dpd_main.file4_cache_most_recent;
@@ -254,6 +269,11 @@ int DPD::file4_cache_del(dpdfile4 *File)
         if(this_entry == dpd_main.file4_cache)
             dpd_main.file4_cache = next_entry;
 
+        dpd_main.file4_cache_index.erase(
+                file4_cache_key(this_entry->filenum, this_entry->irrep,
+                                this_entry->pqnum, this_entry->rsnum,
+                                this_entry->label, this_entry->dpdnum));
+
         free(this_entry);
 
         /* Reassign pointers for adjacent entries in the list */
@@ -295,8 +315,8 @@ void DPD::file4_cache_print_screen(void)
     outfile->Printf( "Total cached: %9.1f kB; MRU = %6d; LRU = %6d\n",
             (total_size*sizeof(double))/1e3,dpd_main.file4_cache_most_recent,
             dpd_main.file4_cache_least_recent);
-    outfile->Printf( "#LRU deletions = %6d; #Low-priority deletions = %6d\n",
-            dpd_main.file4_cache_lru_del,dpd_main.file4_cache_low_del);
+    outfile->Printf( "#LRU deletions = %6d; #Low-priority deletions = %6d; #Cost deletions = %6d\n",
+            dpd_main.file4_cache_lru_del,dpd_main.file4_cache_low_del,dpd_main.file4_cache_cost_del);
     outfile->Printf( "Core max size:  %9.1f kB\n", (dpd_main.memory)*sizeof(double)/1e3);
     outfile->Printf( "Core used:      %9.1f kB\n", (dpd_main.memused)*sizeof(double)/1e3);
     outfile->Printf( "Core available: %9.1f kB\n", dpd_memfree()*sizeof(double)/1e3);
@@ -335,8 +355,8 @@ void DPD::file4_cache_print(std::string out)
     printer->Printf( "Total cached: %8.1f kB; MRU = %6d; LRU = %6d\n",
             (total_size*sizeof(double))/1e3,dpd_main.file4_cache_most_recent,
             dpd_main.file4_cache_least_recent);
-    printer->Printf( "#LRU deletions = %6d; #Low-priority deletions = %6d\n",
-            dpd_main.file4_cache_lru_del,dpd_main.file4_cache_low_del);
+    printer->Printf( "#LRU deletions = %6d; #Low-priority deletions = %6d; #Cost deletions = %6d\n",
+            dpd_main.file4_cache_lru_del,dpd_main.file4_cache_low_del,dpd_main.file4_cache_cost_del);
     printer->Printf( "Core max size:  %9.1f kB\n", (dpd_main.memory)*sizeof(double)/1e3);
     printer->Printf( "Core used:      %9.1f kB\n", (dpd_main.memused)*sizeof(double)/1e3);
     printer->Printf( "Core available: %9.1f kB\n", dpd_memfree()*sizeof(double)/1e3);
@@ -413,8 +433,8 @@ int DPD::file4_cache_del_lru(void)
         dpdnum = dpd_default;
         dpd_set_default(this_entry->dpdnum);
 
-        file4_init(&File, this_entry->filenum, this_entry->irrep,
-                   this_entry->pqnum, this_entry->rsnum, this_entry->label);
+        file4_init_nocache(&File, this_entry->filenum, this_entry->irrep,
+                           this_entry->pqnum, this_entry->rsnum, this_entry->label);
 
         file4_cache_del(&File);
         file4_close(&File);
@@ -447,6 +467,28 @@ void DPD::file4_cache_dirty(dpdfile4 *File)
     }
 }
 
+/* dpd_file4_cache_admit(): Decides whether a file4 on a cached unit enters
+** the cache.  The LOW and LRU policies admit exactly the index pairs marked
+** in the cachelist.  The COST policy also admits any other file4 that takes
+** at most a sixteenth of the memory, and leaves it to the eviction rule to
+** decide which of them stay; the cachelist then only marks the file4s that
+** are admitted regardless of size.
+*/
+int DPD::file4_cache_admit(dpdfile4 *File)
+{
+    int h;
+    long int size;
+
+    if(dpd_main.cachelist[File->params->pqnum][File->params->rsnum]) return 1;
+    if(dpd_main.cachetype != 2) return 0;
+
+    size = 0;
+    for(h=0; h < File->params->nirreps; h++)
+        size += ((long int) File->params->rowtot[h]) * File->params->coltot[h^File->my_irrep];
+
+    return (size <= dpd_main.memory / 16);
+}
+
 int DPD::file4_cache_get_priority(dpdfile4 *File)
 {
     dpd_file4_cache_entry *this_entry;
@@ -528,8 +570,8 @@ int DPD::file4_cache_del_low(void)
 
         dpd_set_default(this_entry->dpdnum);
 
-        file4_init(&File, this_entry->filenum, this_entry->irrep,
-                   this_entry->pqnum, this_entry->rsnum, this_entry->label);
+        file4_init_nocache(&File, this_entry->filenum, this_entry->irrep,
+                           this_entry->pqnum, this_entry->rsnum, this_entry->label);
         file4_cache_del(&File);
         file4_close(&File);
 
@@ -544,6 +586,116 @@ int DPD::file4_cache_del_low(void)
     }
 }
 
+/* dpd_file4_cache_find_cost(): Cost-based (greedy-dual-size-frequency)
+** replacement.  The cost of dropping an entry is the number of times it
+** has already had to be read into cache, doubled if it must be written
+** back first.  Weighted by its access frequency and divided by the bytes
+** it occupies, the retention value of an entry is
+**
+**   H = L + usage * loads * (clean ? 1 : 2) / bytes
+**
+** so that, at equal frequency and cost, large entries are evicted first.
+** L is an aging floor that is raised to H of each victim, so that entries
+** which are no longer touched eventually become evictable no matter how
+** expensive they once were.
+*/
+dpd_file4_cache_entry*
+DPD::file4_cache_find_cost(void)
+{
+    double value, bytes, low_value = 0.0;
+    dpd_file4_cache_entry *this_entry, *low_entry;
+
+    low_entry = NULL;
+    for(this_entry = dpd_main.file4_cache; this_entry != NULL;
+        this_entry = this_entry->next) {
+
+        if(this_entry->lock) continue;
+
+        bytes = ((double) this_entry->size) * sizeof(double);
+        if(bytes < 1.0) bytes = 1.0;
+
+        value = this_entry->cost_base + ((double) this_entry->usage) *
+                ((double) this_entry->loads) * (this_entry->clean ? 1.0 : 2.0) / bytes;
+
+        if(low_entry == NULL || value < low_value) {
+            low_entry = this_entry;
+            low_value = value;
+        }
+    }
+
+    if(low_entry != NULL) dpd_main.file4_cache_cost_floor = low_value;
+
+    return low_entry;
+}
+
+int DPD::file4_cache_del_cost(void)
+{
+    int dpdnum;
+    dpdfile4 File;
+    dpd_file4_cache_entry *this_entry;
+
+#ifdef DPD_TIMER
+    timer_on("cache_cost");
+#endif
+
+    this_entry = file4_cache_find_cost();
+
+    if(this_entry == NULL) {
+#ifdef DPD_TIMER
+        timer_off("cache_cost");
+#endif
+        return 1; /* there is no cache or everything is locked */
+    }
+
+    /* increment the global cost-based deletion counter */
+    dpd_main.file4_cache_cost_del++;
+
+    /* save the current dpd default value */
+    dpdnum = dpd_default;
+    dpd_set_default(this_entry->dpdnum);
+
+    file4_init_nocache(&File, this_entry->filenum, this_entry->irrep,
+                       this_entry->pqnum, this_entry->rsnum, this_entry->label);
+    file4_cache_del(&File);
+    file4_close(&File);
+
+    /* return the default dpd to its original value */
+    dpd_set_default(dpdnum);
+
+#ifdef DPD_TIMER
+    timer_off("cache_cost");
+#endif
+
+    return 0;
+}
+
+/* dpd_file4_cache_print_stats(): Prints the cache hit/miss and eviction
+** counts accumulated since the last call, then resets them.
+*/
+void DPD::file4_cache_print_stats(std::string out)
+{
+    unsigned long int lookups;
+    std::shared_ptr<psi::PsiOutStream> printer=(out=="outfile"?outfile:
+             std::shared_ptr<OutFile>(new OutFile(out)));
+
+    lookups = dpd_main.file4_cache_hits + dpd_main.file4_cache_misses;
+    if(!lookups) return;
+
+    printer->Printf( "\n\tDPD File4 Cache Statistics:\n");
+    printer->Printf( "\tHits   = %10lu\n", dpd_main.file4_cache_hits);
+    printer->Printf( "\tMisses = %10lu (%5.1f%% hit rate)\n", dpd_main.file4_cache_misses,
+            100.0*((double) dpd_main.file4_cache_hits)/((double) lookups));
+    printer->Printf( "\tEvictions: LRU = %u; Low-priority = %u; Cost = %u\n",
+            dpd_main.file4_cache_lru_del, dpd_main.file4_cache_low_del,
+            dpd_main.file4_cache_cost_del);
+
+    dpd_main.file4_cache_hits = 0;
+    dpd_main.file4_cache_misses = 0;
+    dpd_main.file4_cache_lru_del = 0;
+    dpd_main.file4_cache_low_del = 0;
+    dpd_main.file4_cache_cost_del = 0;
+}
+
 void DPD::file4_cache_lock(dpdfile4 *File)
 {
     int h;
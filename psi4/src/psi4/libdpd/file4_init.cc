@@ -107,8 +107,11 @@ int DPD::file4_init(dpdfile4 *File, int filenum, int irrep, int pqnum,
     }
 
     /* Put this file4 into cache if requested */
-    if(dpd_main.cachefiles[filenum] && dpd_main.cachelist[pqnum][rsnum])
+    if(dpd_main.cachefiles[filenum] && file4_cache_admit(File))
     {
+        if(File->incore) dpd_main.file4_cache_hits++;
+        else dpd_main.file4_cache_misses++;
+
         /* Get the file4's cache priority */
         if(dpd_main.cachetype == 1)
             priority = file4_cache_get_priority(File);
@@ -31,6 +31,8 @@
 */
 #include <cstdio>
 #include "psi4/libpsio/psio.h"
+#include "psi4/libpsio/psio.hpp"
+#include "psi4/libpsio/aiohandler.h"
 #include "dpd.h"
 
 namespace psi {
@@ -39,19 +41,38 @@ int DPD::file4_mat_irrep_rd_block(dpdfile4 *File, int irrep, int start_pq,
                                   int num_pq)
 {
     int rowtot, coltot, my_irrep;
-    int seek_block;
     psio_address irrep_ptr, next_address;
     long int size;
 
     my_irrep = File->my_irrep;
     if(File->incore) return 0;  /* We already have this data in core */
 
-    irrep_ptr = File->lfiles[irrep];
     rowtot = num_pq;
     coltot = File->params->coltot[irrep^my_irrep];
 
     size = ((long) rowtot) * ((long) coltot);
 
+    irrep_ptr = file4_mat_irrep_block_address(File, irrep, start_pq);
+
+    if(rowtot && coltot)
+        psio_read(File->filenum, File->label, (char *) File->matrix[irrep][0],
+                size * ((long) sizeof(double)), irrep_ptr, &next_address);
+
+    return 0;
+
+}
+
+/* dpd_file4_mat_irrep_block_address(): Returns the file address of row
+** start_pq of the given irrep of a dpd four-index file.
+*/
+psio_address DPD::file4_mat_irrep_block_address(dpdfile4 *File, int irrep, int start_pq)
+{
+    int coltot, seek_block;
+    psio_address irrep_ptr;
+
+    irrep_ptr = File->lfiles[irrep];
+    coltot = File->params->coltot[irrep^(File->my_irrep)];
+
     /* Advance file pointer to current row --- careful about overflows! */
     if(coltot) {
         seek_block = DPD_BIGNUM/(coltot * sizeof(double)); /* no. of rows for which we can compute the address */
@@ -64,12 +85,27 @@ int DPD::file4_mat_irrep_rd_block(dpdfile4 *File, int irrep, int start_pq,
         irrep_ptr = psio_get_address(irrep_ptr, start_pq*coltot*sizeof(double));
     }
 
-    if(rowtot && coltot)
-        psio_read(File->filenum, File->label, (char *) File->matrix[irrep][0],
-                size * ((long) sizeof(double)), irrep_ptr, &next_address);
+    return irrep_ptr;
+}
 
-    return 0;
+/* dpd_file4_mat_irrep_rd_block_aio(): Posts an asynchronous read of
+** num_pq rows (starting at start_pq) of the given irrep into block.
+** The caller must synchronize the AIOHandler before touching block, and
+** next_address must stay valid until then.  Returns the AIO job ID, or 0
+** if nothing had to be read.
+*/
+unsigned long int DPD::file4_mat_irrep_rd_block_aio(dpdfile4 *File, int irrep, int start_pq,
+                                                    int num_pq, double **block, AIOHandler *aio,
+                                                    psio_address *next_address)
+{
+    long int size;
+
+    size = ((long) num_pq) * ((long) File->params->coltot[irrep^(File->my_irrep)]);
+    if(File->incore || !size) return 0;
 
+    return aio->read(File->filenum, File->label, (char *) block[0],
+                     size * ((long) sizeof(double)),
+                     file4_mat_irrep_block_address(File, irrep, start_pq), next_address);
 }
 
 }
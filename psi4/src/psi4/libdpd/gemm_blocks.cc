@@ -0,0 +1,103 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2016 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+
+/*! \file
+    \ingroup DPD
+    \brief Concurrent execution of the per-irrep GEMMs of a contraction
+*/
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include "psi4/libqt/qt.h"
+#include "psi4/libparallel/process.h"
+#include "dpd.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace psi {
+
+/* Blocks with fewer multiply-adds than this per available thread are too
+** small for a threaded BLAS call to pay off. */
+static const double gemm_min_flops_per_thread = 2.0e6;
+
+/* dpd_gemm_blocks(): Runs a set of independent C_DGEMM calls, typically
+** one per irrep block of a contraction. Each must write a distinct C.
+**
+** Blocks large enough to keep all threads busy are run one after the
+** other with the threaded BLAS. The remaining small blocks are run
+** concurrently, largest first, each as a single-threaded GEMM.
+**
+** Arguments:
+**   std::vector<dpdgemm> &gemms: The GEMMs to run.
+*/
+int DPD::gemm_blocks(std::vector<dpdgemm> &gemms)
+{
+    int nthreads = Process::environment.get_n_threads();
+#ifdef _OPENMP
+    if(omp_in_parallel()) nthreads = 1;
+#else
+    nthreads = 1;
+#endif
+
+    std::vector<std::pair<double, size_t> > small;
+    for(size_t i=0; i < gemms.size(); i++) {
+        dpdgemm &g = gemms[i];
+        double flops = ((double) g.m) * ((double) g.n) * ((double) g.k);
+        if(nthreads > 1 && flops < nthreads * gemm_min_flops_per_thread)
+            small.push_back(std::make_pair(flops, i));
+        else
+            C_DGEMM(g.transa, g.transb, g.m, g.n, g.k, g.alpha, g.A, g.lda,
+                    g.B, g.ldb, g.beta, g.C, g.ldc);
+    }
+
+    if(small.size() == 1) {
+        dpdgemm &g = gemms[small[0].second];
+        C_DGEMM(g.transa, g.transb, g.m, g.n, g.k, g.alpha, g.A, g.lda,
+                g.B, g.ldb, g.beta, g.C, g.ldc);
+    }
+    else if(small.size() > 1) {
+        std::sort(small.begin(), small.end(), std::greater<std::pair<double, size_t> >());
+
+        /* MKL and a pthread-built OpenBLAS would each start their own
+           threads inside the region, so hold them to one meanwhile. */
+        int old_blas_threads = blas_set_num_threads(1);
+        long int nsmall = small.size();
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+        for(long int s=0; s < nsmall; s++) {
+            dpdgemm &g = gemms[small[s].second];
+            C_DGEMM(g.transa, g.transb, g.m, g.n, g.k, g.alpha, g.A, g.lda,
+                    g.B, g.ldb, g.beta, g.C, g.ldc);
+        }
+        blas_set_num_threads(old_blas_threads);
+    }
+
+    return 0;
+}
+
+}
@@ -3947,14 +3947,31 @@ DFTGrid::DFTGrid(std::shared_ptr<Molecule> molecule,
                  Options& options) :
     MolecularGrid(molecule), primary_(primary), options_(options)
 {
-    buildGridFromOptions();
+    buildGridFromOptions(std::map<std::string, int>());
+}
+DFTGrid::DFTGrid(std::shared_ptr<Molecule> molecule,
+                 std::shared_ptr<BasisSet> primary,
+                 const std::map<std::string, int>& int_opts_map,
+                 Options& options) :
+    MolecularGrid(molecule), primary_(primary), options_(options)
+{
+    buildGridFromOptions(int_opts_map);
 }
 DFTGrid::~DFTGrid()
 {
 }
 
-void DFTGrid::buildGridFromOptions()
+void DFTGrid::buildGridFromOptions(const std::map<std::string, int>& int_opts_map)
 {
+    std::map<std::string, int> int_opts;
+    int_opts["DFT_RADIAL_POINTS"] = options_.get_int("DFT_RADIAL_POINTS");
+    int_opts["DFT_SPHERICAL_POINTS"] = options_.get_int("DFT_SPHERICAL_POINTS");
+    for (std::map<std::string, int>::const_iterator it = int_opts_map.begin(); it != int_opts_map.end(); ++it) {
+        if (!int_opts.count(it->first))
+            throw PSIEXCEPTION("DFTGrid: Unknown grid option " + it->first);
+        int_opts[it->first] = it->second;
+    }
+
     MolecularGridOptions opt;
     opt.bs_radius_alpha = options_.get_double("DFT_BS_RADIUS_ALPHA");
     opt.pruning_alpha = options_.get_double("DFT_PRUNING_ALPHA");
@@ -3962,8 +3979,8 @@ void DFTGrid::buildGridFromOptions()
     opt.prunescheme = RadialPruneMgr::WhichPruneScheme(options_.get_str("DFT_PRUNING_SCHEME").c_str());
     opt.nucscheme = NuclearWeightMgr::WhichScheme(options_.get_str("DFT_NUCLEAR_SCHEME").c_str());
     opt.namedGrid = StandardGridMgr::WhichGrid(options_.get_str("DFT_GRID_NAME").c_str());
-    opt.nradpts = options_.get_int("DFT_RADIAL_POINTS");
-    opt.nangpts = options_.get_int("DFT_SPHERICAL_POINTS");
+    opt.nradpts = int_opts["DFT_RADIAL_POINTS"];
+    opt.nangpts = int_opts["DFT_SPHERICAL_POINTS"];
 
     if (LebedevGridMgr::findOrderByNPoints(opt.nangpts) < -1) {
         LebedevGridMgr::PrintHelp(); // Tell what the admissible values are.
@@ -30,6 +30,8 @@
 
 #include "psi4/psi4-dec.h"
 
+#include <map>
+
 #include "psi4/libmints/vector3.h"
 
 namespace psi {
@@ -203,8 +205,8 @@ class DFTGrid : public MolecularGrid {
 protected:
     /// The primary basis
     std::shared_ptr<BasisSet> primary_;
-    /// Master builder methods
-    void buildGridFromOptions();
+    /// Master builder methods, with integer DFT_ options overridden by int_opts_map
+    void buildGridFromOptions(const std::map<std::string, int>& int_opts_map);
     /// The Options object
     Options& options_;
 
@@ -212,6 +214,12 @@ public:
     DFTGrid(std::shared_ptr<Molecule> molecule,
             std::shared_ptr<BasisSet> primary,
             Options& options);
+    /// As above, but DFT_RADIAL_POINTS and DFT_SPHERICAL_POINTS are taken from
+    /// int_opts_map when present, for modules that keep their own grid sizes
+    DFTGrid(std::shared_ptr<Molecule> molecule,
+            std::shared_ptr<BasisSet> primary,
+            const std::map<std::string, int>& int_opts_map,
+            Options& options);
     virtual ~DFTGrid();
 };
 
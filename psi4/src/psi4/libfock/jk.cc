@@ -555,6 +555,62 @@ void JK::AO2USO()
     }
     delete[] temp;
 }
+namespace {
+
+/// Keeps the entries of v flagged in keep (v is left alone if it is not per-density)
+void prune_densities(std::vector<SharedMatrix>& v, const std::vector<bool>& keep)
+{
+    if (v.size() != keep.size()) return;
+    std::vector<SharedMatrix> kept;
+    for (size_t N = 0; N < v.size(); ++N) {
+        if (keep[N]) kept.push_back(v[N]);
+    }
+    v = kept;
+}
+
+}
+
+void JK::compute_JK_nonzero()
+{
+    // Solvers pass every (trial vector, perturbation irrep) pair in one call, and many of
+    // these are identically zero (converged roots, irreps without a component). Their
+    // J/K are already zeroed, so contract only the rest in this single integral pass.
+    std::vector<bool> keep(D_.size());
+    size_t nkeep = 0;
+    for (size_t N = 0; N < D_.size(); ++N) {
+        keep[N] = (D_[N]->absmax() != 0.0);
+        if (keep[N]) nkeep++;
+    }
+
+    if (nkeep == D_.size()) {
+        compute_JK();
+        return;
+    }
+    if (nkeep == 0) return;
+
+    std::vector<SharedMatrix> C_left = C_left_, C_right = C_right_, D = D_, J = J_, K = K_, wK = wK_;
+    std::vector<SharedMatrix> C_left_ao = C_left_ao_, C_right_ao = C_right_ao_, D_ao = D_ao_;
+    std::vector<SharedMatrix> J_ao = J_ao_, K_ao = K_ao_, wK_ao = wK_ao_;
+
+    prune_densities(C_left_, keep);
+    prune_densities(C_right_, keep);
+    prune_densities(J_, keep);
+    prune_densities(K_, keep);
+    prune_densities(wK_, keep);
+    prune_densities(C_left_ao_, keep);
+    prune_densities(C_right_ao_, keep);
+    prune_densities(D_ao_, keep);
+    prune_densities(J_ao_, keep);
+    prune_densities(K_ao_, keep);
+    prune_densities(wK_ao_, keep);
+    prune_densities(D_, keep);
+
+    compute_JK();
+
+    C_left_ = C_left; C_right_ = C_right; D_ = D; J_ = J; K_ = K; wK_ = wK;
+    C_left_ao_ = C_left_ao; C_right_ao_ = C_right_ao; D_ao_ = D_ao;
+    J_ao_ = J_ao; K_ao_ = K_ao; wK_ao_ = wK_ao;
+}
 void JK::initialize()
 {
     preiterations();
@@ -580,7 +636,7 @@ void JK::compute()
     }
 
     timer_on("JK: JK");
-    compute_JK();
+    compute_JK_nonzero();
     timer_off("JK: JK");
 
     if (C1()) {
@@ -305,6 +305,8 @@ protected:
     void AO2USO();
     /// Allocate J_/K_ should we be using SOs
     void allocate_JK();
+    /// Call compute_JK() on the densities that are not identically zero
+    void compute_JK_nonzero();
     /**
      *  Function that sets a number of flags and allocates memory
      *  and sets up AO2USO.
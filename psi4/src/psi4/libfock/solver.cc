@@ -34,6 +34,10 @@
 #include "jk.h"
 #include "psi4/libmints/vector.h"
 #include "psi4/libmints/matrix.h"
+#include "psi4/libpsio/psio.hpp"
+#include "psi4/libpsio/psio.h"
+#include "psi4/libparallel/process.h"
+#include "psi4/psifiles.h"
 
 #include <cmath>
 #include <sstream>
@@ -625,6 +629,105 @@ void CGRSolver::update_p()
     }
 }
 
+SubspaceVectors::SubspaceVectors(const std::string& label) :
+    label_(label), max_core_(0L), ncore_(0L)
+{
+}
+std::string SubspaceVectors::key(size_t i) const
+{
+    std::stringstream s;
+    s << label_ << " " << i;
+    return s.str();
+}
+size_t SubspaceVectors::nspilled() const
+{
+    size_t n = 0;
+    for (size_t i = 0; i < core_.size(); i++) {
+        if (!core_[i]) n++;
+    }
+    return n;
+}
+std::shared_ptr<Vector> SubspaceVectors::operator[](size_t i) const
+{
+    if (core_[i]) return core_[i];
+
+    std::shared_ptr<Vector> v(new Vector(key(i), dimpi_[i]));
+    std::shared_ptr<PSIO> psio = PSIO::shared_object();
+    psio_address addr = PSIO_ZERO;
+    for (int h = 0; h < dimpi_[i].n(); h++) {
+        if (!dimpi_[i][h]) continue;
+        psio->read(PSIF_SOLVER, key(i).c_str(), (char*) v->pointer(h), dimpi_[i][h] * sizeof(double), addr, &addr);
+    }
+    return v;
+}
+void SubspaceVectors::push_back(std::shared_ptr<Vector> v)
+{
+    Dimension dimpi(v->nirrep());
+    for (int h = 0; h < v->nirrep(); h++) {
+        dimpi[h] = v->dimpi()[h];
+    }
+    core_.push_back(v);
+    dimpi_.push_back(dimpi);
+    ncore_ += dimpi.sum();
+    spill();
+}
+void SubspaceVectors::assign(const std::vector<std::shared_ptr<Vector> >& v)
+{
+    clear();
+    for (size_t i = 0; i < v.size(); i++) {
+        push_back(v[i]);
+    }
+}
+void SubspaceVectors::clear()
+{
+    // Stale PSIO entries are simply overwritten by the next vectors with the same index
+    core_.clear();
+    dimpi_.clear();
+    ncore_ = 0L;
+}
+void SubspaceVectors::spill()
+{
+    if (!max_core_) return;
+
+    std::shared_ptr<PSIO> psio = PSIO::shared_object();
+    for (size_t i = 0; i < core_.size() && ncore_ > max_core_; i++) {
+        if (!core_[i]) continue;
+        if (!psio->open_check(PSIF_SOLVER))
+            psio->open(PSIF_SOLVER, PSIO_OPEN_NEW);
+        psio_address addr = PSIO_ZERO;
+        for (int h = 0; h < dimpi_[i].n(); h++) {
+            if (!dimpi_[i][h]) continue;
+            psio->write(PSIF_SOLVER, key(i).c_str(), (char*) core_[i]->pointer(h), dimpi_[i][h] * sizeof(double), addr, &addr);
+        }
+        ncore_ -= dimpi_[i].sum();
+        core_[i].reset();
+    }
+}
+
+namespace {
+
+/// Splits the solver memory (in doubles) between the b and sigma vectors, after the
+/// per-root c, r and d vectors and the diagonal
+void init_subspace_storage(unsigned long int memory, std::shared_ptr<Vector> diag, int nroot,
+                           SubspaceVectors& b, SubspaceVectors& s)
+{
+    unsigned long int dimension = 0L;
+    for (int h = 0; h < diag->nirrep(); h++) {
+        dimension += diag->dimpi()[h];
+    }
+    unsigned long int subspace = 0L;
+    if (memory) {
+        unsigned long int fixed = (3L * nroot + 1L) * dimension;
+        subspace = (memory > fixed ? (memory - fixed) / 2L : 0L);
+        // Always keep the newest vector in core
+        if (subspace < dimension) subspace = dimension;
+    }
+    b.set_memory(subspace);
+    s.set_memory(subspace);
+}
+
+}
+
 DLRSolver::DLRSolver(std::shared_ptr<RHamiltonian> H) :
     RSolver(H),
     nroot_(1),
@@ -632,8 +735,11 @@ DLRSolver::DLRSolver(std::shared_ptr<RHamiltonian> H) :
     max_subspace_(6),
     min_subspace_(2),
     nguess_(1),
+    collapse_per_root_(false),
     nsubspace_(0),
-    nconverged_(0)
+    nconverged_(0),
+    b_("DLRSolver b"),
+    s_("DLRSolver sigma")
 {
     name_ = "DLR";
 }
@@ -672,6 +778,12 @@ std::shared_ptr<DLRSolver> DLRSolver::build_solver(Options& options,
     if (options["SOLVER_MAX_SUBSPACE"].has_changed()) {
         solver->set_max_subspace(options.get_int("SOLVER_MAX_SUBSPACE"));
     }
+    if (options["SOLVER_MEM_FACTOR"].has_changed()) {
+        solver->set_memory((unsigned long int)(options.get_double("SOLVER_MEM_FACTOR") * Process::environment.get_memory() / 8L));
+    }
+    if (options["SOLVER_COLLAPSE"].has_changed()) {
+        solver->set_collapse_per_root(options.get_str("SOLVER_COLLAPSE") == "PER_ROOT");
+    }
     if (options["SOLVER_NORM"].has_changed()) {
         solver->set_norm(options.get_double("SOLVER_NORM"));
     }
@@ -689,6 +801,9 @@ void DLRSolver::print_header() const
         outfile->Printf( "   Number of guess vectors = %11d\n", nguess_);
         outfile->Printf( "   Maximum subspace size   = %11d\n", max_subspace_);
         outfile->Printf( "   Minimum subspace size   = %11d\n", min_subspace_);
+        outfile->Printf( "   Subspace collapse       = %11s\n", (collapse_per_root_ ? "PER_ROOT" : "FIXED"));
+        if (memory_)
+            outfile->Printf( "   Subspace memory [MiB]   = %11ld\n", memory_ * sizeof(double) / (1024L * 1024L));
         outfile->Printf( "   Subspace expansion norm = %11.0E\n", norm_);
         outfile->Printf( "   Convergence cutoff      = %11.0E\n", criteria_);
         outfile->Printf( "   Maximum iterations      = %11d\n", maxiter_);
@@ -720,6 +835,8 @@ void DLRSolver::solve()
     nconverged_ = 0;
     convergence_ = 0.0;
 
+    init_subspace_storage(memory_, diag_, nroot_, b_, s_);
+
     if (print_ > 1) {
         outfile->Printf( "  => Iterations <=\n\n");
         outfile->Printf( "  %10s %4s %10s %10s %11s\n", "", "Iter", "Converged", "Subspace", "Residual");
@@ -785,6 +902,10 @@ void DLRSolver::finalize()
     n_.clear();
     d_.clear();
     diag_.reset();
+
+    std::shared_ptr<PSIO> psio = PSIO::shared_object();
+    if (psio->open_check(PSIF_SOLVER))
+        psio->close(PSIF_SOLVER, 0);
 }
 void DLRSolver::guess()
 {
@@ -818,11 +939,12 @@ void DLRSolver::guess()
         int n = (max_subspace_ > (nguess_ - i) ? (nguess_ - i) : max_subspace_);
         for (int j = 0; j < n; j++) {
             size_t k = i + j;
-            b_.push_back(std::shared_ptr<Vector>(new Vector("Delta Guess", diag_->nirrep(), diag_->dimpi())));
+            std::shared_ptr<Vector> b(new Vector("Delta Guess", diag_->nirrep(), diag_->dimpi()));
             for (int h = 0; h < diag_->nirrep(); h++) {
                 if (k >= A_inds_[h].size()) continue;
-                b_[j]->set(h,A_inds_[h][k],1.0);
+                b->set(h,A_inds_[h][k],1.0);
             }
+            b_.push_back(b);
         }
 
         // Low rank!
@@ -853,17 +975,19 @@ void DLRSolver::guess()
     for (int i = 0; i < nroot_; i++) {
         std::stringstream ss;
         ss << "Guess " << i;
-        b_.push_back(std::shared_ptr<Vector>(new Vector(ss.str(), diag_->nirrep(), diag_->dimpi())));
+        std::shared_ptr<Vector> b(new Vector(ss.str(), diag_->nirrep(), diag_->dimpi()));
         for (int h = 0; h < diag_->nirrep(); h++) {
             double** Up = U->pointer(h);
-            double*  bp = b_[i]->pointer(h);
+            double*  bp = b->pointer(h);
             for (int j = 0; j < rank[h]; j++) {
                 bp[A_inds_[h][j]] = Up[j][i];
             }
         }
+        b_.push_back(b);
     }
 
     nsubspace_ = nroot_;
+    G_.reset();
 
     if (debug_) {
         outfile->Printf( "   > Guess <\n\n");
@@ -879,22 +1003,24 @@ void DLRSolver::sigma()
 {
     int n = b_.size() - s_.size();
     int offset = s_.size();
+    std::vector<std::shared_ptr<Vector> > x;
+    std::vector<std::shared_ptr<Vector> > b;
+
+    // All new trial vectors share one product (one JK pass). The sigma
+    // vectors only join the (possibly disk-backed) subspace once filled.
     for (int i = 0; i < n; i++) {
         std::stringstream s;
         s << "Sigma Vector " << (i + offset);
-        s_.push_back(std::shared_ptr<Vector>(new Vector(s.str(), diag_->nirrep(), diag_->dimpi())));
+        x.push_back(b_[i + offset]);
+        b.push_back(std::shared_ptr<Vector>(new Vector(s.str(), diag_->nirrep(), diag_->dimpi())));
     }
 
-    std::vector<std::shared_ptr<Vector> > x;
-    std::vector<std::shared_ptr<Vector> > b;
+    H_->product(x,b);
 
-    for (int i = offset; i < offset + n; i++) {
-        x.push_back(b_[i]);
-        b.push_back(s_[i]);
+    for (int i = 0; i < n; i++) {
+        s_.push_back(b[i]);
     }
 
-    H_->product(x,b);
-
     if (debug_) {
         outfile->Printf( "   > Sigma <\n\n");
         for (size_t i = 0; i < s_.size(); i++) {
@@ -907,28 +1033,52 @@ void DLRSolver::subspaceHamiltonian()
 {
     int n = s_.size();
     int nirrep = diag_->nirrep();
+
+    // Only the rows of the vectors added since the last call are new;
+    // G_ is kept consistent with the subspace by guess() and subspaceCollapse()
+    int nold = (G_ ? G_->rowspi()[0] : 0);
+    if (nold > n) nold = 0;
+
     int* npi = new int[nirrep];
     for (int h = 0; h < nirrep; ++h) {
         npi[h] = n;
     }
 
-    G_ = SharedMatrix (new Matrix("Subspace Hamiltonian",nirrep,npi,npi));
+    SharedMatrix G(new Matrix("Subspace Hamiltonian",nirrep,npi,npi));
     delete[] npi;
 
     for (int h = 0; h < nirrep; ++h) {
+        if (!nold) continue;
+        double** Gp = G->pointer(h);
+        double** Goldp = G_->pointer(h);
+        for (int i = 0; i < nold; i++) {
+            ::memcpy((void*) Gp[i], (void*) Goldp[i], nold * sizeof(double));
+        }
+    }
 
-        int dimension = diag_->dimpi()[h];
+    std::vector<std::shared_ptr<Vector> > bnew;
+    for (int i = nold; i < n; i++) {
+        bnew.push_back(b_[i]);
+    }
 
-        if (!dimension) continue;
+    // One pass over the sigma vectors, which may be on disk
+    for (int j = 0; j < n; j++) {
+        std::shared_ptr<Vector> sj = s_[j];
+        for (int h = 0; h < nirrep; ++h) {
 
-        double** Gp = G_->pointer(h);
-        for (int i = 0; i < n; i++) {
-            for (int j = 0; j <= i; j++) {
-                Gp[i][j] = Gp[j][i] = C_DDOT(dimension,b_[i]->pointer(h),1,s_[j]->pointer(h),1);
+            int dimension = diag_->dimpi()[h];
+
+            if (!dimension) continue;
+
+            double** Gp = G->pointer(h);
+            for (int i = (j > nold ? j : nold); i < n; i++) {
+                Gp[i][j] = Gp[j][i] = C_DDOT(dimension,bnew[i - nold]->pointer(h),1,sj->pointer(h),1);
             }
         }
     }
 
+    G_ = G;
+
     if (debug_) {
         outfile->Printf( "   > SubspaceHamiltonian <\n\n");
         G_->print();
@@ -994,19 +1144,23 @@ void DLRSolver::eigenvecs()
         }
     }
 
-    for (int h = 0; h < diag_->nirrep(); ++h) {
+    for (int m = 0; m < nroot_; m++) {
+        c_[m]->zero();
+    }
 
-        int dimension = diag_->dimpi()[h];
+    // One pass over the subspace vectors, which may be on disk
+    for (size_t i = 0; i < b_.size(); i++) {
+        std::shared_ptr<Vector> bi = b_[i];
+        for (int h = 0; h < diag_->nirrep(); ++h) {
 
-        if (!dimension) continue;
+            int dimension = diag_->dimpi()[h];
 
-        double** ap = a_->pointer(h);
-        for (int m = 0; m < nroot_; m++) {
-            double* cp = c_[m]->pointer(h);
-            ::memset((void*) cp, '\0', dimension*sizeof(double));
-            for (size_t i = 0; i < b_.size(); i++) {
-                double* bp = b_[i]->pointer(h);
-                C_DAXPY(dimension,ap[i][m],bp,1,cp,1);
+            if (!dimension) continue;
+
+            double** ap = a_->pointer(h);
+            double* bp = bi->pointer(h);
+            for (int m = 0; m < nroot_; m++) {
+                C_DAXPY(dimension,ap[i][m],bp,1,c_[m]->pointer(h),1);
             }
         }
     }
@@ -1056,6 +1210,23 @@ void DLRSolver::residuals()
         }
     }
 
+    // r_k = sum_i a_ik s_i, in one pass over the sigma vectors
+    for (int k = 0; k < nroot_; k++) {
+        r_[k]->zero();
+    }
+    for (size_t i = 0; i < s_.size(); i++) {
+        std::shared_ptr<Vector> si = s_[i];
+        for (int h = 0; h < diag_->nirrep(); ++h) {
+            int dimension = diag_->dimpi()[h];
+            if (!dimension) continue;
+            double** ap = a_->pointer(h);
+            double*  sp = si->pointer(h);
+            for (int k = 0; k < nroot_; k++) {
+                C_DAXPY(dimension,ap[i][k],sp,1,r_[k]->pointer(h),1);
+            }
+        }
+    }
+
     for (int k = 0; k < nroot_; k++) {
 
         double R2 = 0.0;
@@ -1066,17 +1237,10 @@ void DLRSolver::residuals()
         int dimension = diag_->dimpi()[h];
         if (!dimension) continue;
 
-            double** ap = a_->pointer(h);
             double*  lp = l_->pointer(h);
             double*  rp = r_[k]->pointer(h);
             double*  cp = c_[k]->pointer(h);
 
-            ::memset((void*)rp, '\0', dimension*sizeof(double));
-
-            for (size_t i = 0; i < b_.size(); i++) {
-                double* sp = s_[i]->pointer(h);
-                C_DAXPY(dimension,ap[i][k],sp,1,rp,1);
-            }
             S2 += C_DDOT(dimension,rp,1,rp,1);
 
             C_DAXPY(dimension,-lp[k],cp,1,rp,1);
@@ -1218,22 +1382,30 @@ void DLRSolver::subspaceExpansion()
         sig[i] = false;
     }
 
-    // Orthonormalize d_ via Modified Gram-Schmidt
-    for (int h = 0; h < diag_->nirrep(); ++h) {
+    // Remove the projection of d on b from b, in one pass over the
+    // subspace vectors (which may be on disk)
+    for (size_t j = 0; j < b_.size(); ++j) {
+        std::shared_ptr<Vector> bj = b_[j];
+        for (int h = 0; h < diag_->nirrep(); ++h) {
 
-        int dimension = diag_->dimpi()[h];
-        if (!dimension) continue;
+            int dimension = diag_->dimpi()[h];
+            if (!dimension) continue;
 
-        // Remove the projection of d on b from b
-        for (size_t i = 0; i < d_.size(); ++i) {
-            for (size_t j = 0; j < b_.size(); ++j) {
+            double* bp = bj->pointer(h);
+            for (size_t i = 0; i < d_.size(); ++i) {
                 double* dp = d_[i]->pointer(h);
-                double* bp = b_[j]->pointer(h);
 
                 double r_ji = C_DDOT(dimension,dp,1,bp,1);
                 C_DAXPY(dimension,-r_ji,bp,1,dp,1);
             }
         }
+    }
+
+    // Orthonormalize d_ via Modified Gram-Schmidt
+    for (int h = 0; h < diag_->nirrep(); ++h) {
+
+        int dimension = diag_->dimpi()[h];
+        if (!dimension) continue;
 
         // Remove the self-projection of d on d from d
         for (size_t i = 0; i < d_.size(); ++i) {
@@ -1270,12 +1442,16 @@ void DLRSolver::subspaceExpansion()
 }
 void DLRSolver::subspaceCollapse()
 {
-    if (nsubspace_ <= max_subspace_) return;
+    // Thick restart onto the lowest Ritz vectors; PER_ROOT scales both sizes by nroot_
+    int max_subspace = (collapse_per_root_ ? max_subspace_ * nroot_ : max_subspace_);
+    int min_subspace = (collapse_per_root_ ? min_subspace_ * nroot_ : min_subspace_);
+    if (min_subspace < nroot_) min_subspace = nroot_;
+    if (nsubspace_ <= max_subspace || nsubspace_ <= min_subspace) return;
 
     std::vector<std::shared_ptr<Vector> > s2;
     std::vector<std::shared_ptr<Vector> > b2;
 
-    for (int k = 0; k < min_subspace_; ++k) {
+    for (int k = 0; k < min_subspace; ++k) {
         std::stringstream bs;
         bs << "Subspace Vector " << k;
         b2.push_back(std::shared_ptr<Vector>(new Vector(bs.str(), diag_->nirrep(), diag_->dimpi())));
@@ -1285,26 +1461,43 @@ void DLRSolver::subspaceCollapse()
     }
 
     int n = a_->rowspi()[0];
-    for (int k = 0; k < min_subspace_; ++k) {
+    for (int i = 0; i < n; ++i) {
+        std::shared_ptr<Vector> bi = b_[i];
+        std::shared_ptr<Vector> si = s_[i];
         for (int h = 0; h < diag_->nirrep(); ++h) {
             int dimension = diag_->dimpi()[h];
             if (!dimension) continue;
 
             double** ap = a_->pointer(h);
-            double*  b2p = b2[k]->pointer(h);
-            double*  s2p = s2[k]->pointer(h);
+            double*  bp = bi->pointer(h);
+            double*  sp = si->pointer(h);
 
-            for (int i = 0; i < n; ++i) {
-                double*  bp = b_[i]->pointer(h);
-                double*  sp = s_[i]->pointer(h);
-                C_DAXPY(dimension,ap[i][k],sp,1,s2p,1);
-                C_DAXPY(dimension,ap[i][k],bp,1,b2p,1);
+            for (int k = 0; k < min_subspace; ++k) {
+                C_DAXPY(dimension,ap[i][k],sp,1,s2[k]->pointer(h),1);
+                C_DAXPY(dimension,ap[i][k],bp,1,b2[k]->pointer(h),1);
             }
         }
     }
 
-    s_ = s2;
-    b_ = b2;
+    // The subspace Hamiltonian in the collapsed basis is a^T G a
+    int* kpi = new int[diag_->nirrep()];
+    for (int h = 0; h < diag_->nirrep(); ++h) {
+        kpi[h] = min_subspace;
+    }
+    SharedMatrix G(new Matrix("Subspace Hamiltonian", diag_->nirrep(), kpi, kpi));
+    delete[] kpi;
+    for (int h = 0; h < diag_->nirrep(); ++h) {
+        double** ap = a_->pointer(h);
+        double** Gp = G_->pointer(h);
+        double** G2p = G->pointer(h);
+        std::vector<double> T(n * (size_t) min_subspace);
+        C_DGEMM('N','N',n,min_subspace,n,1.0,Gp[0],n,ap[0],n,0.0,T.data(),min_subspace);
+        C_DGEMM('T','N',min_subspace,min_subspace,n,1.0,ap[0],n,T.data(),min_subspace,0.0,G2p[0],min_subspace);
+    }
+    G_ = G;
+
+    s_.assign(s2);
+    b_.assign(b2);
     nsubspace_ = b_.size();
 
     if (debug_) {
@@ -1361,6 +1554,12 @@ std::shared_ptr<RayleighRSolver> RayleighRSolver::build_solver(Options& options,
     if (options["SOLVER_MAX_SUBSPACE"].has_changed()) {
         solver->set_max_subspace(options.get_int("SOLVER_MAX_SUBSPACE"));
     }
+    if (options["SOLVER_MEM_FACTOR"].has_changed()) {
+        solver->set_memory((unsigned long int)(options.get_double("SOLVER_MEM_FACTOR") * Process::environment.get_memory() / 8L));
+    }
+    if (options["SOLVER_COLLAPSE"].has_changed()) {
+        solver->set_collapse_per_root(options.get_str("SOLVER_COLLAPSE") == "PER_ROOT");
+    }
     if (options["SOLVER_NORM"].has_changed()) {
         solver->set_norm(options.get_double("SOLVER_NORM"));
     }
@@ -2214,8 +2413,11 @@ DLUSolver::DLUSolver(std::shared_ptr<UHamiltonian> H) :
     max_subspace_(6),
     min_subspace_(2),
     nguess_(1),
+    collapse_per_root_(false),
     nsubspace_(0),
-    nconverged_(0)
+    nconverged_(0),
+    b_("DLUSolver b"),
+    s_("DLUSolver sigma")
 {
     name_ = "DLU";
 }
@@ -2260,6 +2462,12 @@ std::shared_ptr<DLUSolver> DLUSolver::build_solver(Options& options,
     } else {
         solver->set_max_subspace(12);
     }
+    if (options["SOLVER_MEM_FACTOR"].has_changed()) {
+        solver->set_memory((unsigned long int)(options.get_double("SOLVER_MEM_FACTOR") * Process::environment.get_memory() / 8L));
+    }
+    if (options["SOLVER_COLLAPSE"].has_changed()) {
+        solver->set_collapse_per_root(options.get_str("SOLVER_COLLAPSE") == "PER_ROOT");
+    }
     if (options["SOLVER_NORM"].has_changed()) {
         solver->set_norm(options.get_double("SOLVER_NORM"));
     }
@@ -2279,6 +2487,9 @@ void DLUSolver::print_header() const
         outfile->Printf( "   Number of guess vectors = %11d\n", nguess_);
         outfile->Printf( "   Maximum subspace size   = %11d\n", max_subspace_);
         outfile->Printf( "   Minimum subspace size   = %11d\n", min_subspace_);
+        outfile->Printf( "   Subspace collapse       = %11s\n", (collapse_per_root_ ? "PER_ROOT" : "FIXED"));
+        if (memory_)
+            outfile->Printf( "   Subspace memory [MiB]   = %11ld\n", memory_ * sizeof(double) / (1024L * 1024L));
         outfile->Printf( "   Subspace expansion norm = %11.0E\n", norm_);
         outfile->Printf( "   Convergence cutoff      = %11.0E\n", criteria_);
         outfile->Printf( "   Maximum iterations      = %11d\n", maxiter_);
@@ -2497,6 +2708,8 @@ void DLUSolver::solve()
     nconverged_ = 0;
     convergence_ = 0.0;
 
+    init_subspace_storage(memory_, diag_, nroot_, b_, s_);
+
     if (print_ > 1) {
         outfile->Printf( "  => Iterations <=\n\n");
         outfile->Printf( "  %10s %4s %10s %10s %11s\n", "", "Iter", "Converged", "Subspace", "Residual");
@@ -2563,6 +2776,10 @@ void DLUSolver::finalize()
     n_.clear();
     d_.clear();
     diag_.reset();
+
+    std::shared_ptr<PSIO> psio = PSIO::shared_object();
+    if (psio->open_check(PSIF_SOLVER))
+        psio->close(PSIF_SOLVER, 0);
 }
 
 void DLUSolver::guess()
@@ -2597,11 +2814,12 @@ void DLUSolver::guess()
         int n = (max_subspace_ > (nguess_ - i) ? (nguess_ - i) : max_subspace_);
         for (int j = 0; j < n; j++) {
             size_t k = i + j;
-            b_.push_back(std::shared_ptr<Vector>(new Vector("Delta Guess", diag_->nirrep(), diag_->dimpi())));
+            std::shared_ptr<Vector> b(new Vector("Delta Guess", diag_->nirrep(), diag_->dimpi()));
             for (int h = 0; h < diag_->nirrep(); h++) {
                 if (k >= A_inds_[h].size()) continue;
-                b_[j]->set(h,A_inds_[h][k],1.0);
+                b->set(h,A_inds_[h][k],1.0);
             }
+            b_.push_back(b);
         }
 
         // Low rank!
@@ -2632,17 +2850,19 @@ void DLUSolver::guess()
     for (int i = 0; i < nroot_; i++) {
         std::stringstream ss;
         ss << "Guess " << i;
-        b_.push_back(std::shared_ptr<Vector>(new Vector(ss.str(), diag_->nirrep(), diag_->dimpi())));
+        std::shared_ptr<Vector> b(new Vector(ss.str(), diag_->nirrep(), diag_->dimpi()));
         for (int h = 0; h < diag_->nirrep(); h++) {
             double** Up = U->pointer(h);
-            double*  bp = b_[i]->pointer(h);
+            double*  bp = b->pointer(h);
             for (int j = 0; j < rank[h]; j++) {
                 bp[A_inds_[h][j]] = Up[j][i];
             }
         }
+        b_.push_back(b);
     }
 
     nsubspace_ = nroot_;
+    G_.reset();
 
     if (debug_) {
         outfile->Printf( "   > Guess <\n\n");
@@ -2658,18 +2878,16 @@ void DLUSolver::sigma()
 {
     int n = b_.size() - s_.size();
     int offset = s_.size();
-    for (int i = 0; i < n; i++) {
-        std::stringstream s;
-        s << "Sigma Vector " << (i + offset);
-        s_.push_back(std::shared_ptr<Vector>(new Vector(s.str(), diag_->nirrep(), diag_->dimpi())));
-    }
-
     std::vector<std::shared_ptr<Vector> > x;
     std::vector<std::shared_ptr<Vector> > b;
 
-    for (int i = offset; i < offset + n; i++) {
-        x.push_back(b_[i]);
-        b.push_back(s_[i]);
+    // All new trial vectors share one product (one JK pass). The sigma
+    // vectors only join the (possibly disk-backed) subspace once filled.
+    for (int i = 0; i < n; i++) {
+        std::stringstream s;
+        s << "Sigma Vector " << (i + offset);
+        x.push_back(b_[i + offset]);
+        b.push_back(std::shared_ptr<Vector>(new Vector(s.str(), diag_->nirrep(), diag_->dimpi())));
     }
 
     std::vector< std::pair < std::shared_ptr<Vector>, std::shared_ptr<Vector> > > xpair;
@@ -2690,6 +2908,7 @@ void DLUSolver::sigma()
     for (int i = 0; i < n; i++) {
         contract_pair(xpair[i],x[i]);
         contract_pair(bpair[i],b[i]);
+        s_.push_back(b[i]);
     }
 
     if (debug_) {
@@ -2704,28 +2923,52 @@ void DLUSolver::subspaceHamiltonian()
 {
     int n = s_.size();
     int nirrep = diag_->nirrep();
+
+    // Only the rows of the vectors added since the last call are new;
+    // G_ is kept consistent with the subspace by guess() and subspaceCollapse()
+    int nold = (G_ ? G_->rowspi()[0] : 0);
+    if (nold > n) nold = 0;
+
     int* npi = new int[nirrep];
     for (int h = 0; h < nirrep; ++h) {
         npi[h] = n;
     }
 
-    G_ = SharedMatrix (new Matrix("Subspace Hamiltonian",nirrep,npi,npi));
+    SharedMatrix G(new Matrix("Subspace Hamiltonian",nirrep,npi,npi));
     delete[] npi;
 
     for (int h = 0; h < nirrep; ++h) {
+        if (!nold) continue;
+        double** Gp = G->pointer(h);
+        double** Goldp = G_->pointer(h);
+        for (int i = 0; i < nold; i++) {
+            ::memcpy((void*) Gp[i], (void*) Goldp[i], nold * sizeof(double));
+        }
+    }
 
-        int dimension = diag_->dimpi()[h];
+    std::vector<std::shared_ptr<Vector> > bnew;
+    for (int i = nold; i < n; i++) {
+        bnew.push_back(b_[i]);
+    }
 
-        if (!dimension) continue;
+    // One pass over the sigma vectors, which may be on disk
+    for (int j = 0; j < n; j++) {
+        std::shared_ptr<Vector> sj = s_[j];
+        for (int h = 0; h < nirrep; ++h) {
 
-        double** Gp = G_->pointer(h);
-        for (int i = 0; i < n; i++) {
-            for (int j = 0; j <= i; j++) {
-                Gp[i][j] = Gp[j][i] = C_DDOT(dimension,b_[i]->pointer(h),1,s_[j]->pointer(h),1);
+            int dimension = diag_->dimpi()[h];
+
+            if (!dimension) continue;
+
+            double** Gp = G->pointer(h);
+            for (int i = (j > nold ? j : nold); i < n; i++) {
+                Gp[i][j] = Gp[j][i] = C_DDOT(dimension,bnew[i - nold]->pointer(h),1,sj->pointer(h),1);
             }
         }
     }
 
+    G_ = G;
+
     if (debug_) {
         outfile->Printf( "   > SubspaceHamiltonian <\n\n");
         G_->print();
@@ -2792,19 +3035,23 @@ void DLUSolver::eigenvecs()
         }
     }
 
-    for (int h = 0; h < diag_->nirrep(); ++h) {
+    for (int m = 0; m < nroot_; m++) {
+        c_[m]->zero();
+    }
 
-        int dimension = diag_->dimpi()[h];
+    // One pass over the subspace vectors, which may be on disk
+    for (size_t i = 0; i < b_.size(); i++) {
+        std::shared_ptr<Vector> bi = b_[i];
+        for (int h = 0; h < diag_->nirrep(); ++h) {
 
-        if (!dimension) continue;
+            int dimension = diag_->dimpi()[h];
 
-        double** ap = a_->pointer(h);
-        for (int m = 0; m < nroot_; m++) {
-            double* cp = c_[m]->pointer(h);
-            ::memset((void*) cp, '\0', dimension*sizeof(double));
-            for (size_t i = 0; i < b_.size(); i++) {
-                double* bp = b_[i]->pointer(h);
-                C_DAXPY(dimension,ap[i][m],bp,1,cp,1);
+            if (!dimension) continue;
+
+            double** ap = a_->pointer(h);
+            double* bp = bi->pointer(h);
+            for (int m = 0; m < nroot_; m++) {
+                C_DAXPY(dimension,ap[i][m],bp,1,c_[m]->pointer(h),1);
             }
         }
     }
@@ -2856,6 +3103,23 @@ void DLUSolver::residuals()
         }
     }
 
+    // r_k = sum_i a_ik s_i, in one pass over the sigma vectors
+    for (int k = 0; k < nroot_; k++) {
+        r_[k]->zero();
+    }
+    for (size_t i = 0; i < s_.size(); i++) {
+        std::shared_ptr<Vector> si = s_[i];
+        for (int h = 0; h < diag_->nirrep(); ++h) {
+            int dimension = diag_->dimpi()[h];
+            if (!dimension) continue;
+            double** ap = a_->pointer(h);
+            double*  sp = si->pointer(h);
+            for (int k = 0; k < nroot_; k++) {
+                C_DAXPY(dimension,ap[i][k],sp,1,r_[k]->pointer(h),1);
+            }
+        }
+    }
+
     for (int k = 0; k < nroot_; k++) {
 
         double R2 = 0.0;
@@ -2866,17 +3130,10 @@ void DLUSolver::residuals()
         int dimension = diag_->dimpi()[h];
         if (!dimension) continue;
 
-            double** ap = a_->pointer(h);
             double*  lp = l_->pointer(h);
             double*  rp = r_[k]->pointer(h);
             double*  cp = c_[k]->pointer(h);
 
-            ::memset((void*)rp, '\0', dimension*sizeof(double));
-
-            for (size_t i = 0; i < b_.size(); i++) {
-                double* sp = s_[i]->pointer(h);
-                C_DAXPY(dimension,ap[i][k],sp,1,rp,1);
-            }
             S2 += C_DDOT(dimension,rp,1,rp,1);
 
             C_DAXPY(dimension,-lp[k],cp,1,rp,1);
@@ -3020,22 +3277,30 @@ void DLUSolver::subspaceExpansion()
         sig[i] = false;
     }
 
-    // Orthonormalize d_ via Modified Gram-Schmidt
-    for (int h = 0; h < diag_->nirrep(); ++h) {
+    // Remove the projection of d on b from b, in one pass over the
+    // subspace vectors (which may be on disk)
+    for (size_t j = 0; j < b_.size(); ++j) {
+        std::shared_ptr<Vector> bj = b_[j];
+        for (int h = 0; h < diag_->nirrep(); ++h) {
 
-        int dimension = diag_->dimpi()[h];
-        if (!dimension) continue;
+            int dimension = diag_->dimpi()[h];
+            if (!dimension) continue;
 
-        // Remove the projection of d on b from b
-        for (size_t i = 0; i < d_.size(); ++i) {
-            for (size_t j = 0; j < b_.size(); ++j) {
+            double* bp = bj->pointer(h);
+            for (size_t i = 0; i < d_.size(); ++i) {
                 double* dp = d_[i]->pointer(h);
-                double* bp = b_[j]->pointer(h);
 
                 double r_ji = C_DDOT(dimension,dp,1,bp,1);
                 C_DAXPY(dimension,-r_ji,bp,1,dp,1);
             }
         }
+    }
+
+    // Orthonormalize d_ via Modified Gram-Schmidt
+    for (int h = 0; h < diag_->nirrep(); ++h) {
+
+        int dimension = diag_->dimpi()[h];
+        if (!dimension) continue;
 
         // Remove the self-projection of d on d from d
         for (size_t i = 0; i < d_.size(); ++i) {
@@ -3073,12 +3338,16 @@ void DLUSolver::subspaceExpansion()
 
 void DLUSolver::subspaceCollapse()
 {
-    if (nsubspace_ <= max_subspace_) return;
+    // Thick restart onto the lowest Ritz vectors; PER_ROOT scales both sizes by nroot_
+    int max_subspace = (collapse_per_root_ ? max_subspace_ * nroot_ : max_subspace_);
+    int min_subspace = (collapse_per_root_ ? min_subspace_ * nroot_ : min_subspace_);
+    if (min_subspace < nroot_) min_subspace = nroot_;
+    if (nsubspace_ <= max_subspace || nsubspace_ <= min_subspace) return;
 
     std::vector<std::shared_ptr<Vector> > s2;
     std::vector<std::shared_ptr<Vector> > b2;
 
-    for (int k = 0; k < min_subspace_; ++k) {
+    for (int k = 0; k < min_subspace; ++k) {
         std::stringstream bs;
         bs << "Subspace Vector " << k;
         b2.push_back(std::shared_ptr<Vector>(new Vector(bs.str(), diag_->nirrep(), diag_->dimpi())));
@@ -3088,26 +3357,43 @@ void DLUSolver::subspaceCollapse()
     }
 
     int n = a_->rowspi()[0];
-    for (int k = 0; k < min_subspace_; ++k) {
+    for (int i = 0; i < n; ++i) {
+        std::shared_ptr<Vector> bi = b_[i];
+        std::shared_ptr<Vector> si = s_[i];
         for (int h = 0; h < diag_->nirrep(); ++h) {
             int dimension = diag_->dimpi()[h];
             if (!dimension) continue;
 
             double** ap = a_->pointer(h);
-            double*  b2p = b2[k]->pointer(h);
-            double*  s2p = s2[k]->pointer(h);
+            double*  bp = bi->pointer(h);
+            double*  sp = si->pointer(h);
 
-            for (int i = 0; i < n; ++i) {
-                double*  bp = b_[i]->pointer(h);
-                double*  sp = s_[i]->pointer(h);
-                C_DAXPY(dimension,ap[i][k],sp,1,s2p,1);
-                C_DAXPY(dimension,ap[i][k],bp,1,b2p,1);
+            for (int k = 0; k < min_subspace; ++k) {
+                C_DAXPY(dimension,ap[i][k],sp,1,s2[k]->pointer(h),1);
+                C_DAXPY(dimension,ap[i][k],bp,1,b2[k]->pointer(h),1);
             }
         }
     }
 
-    s_ = s2;
-    b_ = b2;
+    // The subspace Hamiltonian in the collapsed basis is a^T G a
+    int* kpi = new int[diag_->nirrep()];
+    for (int h = 0; h < diag_->nirrep(); ++h) {
+        kpi[h] = min_subspace;
+    }
+    SharedMatrix G(new Matrix("Subspace Hamiltonian", diag_->nirrep(), kpi, kpi));
+    delete[] kpi;
+    for (int h = 0; h < diag_->nirrep(); ++h) {
+        double** ap = a_->pointer(h);
+        double** Gp = G_->pointer(h);
+        double** G2p = G->pointer(h);
+        std::vector<double> T(n * (size_t) min_subspace);
+        C_DGEMM('N','N',n,min_subspace,n,1.0,Gp[0],n,ap[0],n,0.0,T.data(),min_subspace);
+        C_DGEMM('T','N',min_subspace,min_subspace,n,1.0,ap[0],n,T.data(),min_subspace,0.0,G2p[0],min_subspace);
+    }
+    G_ = G;
+
+    s_.assign(s2);
+    b_.assign(b2);
     nsubspace_ = b_.size();
 
     if (debug_) {
@@ -28,6 +28,11 @@
 #ifndef SOLVER_H
 #define SOLVER_H
 
+#include "psi4/libmints/dimension.h"
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace psi {
 
 class Matrix;
@@ -264,6 +269,50 @@ public:
     void set_nguess(int nguess) { nguess_ = nguess; }
 };
 
+/**
+ * SubspaceVectors holds the b or sigma vectors of a Davidson subspace.
+ * Vectors are kept in core until the memory budget is reached, beyond
+ * which the oldest ones are spilled to PSIF_SOLVER and read back on access.
+ * The owning solver opens and closes PSIF_SOLVER.
+ **/
+class SubspaceVectors {
+
+protected:
+    /// Prefix of the PSIO keys of spilled vectors
+    std::string label_;
+    /// In-core vectors, NULL for those on disk
+    std::vector<std::shared_ptr<Vector> > core_;
+    /// Dimensions of each vector
+    std::vector<Dimension> dimpi_;
+    /// Maximum number of doubles held in core, 0 => Unlimited
+    unsigned long int max_core_;
+    /// Number of doubles currently held in core
+    unsigned long int ncore_;
+
+    /// PSIO key of vector i
+    std::string key(size_t i) const;
+    /// Spill the oldest in-core vectors until within the budget
+    void spill();
+
+public:
+    SubspaceVectors(const std::string& label);
+
+    /// Set the in-core budget, in doubles (0 => Unlimited)
+    void set_memory(unsigned long int max_core) { max_core_ = max_core; }
+    /// Number of vectors in the subspace
+    size_t size() const { return core_.size(); }
+    /// Number of vectors currently on disk
+    size_t nspilled() const;
+    /// Vector i, read from disk if it was spilled (changes to a read copy are not kept)
+    std::shared_ptr<Vector> operator[](size_t i) const;
+    /// Append v, spilling older vectors if over budget
+    void push_back(std::shared_ptr<Vector> v);
+    /// Replace the whole subspace by v
+    void assign(const std::vector<std::shared_ptr<Vector> >& v);
+    /// Drop all vectors
+    void clear();
+};
+
 class DLRSolver : public RSolver {
 
 protected:
@@ -280,6 +329,8 @@ protected:
     int min_subspace_;
     /// Number of guess vectors to build
     int nguess_;
+    /// Scale the subspace sizes by the number of roots?
+    bool collapse_per_root_;
 
     // => Iteration values <= //
 
@@ -294,10 +345,10 @@ protected:
     std::vector<std::shared_ptr<Vector> > c_;
     /// Current eigenvalues (nroots)
     std::vector<std::vector<double> > E_;
-    /// B vectors (nsubspace)
-    std::vector<std::shared_ptr<Vector> > b_;
-    /// Sigma vectors (nsubspace)
-    std::vector<std::shared_ptr<Vector> > s_;
+    /// B vectors (nsubspace), possibly on disk
+    SubspaceVectors b_;
+    /// Sigma vectors (nsubspace), possibly on disk
+    SubspaceVectors s_;
     /// Delta Subspace Hamiltonian (preconditioner)
     SharedMatrix A_;
     /// Delta Subspace indices
@@ -378,6 +429,8 @@ public:
     void set_min_subspace(double min_subspace) { min_subspace_ = min_subspace; }
     /// Set number of guesses (defaults to 1)
     void set_nguess(int nguess) { nguess_ = nguess; }
+    /// Scale the maximum and minimum subspace sizes by the number of roots (defaults to false)
+    void set_collapse_per_root(bool collapse_per_root) { collapse_per_root_ = collapse_per_root; }
     /// Set norm critera for adding vectors to subspace (defaults to 1.0E-6)
     void set_norm(double norm) { norm_ = norm; }
 };
@@ -551,6 +604,8 @@ protected:
     int min_subspace_;
     /// Number of guess vectors to build
     int nguess_;
+    /// Scale the subspace sizes by the number of roots?
+    bool collapse_per_root_;
 
     // => Iteration values <= //
 
@@ -565,10 +620,10 @@ protected:
     std::vector<std::shared_ptr<Vector> > c_;
     /// Current eigenvalues (nroots)
     std::vector<std::vector<double> > E_;
-    /// B vectors (nsubspace)
-    std::vector<std::shared_ptr<Vector> > b_;
-    /// Sigma vectors (nsubspace)
-    std::vector<std::shared_ptr<Vector> > s_;
+    /// B vectors (nsubspace), possibly on disk
+    SubspaceVectors b_;
+    /// Sigma vectors (nsubspace), possibly on disk
+    SubspaceVectors s_;
     /// Delta Subspace Hamiltonian (preconditioner)
     SharedMatrix A_;
     /// Delta Subspace indices
@@ -662,6 +717,8 @@ public:
     void set_min_subspace(double min_subspace) { min_subspace_ = min_subspace; }
     /// Set number of guesses (defaults to 1)
     void set_nguess(int nguess) { nguess_ = nguess; }
+    /// Scale the maximum and minimum subspace sizes by the number of roots (defaults to false)
+    void set_collapse_per_root(bool collapse_per_root) { collapse_per_root_ = collapse_per_root; }
     /// Set norm critera for adding vectors to subspace (defaults to 1.0E-6)
     void set_norm(double norm) { norm_ = norm; }
 
@@ -27,6 +27,9 @@
 #include "psi4/libmints/basisset.h"
 #include "psi4/libmints/integral.h"
 #include "psi4/libmints/3coverlap.h"
+#include "psi4/libmints/matrix.h"
+#include "psi4/libmints/vector.h"
+#include "psi4/libmints/dimension.h"
 #include "psi4/libqt/qt.h"
 #include "psi4/libciomr/libciomr.h"
 #include "psi4/libpsi4util/libpsi4util.h"
@@ -1318,6 +1321,96 @@ void benchmark_blas3(int N, double min_time, int max_threads)
     }
 
 
+}
+void benchmark_diagonalize(int N, double min_time)
+{
+    outfile->Printf( "\n");
+    outfile->Printf( "                              -------------------------------------- \n");
+    outfile->Printf( "                              ======> EIGENSOLVER BENCHMARKS <====== \n");
+    outfile->Printf( "                              -------------------------------------- \n");
+    outfile->Printf( "\n");
+
+    outfile->Printf( "  Parameters:\n");
+    outfile->Printf( "   -Minimum runtime (per operation, per size): %14.10f [s].\n", min_time);
+    outfile->Printf( "   -Maximum dimension exponent N: %d. Arrays are D x D = 2^N x 2^N doubles in size. The D\n", N);
+    outfile->Printf( "        value is reported below.\n");
+    outfile->Printf( "\n");
+
+    outfile->Printf( "  Notes:\n");
+    outfile->Printf( "   -All operations compute eigenvectors through Matrix::diagonalize.\n");
+    outfile->Printf( "\n");
+
+    double T;
+    unsigned long int rounds;
+    Timer* qq;
+
+    std::vector<std::string> ops;
+    ops.push_back("DSYEV");
+    ops.push_back("DSYEVD");
+    ops.push_back("DSYEVR");
+
+    std::map<std::string, std::vector<double> > timings;
+    for (size_t op = 0; op < ops.size(); op++)
+        timings[ops[op]].resize(N);
+
+    int dim = 1;
+    for (int k = 0; k < N; k++) {
+
+        dim *= 2;
+
+        Matrix A("A", dim, dim);
+        Matrix U("U", dim, dim);
+        Vector e("e", dim);
+        double** Ap = A.pointer();
+        for (int i = 0; i < dim; i++)
+            for (int j = 0; j <= i; j++)
+                Ap[i][j] = Ap[j][i] = rand() / (double) RAND_MAX;
+
+        for (size_t op = 0; op < ops.size(); op++) {
+            T = 0.0;
+            rounds = 0L;
+            qq = new Timer();
+            while (T < min_time) {
+                A.diagonalize(&U, &e, ascending, Matrix::diagonalize_algorithm_from_string(ops[op]));
+                T = qq->get();
+                rounds++;
+            }
+            delete qq;
+            timings[ops[op]][k] = T / (double) rounds;
+        }
+    }
+
+    outfile->Printf( "Eigensolver Timings [s]:\n\n");
+    dim = 1;
+    outfile->Printf( "Operation  ");
+    for (int k = 0; k < N; k++) {
+        dim *= 2;
+        outfile->Printf( "  %9d", dim);
+    }
+    outfile->Printf( "\n");
+    for (size_t s = 0; s < ops.size(); s++) {
+        outfile->Printf( "%-11s", ops[s].c_str());
+        for (int k = 0; k < N; k++)
+            outfile->Printf( "  %9.3E", timings[ops[s]][k]);
+        outfile->Printf( "\n");
+    }
+    outfile->Printf( "\n");
+
+    outfile->Printf( "Eigensolver Time Relative to DSYEV [-]:\n\n");
+    dim = 1;
+    outfile->Printf( "Operation  ");
+    for (int k = 0; k < N; k++) {
+        dim *= 2;
+        outfile->Printf( "  %9d", dim);
+    }
+    outfile->Printf( "\n");
+    for (size_t s = 1; s < ops.size(); s++) {
+        outfile->Printf( "%-11s", ops[s].c_str());
+        for (int k = 0; k < N; k++)
+            outfile->Printf( "  %9.3E", timings[ops[s]][k] / timings["DSYEV"][k]);
+        outfile->Printf( "\n");
+    }
+    outfile->Printf( "\n");
 }
 void benchmark_disk(int N, double min_time)
 {
@@ -58,6 +58,15 @@ void benchmark_blas2(int N, double min_time);
 **/
 void benchmark_blas3(int N, double min_time, int nthread = 1);
 /**
+* Perform a benchmark of the Matrix::diagonalize eigensolvers
+* (DSYEV, DSYEVD, and DSYEVR) on the current hardware, to tune the
+* DIAG_ALGORITHM choice
+* \param N maximum dimension exponent (requires ~ 3 (2^N x 2^N)
+* double matrices
+* \param min_time minimum amount of time to run each routine [s]
+**/
+void benchmark_diagonalize(int N, double min_time);
+/**
 * Perform a benchmark of PSIO disk performance on
 * the current hardware
 * \param N maximum dimension exponent (requires 1 (2^N x 2^N) 
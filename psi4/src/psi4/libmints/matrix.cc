@@ -40,6 +40,7 @@
 #include "psi4/libiwl/iwl.hpp"
 #include "psi4/libqt/qt.h"
 #include "psi4/libparallel/parallel.h"
+#include "psi4/libparallel/process.h"
 #include "psi4/libmints/matrix.h"
 #include "psi4/libmints/integral.h"
 #include "psi4/libdpd/dpd.h"
@@ -62,6 +63,8 @@
 #include <string>
 #include <regex>
 #include <tuple>
+#include <map>
+#include <atomic>
 
 // In molecule.cc
 namespace psi {
@@ -262,6 +265,112 @@ Matrix::~Matrix()
     release();
 }
 
+namespace {
+
+/// Alignment of Matrix slabs and of each irrep block within them
+const size_t matrix_slab_alignment = 64;
+/// Most slabs of one size that an arena keeps for reuse
+const size_t matrix_arena_max_per_size = 16;
+
+// Each thread parks released slabs in its own free list, so acquire and
+// release never synchronize: Matrix temporaries are created and destroyed
+// inside OpenMP loops, where a shared, locked pool serialized the threads.
+// Only the arena depth, the generation and the byte total are shared, as
+// atomics.  A slab may be released on a different thread than acquired it,
+// which is fine since both sides use the system allocator.  Closing the
+// outermost arena bumps the generation; the closing thread frees its list at
+// once, the others free theirs the next time they touch it (or on exit), so
+// at most the arena budget outlives the arena.
+std::atomic<int> matrix_arena_depth(0);
+std::atomic<unsigned long> matrix_arena_generation(0);
+std::atomic<size_t> matrix_arena_bytes(0);
+
+struct MatrixSlabCache {
+    std::multimap<size_t, void *> free_slabs;
+    size_t bytes;
+    unsigned long generation;
+
+    MatrixSlabCache() : bytes(0), generation(0) {}
+    ~MatrixSlabCache() { flush(); }
+
+    void flush()
+    {
+        for (std::multimap<size_t, void *>::iterator it = free_slabs.begin(); it != free_slabs.end(); ++it)
+            ::free(it->second);
+        free_slabs.clear();
+        matrix_arena_bytes -= bytes;
+        bytes = 0;
+    }
+};
+
+MatrixSlabCache &matrix_slab_cache()
+{
+    thread_local MatrixSlabCache cache;
+    unsigned long generation = matrix_arena_generation.load();
+    if (cache.generation != generation) {
+        cache.flush();
+        cache.generation = generation;
+    }
+    return cache;
+}
+
+size_t matrix_slab_align(size_t bytes)
+{
+    return (bytes + matrix_slab_alignment - 1) / matrix_slab_alignment * matrix_slab_alignment;
+}
+
+void *matrix_slab_acquire(size_t bytes)
+{
+    MatrixSlabCache &cache = matrix_slab_cache();
+    std::multimap<size_t, void *>::iterator it = cache.free_slabs.find(bytes);
+    if (it != cache.free_slabs.end()) {
+        void *slab = it->second;
+        cache.free_slabs.erase(it);
+        cache.bytes -= bytes;
+        matrix_arena_bytes -= bytes;
+        return slab;
+    }
+    void *slab = NULL;
+    if (posix_memalign(&slab, matrix_slab_alignment, bytes))
+        throw PSIEXCEPTION("Matrix::alloc: Unable to allocate matrix storage.");
+    return slab;
+}
+
+void matrix_slab_release(void *slab, size_t bytes)
+{
+    if (matrix_arena_depth.load()) {
+        MatrixSlabCache &cache = matrix_slab_cache();
+        if (cache.free_slabs.count(bytes) < matrix_arena_max_per_size) {
+            // Keep at most a quarter of the memory budget parked over all threads
+            size_t budget = Process::environment.get_memory() / 4;
+            size_t parked = matrix_arena_bytes.load();
+            while (parked + bytes <= budget) {
+                if (matrix_arena_bytes.compare_exchange_weak(parked, parked + bytes)) {
+                    cache.free_slabs.insert(std::make_pair(bytes, slab));
+                    cache.bytes += bytes;
+                    return;
+                }
+            }
+        }
+    }
+    ::free(slab);
+}
+
+}
+
+MatrixArena::MatrixArena()
+{
+    matrix_arena_depth++;
+}
+
+MatrixArena::~MatrixArena()
+{
+    if (--matrix_arena_depth == 0) {
+        matrix_arena_generation++;
+        matrix_slab_cache();
+    }
+}
+
 /// allocate a block matrix -- analogous to libciomr's block_matrix
 double **Matrix::matrix(int nrow, int ncol)
 {
@@ -527,11 +636,34 @@ void Matrix::alloc()
         return;
     }
 
-    matrix_ = (double ***) malloc(sizeof(double ***) * nirrep_);
+    // All irreps live in one slab: the irrep pointers, then the row pointers,
+    // then each irrep block starting on its own cache line
+    size_t nrowtot = 0;
+    size_t data_bytes = 0;
     for (int h = 0; h < nirrep_; ++h) {
-        if (rowspi_[h] != 0 && colspi_[h ^ symmetry_] != 0)
-            matrix_[h] = Matrix::matrix(rowspi_[h], colspi_[h ^ symmetry_]);
-        else {
+        if (rowspi_[h] != 0 && colspi_[h ^ symmetry_] != 0) {
+            nrowtot += rowspi_[h];
+            data_bytes += matrix_slab_align(sizeof(double) * rowspi_[h] * (size_t) colspi_[h ^ symmetry_]);
+        }
+    }
+    size_t header_bytes = matrix_slab_align(sizeof(double **) * nirrep_ + sizeof(double *) * nrowtot);
+    slab_bytes_ = header_bytes + data_bytes;
+
+    char *slab = (char *) matrix_slab_acquire(slab_bytes_);
+    ::memset((void *) (slab + header_bytes), 0, data_bytes);
+
+    matrix_ = (double ***) slab;
+    double **rows = (double **) (slab + sizeof(double **) * nirrep_);
+    char *data = slab + header_bytes;
+    for (int h = 0; h < nirrep_; ++h) {
+        if (rowspi_[h] != 0 && colspi_[h ^ symmetry_] != 0) {
+            int ncol = colspi_[h ^ symmetry_];
+            matrix_[h] = rows;
+            rows[0] = (double *) data;
+            for (int r = 1; r < rowspi_[h]; ++r) rows[r] = rows[r - 1] + ncol;
+            rows += rowspi_[h];
+            data += matrix_slab_align(sizeof(double) * rowspi_[h] * (size_t) ncol);
+        } else {
             // Force rowspi_[h] and colspi_[h^symmetry] to hard 0
             // This solves an issue where a row can have 0 dim but a col does not (or the other way).
 
@@ -549,11 +681,7 @@ void Matrix::release()
     if (!matrix_)
         return;
 
-    for (int h = 0; h < nirrep_; ++h) {
-        if (matrix_[h])
-            Matrix::free(matrix_[h]);
-    }
-    ::free(matrix_);
+    matrix_slab_release((void *) matrix_, slab_bytes_);
     matrix_ = NULL;
 }
 
@@ -1699,15 +1827,20 @@ bool Matrix::add_and_orthogonalize_row(const SharedVector v)
         throw PSIEXCEPTION("Matrix::schmidt_add_and_orthogonalize: Symmetry not allowed (yet).");
     if (v_copy.dimpi()[0] != colspi_[0])
         throw PSIEXCEPTION("Matrix::schmidt_add_and_orthogonalize: Incompatible dimensions.");
-    double **mat = Matrix::matrix(rowspi_[0] + 1, colspi_[0]);
+    // Storage is one slab per matrix, so grow it by reallocating
     size_t n = colspi_[0] * rowspi_[0] * sizeof(double);
+    double **mat = NULL;
     if (n) {
+        mat = Matrix::matrix(rowspi_[0], colspi_[0]);
         ::memcpy(mat[0], matrix_[0][0], n);
-        Matrix::free(matrix_[0]);
     }
-    matrix_[0] = mat;
-    bool ret = schmidt_add_row(0, rowspi_[0], v_copy);
     rowspi_[0]++;
+    alloc();
+    if (n) {
+        ::memcpy(matrix_[0][0], mat[0], n);
+        Matrix::free(mat);
+    }
+    bool ret = schmidt_add_row(0, rowspi_[0] - 1, v_copy);
     return ret;
 }
 
@@ -1863,6 +1996,99 @@ double Matrix::vector_dot(const SharedMatrix &rhs)
     return vector_dot(rhs.get());
 }
 
+namespace {
+
+/// Below this dimension DSYEV beats the divide-and-conquer driver on typical hardware;
+/// see benchmark_diagonalize() to check the crossover on a given machine.
+const int diag_auto_crossover = 128;
+
+/// Diagonalizes the n x n symmetric block A with DSYEVD or DSYEVR, returning the
+/// eigenvectors as the columns of V, in the order requested by nMatz (see sq_rsp)
+void diagonalize_block(int n, double **A, double *w, int nMatz, double **V, diagonalize_algorithm algorithm)
+{
+    bool eigenvectors = (nMatz == ascending || nMatz == descending);
+    bool descend = (nMatz == evals_only_descending || nMatz == descending);
+    char jobz = eigenvectors ? 'V' : 'N';
+
+    // LAPACK overwrites its input, and hands back the eigenvectors as rows
+    std::vector<double> a(A[0], A[0] + n * (size_t) n);
+    std::vector<double> z;
+    double *evecs = a.data();
+    int info = 0;
+
+    if (algorithm == diag_dsyevd) {
+        double lwork_query;
+        int liwork_query;
+        C_DSYEVD(jobz, 'U', n, a.data(), n, w, &lwork_query, -1, &liwork_query, -1);
+        std::vector<double> work((size_t) lwork_query);
+        std::vector<int> iwork(liwork_query);
+        info = C_DSYEVD(jobz, 'U', n, a.data(), n, w, work.data(), work.size(), iwork.data(), iwork.size());
+    } else {
+        int m;
+        double lwork_query;
+        int liwork_query;
+        std::vector<int> isuppz(2 * n);
+        z.resize(eigenvectors ? n * (size_t) n : 1);
+        C_DSYEVR(jobz, 'A', 'U', n, a.data(), n, 0.0, 0.0, 0, 0, 0.0, &m, w, z.data(), n, isuppz.data(),
+                 &lwork_query, -1, &liwork_query, -1);
+        std::vector<double> work((size_t) lwork_query);
+        std::vector<int> iwork(liwork_query);
+        info = C_DSYEVR(jobz, 'A', 'U', n, a.data(), n, 0.0, 0.0, 0, 0, 0.0, &m, w, z.data(), n, isuppz.data(),
+                        work.data(), work.size(), iwork.data(), iwork.size());
+        evecs = z.data();
+    }
+    if (info != 0) {
+        std::stringstream msg;
+        msg << "Matrix::diagonalize: " << (algorithm == diag_dsyevd ? "DSYEVD" : "DSYEVR") << " failed with error " << info << ".";
+        throw PSIEXCEPTION(msg.str());
+    }
+
+    if (descend)
+        std::reverse(w, w + n);
+    if (eigenvectors) {
+        for (int j = 0; j < n; ++j) {
+            double *vj = evecs + (descend ? n - 1 - j : j) * (size_t) n;
+            for (int i = 0; i < n; ++i)
+                V[i][j] = vj[i];
+        }
+    }
+}
+
+}
+
+diagonalize_algorithm Matrix::diagonalize_algorithm_from_string(const std::string& name)
+{
+    if (name == "AUTO") return diag_auto;
+    if (name == "DSYEV") return diag_dsyev;
+    if (name == "DSYEVD") return diag_dsyevd;
+    if (name == "DSYEVR") return diag_dsyevr;
+    throw PSIEXCEPTION("Matrix::diagonalize_algorithm_from_string: Unknown algorithm " + name + ".");
+}
+
+void Matrix::diagonalize(Matrix *eigvectors, Vector *eigvalues, diagonalize_order nMatz, diagonalize_algorithm algorithm)
+{
+    if (symmetry_) {
+        throw PSIEXCEPTION("Matrix::diagonalize: Matrix is non-totally symmetric.");
+    }
+    for (int h = 0; h < nirrep_; ++h) {
+        int n = rowspi_[h];
+        if (!n) continue;
+        diagonalize_algorithm alg = algorithm;
+        if (alg == diag_auto)
+            alg = (n < diag_auto_crossover ? diag_dsyev : diag_dsyevd);
+        if (alg == diag_dsyev)
+            sq_rsp(n, colspi_[h], matrix_[h], eigvalues->vector_[h], static_cast<int>(nMatz), eigvectors->matrix_[h], 1.0e-14);
+        else
+            diagonalize_block(n, matrix_[h], eigvalues->vector_[h], static_cast<int>(nMatz), eigvectors->matrix_[h], alg);
+    }
+}
+
+void Matrix::diagonalize(SharedMatrix &eigvectors, std::shared_ptr <Vector> &eigvalues, diagonalize_order nMatz,
+                         diagonalize_algorithm algorithm)
+{
+    diagonalize(eigvectors.get(), eigvalues.get(), nMatz, algorithm);
+}
+
 void Matrix::diagonalize(Matrix *eigvectors, Vector *eigvalues, diagonalize_order nMatz)
 {
     if (symmetry_) {
@@ -3315,8 +3541,8 @@ void Matrix::load_mpqc(const std::string &filename)
     rowspi_ = Dimension(nirrep_);
     colspi_ = Dimension(nirrep_);
 
-    // We'll handle memory allocation here
-    matrix_ = (double ***) malloc(sizeof(double ***) * nirrep_);
+    // The blocks are read one by one, before the dimensions are all known
+    double ***blocks = (double ***) malloc(sizeof(double ***) * nirrep_);
 
     // This will hold the index in lines we should be working on
     size_t nline = 3;
@@ -3339,9 +3565,9 @@ void Matrix::load_mpqc(const std::string &filename)
 
         // Allocate memory
         if (rowspi_[h] != 0 && colspi_[h ^ symmetry_] != 0)
-            matrix_[h] = Matrix::matrix(rowspi_[h], colspi_[h ^ symmetry_]);
+            blocks[h] = Matrix::matrix(rowspi_[h], colspi_[h ^ symmetry_]);
         else
-            matrix_[h] = NULL;
+            blocks[h] = NULL;
 
         // We read no more than 3 columns at a time
         for (int col = 0; col < colspi_[h ^ symmetry_]; col += 3) {
@@ -3361,11 +3587,11 @@ void Matrix::load_mpqc(const std::string &filename)
 //                            s3.c_str(), s3.length());
 
                     if (s1.length())
-                        matrix_[h][row][col] = str_to_double(s1);
+                        blocks[h][row][col] = str_to_double(s1);
                     if (s2.length())
-                        matrix_[h][row][col + 1] = str_to_double(s2);
+                        blocks[h][row][col + 1] = str_to_double(s2);
                     if (s3.length())
-                        matrix_[h][row][col + 2] = str_to_double(s3);
+                        blocks[h][row][col + 2] = str_to_double(s3);
                 } else
                     throw PSIEXCEPTION("Matrix::load_mpqc: Unable to match data line:\n" + lines[nline]);
 
@@ -3376,6 +3602,14 @@ void Matrix::load_mpqc(const std::string &filename)
         // Last thing to do.
         nline++;
     }
+
+    alloc();
+    copy_from(blocks);
+    for (int h = 0; h < nirrep_; ++h) {
+        if (blocks[h])
+            Matrix::free(blocks[h]);
+    }
+    ::free(blocks);
 }
 
 void Matrix::load(const std::string &filename)
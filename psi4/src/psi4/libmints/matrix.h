@@ -62,6 +62,32 @@ enum diagonalize_order {
     descending = 3
 };
 
+/// LAPACK driver used by Matrix::diagonalize. diag_auto picks DSYEV for small
+/// blocks and the divide-and-conquer DSYEVD for large ones.
+enum diagonalize_algorithm {
+    diag_auto = 0,
+    diag_dsyev = 1,
+    diag_dsyevd = 2,
+    diag_dsyevr = 3
+};
+
+/*! \ingroup MINTS
+ *  \class MatrixArena
+ *  \brief While a MatrixArena is in scope, the storage of destroyed Matrix
+ *         objects is kept and handed to new matrices of the same shape, so
+ *         that iterative procedures stop paying for malloc and first-touch
+ *         page faults on every temporary. Arenas may be nested; the cached
+ *         storage is freed when the outermost one goes out of scope.
+ */
+class MatrixArena {
+public:
+    MatrixArena();
+    ~MatrixArena();
+private:
+    MatrixArena(const MatrixArena&);
+    MatrixArena& operator=(const MatrixArena&);
+};
+
 /*! \ingroup MINTS
  *  \class Matrix
  *  \brief Makes using matrices just a little easier.
@@ -70,8 +96,10 @@ enum diagonalize_order {
  */
 class Matrix : public std::enable_shared_from_this<Matrix> {
 protected:
-    /// Matrix data
+    /// Matrix data, a single aligned slab holding all irrep blocks
     double ***matrix_;
+    /// Size of the slab behind matrix_ [bytes]
+    size_t slab_bytes_;
     /// Number of irreps
     int nirrep_;
     /// Rows per irrep array
@@ -874,6 +902,15 @@ public:
     void diagonalize(SharedMatrix& eigvectors, Vector& eigvalues, diagonalize_order nMatz = ascending);
     /// @}
 
+    /// @{
+    /// As above, with an explicit choice of the LAPACK eigensolver.
+    void diagonalize(Matrix* eigvectors, Vector* eigvalues, diagonalize_order nMatz, diagonalize_algorithm algorithm);
+    void diagonalize(SharedMatrix& eigvectors, std::shared_ptr<Vector>& eigvalues, diagonalize_order nMatz, diagonalize_algorithm algorithm);
+    /// @}
+
+    /// Parses DSYEV, DSYEVD, DSYEVR or AUTO into a diagonalize_algorithm
+    static diagonalize_algorithm diagonalize_algorithm_from_string(const std::string& name);
+
     /// @{
     /// Diagonalizes this, applying supplied metric, eigvectors and eigvalues must be created by caller.  Only for symmetric matrices.
     void diagonalize(SharedMatrix& metric, SharedMatrix& eigvectors, std::shared_ptr<Vector>& eigvalues, diagonalize_order nMatz = ascending);
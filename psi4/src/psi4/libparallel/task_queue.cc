@@ -0,0 +1,75 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2016 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include <algorithm>
+#include <utility>
+#include "task_queue.h"
+
+namespace psi {
+
+TaskQueue::TaskQueue(const std::vector<double>& costs, int nthread) :
+    queues_(nthread < 1 ? 1 : nthread), locks_(nthread < 1 ? 1 : nthread)
+{
+    std::vector<std::pair<double, size_t> > order;
+    for (size_t task = 0; task < costs.size(); task++) {
+        order.push_back(std::make_pair(-costs[task], task));
+    }
+    std::sort(order.begin(), order.end());
+
+    for (size_t n = 0; n < order.size(); n++) {
+        queues_[n % queues_.size()].push_back(order[n].second);
+    }
+}
+
+bool TaskQueue::next(int thread, size_t& task)
+{
+    int nqueue = queues_.size();
+
+    {
+        std::lock_guard<std::mutex> lock(locks_[thread]);
+        if (!queues_[thread].empty()) {
+            task = queues_[thread].front();
+            queues_[thread].pop_front();
+            return true;
+        }
+    }
+
+    // Nothing left here: steal the cheapest task of the next busy thread
+    for (int offset = 1; offset < nqueue; offset++) {
+        int victim = (thread + offset) % nqueue;
+        std::lock_guard<std::mutex> lock(locks_[victim]);
+        if (!queues_[victim].empty()) {
+            task = queues_[victim].back();
+            queues_[victim].pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+}
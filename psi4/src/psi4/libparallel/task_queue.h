@@ -0,0 +1,67 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2016 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#ifndef _psi_src_lib_libparallel_task_queue_h_
+#define _psi_src_lib_libparallel_task_queue_h_
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace psi {
+
+/*! \ingroup PARALLEL
+    A work-stealing pool of independent tasks for a fixed team of threads.
+
+    Tasks are the indices into the cost estimates given at construction.
+    They are dealt round-robin, most expensive first, onto one deque per
+    thread, so every thread starts on the largest work. A thread takes from
+    the front of its own deque; once that is empty it steals from the back,
+    the cheap end, of the others. A thread that never shows up (e.g. an
+    OpenMP team smaller than asked for) simply has its deque stolen empty.
+*/
+class TaskQueue {
+    /// Pending tasks of each thread, in decreasing cost
+    std::vector<std::deque<size_t> > queues_;
+    /// One lock per deque
+    std::vector<std::mutex> locks_;
+
+public:
+    /// Deals tasks 0..costs.size()-1 onto nthread deques by decreasing costs
+    TaskQueue(const std::vector<double>& costs, int nthread);
+
+    /// Hands thread its next task, stealing if it has none; false once all are taken
+    bool next(int thread, size_t& task);
+
+    /// The number of thread deques
+    int nthread() const { return queues_.size(); }
+};
+
+}
+
+#endif
@@ -65,9 +65,17 @@ void AIOHandler::synchronize()
     // a way to identify write jobs and check if they completed from external threads.
 //    std::unique_lock<std::mutex> lock(*locked_);
 //    lock.unlock();
-  if (thread_)
+  if (thread_ && thread_->joinable())
     thread_->join();
 }
+void AIOHandler::start_thread()
+{
+  // A worker that ran out of jobs has left call_aio but was never joined;
+  // replacing a joinable std::thread would terminate the program.
+  if (thread_ && thread_->joinable())
+    thread_->join();
+  thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio,this));
+}
 unsigned long int AIOHandler::read(unsigned int unit, const char *key, char *buffer, ULI size, psio_address start, psio_address *end)
 {
   std::unique_lock<std::mutex> lock(*locked_);
@@ -85,7 +93,7 @@ unsigned long int AIOHandler::read(unsigned int unit, const char *key, char *buf
   if (job_.size() > 1) return uniqueID_;
 
   //thread start
-  thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio,this));
+  start_thread();
   return uniqueID_;
 }
 unsigned long AIOHandler::write(unsigned int unit, const char *key, char *buffer, ULI size, psio_address start, psio_address *end, bool sync)
@@ -120,12 +128,9 @@ unsigned long AIOHandler::write(unsigned int unit, const char *key, char *buffer
 
   //fprintf(stderr,"Starting a thread\n");
   //thread start
-  if (thread_) {
-    printf("thread already exists.\n");
-  }
   if (sync)
     synchronize();
-  thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio,this));
+  start_thread();
   return uniqueID_;
 }
 unsigned long AIOHandler::read_entry(unsigned int unit, const char *key, char *buffer, ULI size)
@@ -143,7 +148,7 @@ unsigned long AIOHandler::read_entry(unsigned int unit, const char *key, char *b
   if (job_.size() > 1) return uniqueID_;
 
   //thread start
-  thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio,this));
+  start_thread();
   return uniqueID_;
 }
 unsigned long AIOHandler::write_entry(unsigned int unit, const char *key, char *buffer, ULI size)
@@ -161,7 +166,7 @@ unsigned long AIOHandler::write_entry(unsigned int unit, const char *key, char *
   if (job_.size() > 1) return uniqueID_;
 
   //thread start
-  thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio,this));
+  start_thread();
   return uniqueID_;
 }
 unsigned long AIOHandler::read_discont(unsigned int unit, const char *key,
@@ -184,7 +189,7 @@ unsigned long AIOHandler::read_discont(unsigned int unit, const char *key,
   if (job_.size() > 1) return uniqueID_;
 
   //thread start
-  thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio,this));
+  start_thread();
   return uniqueID_;
 }
 unsigned long AIOHandler::write_discont(unsigned int unit, const char *key,
@@ -207,7 +212,7 @@ unsigned long AIOHandler::write_discont(unsigned int unit, const char *key,
   if (job_.size() > 1) return uniqueID_;
 
   //thread start
-  thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio,this));
+  start_thread();
   return uniqueID_;
 }
 unsigned long AIOHandler::zero_disk(unsigned int unit, const char *key,
@@ -226,7 +231,7 @@ unsigned long AIOHandler::zero_disk(unsigned int unit, const char *key,
   if (job_.size() > 1) return uniqueID_;
 
   //thread start
-  thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio,this));
+  start_thread();
   return uniqueID_;
 }
 
@@ -250,7 +255,7 @@ unsigned long AIOHandler::write_iwl(unsigned int unit, const char *key,
   if (job_.size() > 1) return uniqueID_;
 
   //thread start
-  thread_ = std::make_shared<std::thread>(std::bind(&AIOHandler::call_aio,this));
+  start_thread();
   return uniqueID_;
 
 }
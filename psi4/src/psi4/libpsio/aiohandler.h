@@ -76,6 +76,8 @@ private:
     unsigned long int uniqueID_;
     /// condition variable to wait for a specific job to finish
     std::condition_variable condition_;
+    /// Joins a finished worker, if any, and starts a new one on call_aio
+    void start_thread();
 public:
     /// AIO_Handlers are constructed around a synchronous PSIO object
     AIOHandler(std::shared_ptr<PSIO> psio);
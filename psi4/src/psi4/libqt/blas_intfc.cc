@@ -54,6 +54,9 @@
 #include <cmath>
 
 #include "psi4/libqt/blas_intfc_mangle.h"
+#ifdef __INTEL_MKL__
+#include <mkl.h>
+#endif
 
 extern "C" {
 
@@ -82,10 +85,43 @@ extern double F_DNRM2(int *n, double *x, int *incx);
 extern double F_DASUM(int *n, double *x, int *incx);
 extern int F_IDAMAX(int *n, double *x, int *incx);
 
+#if !defined(__INTEL_MKL__) && defined(__GNUC__) && !defined(__APPLE__)
+// OpenBLAS's own thread control.  These are weak so that the other BLAS
+// libraries still link; they resolve to null when OpenBLAS isn't loaded.
+extern void openblas_set_num_threads(int nthread) __attribute__((weak));
+extern int openblas_get_num_threads(void) __attribute__((weak));
+#endif
+
 }
 
 namespace psi {
 
+/**
+ * Sets the number of threads used inside each BLAS call.  OpenMP-built BLAS
+ * libraries already run serially inside a parallel region, but MKL and a
+ * pthread-built OpenBLAS do not, so code that calls BLAS from its own
+ * threads should drop this to 1 around the region and restore it after.
+ *
+ * @param nthread The number of threads BLAS may use.
+ * @returns The previous thread count, or 1 if the library can't be queried.
+ *
+ * @ingroup QT
+ */
+int blas_set_num_threads(int nthread)
+{
+    int old_threads = 1;
+#if defined(__INTEL_MKL__)
+    old_threads = mkl_get_max_threads();
+    mkl_set_num_threads(nthread);
+#elif defined(__GNUC__) && !defined(__APPLE__)
+    if(openblas_set_num_threads && openblas_get_num_threads){
+        old_threads = openblas_get_num_threads();
+        openblas_set_num_threads(nthread);
+    }
+#endif
+    return old_threads;
+}
+
 /**
  * Swaps a vector with another vector.
  *
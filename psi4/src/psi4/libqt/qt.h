@@ -170,6 +170,9 @@ void C_DSYRK(char uplo, char trans, int n, int k, double alpha, double* a, int l
 void C_DSYR2K(char uplo, char trans, int n, int k, double alpha, double* a, int lda, double* b, int ldb, double beta, double* c, int ldc);
 void C_DTRSV(char uplo, char trans, char diag, int n, double* a, int lda, double* x, int incx);
 
+// BLAS threading, returns the previous thread count
+int blas_set_num_threads(int nthread);
+
 
 // LAPACK 3.2 Double routines
 // Sorry guys, I know its rather epic
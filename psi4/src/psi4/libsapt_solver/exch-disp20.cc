@@ -116,22 +116,22 @@ void SAPT0::exch_disp20_n5()
 
   if (A_in_core) {
 
-    psio_->read_entry(PSIF_SAPT_TEMP,"AR RI Integrals",(char *)
+    io_read_entry(PSIF_SAPT_TEMP,"AR RI Integrals",(char *)
       &(T_AR[0][0]),sizeof(double)*A_chunk*nvirA_*ndf_);
-    psio_->read_entry(PSIF_SAPT_TEMP,"V1 AS RI Integrals",(char *)
+    io_read_entry(PSIF_SAPT_TEMP,"V1 AS RI Integrals",(char *)
       &(V_AS[0][0]),sizeof(double)*A_chunk*nvirB_*(ndf_+3));
-    psio_->read_entry(PSIF_SAPT_TEMP,"Q12 AS RI Integrals",(char *)
+    io_read_entry(PSIF_SAPT_TEMP,"Q12 AS RI Integrals",(char *)
       &(Q_AS[0][0]),sizeof(double)*A_chunk*nvirB_*(ndf_+3));
 
   }
 
   if (B_in_core) {
 
-    psio_->read_entry(PSIF_SAPT_TEMP,"BS RI Integrals",(char *)
+    io_read_entry(PSIF_SAPT_TEMP,"BS RI Integrals",(char *)
       &(T_BS[0][0]),sizeof(double)*B_chunk*nvirB_*ndf_);
-    psio_->read_entry(PSIF_SAPT_TEMP,"V1 BR RI Integrals",(char *)
+    io_read_entry(PSIF_SAPT_TEMP,"V1 BR RI Integrals",(char *)
       &(V_BR[0][0]),sizeof(double)*B_chunk*nvirA_*(ndf_+3));
-    psio_->read_entry(PSIF_SAPT_TEMP,"Q12 BR RI Integrals",(char *)
+    io_read_entry(PSIF_SAPT_TEMP,"Q12 BR RI Integrals",(char *)
       &(Q_BR[0][0]),sizeof(double)*B_chunk*nvirA_*(ndf_+3));
 
   }
@@ -151,13 +151,13 @@ void SAPT0::exch_disp20_n5()
     A_length += amax;
 
     if (!A_in_core) {
-      psio_->read(PSIF_SAPT_TEMP,"AR RI Integrals",(char *)
+      io_read(PSIF_SAPT_TEMP,"AR RI Integrals",(char *)
         &(T_AR[0][0]),sizeof(double)*A_length*nvirA_*ndf_,next_T_AR,
         &next_T_AR);
-      psio_->read(PSIF_SAPT_TEMP,"V1 AS RI Integrals",(char *)
+      io_read(PSIF_SAPT_TEMP,"V1 AS RI Integrals",(char *)
         &(V_AS[0][0]),sizeof(double)*A_length*nvirB_*(ndf_+3),next_V_AS,
         &next_V_AS);
-      psio_->read(PSIF_SAPT_TEMP,"Q12 AS RI Integrals",(char *)
+      io_read(PSIF_SAPT_TEMP,"Q12 AS RI Integrals",(char *)
         &(Q_AS[0][0]),sizeof(double)*A_length*nvirB_*(ndf_+3),next_Q_AS,
         &next_Q_AS);
     }
@@ -170,13 +170,13 @@ void SAPT0::exch_disp20_n5()
       B_length += bmax;
 
       if (!B_in_core) {
-        psio_->read(PSIF_SAPT_TEMP,"BS RI Integrals",(char *)
+        io_read(PSIF_SAPT_TEMP,"BS RI Integrals",(char *)
           &(T_BS[0][0]),sizeof(double)*B_length*nvirB_*ndf_,next_T_BS,
           &next_T_BS);
-        psio_->read(PSIF_SAPT_TEMP,"V1 BR RI Integrals",(char *)
+        io_read(PSIF_SAPT_TEMP,"V1 BR RI Integrals",(char *)
           &(V_BR[0][0]),sizeof(double)*B_length*nvirA_*(ndf_+3),next_V_BR,
           &next_V_BR);
-        psio_->read(PSIF_SAPT_TEMP,"Q12 BR RI Integrals",(char *)
+        io_read(PSIF_SAPT_TEMP,"Q12 BR RI Integrals",(char *)
           &(Q_BR[0][0]),sizeof(double)*B_length*nvirA_*(ndf_+3),next_Q_BR,
           &next_Q_BR);
       }
@@ -329,34 +329,34 @@ void SAPT0::exch_disp20_n4()
   double **Q10_AS = block_matrix(aoccA_,nvirB_);
   double **Q11_RB = block_matrix(nvirA_,aoccB_);
 
-  psio_->read_entry(PSIF_SAPT_TEMP,"H1 RB Array",(char *) &(H1_RB[0][0]),
+  io_read_entry(PSIF_SAPT_TEMP,"H1 RB Array",(char *) &(H1_RB[0][0]),
     sizeof(double)*nvirA_*aoccB_);
 
-  psio_->read_entry(PSIF_SAPT_TEMP,"H3 AS Array",(char *) &(H3_AS[0][0]),
+  io_read_entry(PSIF_SAPT_TEMP,"H3 AS Array",(char *) &(H3_AS[0][0]),
     sizeof(double)*aoccA_*nvirB_);
 
-  psio_->read_entry(PSIF_SAPT_TEMP,"Q1 AS Array",(char *) &(Q1_AS[0][0]),
+  io_read_entry(PSIF_SAPT_TEMP,"Q1 AS Array",(char *) &(Q1_AS[0][0]),
     sizeof(double)*aoccA_*nvirB_);
 
-  psio_->read_entry(PSIF_SAPT_TEMP,"Q3 AS Array",(char *) &(Q3_AS[0][0]),
+  io_read_entry(PSIF_SAPT_TEMP,"Q3 AS Array",(char *) &(Q3_AS[0][0]),
     sizeof(double)*aoccA_*nvirB_);
 
-  psio_->read_entry(PSIF_SAPT_TEMP,"Q4 BS Array",(char *) &(Q4_BS[0][0]),
+  io_read_entry(PSIF_SAPT_TEMP,"Q4 BS Array",(char *) &(Q4_BS[0][0]),
     sizeof(double)*aoccB_*nvirB_);
 
-  psio_->read_entry(PSIF_SAPT_TEMP,"Q5 RB Array",(char *) &(Q5_RB[0][0]),
+  io_read_entry(PSIF_SAPT_TEMP,"Q5 RB Array",(char *) &(Q5_RB[0][0]),
     sizeof(double)*nvirA_*aoccB_);
 
-  psio_->read_entry(PSIF_SAPT_TEMP,"Q7 RB Array",(char *) &(Q7_RB[0][0]),
+  io_read_entry(PSIF_SAPT_TEMP,"Q7 RB Array",(char *) &(Q7_RB[0][0]),
     sizeof(double)*nvirA_*aoccB_);
 
-  psio_->read_entry(PSIF_SAPT_TEMP,"Q8 AR Array",(char *) &(Q8_AR[0][0]),
+  io_read_entry(PSIF_SAPT_TEMP,"Q8 AR Array",(char *) &(Q8_AR[0][0]),
     sizeof(double)*aoccA_*nvirA_);
 
-  psio_->read_entry(PSIF_SAPT_TEMP,"Q10 AS Array",(char *) &(Q10_AS[0][0]),
+  io_read_entry(PSIF_SAPT_TEMP,"Q10 AS Array",(char *) &(Q10_AS[0][0]),
     sizeof(double)*aoccA_*nvirB_);
 
-  psio_->read_entry(PSIF_SAPT_TEMP,"Q11 RB Array",(char *) &(Q11_RB[0][0]),
+  io_read_entry(PSIF_SAPT_TEMP,"Q11 RB Array",(char *) &(Q11_RB[0][0]),
     sizeof(double)*nvirA_*aoccB_);
 
   SAPTDFInts B_p_AR = set_act_C_AR();
@@ -657,14 +657,14 @@ void SAPT0::theta_ar()
   double *temp = init_array(chunk*nvirA_);
 
   if (in_core) {
-    psio_->read_entry(PSIF_SAPT_TEMP,"AR RI Integrals",(char *)
+    io_read_entry(PSIF_SAPT_TEMP,"AR RI Integrals",(char *)
       &(B_AR[0][0]),sizeof(double)*chunk*nvirA_*ndf_);
   }
 
   psio_address next_B_AR = PSIO_ZERO;
   psio_address next_T_AR = PSIO_ZERO;
 
-  zero_disk(PSIF_SAPT_TEMP,"Theta AR Intermediate",ndf_+3,aoccA_*nvirA_);
+  io_zero_disk(PSIF_SAPT_TEMP,"Theta AR Intermediate",ndf_+3,aoccA_*nvirA_);
 
   for (int a=0,amax=0; a<blocks; a++) {
 
@@ -675,7 +675,7 @@ void SAPT0::theta_ar()
     length += amax;
 
     if (!in_core) {
-      psio_->read(PSIF_SAPT_TEMP,"AR RI Integrals",(char *)
+      io_read(PSIF_SAPT_TEMP,"AR RI Integrals",(char *)
         &(B_AR[0][0]),sizeof(double)*length*nvirA_*ndf_,next_B_AR,
         &next_B_AR);
     }
@@ -703,7 +703,7 @@ void SAPT0::theta_ar()
       next_T_AR = psio_get_address(PSIO_ZERO,sizeof(double)*P*aoccA_*nvirA_
         +sizeof(double)*amin*nvirA_);
       C_DCOPY((long int) length*nvirA_,&(T_AR[0][P]),ndf_+3,temp,1);
-      psio_->write(PSIF_SAPT_TEMP,"Theta AR Intermediate",(char *)
+      io_write(PSIF_SAPT_TEMP,"Theta AR Intermediate",(char *)
         &(temp[0]),sizeof(double)*length*nvirA_,next_T_AR,&next_T_AR);
     }
   }
@@ -714,7 +714,7 @@ void SAPT0::theta_ar()
   free(temp);
 
   if (debug_)
-    psio_->write_entry(PSIF_SAPT_TEMP,"Y PQ Intermediate",(char *)
+    io_write_entry(PSIF_SAPT_TEMP,"Y PQ Intermediate",(char *)
       &(yPQ[0][0]),sizeof(double)*nvec_*ndf_*(ndf_+3));
 
   free_block(yPQ);
@@ -806,14 +806,14 @@ void SAPT0::theta_bs()
   double *temp = init_array(chunk*nvirB_);
 
   if (in_core) {
-    psio_->read_entry(PSIF_SAPT_TEMP,"BS RI Integrals",(char *)
+    io_read_entry(PSIF_SAPT_TEMP,"BS RI Integrals",(char *)
       &(B_BS[0][0]),sizeof(double)*chunk*nvirB_*ndf_);
   }
 
   psio_address next_B_BS = PSIO_ZERO;
   psio_address next_T_BS = PSIO_ZERO;
 
-  zero_disk(PSIF_SAPT_TEMP,"Theta BS Intermediate",ndf_+3,aoccB_*nvirB_);
+  io_zero_disk(PSIF_SAPT_TEMP,"Theta BS Intermediate",ndf_+3,aoccB_*nvirB_);
 
   for (int b=0,bmax=0; b<blocks; b++) {
 
@@ -824,7 +824,7 @@ void SAPT0::theta_bs()
     length += bmax;
 
     if (!in_core) {
-      psio_->read(PSIF_SAPT_TEMP,"BS RI Integrals",(char *)
+      io_read(PSIF_SAPT_TEMP,"BS RI Integrals",(char *)
         &(B_BS[0][0]),sizeof(double)*length*nvirB_*ndf_,next_B_BS,
         &next_B_BS);
     }
@@ -852,7 +852,7 @@ void SAPT0::theta_bs()
       next_T_BS = psio_get_address(PSIO_ZERO,sizeof(double)*P*aoccB_*nvirB_
         +sizeof(double)*bmin*nvirB_);
       C_DCOPY((long int) length*nvirB_,&(T_BS[0][P]),ndf_+3,temp,1);
-      psio_->write(PSIF_SAPT_TEMP,"Theta BS Intermediate",(char *)
+      io_write(PSIF_SAPT_TEMP,"Theta BS Intermediate",(char *)
         &(temp[0]),sizeof(double)*length*nvirB_,next_T_BS,&next_T_BS);
     }
   }
@@ -863,7 +863,7 @@ void SAPT0::theta_bs()
   free(temp);
 
   if (debug_)
-    psio_->write_entry(PSIF_SAPT_TEMP,"X PQ Intermediate",(char *)
+    io_write_entry(PSIF_SAPT_TEMP,"X PQ Intermediate",(char *)
       &(xPQ[0][0]),sizeof(double)*nvec_*ndf_*(ndf_+3));
 
   free_block(xPQ);
@@ -875,10 +875,10 @@ void SAPT0::test_theta()
   double **B_AR = block_matrix(aoccA_*nvirA_,ndf_);
   double **T_AR = block_matrix(aoccA_*nvirA_,ndf_+3);
 
-  psio_->read_entry(PSIF_SAPT_TEMP,"AR RI Integrals",(char *)
+  io_read_entry(PSIF_SAPT_TEMP,"AR RI Integrals",(char *)
     &(B_AR[0][0]),sizeof(double)*aoccA_*nvirA_*ndf_);
 
-  psio_->read_entry(PSIF_SAPT_TEMP,"Theta AR Intermediate",(char *)
+  io_read_entry(PSIF_SAPT_TEMP,"Theta AR Intermediate",(char *)
     &(T_AR[0][0]),sizeof(double)*aoccA_*nvirA_*(ndf_+3));
 
   double disp_ar = 0.0;	
@@ -893,10 +893,10 @@ void SAPT0::test_theta()
   double **B_BS = block_matrix(aoccB_*nvirB_,ndf_);
   double **T_BS = block_matrix(aoccB_*nvirB_,ndf_+3);
 
-  psio_->read_entry(PSIF_SAPT_TEMP,"BS RI Integrals",(char *)
+  io_read_entry(PSIF_SAPT_TEMP,"BS RI Integrals",(char *)
     &(B_BS[0][0]),sizeof(double)*aoccB_*nvirB_*ndf_);
 
-  psio_->read_entry(PSIF_SAPT_TEMP,"Theta BS Intermediate",(char *)
+  io_read_entry(PSIF_SAPT_TEMP,"Theta BS Intermediate",(char *)
     &(T_BS[0][0]),sizeof(double)*aoccB_*nvirB_*(ndf_+3));
 
   double disp_bs = 0.0;
@@ -911,9 +911,9 @@ void SAPT0::test_theta()
   double **xPQ = block_matrix(nvec_,ndf_*(ndf_+3));
   double **yPQ = block_matrix(nvec_,ndf_*(ndf_+3));
 
-  psio_->read_entry(PSIF_SAPT_TEMP,"X PQ Intermediate",(char *)
+  io_read_entry(PSIF_SAPT_TEMP,"X PQ Intermediate",(char *)
     &(xPQ[0][0]),sizeof(double)*nvec_*ndf_*(ndf_+3));
-  psio_->read_entry(PSIF_SAPT_TEMP,"Y PQ Intermediate",(char *)
+  io_read_entry(PSIF_SAPT_TEMP,"Y PQ Intermediate",(char *)
     &(yPQ[0][0]),sizeof(double)*nvec_*ndf_*(ndf_+3));
 
   double disp_xy = -4.0*C_DDOT((long int) nvec_*ndf_*(ndf_+3),xPQ[0],1,
@@ -929,8 +929,8 @@ void SAPT0::test_theta()
 
 void SAPT0::arbs()
 {
-  zero_disk(PSIF_SAPT_TEMP,"AR RI Integrals",aoccA_*nvirA_,ndf_);
-  zero_disk(PSIF_SAPT_TEMP,"BS RI Integrals",aoccB_*nvirB_,ndf_);
+  io_zero_disk(PSIF_SAPT_TEMP,"AR RI Integrals",aoccA_*nvirA_,ndf_);
+  io_zero_disk(PSIF_SAPT_TEMP,"BS RI Integrals",aoccB_*nvirB_,ndf_);
 
   SAPTDFInts T_p_AR = set_act_C_AR();
   Iterator T_AR_iter = get_iterator(mem_/2,&T_p_AR);
@@ -951,7 +951,7 @@ void SAPT0::arbs()
     next_T_AR = psio_get_address(PSIO_ZERO,sizeof(double)*off);
 
     for (int ar=0; ar<aoccA_*nvirA_; ar++) {
-      psio_->write(PSIF_SAPT_TEMP,"AR RI Integrals",(char *)
+      io_write(PSIF_SAPT_TEMP,"AR RI Integrals",(char *)
         &(X_AR_p[ar][0]),sizeof(double)*T_AR_iter.curr_size,next_T_AR,
         &next_T_AR);
       next_T_AR = psio_get_address(next_T_AR,sizeof(double)*skip);
@@ -982,7 +982,7 @@ void SAPT0::arbs()
     next_T_BS = psio_get_address(PSIO_ZERO,sizeof(double)*off);
 
     for (int bs=0; bs<aoccB_*nvirB_; bs++) {
-      psio_->write(PSIF_SAPT_TEMP,"BS RI Integrals",(char *)
+      io_write(PSIF_SAPT_TEMP,"BS RI Integrals",(char *)
         &(X_BS_p[bs][0]),sizeof(double)*T_BS_iter.curr_size,next_T_BS,
         &next_T_BS);
       next_T_BS = psio_get_address(next_T_BS,sizeof(double)*skip);
@@ -1003,8 +1003,8 @@ void SAPT0::v1()
 #endif
   int rank = 0;
 
-  zero_disk(PSIF_SAPT_TEMP,"V1 AS RI Integrals",aoccA_*nvirB_,ndf_+3);
-  zero_disk(PSIF_SAPT_TEMP,"V1 BR RI Integrals",aoccB_*nvirA_,ndf_+3);
+  io_zero_disk(PSIF_SAPT_TEMP,"V1 AS RI Integrals",aoccA_*nvirB_,ndf_+3);
+  io_zero_disk(PSIF_SAPT_TEMP,"V1 BR RI Integrals",aoccB_*nvirA_,ndf_+3);
 
   SAPTDFInts A_p_AA = set_A_AA();
   SAPTDFInts A_p_AS = set_A_AS();
@@ -1039,7 +1039,7 @@ void SAPT0::v1()
     next_A_AS = psio_get_address(PSIO_ZERO,sizeof(double)*off);
 
     for (int as=0; as<aoccA_*nvirB_; as++) {
-      psio_->write(PSIF_SAPT_TEMP,"V1 AS RI Integrals",(char *)
+      io_write(PSIF_SAPT_TEMP,"V1 AS RI Integrals",(char *)
         &(X_AS_p[as][0]),sizeof(double)*AS_iter.curr_size,next_A_AS,
         &next_A_AS);
       next_A_AS = psio_get_address(next_A_AS,sizeof(double)*skip);
@@ -1088,7 +1088,7 @@ void SAPT0::v1()
     next_B_BR = psio_get_address(PSIO_ZERO,sizeof(double)*off);
 
     for (int br=0; br<aoccB_*nvirA_; br++) {
-      psio_->write(PSIF_SAPT_TEMP,"V1 BR RI Integrals",(char *)
+      io_write(PSIF_SAPT_TEMP,"V1 BR RI Integrals",(char *)
         &(X_BR_p[br][0]),sizeof(double)*BR_iter.curr_size,next_B_BR,
         &next_B_BR);
       next_B_BR = psio_get_address(next_B_BR,sizeof(double)*skip);
@@ -1160,7 +1160,7 @@ void SAPT0::h1()
   A_p_AR.done();
   B_p_AB.done();
 
-  psio_->write_entry(PSIF_SAPT_TEMP,"H1 RB Array",(char *) &(xRB[0][0]),
+  io_write_entry(PSIF_SAPT_TEMP,"H1 RB Array",(char *) &(xRB[0][0]),
     sizeof(double)*nvirA_*aoccB_);
 
   free_block(xRB);
@@ -1183,9 +1183,9 @@ double SAPT0::h2()
     for (int p=0; p<AB_iter.curr_size; p++) {
       C_DGEMM('T','N',aoccB_,nvirB_,noccA_,1.0,&(B_p_AB.B_p_[p][foccB_]),
         noccB_,&(sAB_[0][noccB_]),nmoB_,0.0,xBS[0],nvirB_);
-      psio_->write(PSIF_SAPT_TEMP,"H2 BS RI Integrals",(char *)
+      io_write(PSIF_SAPT_TEMP,"H2 BS RI Integrals",(char *)
         &(xBS[0][0]),sizeof(double)*aoccB_*nvirB_,next_BS,&next_BS);
-      psio_->read(PSIF_SAPT_TEMP,"Theta BS Intermediate",(char *)
+      io_read(PSIF_SAPT_TEMP,"Theta BS Intermediate",(char *)
         &(yBS[0][0]),sizeof(double)*aoccB_*nvirB_,next_T_BS,&next_T_BS);
       h_2 += 2.0*C_DDOT(aoccB_*nvirB_,xBS[0],1,yBS[0],1);
     }
@@ -1251,7 +1251,7 @@ void SAPT0::h3()
   for (int n=1; n<nthreads; n++)
     C_DAXPY(aoccA_*nvirB_,1.0,xAS[n],1,xAS[0],1);
 
-  psio_->write_entry(PSIF_SAPT_TEMP,"H3 AS Array",(char *) &(xAS[0][0]),
+  io_write_entry(PSIF_SAPT_TEMP,"H3 AS Array",(char *) &(xAS[0][0]),
     sizeof(double)*aoccA_*nvirB_);
 
   free_block(xAS);
@@ -1275,9 +1275,9 @@ double SAPT0::h4()
       C_DGEMM('N','T',aoccA_,nvirA_,noccB_,1.0,
         &(A_p_AB.B_p_[p][foccA_*noccB_]),noccB_,&(sAB_[noccA_][0]),nmoB_,
         0.0,xAR[0],nvirA_);
-      psio_->write(PSIF_SAPT_TEMP,"H4 AR RI Integrals",(char *)
+      io_write(PSIF_SAPT_TEMP,"H4 AR RI Integrals",(char *)
         &(xAR[0][0]),sizeof(double)*aoccA_*nvirA_,next_AR,&next_AR);
-      psio_->read(PSIF_SAPT_TEMP,"Theta AR Intermediate",(char *)
+      io_read(PSIF_SAPT_TEMP,"Theta AR Intermediate",(char *)
         &(yAR[0][0]),sizeof(double)*aoccA_*nvirA_,next_T_AR,&next_T_AR);
       h_4 += 2.0*C_DDOT(aoccA_*nvirA_,xAR[0],1,yAR[0],1);
     }
@@ -1328,7 +1328,7 @@ void SAPT0::q1()
   for (int n=1; n<nthreads; n++)
     C_DAXPY(aoccA_*nvirB_,1.0,xAS[n],1,xAS[0],1);
 
-  psio_->write_entry(PSIF_SAPT_TEMP,"Q1 AS Array",(char *) &(xAS[0][0]),
+  io_write_entry(PSIF_SAPT_TEMP,"Q1 AS Array",(char *) &(xAS[0][0]),
     sizeof(double)*aoccA_*nvirB_);
 
   free_block(xAB);
@@ -1358,9 +1358,9 @@ double SAPT0::q2()
       C_DGEMM('N','N',aoccA_,nvirA_,noccA_,1.0,
         &(A_p_AA.B_p_[j][foccA_*noccA_]),noccA_,sAR,nvirA_,
         0.0,xAR,nvirA_);
-      psio_->write(PSIF_SAPT_TEMP,"Q2 AR RI Integrals",(char *)
+      io_write(PSIF_SAPT_TEMP,"Q2 AR RI Integrals",(char *)
         &(xAR[0]),sizeof(double)*aoccA_*nvirA_,next_AR,&next_AR);
-      psio_->read(PSIF_SAPT_TEMP,"Theta AR Intermediate",(char *)
+      io_read(PSIF_SAPT_TEMP,"Theta AR Intermediate",(char *)
         &(yAR[0]),sizeof(double)*aoccA_*nvirA_,next_T_AR,&next_T_AR);
       q_2 -= 2.0*C_DDOT(aoccA_*nvirA_,xAR,1,yAR,1);
     }
@@ -1392,10 +1392,10 @@ void SAPT0::q3()
   C_DGEMM('N','N',aoccA_,nvirB_,noccB_,1.0,&(sAB_[foccA_][0]),nmoB_,
     xBS,nvirB_,0.0,xAS,nvirB_);
 
-  psio_->write_entry(PSIF_SAPT_TEMP,"Q3 AS Array",(char *) &(xAS[0]),
+  io_write_entry(PSIF_SAPT_TEMP,"Q3 AS Array",(char *) &(xAS[0]),
     sizeof(double)*aoccA_*nvirB_);
 
-  psio_->write_entry(PSIF_SAPT_TEMP,"Q4 BS Array",(char *) 
+  io_write_entry(PSIF_SAPT_TEMP,"Q4 BS Array",(char *) 
     &(xBS[foccB_*nvirB_]),sizeof(double)*aoccB_*nvirB_);
 
   free(xBS);
@@ -1439,7 +1439,7 @@ void SAPT0::q5()
   for (int n=1; n<nthreads; n++)
     C_DAXPY(nvirA_*aoccB_,1.0,xRB[n],1,xRB[0],1);
 
-  psio_->write_entry(PSIF_SAPT_TEMP,"Q5 RB Array",(char *) &(xRB[0][0]),
+  io_write_entry(PSIF_SAPT_TEMP,"Q5 RB Array",(char *) &(xRB[0][0]),
     sizeof(double)*nvirA_*aoccB_);
 
   free_block(xAB);
@@ -1468,9 +1468,9 @@ double SAPT0::q6()
       C_DGEMM('N','N',aoccB_,nvirB_,noccB_,1.0,
         &(B_p_BB.B_p_[j][foccB_*noccB_]),noccB_,sBS,nvirB_,
         0.0,xBS,nvirB_);
-      psio_->write(PSIF_SAPT_TEMP,"Q6 BS RI Integrals",(char *)
+      io_write(PSIF_SAPT_TEMP,"Q6 BS RI Integrals",(char *)
         &(xBS[0]),sizeof(double)*aoccB_*nvirB_,next_BS,&next_BS);
-      psio_->read(PSIF_SAPT_TEMP,"Theta BS Intermediate",(char *)
+      io_read(PSIF_SAPT_TEMP,"Theta BS Intermediate",(char *)
         &(yBS[0]),sizeof(double)*aoccB_*nvirB_,next_T_BS,&next_T_BS);
       q_6 -= 2.0*C_DDOT(aoccB_*nvirB_,xBS,1,yBS,1);
     }
@@ -1502,10 +1502,10 @@ void SAPT0::q7()
   C_DGEMM('T','N',nvirA_,aoccB_,noccA_,1.0,xAR,nvirA_,&(sAB_[0][foccB_]),nmoB_,
     0.0,xRB,aoccB_);
 
-  psio_->write_entry(PSIF_SAPT_TEMP,"Q7 RB Array",(char *) &(xRB[0]),
+  io_write_entry(PSIF_SAPT_TEMP,"Q7 RB Array",(char *) &(xRB[0]),
     sizeof(double)*nvirA_*aoccB_);
 
-  psio_->write_entry(PSIF_SAPT_TEMP,"Q8 AR Array",(char *) 
+  io_write_entry(PSIF_SAPT_TEMP,"Q8 AR Array",(char *) 
     &(xAR[foccA_*nvirA_]),sizeof(double)*aoccA_*nvirA_);
 
   free(xAR);
@@ -1531,7 +1531,7 @@ void SAPT0::q10()
   C_DGEMM('N','N',aoccA_,nvirB_,noccA_,1.0,&(xAA[foccA_*noccA_]),noccA_,
     &(sAB_[0][noccB_]),nmoB_,0.0,xAS,nvirB_);
 
-  psio_->write_entry(PSIF_SAPT_TEMP,"Q10 AS Array",(char *) &(xAS[0]),
+  io_write_entry(PSIF_SAPT_TEMP,"Q10 AS Array",(char *) &(xAS[0]),
     sizeof(double)*aoccA_*nvirB_);
 
   free(xAA);
@@ -1557,7 +1557,7 @@ void SAPT0::q11()
   C_DGEMM('N','T',nvirA_,aoccB_,noccB_,1.0,&(sAB_[noccA_][0]),nmoB_,
     &(xBB[foccB_*noccB_]),noccB_,0.0,xRB,aoccB_);
 
-  psio_->write_entry(PSIF_SAPT_TEMP,"Q11 RB Array",(char *) &(xRB[0]),
+  io_write_entry(PSIF_SAPT_TEMP,"Q11 RB Array",(char *) &(xRB[0]),
     sizeof(double)*nvirA_*aoccB_);
 
   free(xBB);
@@ -1572,8 +1572,8 @@ void SAPT0::q12()
 #endif
   int rank = 0;
 
-  zero_disk(PSIF_SAPT_TEMP,"Q12 AS RI Integrals",aoccA_*nvirB_,ndf_+3);
-  zero_disk(PSIF_SAPT_TEMP,"Q12 BR RI Integrals",aoccB_*nvirA_,ndf_+3);
+  io_zero_disk(PSIF_SAPT_TEMP,"Q12 AS RI Integrals",aoccA_*nvirB_,ndf_+3);
+  io_zero_disk(PSIF_SAPT_TEMP,"Q12 BR RI Integrals",aoccB_*nvirA_,ndf_+3);
 
   SAPTDFInts A_p_AR = set_A_AR();
   Iterator AR_iter = get_iterator(mem_/2,&A_p_AR);
@@ -1607,7 +1607,7 @@ void SAPT0::q12()
     next_B_BR = psio_get_address(PSIO_ZERO,sizeof(double)*off);
 
     for (int br=0; br<aoccB_*nvirA_; br++) {
-      psio_->write(PSIF_SAPT_TEMP,"Q12 BR RI Integrals",(char *)
+      io_write(PSIF_SAPT_TEMP,"Q12 BR RI Integrals",(char *)
         &(X_BR_p[br][0]),sizeof(double)*AR_iter.curr_size,next_B_BR,
         &next_B_BR);
       next_B_BR = psio_get_address(next_B_BR,sizeof(double)*skip);
@@ -1651,7 +1651,7 @@ void SAPT0::q12()
     next_AS = psio_get_address(PSIO_ZERO,sizeof(double)*off);
 
     for (int as=0; as<aoccA_*nvirB_; as++) {
-      psio_->write(PSIF_SAPT_TEMP,"Q12 AS RI Integrals",(char *)
+      io_write(PSIF_SAPT_TEMP,"Q12 AS RI Integrals",(char *)
         &(X_AS_p[as][0]),sizeof(double)*BS_iter.curr_size,next_AS,
         &next_AS);
       next_AS = psio_get_address(next_AS,sizeof(double)*skip);
@@ -1685,9 +1685,9 @@ double SAPT0::q13()
     for (int j=0; j<BS_iter.curr_size; j++) {
       C_DGEMM('N','N',aoccB_,nvirB_,noccB_,1.0,sBB[0],noccB_,
         &(B_p_BS.B_p_[j][0]),nvirB_,0.0,xBS,nvirB_);
-      psio_->write(PSIF_SAPT_TEMP,"Q13 BS RI Integrals",(char *)
+      io_write(PSIF_SAPT_TEMP,"Q13 BS RI Integrals",(char *)
         &(xBS[0]),sizeof(double)*aoccB_*nvirB_,next_BS,&next_BS);
-      psio_->read(PSIF_SAPT_TEMP,"Theta BS Intermediate",(char *)
+      io_read(PSIF_SAPT_TEMP,"Theta BS Intermediate",(char *)
         &(yBS[0]),sizeof(double)*aoccB_*nvirB_,next_T_BS,&next_T_BS);
       q_13 -= 2.0*C_DDOT(aoccB_*nvirB_,xBS,1,yBS,1);
     }
@@ -1721,9 +1721,9 @@ double SAPT0::q14()
     for (int j=0; j<AR_iter.curr_size; j++) {
       C_DGEMM('N','N',aoccA_,nvirA_,noccA_,1.0,sAA[0],noccA_,
         &(A_p_AR.B_p_[j][0]),nvirA_,0.0,xAR,nvirA_);
-      psio_->write(PSIF_SAPT_TEMP,"Q14 AR RI Integrals",(char *)
+      io_write(PSIF_SAPT_TEMP,"Q14 AR RI Integrals",(char *)
         &(xAR[0]),sizeof(double)*aoccA_*nvirA_,next_AR,&next_AR);
-      psio_->read(PSIF_SAPT_TEMP,"Theta AR Intermediate",(char *)
+      io_read(PSIF_SAPT_TEMP,"Theta AR Intermediate",(char *)
         &(yAR[0]),sizeof(double)*aoccA_*nvirA_,next_T_AR,&next_T_AR);
       q_14 -= 2.0*C_DDOT(aoccA_*nvirA_,xAR,1,yAR,1);
     }
@@ -61,6 +61,7 @@ SAPT0::SAPT0(SharedWavefunction Dimer, SharedWavefunction MonomerA,
   no_response_ = options_.get_bool("NO_RESPONSE");
   aio_cphf_ = options_.get_bool("AIO_CPHF");
   aio_dfints_ = options_.get_bool("AIO_DF_INTS");
+  incore_ = false;
   do_e10_ = options_.get_bool("SAPT0_E10");
   do_e20ind_ = options_.get_bool("SAPT0_E20IND");
   do_e20disp_ = options_.get_bool("SAPT0_E20DISP");
@@ -80,9 +81,9 @@ SAPT0::~SAPT0()
 {
   if (wBAR_ != NULL) free_block(wBAR_);
   if (wABS_ != NULL) free_block(wABS_);
-  psio_->close(PSIF_SAPT_AA_DF_INTS,1);
-  psio_->close(PSIF_SAPT_BB_DF_INTS,1);
-  psio_->close(PSIF_SAPT_AB_DF_INTS,1);
+  io_close(PSIF_SAPT_AA_DF_INTS,1);
+  io_close(PSIF_SAPT_BB_DF_INTS,1);
+  io_close(PSIF_SAPT_AB_DF_INTS,1);
 }
 
 double SAPT0::compute_energy()
@@ -92,12 +93,12 @@ double SAPT0::compute_energy()
   if (elst_basis_ && do_e10_)
     first_order_terms();
 
-  psio_->open(PSIF_SAPT_AA_DF_INTS,PSIO_OPEN_NEW);
-  psio_->open(PSIF_SAPT_BB_DF_INTS,PSIO_OPEN_NEW);
-  psio_->open(PSIF_SAPT_AB_DF_INTS,PSIO_OPEN_NEW);
+  io_open(PSIF_SAPT_AA_DF_INTS,PSIO_OPEN_NEW);
+  io_open(PSIF_SAPT_BB_DF_INTS,PSIO_OPEN_NEW);
+  io_open(PSIF_SAPT_AB_DF_INTS,PSIO_OPEN_NEW);
 
   timer_on("DF Integrals       ");
-    if (aio_dfints_)
+    if (aio_dfints_ && !incore_)
       df_integrals_aio();
     else
       df_integrals();
@@ -131,12 +132,12 @@ double SAPT0::compute_energy()
   if(do_e20disp_) {
       if (debug_) disp20();
       timer_on("Exch-Disp20 N^5    ");
-        psio_->open(PSIF_SAPT_TEMP,PSIO_OPEN_NEW);
+        io_open(PSIF_SAPT_TEMP,PSIO_OPEN_NEW);
         exch_disp20_n5();
       timer_off("Exch-Disp20 N^5    ");
       timer_on("Exch-Disp20 N^4    ");
         exch_disp20_n4();
-        psio_->close(PSIF_SAPT_TEMP,0);
+        io_close(PSIF_SAPT_TEMP,0);
       timer_off("Exch-Disp20 N^4    ");
   }
 
@@ -396,15 +397,69 @@ void SAPT0::check_memory()
   if (exchdisp > mem_) fail = true;
 
   if (fail) throw PsiException("Not enough memory", __FILE__,__LINE__);
+
+  // Keep the DF integrals and scratch arrays in core, rather than on
+  // PSIF_SAPT_*_DF_INTS and PSIF_SAPT_TEMP, if they take at most half of
+  // the memory (or any amount, for SAPT0_DF_STORAGE CORE) and leave the
+  // terms the working memory they need above
+  long int incore = incore_memory();
+  long int working = dfint;
+  if (indices > working) working = indices;
+  if (exchdisp > working) working = exchdisp;
+
+  std::string storage = options_.get_str("SAPT0_DF_STORAGE");
+  bool fits = (incore <= mem_ && working <= mem_ - incore);
+  if (storage == "DISK")
+    incore_ = false;
+  else if (storage == "CORE") {
+    if (!fits)
+      throw PsiException("Not enough memory to keep the DF integrals in core"
+        " for SAPT0_DF_STORAGE CORE", __FILE__,__LINE__);
+    incore_ = true;
+  }
+  else
+    incore_ = (2L*incore <= mem_ && fits);
+
+  if (incore_) {
+    mem_ -= incore;
+    outfile->Printf("    Keeping the DF integrals in core (%8.1lf MB)\n\n",
+      8.0*incore/1000000.0);
+  }
+}
+
+long int SAPT0::incore_memory()
+{
+  long int ndf = ndf_ + 3L;
+
+  long int dfints = ndf*(noccA_*(long int) noccA_ + noccA_*(long int) nvirA_
+    + nvirA_*(nvirA_+1L)/2 + noccB_*(long int) noccB_
+    + noccB_*(long int) nvirB_ + nvirB_*(nvirB_+1L)/2
+    + noccA_*(long int) noccB_ + noccA_*(long int) nvirB_
+    + nvirA_*(long int) noccB_);
+
+  // PSIF_SAPT_TEMP holds the AO DF integrals while the MO ones are formed
+  long int nbf = ndf_;
+  if (elst_basis_ && elstbasis_->nbf() > nbf) nbf = elstbasis_->nbf();
+  long int temp = nbf*(nso_*(nso_+1L)/2);
+
+  // and the exch-disp20 intermediates afterwards
+  if (do_e20disp_) {
+    long int exchdisp = ndf*(5L*aoccA_*nvirA_ + 5L*aoccB_*nvirB_
+      + 2L*aoccA_*nvirB_ + 2L*aoccB_*nvirA_) + 2L*ndf*ndf
+      + 10L*(noccA_+noccB_)*(long int) (nvirA_+nvirB_);
+    if (exchdisp > temp) temp = exchdisp;
+  }
+
+  return(dfints + temp);
 }
 
 void SAPT0::first_order_terms()
 {
   ndf_ = elstbasis_->nbf();
 
-  psio_->open(PSIF_SAPT_AA_DF_INTS,PSIO_OPEN_NEW);
-  psio_->open(PSIF_SAPT_BB_DF_INTS,PSIO_OPEN_NEW);
-  psio_->open(PSIF_SAPT_AB_DF_INTS,PSIO_OPEN_NEW);
+  io_open(PSIF_SAPT_AA_DF_INTS,PSIO_OPEN_NEW);
+  io_open(PSIF_SAPT_BB_DF_INTS,PSIO_OPEN_NEW);
+  io_open(PSIF_SAPT_AB_DF_INTS,PSIO_OPEN_NEW);
 
   timer_on("OO DF Integrals    ");
     oo_df_integrals();
@@ -419,9 +474,9 @@ void SAPT0::first_order_terms()
     exch10_s2();
   timer_off("Exch10 S^2         ");
 
-  psio_->close(PSIF_SAPT_AA_DF_INTS,1);
-  psio_->close(PSIF_SAPT_BB_DF_INTS,1);
-  psio_->close(PSIF_SAPT_AB_DF_INTS,1);
+  io_close(PSIF_SAPT_AA_DF_INTS,1);
+  io_close(PSIF_SAPT_BB_DF_INTS,1);
+  io_close(PSIF_SAPT_AB_DF_INTS,1);
 
   free(diagAA_);
   free(diagBB_);
@@ -431,7 +486,7 @@ void SAPT0::first_order_terms()
 
 void SAPT0::df_integrals()
 {
-  psio_->open(PSIF_SAPT_TEMP,PSIO_OPEN_NEW);
+  io_open(PSIF_SAPT_TEMP,PSIO_OPEN_NEW);
 
   // Get fitting metric
   std::shared_ptr<FittingMetric> metric = std::shared_ptr<FittingMetric>(
@@ -613,7 +668,7 @@ void SAPT0::df_integrals()
     buffer[i] = eri[i]->buffer();
   }
 
-  zero_disk(PSIF_SAPT_TEMP,"AO RI Integrals",ndf_,nsotri_screened);
+  io_zero_disk(PSIF_SAPT_TEMP,"AO RI Integrals",ndf_,nsotri_screened);
 
   psio_address next_DF_AO = PSIO_ZERO;
 
@@ -694,7 +749,7 @@ void SAPT0::df_integrals()
         for (int P=0; P < ndf_; ++P) {
           next_DF_AO = psio_get_address(PSIO_ZERO,
             sizeof(double)*P*nsotri_screened+sizeof(double)*offset);
-          psio_->write(PSIF_SAPT_TEMP,"AO RI Integrals",(char *)
+          io_write(PSIF_SAPT_TEMP,"AO RI Integrals",(char *)
             &(J_AO_RI[P][0]),sizeof(double)*block_length[curr_block],
             next_DF_AO,&next_DF_AO);
         }
@@ -715,7 +770,7 @@ void SAPT0::df_integrals()
   for (int P=0; P < ndf_; ++P) {
     next_DF_AO = psio_get_address(PSIO_ZERO,
       sizeof(double)*P*nsotri_screened+sizeof(double)*offset);
-    psio_->write(PSIF_SAPT_TEMP,"AO RI Integrals",(char *)
+    io_write(PSIF_SAPT_TEMP,"AO RI Integrals",(char *)
       &(J_AO_RI[P][0]),sizeof(double)*block_length[curr_block],
       next_DF_AO,&next_DF_AO);
   }
@@ -768,15 +823,15 @@ void SAPT0::df_integrals()
   psio_address next_DF_AS = PSIO_ZERO;
   psio_address next_DF_RB = PSIO_ZERO;
 
-  zero_disk(PSIF_SAPT_AA_DF_INTS,"AA RI Integrals",ndf_,noccA_*noccA_);
-  zero_disk(PSIF_SAPT_AA_DF_INTS,"AR RI Integrals",ndf_,noccA_*nvirA_);
-  zero_disk(PSIF_SAPT_AA_DF_INTS,"RR RI Integrals",ndf_,nvirA_*(nvirA_+1)/2);
-  zero_disk(PSIF_SAPT_BB_DF_INTS,"BB RI Integrals",ndf_,noccB_*noccB_);
-  zero_disk(PSIF_SAPT_BB_DF_INTS,"BS RI Integrals",ndf_,noccB_*nvirB_);
-  zero_disk(PSIF_SAPT_BB_DF_INTS,"SS RI Integrals",ndf_,nvirB_*(nvirB_+1)/2);
-  zero_disk(PSIF_SAPT_AB_DF_INTS,"AB RI Integrals",ndf_,noccA_*noccB_);
-  zero_disk(PSIF_SAPT_AB_DF_INTS,"AS RI Integrals",ndf_,noccA_*nvirB_);
-  zero_disk(PSIF_SAPT_AB_DF_INTS,"RB RI Integrals",ndf_,nvirA_*noccB_);
+  io_zero_disk(PSIF_SAPT_AA_DF_INTS,"AA RI Integrals",ndf_,noccA_*noccA_);
+  io_zero_disk(PSIF_SAPT_AA_DF_INTS,"AR RI Integrals",ndf_,noccA_*nvirA_);
+  io_zero_disk(PSIF_SAPT_AA_DF_INTS,"RR RI Integrals",ndf_,nvirA_*(nvirA_+1)/2);
+  io_zero_disk(PSIF_SAPT_BB_DF_INTS,"BB RI Integrals",ndf_,noccB_*noccB_);
+  io_zero_disk(PSIF_SAPT_BB_DF_INTS,"BS RI Integrals",ndf_,noccB_*nvirB_);
+  io_zero_disk(PSIF_SAPT_BB_DF_INTS,"SS RI Integrals",ndf_,nvirB_*(nvirB_+1)/2);
+  io_zero_disk(PSIF_SAPT_AB_DF_INTS,"AB RI Integrals",ndf_,noccA_*noccB_);
+  io_zero_disk(PSIF_SAPT_AB_DF_INTS,"AS RI Integrals",ndf_,noccA_*nvirB_);
+  io_zero_disk(PSIF_SAPT_AB_DF_INTS,"RB RI Integrals",ndf_,nvirA_*noccB_);
 
   int Prel;
 
@@ -785,7 +840,7 @@ void SAPT0::df_integrals()
     int length = max_size;
     if (gimp && Pbl == Pblocks-1) length = gimp;
 
-    psio_->read(PSIF_SAPT_TEMP,"AO RI Integrals",(char *) &(B_p_munu[0][0]),
+    io_read(PSIF_SAPT_TEMP,"AO RI Integrals",(char *) &(B_p_munu[0][0]),
       sizeof(double)*length*nsotri_screened,next_DF_AO,&next_DF_AO);
 
 #pragma omp parallel
@@ -885,33 +940,33 @@ void SAPT0::df_integrals()
 
     }
 }
-    psio_->write(PSIF_SAPT_AA_DF_INTS,"AA RI Integrals",(char *)
+    io_write(PSIF_SAPT_AA_DF_INTS,"AA RI Integrals",(char *)
       &(B_p_AA[0][0]),sizeof(double)*length*noccA_*noccA_,
       next_DF_AA,&next_DF_AA);
-    psio_->write(PSIF_SAPT_AA_DF_INTS,"AR RI Integrals",(char *)
+    io_write(PSIF_SAPT_AA_DF_INTS,"AR RI Integrals",(char *)
       &(B_p_AR[0][0]),sizeof(double)*length*noccA_*nvirA_,
       next_DF_AR,&next_DF_AR);
-    psio_->write(PSIF_SAPT_AA_DF_INTS,"RR RI Integrals",(char *)
+    io_write(PSIF_SAPT_AA_DF_INTS,"RR RI Integrals",(char *)
       &(B_p_RR[0][0]),sizeof(double)*length*(nvirA_*(nvirA_+1)/2),
       next_DF_RR,&next_DF_RR);
 
-    psio_->write(PSIF_SAPT_BB_DF_INTS,"BB RI Integrals",(char *)
+    io_write(PSIF_SAPT_BB_DF_INTS,"BB RI Integrals",(char *)
       &(B_p_BB[0][0]),sizeof(double)*length*noccB_*noccB_,
       next_DF_BB,&next_DF_BB);
-    psio_->write(PSIF_SAPT_BB_DF_INTS,"BS RI Integrals",(char *)
+    io_write(PSIF_SAPT_BB_DF_INTS,"BS RI Integrals",(char *)
       &(B_p_BS[0][0]),sizeof(double)*length*noccB_*nvirB_,
       next_DF_BS,&next_DF_BS);
-    psio_->write(PSIF_SAPT_BB_DF_INTS,"SS RI Integrals",(char *)
+    io_write(PSIF_SAPT_BB_DF_INTS,"SS RI Integrals",(char *)
       &(B_p_SS[0][0]),sizeof(double)*length*(nvirB_*(nvirB_+1)/2),
       next_DF_SS,&next_DF_SS);
 
-    psio_->write(PSIF_SAPT_AB_DF_INTS,"AB RI Integrals",(char *)
+    io_write(PSIF_SAPT_AB_DF_INTS,"AB RI Integrals",(char *)
       &(B_p_AB[0][0]),sizeof(double)*length*noccA_*noccB_,
       next_DF_AB,&next_DF_AB);
-    psio_->write(PSIF_SAPT_AB_DF_INTS,"AS RI Integrals",(char *)
+    io_write(PSIF_SAPT_AB_DF_INTS,"AS RI Integrals",(char *)
       &(B_p_AS[0][0]),sizeof(double)*length*noccA_*nvirB_,
       next_DF_AS,&next_DF_AS);
-    psio_->write(PSIF_SAPT_AB_DF_INTS,"RB RI Integrals",(char *)
+    io_write(PSIF_SAPT_AB_DF_INTS,"RB RI Integrals",(char *)
       &(B_p_RB[0][0]),sizeof(double)*length*nvirA_*noccB_,
       next_DF_RB,&next_DF_RB);
 
@@ -939,7 +994,7 @@ void SAPT0::df_integrals()
   for(int i = 0; i < nthreads; ++i)
     eri[i].reset();
 
-  psio_->close(PSIF_SAPT_TEMP,0);
+  io_close(PSIF_SAPT_TEMP,0);
 }
 
 void SAPT0::df_integrals_aio()
@@ -1600,7 +1655,7 @@ void SAPT0::w_integrals()
 
 void SAPT0::oo_df_integrals()
 {
-  psio_->open(PSIF_SAPT_TEMP,PSIO_OPEN_NEW);
+  io_open(PSIF_SAPT_TEMP,PSIO_OPEN_NEW);
 
   // Get Schwartz screening arrays
   double maxSchwartz = 0.0;
@@ -1709,9 +1764,9 @@ void SAPT0::oo_df_integrals()
   psio_address next_DF_AB = PSIO_ZERO;
   psio_address next_DF_BB = PSIO_ZERO;
 
-  zero_disk(PSIF_SAPT_TEMP,"AA RI Integrals",ndf_,noccA_*noccA_);
-  zero_disk(PSIF_SAPT_TEMP,"AB RI Integrals",ndf_,noccA_*noccB_);
-  zero_disk(PSIF_SAPT_TEMP,"BB RI Integrals",ndf_,noccB_*noccB_);
+  io_zero_disk(PSIF_SAPT_TEMP,"AA RI Integrals",ndf_,noccA_*noccA_);
+  io_zero_disk(PSIF_SAPT_TEMP,"AB RI Integrals",ndf_,noccA_*noccB_);
+  io_zero_disk(PSIF_SAPT_TEMP,"BB RI Integrals",ndf_,noccB_*noccB_);
 
   for (int Pshell=0; Pshell<elstbasis_->nshell(); Pshell++) {
     int numPshell = elstbasis_->shell(Pshell).nfunction();
@@ -1760,13 +1815,13 @@ void SAPT0::oo_df_integrals()
         &(CB_[0][0]), nmoB_, 0.0, B_p_BB[P], noccB_);
     }
 
-    psio_->write(PSIF_SAPT_TEMP,"AA RI Integrals",(char *)
+    io_write(PSIF_SAPT_TEMP,"AA RI Integrals",(char *)
       &(B_p_AA[0][0]),sizeof(double)*numPshell*noccA_*noccA_,
       next_DF_AA,&next_DF_AA);
-    psio_->write(PSIF_SAPT_TEMP,"AB RI Integrals",(char *)
+    io_write(PSIF_SAPT_TEMP,"AB RI Integrals",(char *)
       &(B_p_AB[0][0]),sizeof(double)*numPshell*noccA_*noccB_,
       next_DF_AB,&next_DF_AB);
-    psio_->write(PSIF_SAPT_TEMP,"BB RI Integrals",(char *)
+    io_write(PSIF_SAPT_TEMP,"BB RI Integrals",(char *)
       &(B_p_BB[0][0]),sizeof(double)*numPshell*noccB_*noccB_,
       next_DF_BB,&next_DF_BB);
   }
@@ -1808,7 +1863,7 @@ void SAPT0::oo_df_integrals()
   if ((noccA_*noccA_)%max_size)
     blocks++;
 
-  zero_disk(PSIF_SAPT_AA_DF_INTS,"AA RI Integrals",ndf_,noccA_*noccA_);
+  io_zero_disk(PSIF_SAPT_AA_DF_INTS,"AA RI Integrals",ndf_,noccA_*noccA_);
 
   for (int n=0; n<blocks; n++) {
 
@@ -1820,7 +1875,7 @@ void SAPT0::oo_df_integrals()
     for (int P=0; P<ndf_; P++) {
       next_DF_AA = psio_get_address(PSIO_ZERO,sizeof(double)*P*noccA_*noccA_
         + sizeof(double)*start);
-      psio_->read(PSIF_SAPT_TEMP,"AA RI Integrals",(char *) &(B_p_AA[P][0]),
+      io_read(PSIF_SAPT_TEMP,"AA RI Integrals",(char *) &(B_p_AA[P][0]),
         sizeof(double)*size,next_DF_AA,&next_DF_AA);
     }
 
@@ -1830,7 +1885,7 @@ void SAPT0::oo_df_integrals()
     for (int P=0; P<ndf_; P++) {
       next_DFJ_AA = psio_get_address(PSIO_ZERO,sizeof(double)*P*noccA_*noccA_
         + sizeof(double)*start);
-      psio_->write(PSIF_SAPT_AA_DF_INTS,"AA RI Integrals",(char *)
+      io_write(PSIF_SAPT_AA_DF_INTS,"AA RI Integrals",(char *)
         &(B_q_AA[P][0]),sizeof(double)*size,next_DFJ_AA,
         &next_DFJ_AA);
     }
@@ -1853,7 +1908,7 @@ void SAPT0::oo_df_integrals()
   if ((noccA_*noccB_)%max_size)
     blocks++;
 
-  zero_disk(PSIF_SAPT_AB_DF_INTS,"AB RI Integrals",ndf_,noccA_*noccB_);
+  io_zero_disk(PSIF_SAPT_AB_DF_INTS,"AB RI Integrals",ndf_,noccA_*noccB_);
 
   for (int n=0; n<blocks; n++) {
 
@@ -1865,7 +1920,7 @@ void SAPT0::oo_df_integrals()
     for (int P=0; P<ndf_; P++) {
       next_DF_AB = psio_get_address(PSIO_ZERO,sizeof(double)*P*noccA_*noccB_
         + sizeof(double)*start);
-      psio_->read(PSIF_SAPT_TEMP,"AB RI Integrals",(char *) &(B_p_AB[P][0]),
+      io_read(PSIF_SAPT_TEMP,"AB RI Integrals",(char *) &(B_p_AB[P][0]),
         sizeof(double)*size,next_DF_AB,&next_DF_AB);
     }
 
@@ -1875,7 +1930,7 @@ void SAPT0::oo_df_integrals()
     for (int P=0; P<ndf_; P++) {
       next_DFJ_AB = psio_get_address(PSIO_ZERO,sizeof(double)*P*noccA_*noccB_
         + sizeof(double)*start);
-      psio_->write(PSIF_SAPT_AB_DF_INTS,"AB RI Integrals",(char *)
+      io_write(PSIF_SAPT_AB_DF_INTS,"AB RI Integrals",(char *)
         &(B_q_AB[P][0]),sizeof(double)*size,next_DFJ_AB,
         &next_DFJ_AB);
     }
@@ -1898,7 +1953,7 @@ void SAPT0::oo_df_integrals()
   if ((noccB_*noccB_)%max_size)
     blocks++;
 
-  zero_disk(PSIF_SAPT_BB_DF_INTS,"BB RI Integrals",ndf_,noccB_*noccB_);
+  io_zero_disk(PSIF_SAPT_BB_DF_INTS,"BB RI Integrals",ndf_,noccB_*noccB_);
 
   for (int n=0; n<blocks; n++) {
 
@@ -1910,7 +1965,7 @@ void SAPT0::oo_df_integrals()
     for (int P=0; P<ndf_; P++) {
       next_DF_BB = psio_get_address(PSIO_ZERO,sizeof(double)*P*noccB_*noccB_
         + sizeof(double)*start);
-      psio_->read(PSIF_SAPT_TEMP,"BB RI Integrals",(char *) &(B_p_BB[P][0]),
+      io_read(PSIF_SAPT_TEMP,"BB RI Integrals",(char *) &(B_p_BB[P][0]),
         sizeof(double)*size,next_DF_BB,&next_DF_BB);
     }
 
@@ -1920,7 +1975,7 @@ void SAPT0::oo_df_integrals()
     for (int P=0; P<ndf_; P++) {
       next_DFJ_BB = psio_get_address(PSIO_ZERO,sizeof(double)*P*noccB_*noccB_
         + sizeof(double)*start);
-      psio_->write(PSIF_SAPT_BB_DF_INTS,"BB RI Integrals",(char *)
+      io_write(PSIF_SAPT_BB_DF_INTS,"BB RI Integrals",(char *)
         &(B_q_BB[P][0]),sizeof(double)*size,next_DFJ_BB,
         &next_DFJ_BB);
     }
@@ -1933,7 +1988,7 @@ void SAPT0::oo_df_integrals()
   free(MUNUtoMU);
   free(MUNUtoNU);
 
-  psio_->close(PSIF_SAPT_TEMP,0);
+  io_close(PSIF_SAPT_TEMP,0);
 
   diagAA_ = init_array(ndf_+3);
   SAPTDFInts C_p_AA = set_A_AA();
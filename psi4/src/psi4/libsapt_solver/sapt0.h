@@ -28,6 +28,9 @@
 #ifndef SAPT0_H
 #define SAPT0_H
 
+#include <map>
+#include <string>
+#include <vector>
 #include "sapt.h"
 
 namespace psi { namespace sapt {
@@ -41,6 +44,22 @@ private:
   virtual void print_results();
 
   void check_memory();
+  long int incore_memory();
+
+  // psio-like access to the SAPT0 files, which is served from
+  // incore_files_ for the DF integral and scratch files when incore_
+  bool is_incore(unsigned int unit);
+  void io_open(unsigned int unit, int status);
+  void io_close(unsigned int unit, int keep);
+  void io_read(unsigned int unit, const char *key, char *buffer, ULI size,
+    psio_address start, psio_address *end);
+  void io_write(unsigned int unit, const char *key, char *buffer, ULI size,
+    psio_address start, psio_address *end);
+  void io_read_entry(unsigned int unit, const char *key, char *buffer,
+    ULI size);
+  void io_write_entry(unsigned int unit, const char *key, char *buffer,
+    ULI size);
+  void io_zero_disk(int file, const char *array, int rows, int columns);
 
   void df_integrals();
   void df_integrals_aio();
@@ -125,6 +144,7 @@ protected:
   bool no_response_;
   bool aio_cphf_;
   bool aio_dfints_;
+  bool incore_;
   bool do_e10_;
   bool do_e20ind_;
   bool do_e20disp_;
@@ -152,6 +172,9 @@ protected:
   double **wBAR_;
   double **wABS_;
 
+  std::map<std::pair<unsigned int, std::string>, std::vector<char> >
+    incore_files_;
+
 public:
   SAPT0(SharedWavefunction Dimer, SharedWavefunction MonomerA,
         SharedWavefunction MonomerB, Options& options,
@@ -43,6 +43,112 @@ void SAPT::zero_disk(int file, const char *array, int rows, int columns)
   free(zero);
 }
 
+bool SAPT0::is_incore(unsigned int unit)
+{
+  return(incore_ && (unit == PSIF_SAPT_AA_DF_INTS ||
+    unit == PSIF_SAPT_BB_DF_INTS || unit == PSIF_SAPT_AB_DF_INTS ||
+    unit == PSIF_SAPT_TEMP));
+}
+
+void SAPT0::io_open(unsigned int unit, int status)
+{
+  if (!is_incore(unit)) {
+    psio_->open(unit,status);
+    return;
+  }
+
+  if (status == PSIO_OPEN_NEW) io_close(unit,0);
+}
+
+void SAPT0::io_close(unsigned int unit, int keep)
+{
+  if (!is_incore(unit)) {
+    psio_->close(unit,keep);
+    return;
+  }
+
+  if (keep) return;
+
+  std::map<std::pair<unsigned int, std::string>, std::vector<char> >::iterator
+    it = incore_files_.begin();
+  while (it != incore_files_.end()) {
+    if (it->first.first == unit) incore_files_.erase(it++);
+    else ++it;
+  }
+}
+
+void SAPT0::io_read(unsigned int unit, const char *key, char *buffer,
+  ULI size, psio_address start, psio_address *end)
+{
+  if (!is_incore(unit)) {
+    psio_->read(unit,key,buffer,size,start,end);
+    return;
+  }
+
+  std::map<std::pair<unsigned int, std::string>, std::vector<char> >::iterator
+    entry = incore_files_.find(std::make_pair(unit,std::string(key)));
+  ULI offset = start.page*PSIO_PAGELEN + start.offset;
+  if (entry == incore_files_.end() || offset + size > entry->second.size())
+    throw PsiException(std::string("In-core SAPT0 read past the end of ")
+      + key,__FILE__,__LINE__);
+
+  memcpy(buffer,&(entry->second[offset]),size);
+  *end = psio_get_address(start,size);
+}
+
+void SAPT0::io_write(unsigned int unit, const char *key, char *buffer,
+  ULI size, psio_address start, psio_address *end)
+{
+  if (!is_incore(unit)) {
+    psio_->write(unit,key,buffer,size,start,end);
+    return;
+  }
+
+  std::vector<char> &entry = incore_files_[std::make_pair(unit,
+    std::string(key))];
+  ULI offset = start.page*PSIO_PAGELEN + start.offset;
+  if (offset + size > entry.size()) entry.resize(offset + size);
+
+  memcpy(&(entry[offset]),buffer,size);
+  *end = psio_get_address(start,size);
+}
+
+void SAPT0::io_read_entry(unsigned int unit, const char *key, char *buffer,
+  ULI size)
+{
+  if (!is_incore(unit)) {
+    psio_->read_entry(unit,key,buffer,size);
+    return;
+  }
+
+  psio_address end;
+  io_read(unit,key,buffer,size,PSIO_ZERO,&end);
+}
+
+void SAPT0::io_write_entry(unsigned int unit, const char *key, char *buffer,
+  ULI size)
+{
+  if (!is_incore(unit)) {
+    psio_->write_entry(unit,key,buffer,size);
+    return;
+  }
+
+  psio_address end;
+  io_write(unit,key,buffer,size,PSIO_ZERO,&end);
+}
+
+void SAPT0::io_zero_disk(int file, const char *array, int rows, int columns)
+{
+  if (!is_incore(file)) {
+    zero_disk(file,array,rows,columns);
+    return;
+  }
+
+  std::vector<char> &entry = incore_files_[std::make_pair(
+    (unsigned int) file,std::string(array))];
+  entry.assign(sizeof(double)*rows*(ULI) columns,'\0');
+}
+
 void SAPT0::read_all(SAPTDFInts *ints)
 {
   long int nri = ndf_;
@@ -53,18 +159,18 @@ void SAPT0::read_all(SAPTDFInts *ints)
   long int tot_i = ints->i_length_ + ints->i_start_;
 
   if (!ints->active_ && !ints->dress_disk_) {
-    psio_->read_entry(ints->filenum_,ints->label_,(char *)
+    io_read_entry(ints->filenum_,ints->label_,(char *)
       &(ints->B_p_[0][0]),sizeof(double)*ndf_*ints->ij_length_);
   }
   else if (!ints->active_ && ints->dress_disk_) {
-    psio_->read_entry(ints->filenum_,ints->label_,(char *)
+    io_read_entry(ints->filenum_,ints->label_,(char *)
       &(ints->B_p_[0][0]),sizeof(double)*nri*ints->ij_length_);
   }
   else {
     for (int p=0; p<ndf_; p++) {
       ints->next_DF_ = psio_get_address(ints->next_DF_,
         sizeof(double)*ints->i_start_*ints->j_length_);
-      psio_->read(ints->filenum_,ints->label_,(char *) &(ints->B_p_[p][0]),
+      io_read(ints->filenum_,ints->label_,(char *) &(ints->B_p_[p][0]),
         sizeof(double)*ints->ij_length_,ints->next_DF_,&ints->next_DF_);
     }
   }
@@ -90,12 +196,12 @@ void SAPT0::read_block(Iterator *iter, SAPTDFInts *intA)
   if (last_block && dress) block_length -= 3;
 
   if (!intA->active_ && (!intA->dress_disk_ || !last_block)) {
-    psio_->read(intA->filenum_,intA->label_,(char *) &(intA->B_p_[0][0]),
+    io_read(intA->filenum_,intA->label_,(char *) &(intA->B_p_[0][0]),
       sizeof(double)*block_length*intA->ij_length_,intA->next_DF_,
       &intA->next_DF_);
   }
   else if (!intA->active_) {
-    psio_->read(intA->filenum_,intA->label_,(char *) &(intA->B_p_[0][0]),
+    io_read(intA->filenum_,intA->label_,(char *) &(intA->B_p_[0][0]),
       sizeof(double)*(block_length+3L)*intA->ij_length_,intA->next_DF_,
       &intA->next_DF_);
   }
@@ -103,7 +209,7 @@ void SAPT0::read_block(Iterator *iter, SAPTDFInts *intA)
     for (int p=0; p<block_length; p++) {
       intA->next_DF_ = psio_get_address(intA->next_DF_,
         sizeof(double)*intA->i_start_*intA->j_length_);
-      psio_->read(intA->filenum_,intA->label_,(char *) &(intA->B_p_[p][0]),
+      io_read(intA->filenum_,intA->label_,(char *) &(intA->B_p_[p][0]),
         sizeof(double)*intA->ij_length_,intA->next_DF_,&intA->next_DF_);
     }
   }
@@ -136,12 +242,12 @@ void SAPT0::read_block(Iterator *iter, SAPTDFInts *intA, SAPTDFInts *intB)
   if (last_block && dress) block_length -= 3;
 
   if (!intA->active_ && (!intA->dress_disk_ || !last_block)) {
-    psio_->read(intA->filenum_,intA->label_,(char *) &(intA->B_p_[0][0]),
+    io_read(intA->filenum_,intA->label_,(char *) &(intA->B_p_[0][0]),
       sizeof(double)*block_length*intA->ij_length_,intA->next_DF_,
       &intA->next_DF_);
   }
   else if (!intA->active_) {
-    psio_->read(intA->filenum_,intA->label_,(char *) &(intA->B_p_[0][0]),
+    io_read(intA->filenum_,intA->label_,(char *) &(intA->B_p_[0][0]),
       sizeof(double)*(block_length+3L)*intA->ij_length_,intA->next_DF_,
       &intA->next_DF_);
   }
@@ -149,18 +255,18 @@ void SAPT0::read_block(Iterator *iter, SAPTDFInts *intA, SAPTDFInts *intB)
     for (int p=0; p<block_length; p++) {
       intA->next_DF_ = psio_get_address(intA->next_DF_,
         sizeof(double)*intA->i_start_*intA->j_length_);
-      psio_->read(intA->filenum_,intA->label_,(char *) &(intA->B_p_[p][0]),
+      io_read(intA->filenum_,intA->label_,(char *) &(intA->B_p_[p][0]),
         sizeof(double)*intA->ij_length_,intA->next_DF_,&intA->next_DF_);
     }
   }
 
   if (!intB->active_ && (!intB->dress_disk_ || !last_block)) {
-    psio_->read(intB->filenum_,intB->label_,(char *) &(intB->B_p_[0][0]),
+    io_read(intB->filenum_,intB->label_,(char *) &(intB->B_p_[0][0]),
       sizeof(double)*block_length*intB->ij_length_,intB->next_DF_,
       &intB->next_DF_);
   }
   else if (!intB->active_) {
-    psio_->read(intB->filenum_,intB->label_,(char *) &(intB->B_p_[0][0]),
+    io_read(intB->filenum_,intB->label_,(char *) &(intB->B_p_[0][0]),
       sizeof(double)*(block_length+3L)*intB->ij_length_,intB->next_DF_,
       &intB->next_DF_);
   }
@@ -168,7 +274,7 @@ void SAPT0::read_block(Iterator *iter, SAPTDFInts *intA, SAPTDFInts *intB)
     for (int p=0; p<block_length; p++) {
       intB->next_DF_ = psio_get_address(intB->next_DF_,
         sizeof(double)*intB->i_start_*intB->j_length_);
-      psio_->read(intB->filenum_,intB->label_,(char *) &(intB->B_p_[p][0]),
+      io_read(intB->filenum_,intB->label_,(char *) &(intB->B_p_[p][0]),
         sizeof(double)*intB->ij_length_,intB->next_DF_,&intB->next_DF_);
     }
   }
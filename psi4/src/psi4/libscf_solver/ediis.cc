@@ -0,0 +1,194 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2016 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+
+/*
+ * ediis.cc
+ *
+ * Energy-DIIS (Kudin, Scuseria, and Cances, J. Chem. Phys. 116, 8255 (2002))
+ * for the early SCF iterations, blended into the Pulay DIIS extrapolation as
+ * the orbital gradient drops (Garza and Scuseria, J. Chem. Phys. 137, 054110 (2012)).
+ */
+
+#include <cmath>
+#include <vector>
+#include <deque>
+
+#include "psi4/libmints/matrix.h"
+#include "psi4/libpsi4util/libpsi4util.h"
+#include "psi4/libqt/qt.h"
+#include "hf.h"
+
+namespace psi { namespace scf {
+
+std::vector<SharedMatrix> HF::ediis_targets()
+{
+    std::vector<SharedMatrix> targets;
+    targets.push_back(Fa_);
+    if (!same_a_b_orbs_)
+        targets.push_back(Fb_);
+    return targets;
+}
+
+void HF::ediis_reset()
+{
+    ediis_energies_.clear();
+    ediis_densities_.clear();
+    ediis_focks_.clear();
+    ediis_vectors_.clear();
+}
+
+void HF::ediis_add_entry()
+{
+    std::vector<SharedMatrix> D, F, T;
+    D.push_back(SharedMatrix(Da_->clone()));
+    D.push_back(SharedMatrix(Db_->clone()));
+    F.push_back(SharedMatrix(Fa_->clone()));
+    F.push_back(SharedMatrix(Fb_->clone()));
+    std::vector<SharedMatrix> targets = ediis_targets();
+    for (size_t n = 0; n < targets.size(); n++)
+        T.push_back(SharedMatrix(targets[n]->clone()));
+
+    ediis_energies_.push_back(E_);
+    ediis_densities_.push_back(D);
+    ediis_focks_.push_back(F);
+    ediis_vectors_.push_back(T);
+    if (ediis_energies_.size() > (size_t) max_diis_vectors_) {
+        ediis_energies_.pop_front();
+        ediis_densities_.pop_front();
+        ediis_focks_.pop_front();
+        ediis_vectors_.pop_front();
+    }
+}
+
+bool HF::ediis_extrapolate()
+{
+    int n = ediis_energies_.size();
+    if (n < 2 || Drms_ <= ediis_end_) return false;
+
+    // The weight of the EDIIS extrapolant, which falls linearly to zero between the two thresholds
+    double w = 1.0;
+    if (Drms_ < ediis_start_)
+        w = (Drms_ - ediis_end_) / (ediis_start_ - ediis_end_);
+    if (!diis_performed_)
+        w = 1.0;
+
+    // DF[i][j] = sum_spin D_i . F_j
+    std::vector<std::vector<double> > DF(n, std::vector<double>(n, 0.0));
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            for (int s = 0; s < 2; s++)
+                DF[i][j] += ediis_densities_[i][s]->vector_dot(ediis_focks_[j][s]);
+
+    // Minimize f(c) = sum_i c_i E_i - 1/4 sum_ij c_i c_j (D_i - D_j).(F_i - F_j) over the
+    // simplex, using c_i = t_i^2 / sum_k t_k^2 to keep the constraints
+    std::vector<double> E(ediis_energies_.begin(), ediis_energies_.end());
+    double Emin = E[0];
+    for (int i = 1; i < n; i++) Emin = std::min(Emin, E[i]);
+    for (int i = 0; i < n; i++) E[i] -= Emin;
+
+    auto value = [&](const std::vector<double>& c) {
+        double f = 0.0;
+        for (int i = 0; i < n; i++) {
+            f += c[i] * E[i];
+            for (int j = 0; j < n; j++)
+                f -= 0.25 * c[i] * c[j] * (DF[i][i] + DF[j][j] - DF[i][j] - DF[j][i]);
+        }
+        return f;
+    };
+    auto coefficients = [&](const std::vector<double>& t) {
+        double norm = 0.0;
+        for (int i = 0; i < n; i++) norm += t[i] * t[i];
+        std::vector<double> c(n);
+        for (int i = 0; i < n; i++) c[i] = t[i] * t[i] / norm;
+        return c;
+    };
+
+    // Start from the lowest-energy entry, with a little of everything else
+    std::vector<double> t(n, 0.1);
+    for (int i = 0; i < n; i++)
+        if (E[i] == 0.0) t[i] = 1.0;
+    std::vector<double> c = coefficients(t);
+    double f = value(c);
+    double step = 1.0;
+    for (int iter = 0; iter < 200; iter++) {
+        std::vector<double> g(n);
+        for (int i = 0; i < n; i++) {
+            g[i] = E[i];
+            for (int j = 0; j < n; j++)
+                g[i] -= 0.5 * c[j] * (DF[i][i] + DF[j][j] - DF[i][j] - DF[j][i]);
+        }
+        double gbar = 0.0, norm = 0.0;
+        for (int i = 0; i < n; i++) {
+            gbar += c[i] * g[i];
+            norm += t[i] * t[i];
+        }
+        std::vector<double> dt(n);
+        double gnorm = 0.0;
+        for (int i = 0; i < n; i++) {
+            dt[i] = 2.0 * t[i] / norm * (g[i] - gbar);
+            gnorm += dt[i] * dt[i];
+        }
+        if (std::sqrt(gnorm) < 1.0E-10) break;
+
+        // Backtracking line search
+        bool moved = false;
+        for (int ls = 0; ls < 30; ls++) {
+            std::vector<double> tnew(n);
+            for (int i = 0; i < n; i++) tnew[i] = t[i] - step * dt[i];
+            std::vector<double> cnew = coefficients(tnew);
+            double fnew = value(cnew);
+            if (fnew < f) {
+                t = tnew;
+                c = cnew;
+                f = fnew;
+                step *= 2.0;
+                moved = true;
+                break;
+            }
+            step *= 0.5;
+        }
+        if (!moved) break;
+    }
+
+    if (print_ > 2) {
+        outfile->Printf("  EDIIS coefficients (weight %.3f):", w);
+        for (int i = 0; i < n; i++) outfile->Printf(" %.3f", c[i]);
+        outfile->Printf("\n");
+    }
+
+    std::vector<SharedMatrix> targets = ediis_targets();
+    for (size_t m = 0; m < targets.size(); m++) {
+        targets[m]->scale(1.0 - w);
+        for (int i = 0; i < n; i++)
+            targets[m]->axpy(w * c[i], ediis_vectors_[i][m]);
+    }
+
+    return true;
+}
+
+}}
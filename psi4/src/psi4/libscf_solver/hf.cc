@@ -35,6 +35,7 @@
 #include <sstream>
 #include <vector>
 #include <utility>
+#include <functional>
 
 #include "psi4/psifiles.h"
 #include "psi4/physconst.h"
@@ -324,6 +325,14 @@ void HF::common_init()
 
     initialized_diis_manager_ = false;
 
+    diag_algorithm_ = Matrix::diagonalize_algorithm_from_string(options_.get_str("DIAG_ALGORITHM"));
+
+    // Energy-DIIS for the early iterations
+    ediis_enabled_ = options_.get_bool("EDIIS");
+    ediis_start_ = options_.get_double("EDIIS_START");
+    ediis_end_ = options_.get_double("EDIIS_END");
+    ediis_performed_ = false;
+
     // Second-order convergence acceleration
     soscf_enabled_ = options_.get_bool("SOSCF");
     soscf_r_start_ = options_.get_double("SOSCF_START_CONVERGENCE");
@@ -519,6 +528,7 @@ double HF::finalize_E()
           outfile->Printf("    Running SCF again with the rotated orbitals.\n");
 
           if(initialized_diis_manager_) diis_manager_->reset_subspace();
+          ediis_reset();
           // Reading the rotated orbitals in before starting iterations
           form_D();
           E_ = compute_initial_E();
@@ -630,6 +640,8 @@ double HF::finalize_E()
 
     // Orbitals are always saved, in case an MO guess is requested later
     save_orbitals();
+    if (converged_)
+        save_guess_history();
 
     finalize();
 
@@ -653,6 +665,7 @@ void HF::finalize()
         diis_manager_->delete_diis_file();
     diis_manager_.reset();
     initialized_diis_manager_ = false;
+    ediis_reset();
 
     // Figure out how many frozen virtual and frozen core per irrep
     compute_fcpi();
@@ -777,6 +790,8 @@ void HF::print_header()
         outfile->Printf( "  ==> Algorithm <==\n\n");
         outfile->Printf( "  SCF Algorithm Type is %s.\n", options_.get_str("SCF_TYPE").c_str());
         outfile->Printf( "  DIIS %s.\n", diis_enabled_ ? "enabled" : "disabled");
+        if (ediis_enabled_)
+            outfile->Printf( "  EDIIS enabled above an orbital gradient of %8.2E.\n", ediis_end_);
         if (MOM_excited_)
             outfile->Printf( "  Excited-state MOM enabled.\n");
         else
@@ -1327,6 +1342,9 @@ void HF::guess()
     // "GWH"-Generalized Wolfsberg-Helmholtz
     // "SAD"-Superposition of Atomic Denisties
     std::string guess_type = options_.get_str("GUESS");
+    Process::environment.globals["SCF GUESS EXTRAPOLATION ORDER"] = 0.0;
+    if (options_.get_int("GUESS_EXTRAPOLATION") >= 1 && extrapolate_guess())
+        guess_type = "EXTRAPOLATE";
     if (guess_type == "READ" && !psio_->exists(PSIF_SCF_MOS)) {
         outfile->Printf( "  SCF Guess was Projection but file not found.\n");
         outfile->Printf( "  Switching over to SAD guess.\n\n");
@@ -1405,6 +1423,186 @@ void HF::guess()
     E_ = 0.0; // don't use this guess in our convergence checks
 }
 
+/*
+ * The converged densities of the last GUESS_EXTRAPOLATION SCF runs are kept
+ * in Process::environment.arrays as "SCF GUESS HISTORY DA i" (and DB), with
+ * i = 0 the most recent, together with the occupations and the SO dimensions
+ * in "SCF GUESS HISTORY OCC".  The basis set (name, size) and the nuclear
+ * charges of the atoms, in order, are kept in "SCF GUESS HISTORY SIGNATURE".
+ * A run with different occupations, a different basis or different atoms
+ * starts a fresh history.
+ */
+static std::string guess_history_key(const std::string& spin, int i)
+{
+    std::stringstream key;
+    key << "SCF GUESS HISTORY " << spin << " " << i;
+    return key.str();
+}
+
+static int guess_history_size(int maxhist)
+{
+    std::map<std::string, SharedMatrix>& arrays = Process::environment.arrays;
+    int n = 0;
+    while (n < maxhist && arrays.count(guess_history_key("DA", n)) && arrays.count(guess_history_key("DB", n)))
+        n++;
+    return n;
+}
+
+static SharedMatrix guess_history_signature(std::shared_ptr<BasisSet> basis)
+{
+    std::shared_ptr<Molecule> mol = basis->molecule();
+    int natom = mol->natom();
+    // The basis name enters through a hash truncated to 48 bits, which a
+    // double holds exactly
+    size_t namehash = std::hash<std::string>()(basis->name()) & ((1ULL << 48) - 1);
+    SharedMatrix sig(new Matrix("SCF GUESS HISTORY SIGNATURE", 1, natom + 3));
+    sig->set(0, 0, (double)namehash);
+    sig->set(0, 1, basis->nbf());
+    sig->set(0, 2, natom);
+    for (int A = 0; A < natom; A++)
+        sig->set(0, 3 + A, mol->Z(A));
+    return sig;
+}
+
+static bool guess_history_signature_matches(std::shared_ptr<BasisSet> basis)
+{
+    std::map<std::string, SharedMatrix>& arrays = Process::environment.arrays;
+    if (!arrays.count("SCF GUESS HISTORY SIGNATURE")) return false;
+    SharedMatrix old = arrays["SCF GUESS HISTORY SIGNATURE"];
+    SharedMatrix sig = guess_history_signature(basis);
+    if (old->rowspi()[0] != 1 || old->colspi()[0] != sig->colspi()[0]) return false;
+    for (int i = 0; i < sig->colspi()[0]; i++)
+        if (old->get(0, i) != sig->get(0, i)) return false;
+    return true;
+}
+
+SharedMatrix HF::guess_history_occupation()
+{
+    SharedMatrix occ(new Matrix("SCF GUESS HISTORY OCC", 3, nirrep_));
+    for (int h = 0; h < nirrep_; h++) {
+        occ->set(0, h, nalphapi_[h]);
+        occ->set(1, h, nbetapi_[h]);
+        occ->set(2, h, nsopi_[h]);
+    }
+    return occ;
+}
+
+bool HF::guess_history_matches(SharedMatrix occ)
+{
+    if (!guess_history_signature_matches(basisset_)) return false;
+    if (occ->colspi()[0] != nirrep_) return false;
+    for (int h = 0; h < nirrep_; h++) {
+        if (occ->get(0, h) != nalphapi_[h] || occ->get(1, h) != nbetapi_[h] ||
+            occ->get(2, h) != nsopi_[h])
+            return false;
+    }
+    return true;
+}
+
+void HF::save_guess_history()
+{
+    int maxhist = options_.get_int("GUESS_EXTRAPOLATION");
+    // ROHF's orbitals can't be recovered from its two densities
+    if (maxhist < 1 || (same_a_b_orbs_ && !same_a_b_dens_)) return;
+
+    std::map<std::string, SharedMatrix>& arrays = Process::environment.arrays;
+    SharedMatrix occ = guess_history_occupation();
+    int nhist = 0;
+    if (arrays.count("SCF GUESS HISTORY OCC") && guess_history_matches(arrays["SCF GUESS HISTORY OCC"]))
+        nhist = guess_history_size(maxhist);
+    for (int i = nhist; i < maxhist; i++) {
+        arrays.erase(guess_history_key("DA", i));
+        arrays.erase(guess_history_key("DB", i));
+    }
+    for (int i = std::min(nhist, maxhist - 1); i > 0; i--) {
+        arrays[guess_history_key("DA", i)] = arrays[guess_history_key("DA", i - 1)];
+        arrays[guess_history_key("DB", i)] = arrays[guess_history_key("DB", i - 1)];
+    }
+    arrays[guess_history_key("DA", 0)] = SharedMatrix(Da_->clone());
+    arrays[guess_history_key("DB", 0)] = SharedMatrix(Db_->clone());
+    arrays["SCF GUESS HISTORY OCC"] = occ;
+    arrays["SCF GUESS HISTORY SIGNATURE"] = guess_history_signature(basisset_);
+}
+
+bool HF::extrapolate_guess()
+{
+    int maxhist = options_.get_int("GUESS_EXTRAPOLATION");
+    if (same_a_b_orbs_ && !same_a_b_dens_) return false;
+
+    std::map<std::string, SharedMatrix>& arrays = Process::environment.arrays;
+    if (!arrays.count("SCF GUESS HISTORY OCC")) return false;
+    if (!guess_history_signature_matches(basisset_)) return false;
+    SharedMatrix occ = arrays["SCF GUESS HISTORY OCC"];
+    if (occ->colspi()[0] != nirrep_) return false;
+    int nalpha = 0, nbeta = 0;
+    for (int h = 0; h < nirrep_; h++) {
+        if (occ->get(2, h) != nsopi_[h]) return false;
+        nalpha += (int)occ->get(0, h);
+        nbeta += (int)occ->get(1, h);
+    }
+    if (nalpha != nalpha_ || nbeta != nbeta_) return false;
+
+    int nhist = guess_history_size(maxhist);
+    if (nhist < 1) return false;
+
+    // Always-stable predictor coefficients (Kolafa, J. Comput. Chem. 25, 335 (2004)),
+    // B_j = (-1)^(j+1) j C(2n, n-j) / C(2n-2, n-1) for n stored densities;
+    // a single density gives B_1 = 1, i.e. the previous density is reused
+    std::vector<double> B(nhist);
+    for (int j = 1; j <= nhist; j++) {
+        double binom = 1.0;
+        for (int k = 1; k <= nhist - j; k++)
+            binom *= (double)(nhist + j + k) / (double)k;
+        double norm = 1.0;
+        for (int k = 1; k <= nhist - 1; k++)
+            norm *= (double)(nhist - 1 + k) / (double)k;
+        B[j - 1] = (j % 2 ? 1.0 : -1.0) * j * binom / norm;
+    }
+
+    if (print_)
+        outfile->Printf("  SCF Guess: Extrapolation from the %d previously converged densities.\n\n", nhist);
+    Process::environment.globals["SCF GUESS EXTRAPOLATION ORDER"] = nhist;
+
+    for (int h = 0; h < nirrep_; h++) {
+        nalphapi_[h] = (int)occ->get(0, h);
+        nbetapi_[h] = (int)occ->get(1, h);
+        doccpi_[h] = std::min(nalphapi_[h], nbetapi_[h]);
+        soccpi_[h] = std::abs(nalphapi_[h] - nbetapi_[h]);
+    }
+
+    SharedMatrix Shalf(S_->clone());
+    Shalf->power(0.5, 1.0E-10);
+    SharedMatrix Sminushalf(S_->clone());
+    Sminushalf->power(-0.5, 1.0E-10);
+
+    // The occupied orbitals are the leading natural orbitals of the extrapolated
+    // density in the orthonormal basis, which restores idempotency
+    for (int spin = 0; spin < (same_a_b_orbs_ ? 1 : 2); spin++) {
+        SharedMatrix D(new Matrix("Extrapolated D", nsopi_, nsopi_));
+        for (int j = 0; j < nhist; j++)
+            D->axpy(B[j], arrays[guess_history_key(spin ? "DB" : "DA", j)]);
+
+        SharedMatrix M(D->clone());
+        M->transform(D, Shalf);
+        SharedMatrix U(new Matrix("U", nsopi_, nsopi_));
+        SharedVector n(new Vector("Occupations", nsopi_));
+        M->diagonalize(U, n, descending);
+        SharedMatrix C(new Matrix("C", nsopi_, nsopi_));
+        C->gemm(false, false, 1.0, Sminushalf, U, 0.0);
+
+        SharedMatrix Cspin = spin ? Cb_ : Ca_;
+        const Dimension& noccpi = spin ? nbetapi_ : nalphapi_;
+        Cspin->zero();
+        for (int h = 0; h < nirrep_; h++)
+            for (int m = 0; m < nsopi_[h]; m++)
+                for (int i = 0; i < noccpi[h]; i++)
+                    Cspin->set(h, m, i, C->get(h, m, i));
+    }
+    form_D();
+
+    return true;
+}
+
 void HF::save_orbitals()
 {
     psio_->open(PSIF_SCF_MOS,PSIO_OPEN_NEW);
@@ -1724,7 +1922,7 @@ void HF::initialize()
 
     // Andy trick 2.0
     old_scf_type_ = options_.get_str("SCF_TYPE");
-    if (options_.get_bool("DF_SCF_GUESS") && (old_scf_type_ == "DIRECT") ) {
+    if (df_scf_guess_applies(old_scf_type_)) {
          outfile->Printf( "  Starting with a DF guess...\n\n");
          if(!options_["DF_BASIS_SCF"].has_changed()) {
              // TODO: Match Dunning basis sets
@@ -1779,9 +1977,14 @@ void HF::iterations()
 
     MOM_performed_ = false;
     diis_performed_ = false;
+    ediis_performed_ = false;
+    int ediis_iterations = 0;
 
     bool df = (options_.get_str("SCF_TYPE") == "DF");
 
+    // Recycle the storage of the per-iteration temporaries (JK, DIIS, V builds)
+    MatrixArena arena;
+
         outfile->Printf( "  ==> Iterations <==\n\n");
         outfile->Printf( "%s                        Total Energy        Delta E     RMS |[F,P]|\n\n", df ? "   " : "");
 
@@ -1874,6 +2077,7 @@ void HF::iterations()
         if (soscf_enabled_ && (Drms_ < soscf_r_start_) && (iteration_ > 3)){
             compute_orbital_gradient(false);
             diis_performed_ = false;
+            ediis_performed_ = false;
 
             if (!test_convergency()){
                 int nmicro = soscf_update();
@@ -1908,12 +2112,15 @@ void HF::iterations()
                 add_to_diis_subspace = true;
 
             compute_orbital_gradient(add_to_diis_subspace);
+            if (ediis_enabled_ && iteration_ > 0)
+                ediis_add_entry();
 
             if (diis_enabled_ == true && iteration_ >= diis_start_ + min_diis_vectors_ - 1) {
                 diis_performed_ = diis();
             } else {
                 diis_performed_ = false;
             }
+            ediis_performed_ = ediis_enabled_ && iteration_ > 0 && ediis_extrapolate();
             timer_off("HF: DIIS");
 
             if (print_>4 && diis_performed_) {
@@ -1930,6 +2137,11 @@ void HF::iterations()
         // If we're too well converged, or damping wasn't enabled, do DIIS
         damping_performed_ = (damping_enabled_ && iteration_ > 1 && Drms_ > damping_convergence_);
 
+        if(ediis_performed_){
+            if(status != "") status += "/";
+            status += "EDIIS";
+            ediis_iterations++;
+        }
         if(diis_performed_){
             if(status != "") status += "/";
             status += "DIIS";
@@ -1979,11 +2191,23 @@ void HF::iterations()
         if (frac_enabled_ && !frac_performed_) converged_ = false;
 
         // If a DF Guess environment, reset the JK object, and keep running
-        if (converged_ && options_.get_bool("DF_SCF_GUESS") && (old_scf_type_ == "DIRECT")) {
-            outfile->Printf( "\n  DF guess converged.\n\n"); // Be cool dude.
+        // An early switch tolerance hands over once the density is close enough,
+        // so that the target JK object only builds the last few Fock matrices
+        bool df_guess_done = converged_;
+        bool df_guess_early = false;
+        double df_guess_conv = options_.get_double("DF_SCF_GUESS_CONVERGENCE");
+        if (!df_guess_done && df_guess_conv > 0.0 && Drms_ < df_guess_conv && iteration_ > 1)
+            df_guess_done = df_guess_early = true;
+        if (df_guess_done && df_scf_guess_applies(old_scf_type_)) {
+            outfile->Printf( "\n  DF guess converged, switching to %s.\n\n", old_scf_type_.c_str()); // Be cool dude.
             converged_ = false;
-            if(initialized_diis_manager_)
+            // After an early handover the DF Fock matrices are still far from
+            // converged, so their DF error is small against the remaining
+            // orbital gradient and the subspace may be kept.  A fully converged
+            // DF subspace only encodes the DF error, so it is always dropped.
+            if(initialized_diis_manager_ && !(df_guess_early && options_.get_bool("DF_SCF_GUESS_KEEP_DIIS")))
                 diis_manager_->reset_subspace();
+            ediis_reset();
             scf_type_ = old_scf_type_;
             options_.set_str("SCF","SCF_TYPE",old_scf_type_);
             old_scf_type_ = "DF";
@@ -1995,6 +2219,20 @@ void HF::iterations()
 
     } while (!converged_ && iteration_ < maxiter_ );
 
+    Process::environment.globals["SCF EDIIS ITERATIONS"] = ediis_iterations;
+}
+
+bool HF::df_scf_guess_applies(const std::string& type) const
+{
+    if (!options_.get_bool("DF_SCF_GUESS") || type == "DF")
+        return false;
+    if (!options_["DF_SCF_GUESS_TYPES"].size())
+        return type == "DIRECT";
+    for (int i = 0; i < (int)options_["DF_SCF_GUESS_TYPES"].size(); ++i) {
+        if (options_["DF_SCF_GUESS_TYPES"][i].to_string() == type)
+            return true;
+    }
+    return false;
 }
 
 void HF::print_energies()
@@ -2099,7 +2337,7 @@ void HF::diagonalize_F(const SharedMatrix& Fm, SharedMatrix& Cm, std::shared_ptr
     diag_F_temp_->gemm(false, false, 1.0, diag_temp_, X_, 0.0);
 
     //Form C' = eig(F')
-    diag_F_temp_->diagonalize(diag_C_temp_, epsm);
+    diag_F_temp_->diagonalize(diag_C_temp_, epsm, ascending, diag_algorithm_);
 
     //Form C = XC'
     Cm->gemm(false, false, 1.0, X_, diag_C_temp_, 0.0);
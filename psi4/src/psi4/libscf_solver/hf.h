@@ -29,9 +29,11 @@
 #define HF_H
 
 #include <vector>
+#include <deque>
 #include "psi4/libpsio/psio.hpp"
 #include "psi4/libmints/wavefunction.h"
 #include "psi4/libmints/basisset.h"
+#include "psi4/libmints/matrix.h"
 #include "psi4/libmints/vector.h"
 #include "psi4/libdiis/diismanager.h"
 #include "psi4/libdiis/diisentry.h"
@@ -66,6 +68,8 @@ protected:
     SharedMatrix diag_F_temp_;
     /// Temporary matrix for diagonalize_F
     SharedMatrix diag_C_temp_;
+    /// LAPACK eigensolver used to diagonalize the Fock matrix
+    diagonalize_algorithm diag_algorithm_;
 
     /// Old C Alpha matrix (if needed for MOM)
     SharedMatrix Ca_old_;
@@ -172,6 +176,20 @@ protected:
     /// Are we even using DIIS?
     int diis_enabled_;
 
+    /// Are we blending EDIIS into the early iterations?
+    bool ediis_enabled_;
+    /// The orbital gradient above which EDIIS is used alone
+    double ediis_start_;
+    /// The orbital gradient below which only DIIS is used
+    double ediis_end_;
+    /// Whether EDIIS was performed this iteration, or not
+    bool ediis_performed_;
+    /// The energies, densities, Fock matrices and DIIS extrapolants of the EDIIS subspace
+    std::deque<double> ediis_energies_;
+    std::deque<std::vector<SharedMatrix> > ediis_densities_;
+    std::deque<std::vector<SharedMatrix> > ediis_focks_;
+    std::deque<std::vector<SharedMatrix> > ediis_vectors_;
+
     /// Are we doing second-order convergence acceleration?
     bool soscf_enabled_;
     /// What is the gradient threshold that we should start?
@@ -288,6 +306,9 @@ protected:
     /// Prints the energy breakdown from this SCF
     void print_energies();
 
+    /// Does DF_SCF_GUESS start a calculation of SCF_TYPE type with DF iterations?
+    bool df_scf_guess_applies(const std::string& type) const;
+
     /// Prints some opening information
     void print_header();
 
@@ -381,6 +402,14 @@ protected:
     /** Performs DIIS extrapolation */
     virtual bool diis() { return false; }
 
+    /** The matrices that DIIS extrapolates, which EDIIS also writes to */
+    virtual std::vector<SharedMatrix> ediis_targets();
+    /** Adds the current energy, densities and Fock matrices to the EDIIS subspace */
+    void ediis_add_entry();
+    /** Blends the EDIIS extrapolation into the DIIS one, according to the orbital gradient */
+    bool ediis_extrapolate();
+    void ediis_reset();
+
     /** Form Fia (for DIIS) **/
     virtual SharedMatrix form_Fia(SharedMatrix Fso, SharedMatrix Cso, int* noccpi);
 
@@ -399,6 +428,16 @@ protected:
     /** Load orbitals from previous computation, projecting if needed **/
     virtual void load_orbitals();
 
+    /** Keep the converged densities for guess extrapolation in later runs **/
+    void save_guess_history();
+
+    /** The occupations and dimensions that label the guess history **/
+    SharedMatrix guess_history_occupation();
+    bool guess_history_matches(SharedMatrix occ);
+
+    /** Form C and D by extrapolating the densities of previous runs; false if there's no usable history **/
+    bool extrapolate_guess();
+
 public:
     HF(SharedWavefunction ref_wfn, std::shared_ptr<SuperFunctional> funct,
        Options& options, std::shared_ptr<PSIO> psio);
@@ -345,6 +345,14 @@ bool ROHF::diis()
     return diis_manager_->extrapolate(1, soFeff_.get());
 }
 
+std::vector<SharedMatrix> ROHF::ediis_targets()
+{
+    // The effective Fock matrix is what gets diagonalized, so it's what EDIIS mixes
+    std::vector<SharedMatrix> targets;
+    targets.push_back(soFeff_);
+    return targets;
+}
+
 bool ROHF::test_convergency()
 {
     // energy difference
@@ -438,7 +446,7 @@ void ROHF::form_F()
 
 void ROHF::form_C()
 {
-    soFeff_->diagonalize(Ct_, epsilon_a_);
+    soFeff_->diagonalize(Ct_, epsilon_a_, ascending, diag_algorithm_);
     //Form C = XC'
     Ca_->gemm(false, false, 1.0, X_, Ct_, 0.0);
 
@@ -470,7 +478,7 @@ void ROHF::form_initial_C()
     diag_F_temp_->gemm(false, false, 1.0, diag_temp_, X_, 0.0);
 
     //Form C' = eig(F')
-    diag_F_temp_->diagonalize(Ct_, epsilon_a_);
+    diag_F_temp_->diagonalize(Ct_, epsilon_a_, ascending, diag_algorithm_);
 
     //Form C = XC'
     Ca_->gemm(false, false, 1.0, X_, Ct_, 0.0);
@@ -65,6 +65,7 @@ protected:
 
     virtual void compute_orbital_gradient(bool save_diis);
     bool diis();
+    virtual std::vector<SharedMatrix> ediis_targets();
 
     bool test_convergency();
 
@@ -35,14 +35,21 @@
 
 #include <cstdlib>
 #include <cstdio>
+#include <cstring>
 #include <cmath>
 #include <algorithm>
 #include <vector>
 #include <utility>
+#include <map>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <stdint.h>
 
 #include "psi4/psifiles.h"
 #include "psi4/libciomr/libciomr.h"
 #include "psi4/libpsio/psio.h"
+#include "psi4/libpsio/psio.hpp"
 #include "psi4/libparallel/parallel.h"
 #include "psi4/libiwl/iwl.hpp"
 #include "psi4/libqt/qt.h"
@@ -62,6 +69,96 @@ using namespace psi;
 
 namespace psi { namespace scf {
 
+namespace {
+
+/*
+ * The persistent atomic density cache.  Each record in the file is
+ *   [uint32 key length][key][int32 nbf][nbf x nbf doubles]
+ * after an 8 byte magic header.  A truncated trailing record (e.g. from a
+ * killed job) is ignored on load.  The file is never modified in place:
+ * once a guess has computed its new densities, they are merged with
+ * whatever is on disk, written to a private temporary file and renamed over
+ * the cache, so that concurrent jobs that share a scratch directory never
+ * see each other's partial writes.
+ */
+const char sad_cache_magic[8] = {'P', 'S', 'I', '4', 'S', 'A', 'D', '1'};
+// The densities loaded from (or added to) sad_cache_file, keyed as in atomic_density_key()
+std::map<std::string, SharedMatrix> sad_cache;
+std::string sad_cache_file;
+// Whether sad_cache holds densities that sad_cache_file doesn't yet
+bool sad_cache_dirty = false;
+
+void sad_cache_read(const std::string& path, std::map<std::string, SharedMatrix>& cache)
+{
+    FILE* fh = fopen(path.c_str(), "rb");
+    if (!fh) return;
+    char magic[8];
+    if (fread(magic, 1, 8, fh) != 8 || memcmp(magic, sad_cache_magic, 8)) {
+        fclose(fh);
+        return;
+    }
+    while (true) {
+        uint32_t keylen;
+        int32_t nbf;
+        if (fread(&keylen, sizeof(uint32_t), 1, fh) != 1 || keylen > 65536) break;
+        std::string key(keylen, ' ');
+        if (fread(&key[0], 1, keylen, fh) != keylen) break;
+        if (fread(&nbf, sizeof(int32_t), 1, fh) != 1 || nbf <= 0) break;
+        SharedMatrix D(new Matrix("Atomic D", nbf, nbf));
+        size_t nel = (size_t)nbf * nbf;
+        if (fread(D->pointer()[0], sizeof(double), nel, fh) != nel) break;
+        cache[key] = D;
+    }
+    fclose(fh);
+}
+
+void sad_cache_load(const std::string& path)
+{
+    if (path == sad_cache_file) return;
+    sad_cache.clear();
+    sad_cache_file = path;
+    sad_cache_dirty = false;
+    sad_cache_read(path, sad_cache);
+}
+
+void sad_cache_add(const std::string& key, SharedMatrix D)
+{
+    sad_cache[key] = SharedMatrix(D->clone());
+    sad_cache_dirty = true;
+}
+
+void sad_cache_write()
+{
+    if (!sad_cache_dirty) return;
+    sad_cache_dirty = false;
+
+    // Pick up the records other jobs have added since we loaded the file
+    std::map<std::string, SharedMatrix> on_disk;
+    sad_cache_read(sad_cache_file, on_disk);
+    for (std::map<std::string, SharedMatrix>::iterator it = on_disk.begin(); it != on_disk.end(); ++it)
+        if (sad_cache.find(it->first) == sad_cache.end()) sad_cache[it->first] = it->second;
+
+    std::string tmp = sad_cache_file + "." + psio_getpid() + ".tmp";
+    FILE* fh = fopen(tmp.c_str(), "wb");
+    if (!fh) return;
+    bool ok = (fwrite(sad_cache_magic, 1, 8, fh) == 8);
+    for (std::map<std::string, SharedMatrix>::iterator it = sad_cache.begin(); ok && it != sad_cache.end(); ++it) {
+        uint32_t keylen = it->first.size();
+        int32_t nbf = it->second->rowdim();
+        size_t nel = (size_t)nbf * nbf;
+        ok = fwrite(&keylen, sizeof(uint32_t), 1, fh) == 1 &&
+             fwrite(it->first.c_str(), 1, keylen, fh) == keylen &&
+             fwrite(&nbf, sizeof(int32_t), 1, fh) == 1 &&
+             fwrite(it->second->pointer()[0], sizeof(double), nel, fh) == nel;
+    }
+    if (fclose(fh) != 0) ok = false;
+    // rename() replaces the cache atomically; a failed write just leaves it alone
+    if (!ok || rename(tmp.c_str(), sad_cache_file.c_str()) != 0)
+        remove(tmp.c_str());
+}
+
+}
+
 SADGuess::SADGuess(std::shared_ptr<BasisSet> basis, int nalpha, int nbeta, Options& options) :
     basis_(basis), nalpha_(nalpha), nbeta_(nbeta), options_(options)
 {
@@ -271,15 +368,43 @@ SharedMatrix SADGuess::form_D_AO()
         atomic_D.push_back(dtmp);
     }
 
+    // Consult the persistent cache of atomic densities, if requested
+    bool use_cache = options_.get_bool("SAD_CACHE");
+    int cache_hits = 0;
+    if (use_cache) {
+        std::string path = options_.get_str("SAD_CACHE_FILE");
+        if (path.empty())
+            path = PSIOManager::shared_object()->get_default_path() + "psi4.sad_cache.dat";
+        sad_cache_load(path);
+    }
+
     if (print_ > 1)
         outfile->Printf("\n  Performing Atomic UHF Computations:\n");
     for (int A = 0; A<nunique; A++) {
         int index = atomic_indices[A];
+        std::string key;
+        if (use_cache) {
+            key = atomic_density_key(atomic_bases[index], nelec[index], nhigh[index]);
+            std::map<std::string, SharedMatrix>::iterator it = sad_cache.find(key);
+            if (it != sad_cache.end() && it->second->rowdim() == atomic_D[A]->rowdim()) {
+                atomic_D[A]->copy(it->second);
+                cache_hits++;
+                if (print_ > 1)
+                    outfile->Printf("\n  Unique Atom %d which is Atom %d: read from the SAD cache\n", A, index);
+                continue;
+            }
+        }
         if (print_ > 1)
             outfile->Printf("\n  UHF Computation for Unique Atom %d which is Atom %d:",A, index);
         get_uhf_atomic_density(atomic_bases[index], nelec[index], nhigh[index], atomic_D[A]);
         if (print_ > 1)
             outfile->Printf("Finished UHF Computation!\n");
+        if (use_cache)
+            sad_cache_add(key, atomic_D[A]);
+    }
+    if (use_cache) {
+        sad_cache_write();
+        Process::environment.globals["SAD CACHE HITS"] = cache_hits;
     }
     if (print_)
         outfile->Printf("\n");
@@ -304,6 +429,58 @@ SharedMatrix SADGuess::form_D_AO()
 
     return DAO;
 }
+namespace {
+
+// FNV-1a over the shell structure, exponents and contraction coefficients
+uint64_t basis_hash(std::shared_ptr<BasisSet> bas)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](const void* data, size_t len) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < len; i++) {
+            hash ^= p[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+    for (int Q = 0; Q < bas->nshell(); Q++) {
+        const GaussianShell& shell = bas->shell(Q);
+        int am = shell.am();
+        int pure = shell.is_pure();
+        mix(&am, sizeof(int));
+        mix(&pure, sizeof(int));
+        for (int K = 0; K < shell.nprimitive(); K++) {
+            double exp = shell.exp(K);
+            double coef = shell.original_coef(K);
+            mix(&exp, sizeof(double));
+            mix(&coef, sizeof(double));
+        }
+    }
+    return hash;
+}
+
+}
+
+std::string SADGuess::atomic_density_key(std::shared_ptr<BasisSet> bas, int nelec, int nhigh)
+{
+    std::stringstream key;
+    key << std::setprecision(17);
+    key << "Z=" << bas->molecule()->Z(0) << ";nelec=" << nelec << ";nhigh=" << nhigh;
+    key << ";basis=" << bas->name() << ";nbf=" << bas->nbf() << ";hash=" << std::hex << basis_hash(bas) << std::dec;
+    key << ";type=" << options_.get_str("SAD_SCF_TYPE");
+    if (options_.get_str("SAD_SCF_TYPE") == "DF") {
+        // Key on the fitting basis actually built for this atom, not on the option string
+        std::shared_ptr<BasisSet> auxiliary = BasisSet::pyconstruct_orbital(bas->molecule(), "BASIS",
+                                                options_.get_str("DF_BASIS_SAD"));
+        key << ";fit=" << auxiliary->name() << ";nfit=" << auxiliary->nbf()
+            << ";fithash=" << std::hex << basis_hash(auxiliary) << std::dec;
+    }
+    key << ";frac=" << options_.get_bool("SAD_FRAC_OCC");
+    key << ";e_conv=" << options_.get_double("SAD_E_CONVERGENCE");
+    key << ";d_conv=" << options_.get_double("SAD_D_CONVERGENCE");
+    key << ";maxiter=" << options_.get_int("SAD_MAXITER");
+    key << ";chol=" << options_.get_double("SAD_CHOL_TOLERANCE");
+    return key.str();
+}
 void SADGuess::get_uhf_atomic_density(std::shared_ptr<BasisSet> bas, int nelec, int nhigh, SharedMatrix D)
 {
     std::shared_ptr<Molecule> mol = bas->molecule();
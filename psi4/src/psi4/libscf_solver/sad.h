@@ -64,6 +64,8 @@ protected:
                       SharedMatrix S, SharedMatrix X);
     void get_uhf_atomic_density(std::shared_ptr<BasisSet> atomic_basis,
                                 int n_electrons, int multiplicity, SharedMatrix D);
+    std::string atomic_density_key(std::shared_ptr<BasisSet> atomic_basis,
+                                   int n_electrons, int multiplicity);
     void form_C_and_D(int nocc, int norbs, SharedMatrix X, SharedMatrix F,
                                   SharedMatrix C, SharedMatrix Cocc, SharedVector occ,
                                   SharedMatrix D);
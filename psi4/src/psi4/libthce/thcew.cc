@@ -56,9 +56,11 @@ using namespace std;
 
 namespace psi {
 
-THCEW::THCEW() :
-    Wavefunction(Process::environment.options)
+THCEW::THCEW(SharedWavefunction ref_wfn, Options& options) :
+    Wavefunction(options)
 {
+    shallow_copy(ref_wfn);
+    reference_wavefunction_ = ref_wfn;
     common_init();
 }
 THCEW::~THCEW()
@@ -69,9 +71,6 @@ void THCEW::common_init()
     print_ = options_.get_int("PRINT");
     debug_ = options_.get_int("DEBUG");
 
-
-    //reference_wavefunction_ = Process::environment.legacy_wavefunction();
-    throw PSIEXCEPTION("Rob: I broke your code. Check your email.");
     if (!reference_wavefunction_) {
         throw PSIEXCEPTION("THCEW: Run SCF first");
     }
@@ -80,12 +79,10 @@ void THCEW::common_init()
         throw PSIEXCEPTION("Does not currently work for non RHF references. Blame DGAS.");
         // reference_wavefunction_->semicanonicalize();
 
-    shallow_copy(reference_wavefunction_);
-
     thce_ = std::shared_ptr<THCE>(new THCE());
 }
-RTHCEW::RTHCEW() :
-    THCEW()
+RTHCEW::RTHCEW(SharedWavefunction ref_wfn, Options& options) :
+    THCEW(ref_wfn, options)
 {
     common_init();
 }
@@ -48,7 +48,7 @@ protected:
     void common_init();
 
 public:
-    THCEW();
+    THCEW(SharedWavefunction ref_wfn, Options& options);
     virtual ~THCEW();
 
 };
@@ -152,7 +152,7 @@ protected:
     void build_meth_ia(std::shared_ptr<Matrix> X);
 
 public:
-    RTHCEW();
+    RTHCEW(SharedWavefunction ref_wfn, Options& options);
     virtual ~RTHCEW();
 };
 
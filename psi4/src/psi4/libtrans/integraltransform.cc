@@ -86,6 +86,7 @@ IntegralTransform::IntegralTransform(std::shared_ptr<Wavefunction> wfn,
             keepDpdSoInts_(false),
             keepDpdMoTpdm_(true),
             keepHtInts_(true),
+            htInCore_(Process::environment.options.get_bool("HALF_TRANSFORM_IN_CORE")),
             keepHtTpdm_(true),
             tpdmAlreadyPresorted_(false),
             soIntTEIFile_(PSIF_SO_TEI)
@@ -171,6 +172,7 @@ IntegralTransform::IntegralTransform(SharedMatrix c,
     keepDpdSoInts_(false),
     keepDpdMoTpdm_(true),
     keepHtInts_(true),
+    htInCore_(Process::environment.options.get_bool("HALF_TRANSFORM_IN_CORE")),
     keepHtTpdm_(true),
     tpdmAlreadyPresorted_(false),
     soIntTEIFile_(PSIF_SO_TEI)
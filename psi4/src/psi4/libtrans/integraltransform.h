@@ -204,6 +204,11 @@ class IntegralTransform{
         /// Whether the library will keep or delete the SO integrals in DPD form after processing
         bool get_keep_dpd_so_ints() const {return keepDpdSoInts_;}
 
+        /// Set the library to hold the half-transformed integrals in core during the first half, when they fit
+        void set_half_transform_in_core(bool val) {htInCore_ = val;}
+        /// Whether the library will try to hold the half-transformed integrals in core during the first half
+        bool get_half_transform_in_core() const {return htInCore_;}
+
         /// Set the library to keep or delete the SO integrals in IWL form after processing
         void set_keep_iwl_so_ints(bool val) {keepIwlSoInts_ = val;}
         /// Whether the library will keep or delete the SO integrals in IWL form after processing
@@ -261,6 +266,13 @@ class IntegralTransform{
         void presort_mo_tpdm_unrestricted();
         void setup_tpdm_buffer(const dpdbuf4 *D);
         void sort_so_tpdm(const dpdbuf4 *B, int irrep, size_t first_row, size_t num_rows, bool first_run);
+        void transform_tei_rows(dpdbuf4 *J, dpdbuf4 *K, int h, int nbucketrows,
+                                const SharedMatrix &c1, const SharedMatrix &c2,
+                                const int *orbsPI1, const int *orbsPI2);
+        bool first_half_fits_in_core(dpdbuf4 *J, dpdbuf4 *K);
+        void transform_tei_first_half_in_core(dpdbuf4 *J, dpdbuf4 *K, dpdbuf4 *T,
+                                              const SharedMatrix &c1, const SharedMatrix &c2,
+                                              const int *orbsPI1, const int *orbsPI2);
 
         void trans_one(int m, int n, double *input, double *output, double **C, int soOffset,
                        int *order, bool backtransform = false, double scale = 0.0);
@@ -408,6 +420,8 @@ class IntegralTransform{
         bool keepDpdMoTpdm_;
         // Whether to keep the half-transformed two electron integrals
         bool keepHtInts_;
+        // Whether to do the first half-transformation in core when it fits
+        bool htInCore_;
         // Whether to keep the half-transformed TPDM
         bool keepHtTpdm_;
         // Whether to print the two-electron integrals or not
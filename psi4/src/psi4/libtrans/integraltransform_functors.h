@@ -31,6 +31,10 @@
 #include "psi4/libdpd/dpd.h"
 #include "psi4/libiwl/iwl.hpp"
 #include "psi4/libpsio/psio.hpp"
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace psi{
 
@@ -477,6 +481,13 @@ private:
     bool symmetrize_;
     bool have_bra_ket_sym_;
 public:
+    /// A resolved contribution: the bucket element it goes to, and its (global) row
+    struct Target {
+        double *element;
+        double value;
+        int row;
+    };
+
     DPDFillerFunctor(dpdfile4 *file, int this_bucket, int **bucket_map,
                      int **bucket_offset, bool symmetrize, bool have_bra_ket_sym):
         file_(file), this_bucket_(this_bucket), bucket_map_(bucket_map),
@@ -487,6 +498,18 @@ public:
     }
     void operator()(int p, int q, int r, int s, double value)
     {
+        Target targets[2];
+        int ntargets = resolve(p, q, r, s, value, targets);
+        for(int n = 0; n < ntargets; ++n)
+            *(targets[n].element) += targets[n].value;
+    }
+    /*
+     * Works out where the integral (pq|rs) goes in the current bucket, without
+     * touching the bucket, and returns the number (0, 1 or 2) of targets found.
+     */
+    int resolve(int p, int q, int r, int s, double value, Target *targets)
+    {
+        int ntargets = 0;
         if(symmetrize_){
             // Symmetrize the quantity (used in density matrix processing)
             if(p!=q) value *= 0.5;
@@ -511,7 +534,10 @@ public:
             int offset = bucket_offset_[this_bucket_][pq_sym];
             if((pq-offset >= params_->rowtot[pq_sym]) || (rs >= params_->coltot[rs_sym]))
                 error("MP Params_make: pq, rs", p,q,r,s,pq,rs,pq_sym,rs_sym);
-            file_->matrix[pq_sym][pq-offset][rs] += value;
+            targets[ntargets].element = &(file_->matrix[pq_sym][pq-offset][rs]);
+            targets[ntargets].value = value;
+            targets[ntargets].row = pq;
+            ++ntargets;
         }
 
         /*
@@ -526,8 +552,12 @@ public:
             int offset = bucket_offset_[this_bucket_][rs_sym];
             if((rs-offset >= params_->rowtot[rs_sym])||(pq >= params_->coltot[pq_sym]))
                 error("MP Params_make: rs, pq", p,q,r,s,rs,pq,rs_sym,pq_sym);
-            file_->matrix[rs_sym][rs-offset][pq] += value;
+            targets[ntargets].element = &(file_->matrix[rs_sym][rs-offset][pq]);
+            targets[ntargets].value = value;
+            targets[ntargets].row = rs;
+            ++ntargets;
         }
+        return ntargets;
     }
 
 private:
@@ -584,5 +614,81 @@ void iwl_integrals(IWL* iwl, DPDFunctor &dpd, FockFunctor &fock)
     iwl->set_keep_flag(1);
 }
 
+/*
+ * A threaded variant of iwl_integrals for the DPD bucket fill.  The IWL buffers
+ * are read sequentially and their labels decoded into a staging block of up to
+ * nbuffers buffers.  Each thread then takes a contiguous slice of the block,
+ * runs its own Fock functor over it, and resolves every integral once into
+ * bucket elements, which it files into per-thread buckets by the thread that
+ * owns the destination row (row % nthread).  After a barrier each thread adds
+ * in the contributions filed for its rows, so no two threads write the same
+ * row and no integral is looked up twice.  The Fock functors must accumulate
+ * into private arrays, which the caller sums afterwards; one functor is
+ * passed per thread.
+ */
+template <class FockFunctor>
+void iwl_integrals_threaded(IWL* iwl, DPDFillerFunctor &dpd, std::vector<FockFunctor> &fock,
+                            int nbuffers = 64)
+{
+    int nthread = fock.size();
+    if(nthread < 2){
+        iwl_integrals(iwl, dpd, fock[0]);
+        return;
+    }
+    Label *lblptr = iwl->labels();
+    Value *valptr = iwl->values();
+    size_t maxints = (size_t) nbuffers * iwl->ints_per_buffer();
+    std::vector<int> labels(4*maxints);
+    std::vector<double> values(maxints);
+    // buckets[from * nthread + owner] holds what thread "from" resolved for thread "owner"
+    std::vector<std::vector<DPDFillerFunctor::Target> > buckets(nthread * nthread);
+    bool lastBuffer;
+    do{
+        size_t nints = 0;
+        do{
+            lastBuffer = iwl->last_buffer();
+            for(int index = 0; index < iwl->buffer_count(); ++index, ++nints){
+                int labelIndex = 4*index;
+                labels[4*nints    ] = abs((int) lblptr[labelIndex++]);
+                labels[4*nints + 1] = (int) lblptr[labelIndex++];
+                labels[4*nints + 2] = (int) lblptr[labelIndex++];
+                labels[4*nints + 3] = (int) lblptr[labelIndex++];
+                values[nints] = (double) valptr[index];
+            }
+            if(!lastBuffer) iwl->fetch();
+        }while(!lastBuffer && nints + iwl->ints_per_buffer() <= maxints);
+
+        const int *lbl = labels.data();
+        const double *val = values.data();
+#pragma omp parallel num_threads(nthread)
+        {
+            int thread = 0;
+#ifdef _OPENMP
+            thread = omp_get_thread_num();
+#endif
+            size_t first = nints * thread / nthread;
+            size_t last = nints * (thread + 1) / nthread;
+            FockFunctor &myfock = fock[thread];
+            DPDFillerFunctor::Target targets[2];
+            for(int owner = 0; owner < nthread; ++owner)
+                buckets[thread * nthread + owner].clear();
+            for(size_t index = first; index < last; ++index){
+                const int *pqrs = lbl + 4*index;
+                myfock(pqrs[0], pqrs[1], pqrs[2], pqrs[3], 0,0,0,0,0,0,0,0, val[index]);
+                int ntargets = dpd.resolve(pqrs[0], pqrs[1], pqrs[2], pqrs[3], val[index], targets);
+                for(int n = 0; n < ntargets; ++n)
+                    buckets[thread * nthread + targets[n].row % nthread].push_back(targets[n]);
+            }
+#pragma omp barrier
+            for(int from = 0; from < nthread; ++from){
+                const std::vector<DPDFillerFunctor::Target> &mine = buckets[from * nthread + thread];
+                for(size_t n = 0; n < mine.size(); ++n)
+                    *(mine[n].element) += mine[n].value;
+            }
+        }
+    }while(!lastBuffer);
+    iwl->set_keep_flag(1);
+}
+
 } // Namespaces
 #endif // INTEGRALTRANSFORM_FUNCTORS_H
@@ -31,6 +31,7 @@
 #include "psi4/libqt/qt.h"
 #include "psi4/libiwl/iwl.hpp"
 #include "psi4/libmints/matrix.h"
+#include "psi4/libparallel/process.h"
 #include "psi4/psifiles.h"
 #include "integraltransform_functors.h"
 #include "mospace.h"
@@ -306,9 +307,12 @@ IntegralTransform::presort_so_tei()
         }
     }
 
+    int nthreads = Process::environment.get_n_threads();
+
     if(print_) {
         outfile->Printf( "\tSorting File: %s nbuckets = %d\n", I.label, nBuckets);
-
+        if(print_ > 1)
+            outfile->Printf( "\tFilling the buckets with %d threads\n", nthreads);
     }
 
     next = PSIO_ZERO;
@@ -319,22 +323,33 @@ IntegralTransform::presort_so_tei()
         }
 
         DPDFillerFunctor dpdfiller(&I,n,bucketMap,bucketOffset, false, true);
-        NullFunctor null;
         IWL *iwl = new IWL(psio_.get(), soIntTEIFile_, tolerance_, 1, 1);
-        // In the functors below, we only want to build the Fock matrix on the first pass
-        if(transformationType_ == Restricted){
-            FrozenCoreAndFockRestrictedFunctor fock(aD, aFzcD,aFock,aFzcOp);
-            if(n)
-                iwl_integrals(iwl, dpdfiller, null);
-            else
-                iwl_integrals(iwl, dpdfiller, fock);
+        // We only want to build the Fock matrix on the first pass.  Each thread
+        // accumulates its share into private copies, summed in afterwards.
+        if(n){
+            std::vector<NullFunctor> null(nthreads);
+            iwl_integrals_threaded(iwl, dpdfiller, null);
         }else{
-            FrozenCoreAndFockUnrestrictedFunctor fock(aD, bD, aFzcD, bFzcD,
-                                                      aFock, bFock, aFzcOp, bFzcOp);
-            if(n)
-                iwl_integrals(iwl, dpdfiller, null);
-            else
-                iwl_integrals(iwl, dpdfiller, fock);
+            int ncopies = (transformationType_ == Restricted ? 2 : 4);
+            double **partial = block_matrix(nthreads * ncopies, nTriSo_);
+            if(transformationType_ == Restricted){
+                std::vector<FrozenCoreAndFockRestrictedFunctor> fock;
+                for(int t = 0; t < nthreads; ++t)
+                    fock.push_back(FrozenCoreAndFockRestrictedFunctor(aD, aFzcD,
+                                   partial[2*t], partial[2*t+1]));
+                iwl_integrals_threaded(iwl, dpdfiller, fock);
+            }else{
+                std::vector<FrozenCoreAndFockUnrestrictedFunctor> fock;
+                for(int t = 0; t < nthreads; ++t)
+                    fock.push_back(FrozenCoreAndFockUnrestrictedFunctor(aD, bD, aFzcD, bFzcD,
+                                   partial[4*t], partial[4*t+2], partial[4*t+1], partial[4*t+3]));
+                iwl_integrals_threaded(iwl, dpdfiller, fock);
+            }
+            double *targets[4] = {aFock, aFzcOp, bFock, bFzcOp};
+            for(int t = 0; t < nthreads; ++t)
+                for(int c = 0; c < ncopies; ++c)
+                    C_DAXPY(nTriSo_, 1.0, partial[ncopies*t + c], 1, targets[c], 1);
+            free_block(partial);
         }
         delete iwl;
 
@@ -30,6 +30,8 @@
 #include "psi4/libciomr/libciomr.h"
 #include "psi4/libiwl/iwl.hpp"
 #include "psi4/libqt/qt.h"
+#include "psi4/libmints/matrix.h"
+#include "psi4/libparallel/process.h"
 #include <math.h>
 #include <ctype.h>
 #include <stdio.h>
@@ -37,6 +39,9 @@
 #include "mospace.h"
 #define EXTERN
 #include "psi4/libdpd/dpd.gbl"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 ;
 using namespace psi;
@@ -66,3 +71,128 @@ IntegralTransform::transform_tei(const std::shared_ptr<MOSpace> s1, const std::s
     }
     transform_tei_second_half(s1, s2, s3, s4);
 }
+
+/**
+ * Transforms the ket indices of a block of rows from (xx|nn) to (xx|S1 S2), one irrep
+ * at a time.  The (row, ket irrep) pairs are independent, so they're distributed
+ * over the threads together, each thread using its own half-transformed scratch.
+ * BLAS is held to one thread meanwhile, so a threaded BLAS doesn't oversubscribe.
+ *
+ * @param J           - the buffer holding the input rows for irrep h, with [n,n] kets
+ * @param K           - the buffer receiving the transformed rows for irrep h
+ * @param h           - the irrep of the rows
+ * @param nbucketrows - the number of rows currently held in J and K
+ * @param c1          - the coefficients for the first ket index
+ * @param c2          - the coefficients for the second ket index
+ * @param orbsPI1     - the number of orbitals per irrep in the first ket space
+ * @param orbsPI2     - the number of orbitals per irrep in the second ket space
+ */
+void
+IntegralTransform::transform_tei_rows(dpdbuf4 *J, dpdbuf4 *K, int h, int nbucketrows,
+                                      const SharedMatrix &c1, const SharedMatrix &c2,
+                                      const int *orbsPI1, const int *orbsPI2)
+{
+    int nthread = Process::environment.get_n_threads();
+    std::vector<double**> TMP(nthread);
+    for(int t = 0; t < nthread; ++t)
+        TMP[t] = block_matrix(nso_, nso_);
+
+    long int ntasks = static_cast<long int>(nbucketrows) * nirreps_;
+    int old_blas_threads = blas_set_num_threads(1);
+#pragma omp parallel for schedule(dynamic) num_threads(nthread)
+    for(long int task = 0; task < ntasks; ++task){
+        int pq = task / nirreps_;
+        int Gr = task % nirreps_;
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        double **T = TMP[thread];
+
+        // Transform ( x x | n n ) -> ( x x | n S2 )
+        int Gs = h^Gr;
+        int nrows = sopi_[Gr];
+        int ncols = orbsPI2[Gs];
+        int nlinks = sopi_[Gs];
+        int rs = J->col_offset[h][Gr];
+        double **pc2 = c2->pointer(Gs);
+        if(nrows && ncols && nlinks)
+            C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, &J->matrix[h][pq][rs],
+                    nlinks, pc2[0], ncols, 0.0, T[0], nso_);
+
+        // Transform ( x x | n S2 ) -> ( x x | S1 S2 )
+        nrows = orbsPI1[Gr];
+        ncols = orbsPI2[Gs];
+        nlinks = sopi_[Gr];
+        rs = K->col_offset[h][Gr];
+        double **pc1 = c1->pointer(Gr);
+        if(nrows && ncols && nlinks)
+            C_DGEMM('t', 'n', nrows, ncols, nlinks, 1.0, pc1[0], nrows,
+                    T[0], nso_, 0.0, &K->matrix[h][pq][rs], ncols);
+    }
+    blas_set_num_threads(old_blas_threads);
+
+    for(int t = 0; t < nthread; ++t)
+        free_block(TMP[t]);
+}
+
+/**
+ * Whether the in-core first half-transformation can hold every irrep at once: all of
+ * the SO integral rows, the half-transformed rows and their sorted copy.
+ *
+ * @param J - the buffer holding the SO integrals, with [n,n] kets
+ * @param K - the buffer receiving the half-transformed integrals
+ */
+bool
+IntegralTransform::first_half_fits_in_core(dpdbuf4 *J, dpdbuf4 *K)
+{
+    long int memFree = dpd_memfree();
+    for(int h = 0; h < nirreps_; ++h){
+        long int need = static_cast<long int>(J->params->rowtot[h]) * J->params->coltot[h]
+                      + 2L * K->params->rowtot[h] * K->params->coltot[h];
+        if(need > memFree) return false;
+    }
+    return true;
+}
+
+/**
+ * The first half-transformation with each irrep held in core.  The (nn|S1 S2) rows in
+ * K are sorted straight into the (S1 S2|nn) layout of T, which replaces the round trip
+ * through PSIF_HALFT0 and buf4_sort() taken by the bucketed algorithm.
+ *
+ * @param J       - the buffer holding the SO integrals, with [n,n] kets
+ * @param K       - the buffer for the half-transformed integrals, with unpacked S1 S2 kets
+ * @param T       - the buffer receiving the sorted half-transformed integrals
+ * @param c1      - the coefficients for the first ket index
+ * @param c2      - the coefficients for the second ket index
+ * @param orbsPI1 - the number of orbitals per irrep in the first ket space
+ * @param orbsPI2 - the number of orbitals per irrep in the second ket space
+ */
+void
+IntegralTransform::transform_tei_first_half_in_core(dpdbuf4 *J, dpdbuf4 *K, dpdbuf4 *T,
+                                                    const SharedMatrix &c1, const SharedMatrix &c2,
+                                                    const int *orbsPI1, const int *orbsPI2)
+{
+    for(int h = 0; h < nirreps_; ++h){
+        if(!J->params->rowtot[h] || !J->params->coltot[h]) continue;
+
+        global_dpd_->buf4_mat_irrep_init(J, h);
+        global_dpd_->buf4_mat_irrep_init(K, h);
+        global_dpd_->buf4_mat_irrep_rd(J, h);
+        transform_tei_rows(J, K, h, J->params->rowtot[h], c1, c2, orbsPI1, orbsPI2);
+        global_dpd_->buf4_mat_irrep_close(J, h);
+
+        // The rspq sort; the rows of T are the (packed) S1 S2 kets of K
+        global_dpd_->buf4_mat_irrep_init(T, h);
+        for(int pq = 0; pq < T->params->rowtot[h]; ++pq){
+            int p = T->params->roworb[h][pq][0];
+            int q = T->params->roworb[h][pq][1];
+            int PQ = K->params->colidx[p][q];
+            for(int rs = 0; rs < T->params->coltot[h]; ++rs)
+                T->matrix[h][pq][rs] = K->matrix[h][rs][PQ];
+        }
+        global_dpd_->buf4_mat_irrep_close(K, h);
+        global_dpd_->buf4_mat_irrep_wrt(T, h);
+        global_dpd_->buf4_mat_irrep_close(T, h);
+    }
+}
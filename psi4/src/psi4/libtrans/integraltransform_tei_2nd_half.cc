@@ -87,8 +87,6 @@ IntegralTransform::transform_tei_second_half(const std::shared_ptr<MOSpace> s1,
     size_t memFree;
     dpdbuf4 J, K;
 
-    double **TMP = block_matrix(nso_, nso_);
-
     if(print_) {
         if(transformationType_ == Restricted){
             outfile->Printf( "\tStarting second half-transformation.\n");
@@ -159,31 +157,8 @@ IntegralTransform::transform_tei_second_half(const std::shared_ptr<MOSpace> s1,
             else
                 thisBucketRows = (n < nBuckets-1) ? rowsPerBucket : rowsLeft;
             global_dpd_->buf4_mat_irrep_rd_block(&J, h, n*rowsPerBucket, thisBucketRows);
+            transform_tei_rows(&J, &K, h, thisBucketRows, c3a, c4a, aOrbsPI3, aOrbsPI4);
             for(int pq=0; pq < thisBucketRows; pq++) {
-                for(int Gr=0; Gr < nirreps_; Gr++) {
-                    // Transform ( S1 S2 | n n ) -> ( S1 S2 | n S4 )
-                    int Gs = h^Gr;
-                    int nrows = sopi_[Gr];
-                    int ncols = aOrbsPI4[Gs];
-                    int nlinks = sopi_[Gs];
-                    int rs = J.col_offset[h][Gr];
-                    double **pc4a = c4a->pointer(Gs);
-                    if(nrows && ncols && nlinks)
-                        C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, &J.matrix[h][pq][rs],
-                                nlinks, pc4a[0], ncols, 0.0, TMP[0], nso_);
-                    //TODO else if s4->label() == MOSPACE_NIL, copy buffer...
-
-                    // Transform ( S1 S2 | n S4 ) -> ( S1 S2 | S3 S4 )
-                    nrows = aOrbsPI3[Gr];
-                    ncols = aOrbsPI4[Gs];
-                    nlinks = sopi_[Gr];
-                    rs = K.col_offset[h][Gr];
-                    double **pc3a = c3a->pointer(Gr);
-                    if(nrows && ncols && nlinks)
-                        C_DGEMM('t', 'n', nrows, ncols, nlinks, 1.0, pc3a[0], nrows ,
-                                TMP[0], nso_, 0.0, &K.matrix[h][pq][rs], ncols);
-                    //TODO else if s3->label() == MOSPACE_NIL, copy buffer...
-                } /* Gr */
                 if(useIWL_){
                     int P = aIndex1[K.params->roworb[h][pq+n*rowsPerBucket][0]];
                     int Q = aIndex2[K.params->roworb[h][pq+n*rowsPerBucket][1]];
@@ -280,31 +255,8 @@ IntegralTransform::transform_tei_second_half(const std::shared_ptr<MOSpace> s1,
                 else
                     thisBucketRows = (n < nBuckets-1) ? rowsPerBucket : rowsLeft;
                 global_dpd_->buf4_mat_irrep_rd_block(&J, h, n*rowsPerBucket, thisBucketRows);
+                transform_tei_rows(&J, &K, h, thisBucketRows, c3b, c4b, bOrbsPI3, bOrbsPI4);
                 for(int pq=0; pq < thisBucketRows; pq++) {
-                    for(int Gr=0; Gr < nirreps_; Gr++) {
-                        // Transform ( S1 S2 | n n ) -> ( S1 S2 | n s4 )
-                        int Gs = h^Gr;
-                        int nrows = sopi_[Gr];
-                        int ncols = bOrbsPI4[Gs];
-                        int nlinks = sopi_[Gs];
-                        int rs = J.col_offset[h][Gr];
-                        double **pc4b = c4b->pointer(Gs);
-                        if(nrows && ncols && nlinks)
-                            C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, &J.matrix[h][pq][rs],
-                                    nlinks, pc4b[0], ncols, 0.0, TMP[0], nso_);
-                        //TODO else if s4->label() == MOSPACE_NIL, copy buffer...
-
-                        // Transform ( S1 S2 | n s4 ) -> ( S1 S2 | s3 s4 )
-                        nrows = bOrbsPI3[Gr];
-                        ncols = bOrbsPI4[Gs];
-                        nlinks = sopi_[Gr];
-                        rs = K.col_offset[h][Gr];
-                        double **pc3b = c3b->pointer(Gr);
-                        if(nrows && ncols && nlinks)
-                            C_DGEMM('t', 'n', nrows, ncols, nlinks, 1.0, pc3b[0], nrows,
-                                    TMP[0], nso_, 0.0, &K.matrix[h][pq][rs], ncols);
-                        //TODO else if s3->label() == MOSPACE_NIL, copy buffer...
-                    } /* Gr */
                     if(useIWL_){
                         int P = aIndex1[K.params->roworb[h][pq+n*rowsPerBucket][0]];
                         int Q = aIndex2[K.params->roworb[h][pq+n*rowsPerBucket][1]];
@@ -403,29 +355,8 @@ IntegralTransform::transform_tei_second_half(const std::shared_ptr<MOSpace> s1,
                 else
                     thisBucketRows = (n < nBuckets-1) ? rowsPerBucket : rowsLeft;
                 global_dpd_->buf4_mat_irrep_rd_block(&J, h, n*rowsPerBucket, thisBucketRows);
+                transform_tei_rows(&J, &K, h, thisBucketRows, c3b, c4b, bOrbsPI3, bOrbsPI4);
                 for(int pq=0; pq < thisBucketRows; pq++) {
-                    for(int Gr=0; Gr < nirreps_; Gr++) {
-                        // Transform ( s1 s2 | n n ) -> ( s1 s2 | n s4 )
-                        int Gs = h^Gr;
-                        int nrows = sopi_[Gr];
-                        int ncols = bOrbsPI4[Gs];
-                        int nlinks = sopi_[Gs];
-                        int rs = J.col_offset[h][Gr];
-                        double **pc4b = c4b->pointer(Gs);
-                        if(nrows && ncols && nlinks)
-                            C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, &J.matrix[h][pq][rs],
-                                    nlinks, pc4b[0], ncols, 0.0, TMP[0], nso_);
-
-                        // Transform ( s1 s2 | n s4 ) -> ( s1 s2 | s3 s4 )
-                        nrows = bOrbsPI3[Gr];
-                        ncols = bOrbsPI4[Gs];
-                        nlinks = sopi_[Gr];
-                        rs = K.col_offset[h][Gr];
-                        double **pc3b = c3b->pointer(Gr);
-                        if(nrows && ncols && nlinks)
-                            C_DGEMM('t', 'n', nrows, ncols, nlinks, 1.0, pc3b[0], nrows,
-                                    TMP[0], nso_, 0.0, &K.matrix[h][pq][rs], ncols);
-                    } /* Gr */
                     if(useIWL_){
                         int P = bIndex1[K.params->roworb[h][pq+n*rowsPerBucket][0]];
                         int Q = bIndex2[K.params->roworb[h][pq+n*rowsPerBucket][1]];
@@ -468,7 +399,6 @@ IntegralTransform::transform_tei_second_half(const std::shared_ptr<MOSpace> s1,
     psio_->close(dpdIntFile_, 1);
     psio_->close(aHtIntFile_, keepHtInts_);
 
-    free_block(TMP);
     delete [] label;
 
     if(print_){
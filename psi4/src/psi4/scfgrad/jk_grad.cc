@@ -37,6 +37,8 @@
 #include "psi4/libmints/basisset.h"
 #include "psi4/libmints/integral.h"
 #include "psi4/libmints/vector.h"
+#include <algorithm>
+#include <cmath>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -46,6 +48,36 @@ using namespace psi;
 namespace psi {
 namespace scfgrad {
 
+namespace {
+
+/// Largest |D1|, |D2| element in each shell block, for density screening
+SharedMatrix shell_block_max(std::shared_ptr<BasisSet> basis, SharedMatrix D1, SharedMatrix D2)
+{
+    int nshell = basis->nshell();
+    SharedMatrix Dmax(new Matrix("Shell Block Max", nshell, nshell));
+    double** Dmaxp = Dmax->pointer();
+    double** D1p = D1->pointer();
+    double** D2p = D2->pointer();
+    for (int M = 0; M < nshell; M++) {
+        int oM = basis->shell(M).function_index();
+        int nM = basis->shell(M).nfunction();
+        for (int N = 0; N < nshell; N++) {
+            int oN = basis->shell(N).function_index();
+            int nN = basis->shell(N).nfunction();
+            double val = 0.0;
+            for (int m = oM; m < oM + nM; m++) {
+                for (int n = oN; n < oN + nN; n++) {
+                    val = std::max(val, std::max(std::fabs(D1p[m][n]), std::fabs(D2p[m][n])));
+                }
+            }
+            Dmaxp[M][N] = val;
+        }
+    }
+    return Dmax;
+}
+
+}
+
 JKGrad::JKGrad(int deriv, std::shared_ptr<BasisSet> primary) :
     deriv_(deriv), primary_(primary)
 {
@@ -1626,6 +1658,11 @@ void DFJKGrad::compute_hessian()
      *
      * Andy Simmonett (07/16)
      *
+     * The three terms built from first derivatives combine to 2 W[x] Minv W[y], with W[x] = (mn|A)^x - (A|B)^x Minv[B][C] (C|mn).
+     * The J and K flavors of W are accumulated in a single intermediate each, and the integral loops run one auxiliary shell
+     * per task with per-thread Hessian accumulators.  Shell pairs are Schwarz screened, and second derivative blocks whose
+     * density weights all fall below the cutoff are skipped.
+     *
      */
 
     // => Set up hessians <= //
@@ -1664,24 +1701,36 @@ void DFJKGrad::compute_hessian()
 
     SharedVector c(new Vector("c[A] = (mn|A) D[m][n]", np));
     double *cp = c->pointer();
-    SharedMatrix dc(new Matrix("dc[x][A] = (mn|A)^x D[m][n]",  3*natoms, np));
+    SharedMatrix dc(new Matrix("dc[x][A] = (mn|A)^x D[m][n] - (A|B)^x d[B]",  3*natoms, np));
     double **dcp = dc->pointer();
-    SharedMatrix dAij(new Matrix("dAij[x][A,i,j] = (mn|A)^x C[m][i] C[n][j]",  3*natoms, np*na*na));
+    SharedMatrix dAij(new Matrix("dAij[x][A,i,j] = (mn|A)^x C[m][i] C[n][j] - (A|B)^x Bij[B,i,j]",  3*natoms, np*na*na));
     double **dAijp = dAij->pointer();
     SharedVector d(new Vector("d[A] = Minv[A][B] C[B]", np));
     double *dp = d->pointer();
-    SharedMatrix dd(new Matrix("dd[x][B] = dc[x][A] Minv[A][B]", 3*natoms, np));
-    double **ddp = dd->pointer();
-    SharedMatrix de(new Matrix("de[x][A] = (A|B)^x d[B] ", 3*natoms, np));
-    double **dep = de->pointer();
-    SharedMatrix deij(new Matrix("deij[x][A,i,j] = (A|B)^x Bij[B,i,j]", 3*natoms, np*na*na));
-    double **deijp = deij->pointer();
 
     // Build some integral factories
     std::shared_ptr<IntegralFactory> Pmnfactory(new IntegralFactory(auxiliary_, BasisSet::zero_ao_basis_set(), primary_, primary_));
     std::shared_ptr<IntegralFactory> PQfactory(new IntegralFactory(auxiliary_, BasisSet::zero_ao_basis_set(), auxiliary_, BasisSet::zero_ao_basis_set()));
-    std::shared_ptr<TwoBodyAOInt> Pmnint(Pmnfactory->eri(2));
-    std::shared_ptr<TwoBodyAOInt> PQint(PQfactory->eri(2));
+    int nthread = df_ints_num_threads_;
+    std::vector<std::shared_ptr<TwoBodyAOInt> > Pmnint;
+    std::vector<std::shared_ptr<TwoBodyAOInt> > PQint;
+    std::vector<SharedMatrix> JHess;
+    std::vector<SharedMatrix> KHess;
+    for (int t = 0; t < nthread; t++) {
+        Pmnint.push_back(std::shared_ptr<TwoBodyAOInt>(Pmnfactory->eri(2)));
+        PQint.push_back(std::shared_ptr<TwoBodyAOInt>(PQfactory->eri(2)));
+        JHess.push_back(SharedMatrix(new Matrix("JHess", 3*natoms, 3*natoms)));
+        KHess.push_back(SharedMatrix(new Matrix("KHess", 3*natoms, 3*natoms)));
+    }
+
+    // Schwarz significant (M,N) shell pairs, in both orders
+    std::shared_ptr<ERISieve> sieve(new ERISieve(primary_, cutoff_));
+    std::vector<char> significant(nshell * (size_t) nshell, 0);
+    const std::vector<std::pair<int,int> >& shell_pairs = sieve->shell_pairs();
+    for (size_t MN = 0; MN < shell_pairs.size(); MN++) {
+        significant[shell_pairs[MN].first * (size_t) nshell + shell_pairs[MN].second] = 1;
+        significant[shell_pairs[MN].second * (size_t) nshell + shell_pairs[MN].first] = 1;
+    }
     SharedMatrix Amn(new Matrix("(A|mn)", np, nso*nso));
     SharedMatrix Ami(new Matrix("(A|mi)", np, nso*na));
     SharedMatrix Aij(new Matrix("(A|ij)", np, na*na));
@@ -1689,6 +1738,7 @@ void DFJKGrad::compute_hessian()
     SharedMatrix Bim(new Matrix("Minv[B][A] (A|im)", np, nso*na));
     SharedMatrix Bmn(new Matrix("Minv[B][A] (A|mn)", np, nso*nso));
     SharedMatrix DPQ(new Matrix("B(P|ij) B(Q|ij)", np, np));
+    std::vector<double> dmax(nauxshell);
     double **Amnp = Amn->pointer();
     double **Amip = Ami->pointer();
     double **Aijp = Aij->pointer();
@@ -1698,18 +1748,25 @@ void DFJKGrad::compute_hessian()
     double **DPQp = DPQ->pointer();
 
 
+    // Each auxiliary shell owns its rows of (A|mn)
+#pragma omp parallel for schedule(dynamic) num_threads(nthread)
     for (int P = 0; P < nauxshell; ++P){
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
         int nP = auxiliary_->shell(P).nfunction();
         int oP = auxiliary_->shell(P).function_index();
         for(int M = 0; M < nshell; ++M){
             int nM = primary_->shell(M).nfunction();
             int oM = primary_->shell(M).function_index();
             for(int N = 0; N < nshell; ++N){
+                if (!significant[M * (size_t) nshell + N]) continue;
                 int nN = primary_->shell(N).nfunction();
                 int oN = primary_->shell(N).function_index();
 
-                Pmnint->compute_shell(P,0,M,N);
-                const double* buffer = Pmnint->buffer();
+                Pmnint[thread]->compute_shell(P,0,M,N);
+                const double* buffer = Pmnint[thread]->buffer();
 
                 for (int p = oP; p < oP+nP; p++) {
                     for (int m = oM; m < oM+nM; m++) {
@@ -1718,19 +1775,18 @@ void DFJKGrad::compute_hessian()
                         }
                     }
                 }
-                // c[A] = (A|mn) D[m][n]
-                C_DGEMV('N', np, nso*(ULI)nso, 1.0, Amnp[0], nso*(ULI)nso, Dtp[0], 1, 0.0, cp, 1);
-                // (A|mj) = (A|mn) C[n][j]
-                C_DGEMM('N','N',np*(ULI)nso,na,nso,1.0,Amnp[0],nso,Cap[0],na,0.0,Amip[0],na);
-                // (A|ij) = (A|mj) C[m][i]
-                #pragma omp parallel for
-                for (int p = 0; p < np; p++) {
-                    C_DGEMM('T','N',na,na,nso,1.0,Amip[p],na,Cap[0],na,0.0,&Aijp[0][p * (ULI) na * na],na);
-                }
-
             }
         }
     }
+    // c[A] = (A|mn) D[m][n]
+    C_DGEMV('N', np, nso*(ULI)nso, 1.0, Amnp[0], nso*(ULI)nso, Dtp[0], 1, 0.0, cp, 1);
+    // (A|mj) = (A|mn) C[n][j]
+    C_DGEMM('N','N',np*(ULI)nso,na,nso,1.0,Amnp[0],nso,Cap[0],na,0.0,Amip[0],na);
+    // (A|ij) = (A|mj) C[m][i]
+    #pragma omp parallel for
+    for (int p = 0; p < np; p++) {
+        C_DGEMM('T','N',na,na,nso,1.0,Amip[p],na,Cap[0],na,0.0,&Aijp[0][p * (ULI) na * na],na);
+    }
 
     // d[A] = Minv[A][B] c[B]
     C_DGEMV('n', np, np, 1.0, PQp[0], np, cp, 1, 0.0, dp, 1);
@@ -1746,12 +1802,30 @@ void DFJKGrad::compute_hessian()
     // D[A][B] = B[A][ij] B[B][ij]
     C_DGEMM('n','t', np, np, na*na, 1.0, Bijp[0], na*na, Bijp[0], na*na, 0.0, DPQp[0], np);
 
+    // max |d[A]| per auxiliary shell, for screening the second derivative blocks
+    for (int P = 0; P < nauxshell; ++P){
+        int nP = auxiliary_->shell(P).nfunction();
+        int oP = auxiliary_->shell(P).function_index();
+        dmax[P] = 0.0;
+        for (int p = oP; p < oP+nP; p++) {
+            dmax[P] = std::max(dmax[P], std::fabs(dp[p]));
+        }
+    }
+
     int maxp = auxiliary_->max_function_per_shell();
     int maxm = primary_->max_function_per_shell();
-    SharedMatrix T(new Matrix("T", maxp, maxm*na));
-    double **Tp = T->pointer();
+    std::vector<SharedMatrix> T;
+    for (int t = 0; t < nthread; t++) {
+        T.push_back(SharedMatrix(new Matrix("T", maxp, maxm*na)));
+    }
 
+#pragma omp parallel for schedule(dynamic) num_threads(nthread)
     for (int P = 0; P < nauxshell; ++P){
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        double **Tp = T[thread]->pointer();
         int nP = auxiliary_->shell(P).nfunction();
         int oP = auxiliary_->shell(P).function_index();
         int Pcenter = auxiliary_->shell(P).ncenter();
@@ -1768,6 +1842,7 @@ void DFJKGrad::compute_hessian()
             int my = 3 * Mcenter + 1;
             int mz = 3 * Mcenter + 2;
             for(int N = 0; N < nshell; ++N){
+                if (!significant[M * (size_t) nshell + N]) continue;
                 int nN = primary_->shell(N).nfunction();
                 int oN = primary_->shell(N).function_index();
                 int Ncenter = primary_->shell(N).ncenter();
@@ -1778,8 +1853,8 @@ void DFJKGrad::compute_hessian()
 
                 size_t stride = Pncart * Mncart * Nncart;
 
-                Pmnint->compute_shell_deriv1(P,0,M,N);
-                const double* buffer = Pmnint->buffer();
+                Pmnint[thread]->compute_shell_deriv1(P,0,M,N);
+                const double* buffer = Pmnint[thread]->buffer();
 
                 size_t delta = 0L;
                 // Terms for J intermediates
@@ -1810,39 +1885,30 @@ void DFJKGrad::compute_hessian()
                 // dAij[x][p,i,j] <- C[m][i] T[p][m,j]
                 double *ptr = const_cast<double*>(buffer);
                 C_DGEMM('n', 'n', nP*nM, na, nN, 1.0, ptr+0*stride, nN, Cap[oN], na, 0.0, Tp[0], na);
-                #pragma omp parallel for
                 for(int p = 0; p < nP; ++p)
                     C_DGEMM('t', 'n', na, na, nM, 1.0, Cap[oM], na, Tp[0]+p*(nM*na), na, 1.0, &dAijp[Px][(p+oP)*na*na], na);
                 C_DGEMM('n', 'n', nP*nM, na, nN, 1.0, ptr+1*stride, nN, Cap[oN], na, 0.0, Tp[0], na);
-                #pragma omp parallel for
                 for(int p = 0; p < nP; ++p)
                     C_DGEMM('t', 'n', na, na, nM, 1.0, Cap[oM], na, Tp[0]+p*(nM*na), na, 1.0, &dAijp[Py][(p+oP)*na*na], na);
                 C_DGEMM('n', 'n', nP*nM, na, nN, 1.0, ptr+2*stride, nN, Cap[oN], na, 0.0, Tp[0], na);
-                #pragma omp parallel for
                 for(int p = 0; p < nP; ++p)
                     C_DGEMM('t', 'n', na, na, nM, 1.0, Cap[oM], na, Tp[0]+p*(nM*na), na, 1.0, &dAijp[Pz][(p+oP)*na*na], na);
                 C_DGEMM('n', 'n', nP*nM, na, nN, 1.0, ptr+3*stride, nN, Cap[oN], na, 0.0, Tp[0], na);
-                #pragma omp parallel for
                 for(int p = 0; p < nP; ++p)
                     C_DGEMM('t', 'n', na, na, nM, 1.0, Cap[oM], na, Tp[0]+p*(nM*na), na, 1.0, &dAijp[mx][(p+oP)*na*na], na);
                 C_DGEMM('n', 'n', nP*nM, na, nN, 1.0, ptr+4*stride, nN, Cap[oN], na, 0.0, Tp[0], na);
-                #pragma omp parallel for
                 for(int p = 0; p < nP; ++p)
                     C_DGEMM('t', 'n', na, na, nM, 1.0, Cap[oM], na, Tp[0]+p*(nM*na), na, 1.0, &dAijp[my][(p+oP)*na*na], na);
                 C_DGEMM('n', 'n', nP*nM, na, nN, 1.0, ptr+5*stride, nN, Cap[oN], na, 0.0, Tp[0], na);
-                #pragma omp parallel for
                 for(int p = 0; p < nP; ++p)
                     C_DGEMM('t', 'n', na, na, nM, 1.0, Cap[oM], na, Tp[0]+p*(nM*na), na, 1.0, &dAijp[mz][(p+oP)*na*na], na);
                 C_DGEMM('n', 'n', nP*nM, na, nN, 1.0, ptr+6*stride, nN, Cap[oN], na, 0.0, Tp[0], na);
-                #pragma omp parallel for
                 for(int p = 0; p < nP; ++p)
                     C_DGEMM('t', 'n', na, na, nM, 1.0, Cap[oM], na, Tp[0]+p*(nM*na), na, 1.0, &dAijp[nx][(p+oP)*na*na], na);
                 C_DGEMM('n', 'n', nP*nM, na, nN, 1.0, ptr+7*stride, nN, Cap[oN], na, 0.0, Tp[0], na);
-                #pragma omp parallel for
                 for(int p = 0; p < nP; ++p)
                     C_DGEMM('t', 'n', na, na, nM, 1.0, Cap[oM], na, Tp[0]+p*(nM*na), na, 1.0, &dAijp[ny][(p+oP)*na*na], na);
                 C_DGEMM('n', 'n', nP*nM, na, nN, 1.0, ptr+8*stride, nN, Cap[oN], na, 0.0, Tp[0], na);
-                #pragma omp parallel for
                 for(int p = 0; p < nP; ++p)
                     C_DGEMM('t', 'n', na, na, nM, 1.0, Cap[oM], na, Tp[0]+p*(nM*na), na, 1.0, &dAijp[nz][(p+oP)*na*na], na);
 
@@ -1850,10 +1916,12 @@ void DFJKGrad::compute_hessian()
         }
     }
 
-    // dd[x][A] = dc[x][B] Minv[B][A]
-    C_DGEMM('N', 'N', 3*natoms, np, np, 1.0, dcp[0], np, PQp[0], np, 0.0, ddp[0], np);
-
+#pragma omp parallel for schedule(dynamic) num_threads(nthread)
     for (int P = 0; P < nauxshell; ++P){
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
         int nP = auxiliary_->shell(P).nfunction();
         int oP = auxiliary_->shell(P).function_index();
         int Pcenter = auxiliary_->shell(P).ncenter();
@@ -1872,39 +1940,46 @@ void DFJKGrad::compute_hessian()
 
             size_t stride = Pncart * Qncart;
 
-            PQint->compute_shell_deriv1(P,0,Q,0);
-            const double* buffer = PQint->buffer();
+            PQint[thread]->compute_shell_deriv1(P,0,Q,0);
+            const double* buffer = PQint[thread]->buffer();
 
             size_t delta = 0L;
             // J term intermediates
-            // de[x][A] = (A|B)^x d[B]
+            // dc[x][A] -= (A|B)^x d[B]
             for (int p = oP; p < oP+nP; p++) {
                 for (int q = oQ; q < oQ+nQ; q++) {
                     double dq = dp[q];
-                    dep[Px][p] += dq * buffer[0 * stride + delta];
-                    dep[Py][p] += dq * buffer[1 * stride + delta];
-                    dep[Pz][p] += dq * buffer[2 * stride + delta];
-                    dep[Qx][p] += dq * buffer[3 * stride + delta];
-                    dep[Qy][p] += dq * buffer[4 * stride + delta];
-                    dep[Qz][p] += dq * buffer[5 * stride + delta];
+                    dcp[Px][p] -= dq * buffer[0 * stride + delta];
+                    dcp[Py][p] -= dq * buffer[1 * stride + delta];
+                    dcp[Pz][p] -= dq * buffer[2 * stride + delta];
+                    dcp[Qx][p] -= dq * buffer[3 * stride + delta];
+                    dcp[Qy][p] -= dq * buffer[4 * stride + delta];
+                    dcp[Qz][p] -= dq * buffer[5 * stride + delta];
                     ++delta;
                 }
             }
             // K term intermediates
-            // deij[x][A,i,j] <- (A|B)^x Bij[B,i,j]
+            // dAij[x][A,i,j] -= (A|B)^x Bij[B,i,j]
             double *ptr = const_cast<double*>(buffer);
-            C_DGEMM('n', 'n', nP, na*na, nQ, 1.0, ptr+0*stride, nQ, Bijp[oQ], na*na, 1.0, &deijp[Px][oP*na*na], na*na);
-            C_DGEMM('n', 'n', nP, na*na, nQ, 1.0, ptr+1*stride, nQ, Bijp[oQ], na*na, 1.0, &deijp[Py][oP*na*na], na*na);
-            C_DGEMM('n', 'n', nP, na*na, nQ, 1.0, ptr+2*stride, nQ, Bijp[oQ], na*na, 1.0, &deijp[Pz][oP*na*na], na*na);
-            C_DGEMM('n', 'n', nP, na*na, nQ, 1.0, ptr+3*stride, nQ, Bijp[oQ], na*na, 1.0, &deijp[Qx][oP*na*na], na*na);
-            C_DGEMM('n', 'n', nP, na*na, nQ, 1.0, ptr+4*stride, nQ, Bijp[oQ], na*na, 1.0, &deijp[Qy][oP*na*na], na*na);
-            C_DGEMM('n', 'n', nP, na*na, nQ, 1.0, ptr+5*stride, nQ, Bijp[oQ], na*na, 1.0, &deijp[Qz][oP*na*na], na*na);
+            C_DGEMM('n', 'n', nP, na*na, nQ, -1.0, ptr+0*stride, nQ, Bijp[oQ], na*na, 1.0, &dAijp[Px][oP*na*na], na*na);
+            C_DGEMM('n', 'n', nP, na*na, nQ, -1.0, ptr+1*stride, nQ, Bijp[oQ], na*na, 1.0, &dAijp[Py][oP*na*na], na*na);
+            C_DGEMM('n', 'n', nP, na*na, nQ, -1.0, ptr+2*stride, nQ, Bijp[oQ], na*na, 1.0, &dAijp[Pz][oP*na*na], na*na);
+            C_DGEMM('n', 'n', nP, na*na, nQ, -1.0, ptr+3*stride, nQ, Bijp[oQ], na*na, 1.0, &dAijp[Qx][oP*na*na], na*na);
+            C_DGEMM('n', 'n', nP, na*na, nQ, -1.0, ptr+4*stride, nQ, Bijp[oQ], na*na, 1.0, &dAijp[Qy][oP*na*na], na*na);
+            C_DGEMM('n', 'n', nP, na*na, nQ, -1.0, ptr+5*stride, nQ, Bijp[oQ], na*na, 1.0, &dAijp[Qz][oP*na*na], na*na);
 
         }
     }
 
 
+#pragma omp parallel for schedule(dynamic) num_threads(nthread)
     for (int P = 0; P < nauxshell; ++P){
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        double **JHessp = JHess[thread]->pointer();
+        double **KHessp = KHess[thread]->pointer();
         int nP = auxiliary_->shell(P).nfunction();
         int oP = auxiliary_->shell(P).function_index();
         int Pcenter = auxiliary_->shell(P).ncenter();
@@ -1929,10 +2004,29 @@ void DFJKGrad::compute_hessian()
                 int ny = 3 * Ncenter + 1;
                 int nz = 3 * Ncenter + 2;
 
+                if (!significant[M * (size_t) nshell + N]) continue;
+
+                // Skip blocks whose J and K weights are both negligible
+                double Dmax = 0.0;
+                for (int m = oM; m < oM+nM; m++) {
+                    for (int n = oN; n < oN+nN; n++) {
+                        Dmax = std::max(Dmax, std::fabs(Dtp[m][n]));
+                    }
+                }
+                double Bmax = 0.0;
+                for (int p = oP; p < oP+nP; p++) {
+                    for (int m = oM; m < oM+nM; m++) {
+                        for (int n = oN; n < oN+nN; n++) {
+                            Bmax = std::max(Bmax, std::fabs(Bmnp[p][m*nso+n]));
+                        }
+                    }
+                }
+                if (2.0 * std::max(dmax[P] * Dmax, Bmax) < cutoff_) continue;
+
                 size_t stride = Pncart * Mncart * Nncart;
 
-                Pmnint->compute_shell_deriv2(P,0,M,N);
-                const double* buffer = Pmnint->buffer();
+                Pmnint[thread]->compute_shell_deriv2(P,0,M,N);
+                const double* buffer = Pmnint[thread]->buffer();
 
                 double Pmscale = Pcenter == Mcenter ? 2.0 : 1.0;
                 double Pnscale = Pcenter == Ncenter ? 2.0 : 1.0;
@@ -2156,7 +2250,14 @@ void DFJKGrad::compute_hessian()
         }
     }
 
+#pragma omp parallel for schedule(dynamic) num_threads(nthread)
     for (int P = 0; P < nauxshell; ++P){
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        double **JHessp = JHess[thread]->pointer();
+        double **KHessp = KHess[thread]->pointer();
         int nP = auxiliary_->shell(P).nfunction();
         int oP = auxiliary_->shell(P).function_index();
         int Pcenter = auxiliary_->shell(P).ncenter();
@@ -2175,8 +2276,8 @@ void DFJKGrad::compute_hessian()
 
             size_t stride = Pncart * Qncart;
 
-            PQint->compute_shell_deriv2(P,0,Q,0);
-            const double* buffer = PQint->buffer();
+            PQint[thread]->compute_shell_deriv2(P,0,Q,0);
+            const double* buffer = PQint[thread]->buffer();
 
             double PQscale = Pcenter == Qcenter ? 2.0 : 1.0;
 
@@ -2293,6 +2394,11 @@ void DFJKGrad::compute_hessian()
     }
 
 
+    for (int t = 0; t < nthread; t++) {
+        hessians_["Coulomb"]->add(JHess[t]);
+        hessians_["Exchange"]->add(KHess[t]);
+    }
+
     // Add permutational symmetry components missing from the above
     for(int i = 0; i < 3*natoms; ++i){
         for(int j = 0; j < i; ++j){
@@ -2301,33 +2407,24 @@ void DFJKGrad::compute_hessian()
         }
     }
 
-
-    // Stitch all the intermediates together to form the actual Hessian contributions
+    // Stitch the first derivative intermediates together: H[x][y] += 2 W[x] Minv W[y]
     SharedMatrix tmp(new Matrix("Tmp [P][i,j]", np, na*na));
     double **ptmp = tmp->pointer();
 
-    for(int x = 0; x < 3*natoms; ++x){
-        for(int y = 0; y < 3*natoms; ++y){
-            // J terms
-            JHessp[x][y] += 2.0*C_DDOT(np, ddp[x], 1, dcp[y], 1);
-            JHessp[x][y] -= 4.0*C_DDOT(np, ddp[x], 1, dep[y], 1);
-            C_DGEMV('n', np, np, 1.0, PQp[0], np, dep[y], 1, 0.0, ptmp[0], 1);
-            JHessp[x][y] += 2.0*C_DDOT(np, dep[x], 1, ptmp[0], 1);
+    // J terms, tmp[x][B] = dc[x][A] Minv[A][B]
+    SharedMatrix dcM(new Matrix("dc Minv", 3*natoms, np));
+    double **dcMp = dcM->pointer();
+    C_DGEMM('N', 'N', 3*natoms, np, np, 1.0, dcp[0], np, PQp[0], np, 0.0, dcMp[0], np);
+    C_DGEMM('N', 'T', 3*natoms, 3*natoms, np, 2.0, dcMp[0], np, dcp[0], np, 1.0, JHessp[0], 3*natoms);
 
-            // K terms
-            C_DGEMM('n', 'n', np, na*na, np,  1.0, PQp[0], np, dAijp[y], na*na, 0.0, ptmp[0], na*na);
-            KHessp[x][y] += 2.0*C_DDOT(np*na*na, dAijp[x], 1, ptmp[0], 1);
-            C_DGEMM('n', 'n', np, na*na, np,  1.0, PQp[0], np, deijp[y], na*na, 0.0, ptmp[0], na*na);
-            KHessp[x][y] -= 4.0*C_DDOT(np*na*na, dAijp[x], 1, ptmp[0], 1);
-            KHessp[x][y] += 2.0*C_DDOT(np*na*na, deijp[x], 1, ptmp[0], 1);
-        }
+    // K terms, one Minv contraction per perturbation
+    for(int y = 0; y < 3*natoms; ++y){
+        C_DGEMM('n', 'n', np, na*na, np,  1.0, PQp[0], np, dAijp[y], na*na, 0.0, ptmp[0], na*na);
+        C_DGEMV('n', 3*natoms, np*(ULI)na*na, 2.0, dAijp[0], np*(ULI)na*na, ptmp[0], 1, 1.0, &KHessp[0][y], 3*natoms);
     }
-
-    // Make sure the newly added components are symmetric
-    for(int i = 0; i < 3*natoms; ++i){
-        for(int j = 0; j < i; ++j){
-            JHessp[i][j] = JHessp[j][i] = 0.5*(JHessp[i][j] + JHessp[j][i]);
-            KHessp[i][j] = KHessp[j][i] = 0.5*(KHessp[i][j] + KHessp[j][i]);
+    for(int x = 0; x < 3*natoms; ++x){
+        for(int y = 0; y < x; ++y){
+            KHessp[x][y] = KHessp[y][x] = 0.5*(KHessp[x][y] + KHessp[y][x]);
         }
     }
 
@@ -2434,6 +2531,12 @@ std::map<std::string, std::shared_ptr<Matrix> > DirectJKGrad::compute1(std::vect
     double** Dap = Da_->pointer();
     double** Dbp = Db_->pointer();
 
+    // A quartet enters through D[P][Q] D[R][S] (J) and D[P][R] D[Q][S], D[P][S] D[Q][R] (K)
+    SharedMatrix Jmax = shell_block_max(primary_, Dt_, Dt_);
+    SharedMatrix Kmax = shell_block_max(primary_, Da_, Db_);
+    double** Jmaxp = Jmax->pointer();
+    double** Kmaxp = Kmax->pointer();
+
 #pragma omp parallel for num_threads(nthreads) schedule(dynamic)
     for (size_t index = 0L; index < npairs2; index++) {
 
@@ -2449,6 +2552,10 @@ std::map<std::string, std::shared_ptr<Matrix> > DirectJKGrad::compute1(std::vect
 
         if (!sieve_->shell_significant(P,Q,R,S)) continue;
 
+        double Dbound = std::max(Jmaxp[P][Q] * Jmaxp[R][S],
+                        std::max(Kmaxp[P][R] * Kmaxp[Q][S], Kmaxp[P][S] * Kmaxp[Q][R]));
+        if (Dbound * std::sqrt(sieve_->shell_ceiling2(P,Q,R,S)) < cutoff_) continue;
+
         //outfile->Printf("(%d,%d,%d,%d)\n", P,Q,R,S);
 
         int thread = 0;
@@ -2683,6 +2790,12 @@ std::map<std::string, std::shared_ptr<Matrix> > DirectJKGrad::compute2(std::vect
     double** Dap = Da_->pointer();
     double** Dbp = Db_->pointer();
 
+    // A quartet enters through D[P][Q] D[R][S] (J) and D[P][R] D[Q][S], D[P][S] D[Q][R] (K)
+    SharedMatrix Jmax = shell_block_max(primary_, Dt_, Dt_);
+    SharedMatrix Kmax = shell_block_max(primary_, Da_, Db_);
+    double** Jmaxp = Jmax->pointer();
+    double** Kmaxp = Kmax->pointer();
+
 #pragma omp parallel for num_threads(nthreads) schedule(dynamic)
     for (size_t index = 0L; index < npairs2; index++) {
 
@@ -2698,6 +2811,10 @@ std::map<std::string, std::shared_ptr<Matrix> > DirectJKGrad::compute2(std::vect
 
         if (!sieve_->shell_significant(P,Q,R,S)) continue;
 
+        double Dbound = std::max(Jmaxp[P][Q] * Jmaxp[R][S],
+                        std::max(Kmaxp[P][R] * Kmaxp[Q][S], Kmaxp[P][S] * Kmaxp[Q][R]));
+        if (Dbound * std::sqrt(sieve_->shell_ceiling2(P,Q,R,S)) < cutoff_) continue;
+
         int thread = 0;
 #ifdef _OPENMP
         thread = omp_get_thread_num();
@@ -0,0 +1,496 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2016 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include <cstdio>
+#include <cmath>
+#include <vector>
+
+#include "psi4/libqt/qt.h"
+#include "psi4/libmints/basisset.h"
+#include "psi4/libmints/matrix.h"
+#include "psi4/libmints/vector.h"
+#include "psi4/libmints/molecule.h"
+#include "psi4/libfock/cubature.h"
+#include "psi4/libfock/points.h"
+#include "psi4/libthce/thce.h"
+#include "psi4/libthce/lreri.h"
+#include "psi4/psi4-dec.h"
+#include "thcmp2.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace psi {
+namespace thcmp2 {
+
+RTHCMP2::RTHCMP2(SharedWavefunction ref_wfn, Options& options) :
+    RTHCEW(ref_wfn, options)
+{
+    common_init();
+}
+RTHCMP2::~RTHCMP2()
+{
+}
+void RTHCMP2::common_init()
+{
+    name_ = "THC-MP2";
+
+    doubles_ = (size_t)(0.9 * memory_ / 8L);
+    delta_ = options_.get_double("THC_LAPLACE_DELTA");
+    same_spin_ = options_.get_bool("THC_SAME_SPIN");
+    oss_ = options_.get_double("MP2_OS_SCALE");
+    sss_ = options_.get_double("MP2_SS_SCALE");
+    sos_ = options_.get_double("MP2_SOS_SCALE");
+
+    energies_["Reference Energy"] = reference_wavefunction_->reference_energy();
+    energies_["Opposite-Spin Energy"] = 0.0;
+    energies_["Same-Spin Energy"] = 0.0;
+
+    ribasis_ = BasisSet::pyconstruct_auxiliary(molecule_,
+        "DF_BASIS_MP2", options_.get_str("DF_BASIS_MP2"),
+        "RIFIT", options_.get_str("BASIS"));
+}
+double RTHCMP2::compute_energy()
+{
+    print_header();
+    timer_on("THCMP2 Factors");
+    form_factors();
+    timer_off("THCMP2 Factors");
+    timer_on("THCMP2 Energy");
+    form_energy();
+    timer_off("THCMP2 Energy");
+    print_energies();
+
+    return (same_spin_ ? energies_["Total Energy"] : energies_["SOS Total Energy"]);
+}
+void RTHCMP2::print_header()
+{
+    int nthread = 1;
+    #ifdef _OPENMP
+        nthread = omp_get_max_threads();
+    #endif
+
+    outfile->Printf( "\t --------------------------------------------------------\n");
+    outfile->Printf( "\t                         THC-MP2                         \n");
+    outfile->Printf( "\t  2nd-Order Tensor-Hypercontracted Moller-Plesset Theory \n");
+    outfile->Printf( "\t              RMP2 Wavefunction, %3d Threads             \n", nthread);
+    outfile->Printf( "\t --------------------------------------------------------\n");
+    outfile->Printf( "\n");
+
+    if (print_ >= 1) {
+        outfile->Printf( "   => Auxiliary Basis Set <=\n\n");
+        ribasis_->print_by_level("outfile", print_);
+    }
+
+    outfile->Printf( "\t --------------------------------------------------------\n");
+    outfile->Printf( "\t                 NBF = %5d, NAUX = %5d\n", basisset_->nbf(), ribasis_->nbf());
+    outfile->Printf( "\t --------------------------------------------------------\n");
+    outfile->Printf( "\t %7s %7s %7s %7s %7s %7s %7s\n", "CLASS", "FOCC", "OCC", "AOCC", "AVIR", "VIR", "FVIR");
+    outfile->Printf( "\t %7s %7d %7d %7d %7d %7d %7d\n", "PAIRS",
+        thce_->dimensions()["nfocc"], thce_->dimensions()["nocc"], thce_->dimensions()["naocc"],
+        thce_->dimensions()["navir"], thce_->dimensions()["nvir"], thce_->dimensions()["nfvir"]);
+    outfile->Printf( "\t --------------------------------------------------------\n\n");
+
+    outfile->Printf( "   => THC Parameters <=\n\n");
+    outfile->Printf( "    Same-Spin Energy   = %11s\n", (same_spin_ ? "Yes" : "No"));
+    outfile->Printf( "    Laplace Delta      = %11.3E\n", delta_);
+    outfile->Printf( "    Memory (MB)        = %11zu\n", doubles_ * 8L / (1024L * 1024L));
+    outfile->Printf( "\n");
+}
+std::shared_ptr<Matrix> RTHCMP2::build_collocation()
+{
+    // The THC grid is a DFTGrid, sized by THC_RADIAL_POINTS and THC_SPHERICAL_POINTS
+    // so that it does not follow the much finer SCF grid
+    std::map<std::string, int> grid_opts;
+    grid_opts["DFT_RADIAL_POINTS"] = options_.get_int("THC_RADIAL_POINTS");
+    grid_opts["DFT_SPHERICAL_POINTS"] = options_.get_int("THC_SPHERICAL_POINTS");
+    std::shared_ptr<DFTGrid> grid(new DFTGrid(molecule_, basisset_, grid_opts, options_));
+    int npoints = grid->npoints();
+    int nbf = basisset_->nbf();
+    int max_points = grid->max_points();
+    int max_functions = grid->max_functions();
+
+    // Raw collocation, as LS-THC absorbs any column scaling into Z
+    std::shared_ptr<Matrix> X(new Matrix("X", nbf, npoints));
+    double** Xp = X->pointer();
+
+    std::shared_ptr<BasisFunctions> points(new BasisFunctions(basisset_, max_points, max_functions));
+    const std::vector<std::shared_ptr<BlockOPoints> >& blocks = grid->blocks();
+    int offset = 0;
+    for (int index = 0; index < blocks.size(); index++) {
+        points->compute_functions(blocks[index]);
+        SharedMatrix phi = points->basis_value("PHI");
+        double** phip = phi->pointer();
+        const std::vector<int>& funmap = blocks[index]->functions_local_to_global();
+        int nP = blocks[index]->npoints();
+
+        for (int i = 0; i < funmap.size(); i++) {
+            int iglobal = funmap[i];
+            C_DCOPY(nP,&phip[0][i],max_functions,&Xp[iglobal][offset],1);
+        }
+
+        offset += nP;
+    }
+
+    outfile->Printf( "  THC grid: %d points, %d per atom.\n\n", npoints, npoints / molecule_->natom());
+
+    return X;
+}
+void RTHCMP2::form_factors()
+{
+    // => LS-THC (ia|jb): Xi, Xa, Ziaia [swapped] <= //
+
+    std::shared_ptr<Matrix> X = build_collocation();
+    build_lsthc_ia(ribasis_, X);
+    X.reset();
+
+    // The fitting intermediates are not needed past Z
+    thce_->delete_tensor("Lia");
+    thce_->delete_tensor("Sia");
+
+    // => Laplace: pi_i, pi_a <= //
+
+    build_laplace(delta_);
+
+    if (print_ > 1) {
+        thce_->print();
+    }
+}
+void RTHCMP2::form_OV(int w, double** Op, double** Vp, double** Tip, double** Tap)
+{
+    int naocc = thce_->dimensions()["naocc"];
+    int navir = thce_->dimensions()["navir"];
+    int nP = thce_->dimensions()["ngrid"];
+
+    double* Xip = (*thce_)["Xi"]->pointer();
+    double* Xap = (*thce_)["Xa"]->pointer();
+    double* pip = (*thce_)["pi_i"]->pointer() + w * (size_t) naocc;
+    double* pap = (*thce_)["pi_a"]->pointer() + w * (size_t) navir;
+
+    // O_PQ = X_i^P tau_i X_i^Q, V_PQ = X_a^P tau_a X_a^Q
+    for (int i = 0; i < naocc; i++) {
+        C_DCOPY(nP,Xip + i * (size_t) nP,1,Tip[i],1);
+        C_DSCAL(nP,pip[i],Tip[i],1);
+    }
+    for (int a = 0; a < navir; a++) {
+        C_DCOPY(nP,Xap + a * (size_t) nP,1,Tap[a],1);
+        C_DSCAL(nP,pap[a],Tap[a],1);
+    }
+
+    C_DGEMM('T','N',nP,nP,naocc,1.0,Xip,nP,Tip[0],nP,0.0,Op[0],nP);
+    C_DGEMM('T','N',nP,nP,navir,1.0,Xap,nP,Tap[0],nP,0.0,Vp[0],nP);
+}
+double RTHCMP2::form_J_core(double** Zp, double** Ap, double** T1p, double** T2p)
+{
+    int nP = thce_->dimensions()["ngrid"];
+
+    C_DGEMM('N','N',nP,nP,nP,1.0,Ap[0],nP,Zp[0],nP,0.0,T1p[0],nP);
+    C_DGEMM('N','N',nP,nP,nP,1.0,T1p[0],nP,Ap[0],nP,0.0,T2p[0],nP);
+
+    return C_DDOT(nP * (size_t) nP,Zp[0],1,T2p[0],1);
+}
+double RTHCMP2::form_J_disk(FILE* Zf, int max_rows, double** Ap, double** T1p, double** Zbp, double** T2bp)
+{
+    int nP = thce_->dimensions()["ngrid"];
+
+    // T1 = A Z, accumulated over row blocks of Z
+    fseek(Zf,0L,SEEK_SET);
+    for (int Pstart = 0; Pstart < nP; Pstart += max_rows) {
+        int nPblock = (Pstart + max_rows >= nP ? nP - Pstart : max_rows);
+        size_t statusvalue=fread(Zbp[0],sizeof(double),nPblock * (size_t) nP,Zf);
+        C_DGEMM('N','N',nP,nP,nPblock,1.0,&Ap[0][Pstart],nP,Zbp[0],nP,(Pstart == 0 ? 0.0 : 1.0),T1p[0],nP);
+    }
+
+    // J = Z . (T1 A), a row block at a time
+    double J = 0.0;
+    fseek(Zf,0L,SEEK_SET);
+    for (int Pstart = 0; Pstart < nP; Pstart += max_rows) {
+        int nPblock = (Pstart + max_rows >= nP ? nP - Pstart : max_rows);
+        size_t statusvalue=fread(Zbp[0],sizeof(double),nPblock * (size_t) nP,Zf);
+        C_DGEMM('N','N',nPblock,nP,nP,1.0,T1p[Pstart],nP,Ap[0],nP,0.0,T2bp[0],nP);
+        J += C_DDOT(nPblock * (size_t) nP,Zbp[0],1,T2bp[0],1);
+    }
+    fseek(Zf,0L,SEEK_SET);
+
+    return J;
+}
+double RTHCMP2::form_K(double** Zp, double** Op, double** Vp, std::vector<std::shared_ptr<Matrix> >& Fs,
+                       std::vector<std::shared_ptr<Matrix> >& Hs, std::vector<std::shared_ptr<Matrix> >& FHs)
+{
+    int nP = thce_->dimensions()["ngrid"];
+    int nthread = Fs.size();
+
+    // K = \sum_P <F^P H^P, O>, with F^P_QP' = Z_PQ V_QP' and H^P_P'Q' = O_PP' Z_P'Q' V_PQ'
+    double K = 0.0;
+    #pragma omp parallel for schedule(dynamic) num_threads(nthread) reduction(+: K)
+    for (int P = 0; P < nP; P++) {
+
+        int thread = 0;
+        #ifdef _OPENMP
+            thread = omp_get_thread_num();
+        #endif
+
+        double** Fp = Fs[thread]->pointer();
+        double** Hp = Hs[thread]->pointer();
+        double** FHp = FHs[thread]->pointer();
+
+        for (int Q = 0; Q < nP; Q++) {
+            C_DCOPY(nP,Vp[Q],1,Fp[Q],1);
+            C_DSCAL(nP,Zp[P][Q],Fp[Q],1);
+        }
+        for (int P2 = 0; P2 < nP; P2++) {
+            double OPP2 = Op[P][P2];
+            double* Z2p = Zp[P2];
+            double* H2p = Hp[P2];
+            double* VPp = Vp[P];
+            for (int Q2 = 0; Q2 < nP; Q2++) {
+                H2p[Q2] = OPP2 * Z2p[Q2] * VPp[Q2];
+            }
+        }
+
+        C_DGEMM('N','N',nP,nP,nP,1.0,Fp[0],nP,Hp[0],nP,0.0,FHp[0],nP);
+        K += C_DDOT(nP * (size_t) nP,FHp[0],1,Op[0],1);
+    }
+
+    return K;
+}
+void RTHCMP2::form_energy()
+{
+    int naocc = thce_->dimensions()["naocc"];
+    int navir = thce_->dimensions()["navir"];
+    int nP = thce_->dimensions()["ngrid"];
+    int nw = thce_->dimensions()["nw"];
+
+    long int nP2 = nP * (long int) nP;
+
+    int nthread = 1;
+    #ifdef _OPENMP
+        nthread = omp_get_max_threads();
+    #endif
+
+    // => Memory Plan <= //
+
+    // Xi, Xa and their scaled copies Ti, Ta, and the Laplace factors
+    long int rem = (long int) doubles_ - 2L * (naocc + navir) * (long int) nP - nw * (long int) (naocc + navir);
+    if (rem < 0L) rem = 0L;
+
+    // Z, O (-> A), V (-> T1), T2
+    bool core = (rem >= 4L * nP2);
+
+    // Z, O, V, and F, H, FH per thread for the exchange
+    int nthread_K = 0;
+    if (same_spin_) {
+        long int rem_K = rem - 3L * nP2;
+        nthread_K = (rem_K > 0L ? rem_K / (3L * nP2) : 0);
+        nthread_K = (nthread_K > nthread ? nthread : nthread_K);
+        if (nthread_K < 1) {
+            throw PSIEXCEPTION("THCMP2: Too little memory for the same-spin exchange, which needs 6 ngrid^2 doubles.");
+        }
+        core = true;
+    }
+
+    // O (-> A), V (-> T1), and row blocks of Z and T2 otherwise
+    int max_rows = nP;
+    if (!core) {
+        max_rows = (rem - 2L * nP2) / (2L * nP);
+        max_rows = (max_rows > nP ? nP : max_rows);
+        if (max_rows < 1) {
+            throw PSIEXCEPTION("THCMP2: Too little memory, the opposite-spin energy needs 2 ngrid^2 doubles.");
+        }
+    }
+
+    outfile->Printf( "  ==> Laplace-THC Energy <==\n\n");
+    outfile->Printf( "    Grid Points        = %11d\n", nP);
+    outfile->Printf( "    Laplace Points     = %11d\n", nw);
+    outfile->Printf( "    Z Algorithm        = %11s\n", (core ? "Core" : "Disk"));
+    if (!core) {
+        outfile->Printf( "    Z Rows per Block   = %11d\n", max_rows);
+    }
+    if (same_spin_) {
+        outfile->Printf( "    Exchange Threads   = %11d\n", nthread_K);
+    }
+    outfile->Printf( "\n");
+
+    // => Tensors <= //
+
+    std::shared_ptr<Tensor> Z = (*thce_)["Ziaia"];
+    if (core) {
+        Z->swap_in();
+    } else if (!Z->swapped()) {
+        Z->swap_out();
+    }
+
+    std::shared_ptr<Matrix> Ti(new Matrix("Ti", naocc, nP));
+    std::shared_ptr<Matrix> Ta(new Matrix("Ta", navir, nP));
+    std::shared_ptr<Matrix> O(new Matrix("O", nP, nP));
+    std::shared_ptr<Matrix> V(new Matrix("V", nP, nP));
+    double** Tip = Ti->pointer();
+    double** Tap = Ta->pointer();
+    double** Op = O->pointer();
+    double** Vp = V->pointer();
+
+    std::shared_ptr<Matrix> T2(new Matrix("T2", (core ? nP : max_rows), nP));
+    std::shared_ptr<Matrix> Zb;
+    double** T2p = T2->pointer();
+    double** Zp = NULL;
+    if (core) {
+        Zp = new double*[nP];
+        for (int P = 0; P < nP; P++) {
+            Zp[P] = Z->pointer() + P * (size_t) nP;
+        }
+    } else {
+        Zb = std::shared_ptr<Matrix>(new Matrix("Zb", max_rows, nP));
+    }
+
+    std::vector<std::shared_ptr<Matrix> > Fs;
+    std::vector<std::shared_ptr<Matrix> > Hs;
+    std::vector<std::shared_ptr<Matrix> > FHs;
+    for (int t = 0; t < nthread_K; t++) {
+        Fs.push_back(std::shared_ptr<Matrix>(new Matrix("F", nP, nP)));
+        Hs.push_back(std::shared_ptr<Matrix>(new Matrix("H", nP, nP)));
+        FHs.push_back(std::shared_ptr<Matrix>(new Matrix("FH", nP, nP)));
+    }
+
+    // => Quadrature <= //
+
+    double J = 0.0;
+    double K = 0.0;
+
+    if (print_ > 1) {
+        outfile->Printf( "    %4s %24s %24s\n", "w", "J [Eh]", "K [Eh]");
+    }
+
+    for (int w = 0; w < nw; w++) {
+
+        form_OV(w, Op, Vp, Tip, Tap);
+
+        double Kw = 0.0;
+        if (same_spin_) {
+            Kw = form_K(Zp, Op, Vp, Fs, Hs, FHs);
+        }
+
+        // A = O * V, then V is free
+        double* O2p = Op[0];
+        double* V2p = Vp[0];
+        for (long int PQ = 0L; PQ < nP2; PQ++) {
+            (*O2p++) *= (*V2p++);
+        }
+
+        double Jw;
+        if (core) {
+            Jw = form_J_core(Zp, Op, Vp, T2p);
+        } else {
+            Jw = form_J_disk(Z->file_pointer(), max_rows, Op, Vp, Zb->pointer(), T2p);
+        }
+
+        if (print_ > 1) {
+            outfile->Printf( "    %4d %24.16E %24.16E\n", w + 1, Jw, Kw);
+        }
+
+        J += Jw;
+        K += Kw;
+    }
+    if (print_ > 1) {
+        outfile->Printf( "\n");
+    }
+
+    if (core) {
+        delete[] Zp;
+        Z->swap_out(false);
+    }
+
+    energies_["Opposite-Spin Energy"] = -J;
+    energies_["Same-Spin Energy"] = -(J - K);
+}
+void RTHCMP2::print_energies()
+{
+    energies_["Correlation Energy"] = energies_["Opposite-Spin Energy"] + energies_["Same-Spin Energy"];
+    energies_["Total Energy"] = energies_["Reference Energy"] + energies_["Correlation Energy"];
+
+    energies_["SCS Opposite-Spin Energy"] = oss_*energies_["Opposite-Spin Energy"];
+    energies_["SCS Same-Spin Energy"] = sss_*energies_["Same-Spin Energy"];
+    energies_["SCS Correlation Energy"] = energies_["SCS Opposite-Spin Energy"] + energies_["SCS Same-Spin Energy"];
+    energies_["SCS Total Energy"] = energies_["Reference Energy"] + energies_["SCS Correlation Energy"];
+
+    energies_["SOS Correlation Energy"] = sos_*energies_["Opposite-Spin Energy"];
+    energies_["SOS Total Energy"] = energies_["Reference Energy"] + energies_["SOS Correlation Energy"];
+
+    outfile->Printf( "\t-----------------------------------------------------------\n");
+    outfile->Printf( "\t ==================> THC-MP2 Energies <=================== \n");
+    outfile->Printf( "\t-----------------------------------------------------------\n");
+    outfile->Printf( "\t %-25s = %24.16f [Eh]\n", "Reference Energy",         energies_["Reference Energy"]);
+    if (same_spin_) {
+        outfile->Printf( "\t %-25s = %24.16f [Eh]\n", "Same-Spin Energy",         energies_["Same-Spin Energy"]);
+        outfile->Printf( "\t %-25s = %24.16f [Eh]\n", "Opposite-Spin Energy",     energies_["Opposite-Spin Energy"]);
+        outfile->Printf( "\t %-25s = %24.16f [Eh]\n", "Correlation Energy",       energies_["Correlation Energy"]);
+        outfile->Printf( "\t %-25s = %24.16f [Eh]\n", "Total Energy",             energies_["Total Energy"]);
+        outfile->Printf( "\t-----------------------------------------------------------\n");
+        outfile->Printf( "\t ================> THC-SCS-MP2 Energies <================= \n");
+        outfile->Printf( "\t-----------------------------------------------------------\n");
+        outfile->Printf( "\t %-25s = %24.16f [-]\n", "SCS Same-Spin Scale",      sss_);
+        outfile->Printf( "\t %-25s = %24.16f [-]\n", "SCS Opposite-Spin Scale",  oss_);
+        outfile->Printf( "\t %-25s = %24.16f [Eh]\n", "SCS Same-Spin Energy",     energies_["SCS Same-Spin Energy"]);
+        outfile->Printf( "\t %-25s = %24.16f [Eh]\n", "SCS Opposite-Spin Energy", energies_["SCS Opposite-Spin Energy"]);
+        outfile->Printf( "\t %-25s = %24.16f [Eh]\n", "SCS Correlation Energy",   energies_["SCS Correlation Energy"]);
+        outfile->Printf( "\t %-25s = %24.16f [Eh]\n", "SCS Total Energy",         energies_["SCS Total Energy"]);
+    } else {
+        outfile->Printf( "\t %-25s = %24s [Eh]\n",    "Same-Spin Energy",         "(not computed)");
+        outfile->Printf( "\t %-25s = %24.16f [Eh]\n", "Opposite-Spin Energy",     energies_["Opposite-Spin Energy"]);
+    }
+    outfile->Printf( "\t-----------------------------------------------------------\n");
+    outfile->Printf( "\t ================> THC-SOS-MP2 Energies <================= \n");
+    outfile->Printf( "\t-----------------------------------------------------------\n");
+    outfile->Printf( "\t %-25s = %24.16f [-]\n", "SOS Opposite-Spin Scale",  sos_);
+    outfile->Printf( "\t %-25s = %24.16f [Eh]\n", "SOS Correlation Energy",   energies_["SOS Correlation Energy"]);
+    outfile->Printf( "\t %-25s = %24.16f [Eh]\n", "SOS Total Energy",         energies_["SOS Total Energy"]);
+    outfile->Printf( "\t-----------------------------------------------------------\n");
+    outfile->Printf( "\n");
+
+    Process::environment.globals["MP2 OPPOSITE-SPIN CORRELATION ENERGY"] = energies_["Opposite-Spin Energy"];
+    Process::environment.globals["SOS-MP2 TOTAL ENERGY"] = energies_["SOS Total Energy"];
+    Process::environment.globals["SOS-MP2 CORRELATION ENERGY"] = energies_["SOS Correlation Energy"];
+
+    // Only the SOS energies are complete without the same-spin term
+    if (!same_spin_) {
+        Process::environment.globals["CURRENT ENERGY"] = energies_["SOS Total Energy"];
+        Process::environment.globals["CURRENT CORRELATION ENERGY"] = energies_["SOS Correlation Energy"];
+        energy_ = energies_["SOS Total Energy"];
+        return;
+    }
+
+    Process::environment.globals["CURRENT ENERGY"] = energies_["Total Energy"];
+    Process::environment.globals["CURRENT CORRELATION ENERGY"] = energies_["Correlation Energy"];
+    Process::environment.globals["MP2 TOTAL ENERGY"] = energies_["Total Energy"];
+    Process::environment.globals["MP2 SAME-SPIN CORRELATION ENERGY"] = energies_["Same-Spin Energy"];
+    Process::environment.globals["MP2 CORRELATION ENERGY"] = energies_["Correlation Energy"];
+    Process::environment.globals["SCS-MP2 TOTAL ENERGY"] = energies_["SCS Total Energy"];
+    Process::environment.globals["SCS-MP2 CORRELATION ENERGY"] = energies_["SCS Correlation Energy"];
+    energy_ = energies_["Total Energy"];
+}
+
+}} // End namespaces
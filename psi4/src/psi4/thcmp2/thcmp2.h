@@ -0,0 +1,123 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2016 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#ifndef THCMP2_H
+#define THCMP2_H
+
+#include "psi4/libmints/typedefs.h"
+#include "psi4/libthce/thcew.h"
+#include <map>
+
+namespace psi {
+
+class BasisSet;
+class Options;
+
+namespace thcmp2 {
+
+/**
+ * RTHCMP2: LS-THC MP2 and SOS-MP2 energies for RHF references
+ *
+ * The (ia|jb) integrals are least-squares tensor-hypercontracted,
+ *
+ * (ia|jb) \approx X_i^P X_a^P Z_PQ X_j^Q X_b^Q
+ *
+ * with X collocated on a DFTGrid and Z fitted through DF integrals,
+ * and the denominator is Laplace-factored,
+ *
+ * 1 / (e_a + e_b - e_i - e_j) \approx \sum_w \tau_i^w \tau_j^w \tau_a^w \tau_b^w.
+ *
+ * With O^w_PQ = \tau_i^w X_i^P X_i^Q and V^w_PQ = \tau_a^w X_a^P X_a^Q, the
+ * opposite-spin (Coulomb) energy is an O(N^3) contraction per quadrature point,
+ *
+ * J^w = Z_PQ (O^w * V^w)_PP' Z_P'Q' (O^w * V^w)_Q'Q
+ *
+ * (* the elementwise product), and the same-spin exchange an O(N^4) one,
+ *
+ * K^w = Z_PQ Z_P'Q' O^w_PP' V^w_PQ' O^w_QQ' V^w_QP'.
+ *
+ * Z is streamed from its swap file during the energy if it does not fit in
+ * core next to Xi, Xa, their scaled copies, and the O(N^2) intermediates.
+ * LSTHCERI still forms all of Z in core during the fit, so the fit, not the
+ * energy, sets the memory floor. The exchange is only formed for THC_SAME_SPIN.
+ **/
+class RTHCMP2 : public RTHCEW {
+
+protected:
+
+    /// Auxiliary basis for the LS-THC fitting
+    std::shared_ptr<BasisSet> ribasis_;
+
+    /// Memory in doubles
+    size_t doubles_;
+    /// Laplace quadrature error tolerance
+    double delta_;
+    /// Form the same-spin exchange energy?
+    bool same_spin_;
+    /// SCS-MP2 opposite-spin scale
+    double oss_;
+    /// SCS-MP2 same-spin scale
+    double sss_;
+    /// SOS-MP2 opposite-spin scale
+    double sos_;
+
+    void common_init();
+
+    /// Print the header and sizing
+    void print_header();
+    /// Collocation matrix of the AO basis on the THC grid (nso x ngrid)
+    std::shared_ptr<Matrix> build_collocation();
+    /// Form the LS-THC factors and the Laplace quadrature
+    void form_factors();
+    /// Form the opposite-spin (and, optionally, same-spin) energies
+    void form_energy();
+    /// Print the energies and set the global variables
+    void print_energies();
+
+    /// O^w and V^w for quadrature point w
+    void form_OV(int w, double** Op, double** Vp, double** Tip, double** Tap);
+    /// J^w with Z in core, given A = O^w * V^w (T1 and T2 are scratch)
+    double form_J_core(double** Zp, double** Ap, double** T1p, double** T2p);
+    /// J^w with Z streamed from disk in row blocks (T1 is scratch, Zb and T2b are nPblock x nP)
+    double form_J_disk(FILE* Zf, int max_rows, double** Ap, double** T1p, double** Zbp, double** T2bp);
+    /// K^w with Z in core
+    double form_K(double** Zp, double** Op, double** Vp, std::vector<std::shared_ptr<Matrix> >& Fs,
+                  std::vector<std::shared_ptr<Matrix> >& Hs, std::vector<std::shared_ptr<Matrix> >& FHs);
+
+public:
+
+    RTHCMP2(SharedWavefunction ref_wfn, Options& options);
+    virtual ~RTHCMP2();
+
+    /// Compute the energy, returning the total (SOS-MP2 total if !THC_SAME_SPIN)
+    virtual double compute_energy();
+
+};
+
+}} // End namespaces
+
+#endif
@@ -108,6 +108,7 @@ namespace libfock   { SharedWavefunction   libfock(SharedWavefunction, Options&)
 namespace fnocc     { SharedWavefunction     fnocc(SharedWavefunction, Options&); }
 namespace occwave   { SharedWavefunction   occwave(SharedWavefunction, Options&); }
 namespace mcscf     { SharedWavefunction     mcscf(SharedWavefunction, Options&); }
+namespace thcmp2    { SharedWavefunction    thcmp2(SharedWavefunction, Options&); }
 
 #ifdef USING_gdma
 namespace gdma_interface { SharedWavefunction     gdma_interface(SharedWavefunction, Options&, const std::string &datfilename); }
@@ -385,6 +386,12 @@ SharedWavefunction py_psi_dfmp2(SharedWavefunction ref_wfn)
     return dfmp2::dfmp2(ref_wfn, Process::environment.options);
 }
 
+SharedWavefunction py_psi_thcmp2(SharedWavefunction ref_wfn)
+{
+    py_psi_prepare_options_for_module("THCMP2");
+    return thcmp2::thcmp2(ref_wfn, Process::environment.options);
+}
+
 // double py_psi_dfmp2grad()
 // {
 //     py_psi_prepare_options_for_module("DFMP2");
@@ -1468,6 +1475,7 @@ PyObject * initpsimod(void) {
     psimod.def("dcft", py_psi_dcft, "Runs the density cumulant functional theory code.");
     psimod.def("libfock", py_psi_libfock, "Runs a CPHF calculation, using libfock.");
     psimod.def("dfmp2", py_psi_dfmp2, "Runs the DF-MP2 code.");
+    psimod.def("thcmp2", py_psi_thcmp2, "Runs the LS-THC MP2 and SOS-MP2 code.");
     psimod.def("mcscf", py_psi_mcscf, "Runs the MCSCF code, (N.B. restricted to certain active spaces).");
     psimod.def("mrcc_generate_input", py_psi_mrcc_generate_input, "Generates an input for Kallay's MRCC code.");
     psimod.def("mrcc_load_densities", py_psi_mrcc_load_densities, "Reads in the density matrices from Kallay's MRCC code.");
@@ -179,6 +179,13 @@ int read_options(const std::string &name, Options & options, bool suppress_print
   /*- Algorithm to use for CI computation (e.g., CID or CISD).
   See :ref:`Cross-module Redundancies <table:managedmethods>` for details. -*/
   options.add_str("CI_TYPE", "CONV", "CONV");
+  /*- Do the first half of the conventional integral transformation in
+  core, sorting the half-transformed integrals straight into the layout
+  the second half reads instead of writing them to a scratch file and
+  sorting them back from disk. Falls back to the disk algorithm when an
+  irrep of the half-transformed integrals and its sorted copy don't fit in
+  memory together. !expert -*/
+  options.add_bool("HALF_TRANSFORM_IN_CORE", false);
 
   // CDS-TODO: We should go through and check that the user hasn't done
   // something silly like specify frozen_docc in DETCI but not in TRANSQT.
@@ -307,7 +314,9 @@ int read_options(const std::string &name, Options & options, bool suppress_print
     less core memory. -*/
     options.add_int("ICORE", 1);
 
-    /*- Number of threads for DETCI. -*/
+    /*- Number of threads for the DETCI sigma build, which runs the sigma
+    blocks concurrently for ICORE = 1 and 2. Defaults to the global number of
+    threads. -*/
     options.add_int("CI_NUM_THREADS", 1);
 
     /*- Do print the sigma overlap matrix?  Not generally useful.  !expert -*/
@@ -842,6 +851,12 @@ int read_options(const std::string &name, Options & options, bool suppress_print
     additional thread. -*/
     options.add_bool("AIO_DF_INTS",false);
 
+    /*- Where SAPT0 keeps its DF integrals and scratch files. ``AUTO``
+    keeps them in core when they take at most half of the memory, ``CORE``
+    keeps them in core whenever they fit next to the working arrays, and
+    ``DISK`` always streams them through PSIO files. !expert -*/
+    options.add_str("SAPT0_DF_STORAGE","AUTO","AUTO CORE DISK");
+
     /*- Maximum number of CPHF iterations -*/
     options.add_int("MAXITER",50);
     /*- Do CCD dispersion correction in SAPT2+, SAPT2+(3) or SAPT2+3? !expert -*/
@@ -1193,12 +1208,27 @@ int read_options(const std::string &name, Options & options, bool suppress_print
     /*- Use DF integrals tech to converge the SCF before switching to a conventional tech
         in a |scf__scf_type| ``DIRECT`` calculation -*/
     options.add_bool("DF_SCF_GUESS", true);
+    /*- The |scf__scf_type| values that |scf__df_scf_guess| applies to. If empty,
+        only ``DIRECT`` calculations start with DF iterations. -*/
+    options.add("DF_SCF_GUESS_TYPES", new ArrayType());
+    /*- Orbital gradient RMS at which the |scf__df_scf_guess| iterations hand over to
+        the target |scf__scf_type|. If 0.0, the DF iterations are fully converged first. -*/
+    options.add_double("DF_SCF_GUESS_CONVERGENCE", 0.0);
+    /*- Keep the DIIS subspace of the DF iterations after an early
+        |scf__df_scf_guess| switch (see |scf__df_scf_guess_convergence|) to the
+        target |scf__scf_type|? The subspace is always dropped after fully
+        converged DF iterations. -*/
+    options.add_bool("DF_SCF_GUESS_KEEP_DIIS", false);
     /*- Keep JK object for later use? -*/
     options.add_bool("SAVE_JK", false);
     /*- Memory safety factor for allocating JK -*/
     options.add_double("SCF_MEM_SAFETY_FACTOR",0.75);
     /*- SO orthogonalization: symmetric or canonical? -*/
     options.add_str("S_ORTHOGONALIZATION","SYMMETRIC","SYMMETRIC CANONICAL");
+    /*- LAPACK eigensolver for the Fock matrix. ``AUTO`` opts in to the
+    divide-and-conquer DSYEVD for large irrep blocks, keeping DSYEV for small
+    ones. -*/
+    options.add_str("DIAG_ALGORITHM","DSYEV","AUTO DSYEV DSYEVD DSYEVR");
     /*- Minimum S matrix eigenvalue to be used before compensating for linear
     dependencies. -*/
     options.add_double("S_TOLERANCE",1E-7);
@@ -1222,6 +1252,14 @@ int read_options(const std::string &name, Options & options, bool suppress_print
     /*- If true, then repeat the specified guess procedure for the orbitals every time -
     even during a geometry optimization. -*/
     options.add_bool("GUESS_PERSIST", false);
+    /*- The number of previously converged SCF densities to keep for guess
+    extrapolation across geometries (e.g. optimization steps). Densities are
+    compatible when the basis set, the atoms (in order) and the occupations
+    match. Whenever at least one compatible density is available, the GUESS is
+    replaced by an always-stable predictor extrapolation, which for a single
+    density reuses it directly. The number of densities used is stored in the
+    variable SCF GUESS EXTRAPOLATION ORDER. Zero disables the history. -*/
+    options.add_int("GUESS_EXTRAPOLATION", 0);
 
     /*- Flag to print the molecular orbitals. -*/
     options.add_bool("PRINT_MOS", false);
@@ -1281,6 +1319,13 @@ int read_options(const std::string &name, Options & options, bool suppress_print
     options.add("MOM_OCC", new ArrayType());
     /*- The absolute indices of orbitals to excite to in MOM (+/- for alpha/beta) -*/
     options.add("MOM_VIR", new ArrayType());
+    /*- Do use energy-DIIS (EDIIS) in the early iterations? EDIIS is used alone above
+    |scf__ediis_start| and blended into DIIS down to |scf__ediis_end|. -*/
+    options.add_bool("EDIIS", false);
+    /*- The orbital gradient RMS above which only EDIIS is used. -*/
+    options.add_double("EDIIS_START", 1.0E-1);
+    /*- The orbital gradient RMS below which EDIIS is switched off. -*/
+    options.add_double("EDIIS_END", 1.0E-4);
     /*- Do use second-order SCF convergence methods? -*/
     options.add_bool("SOSCF", false);
     /*- When to start second-order SCF iterations based on gradient RMS. -*/
@@ -1402,6 +1447,12 @@ int read_options(const std::string &name, Options & options, bool suppress_print
     options.add_bool("SAD_FRAC_OCC", false);
     /*- Auxiliary basis for the SAD guess !expert -*/
     options.add_double("SAD_CHOL_TOLERANCE", 1E-7);
+    /*- Do reuse converged atomic densities from the SAD cache file, and add new ones to it?
+    Entries are keyed on the element, basis set, and the SAD options above. The number of
+    unique atoms read from the cache is stored in the SAD CACHE HITS variable. !expert -*/
+    options.add_bool("SAD_CACHE", false);
+    /*- The SAD cache file. Defaults to psi4.sad_cache.dat in the scratch directory. !expert -*/
+    options.add_str_i("SAD_CACHE_FILE", "");
 
     /*- SUBSECTION DFT -*/
 
@@ -1585,6 +1636,14 @@ int read_options(const std::string &name, Options & options, bool suppress_print
     /*- Solver exact diagonal or eigenvalue difference?
     -*/
     options.add_bool("SOLVER_EXACT_DIAGONAL", false);
+    /*- Fraction of memory the DL solvers may spend on subspace vectors before
+    spilling the oldest ones to disk. 0 keeps all vectors in core.
+    -*/
+    options.add_double("SOLVER_MEM_FACTOR", 0.0);
+    /*- DL Solver subspace collapse policy. PER_ROOT scales SOLVER_MIN_SUBSPACE
+    and SOLVER_MAX_SUBSPACE by the number of roots.
+    -*/
+    options.add_str("SOLVER_COLLAPSE", "FIXED", "FIXED PER_ROOT");
 
   }
   // Options of this module not standardized since it's bound for deletion
@@ -1834,6 +1893,19 @@ int read_options(const std::string &name, Options & options, bool suppress_print
     options.add_bool("PR", false);
     /*- Number of components of transition amplitudes printed -*/
     options.add_int("NUM_AMPS_PRINT", 5);
+    /*- Algorithm for the ADC(2) response matrix. ``CONV`` transforms and sorts the
+    four-index integrals into DPD files, ``DF`` builds every sigma vector directly
+    from in-core three-index integrals. -*/
+    options.add_str("ADC_TYPE", "CONV", "CONV DF");
+    /*- Primary basis set -*/
+    options.add_str("BASIS","NONE");
+    /*- Auxiliary basis set for ADC density fitting computations.
+    :ref:`Defaults <apdx:basisFamily>` to a RI basis. -*/
+    options.add_str("DF_BASIS_ADC", "");
+    /*- Minimum absolute value below which integrals are neglected. -*/
+    options.add_double("INTS_TOLERANCE", 1.0E-12);
+    /*- Fitting Condition !expert -*/
+    options.add_double("DF_FITTING_CONDITION", 1.0E-12);
   }
   if(name == "CCHBAR"|| options.read_globals()) {
      /*- MODULEDESCRIPTION Assembles the coupled cluster effective Hamiltonian. Called whenever CC
@@ -1873,8 +1945,11 @@ int read_options(const std::string &name, Options & options, bool suppress_print
     which means that all four-index quantites with up to two virtual-orbital
     indices (e.g., $\langle ij | ab \rangle>$ integrals) may be held in the cache. -*/
     options.add_int("CACHELEVEL",2);
-    /*- The criterion used to retain/release cached data -*/
-    options.add_str("CACHETYPE", "LRU", "LOW LRU");
+    /*- The criterion used to retain/release cached data. ``COST`` evicts
+    the entries that are cheapest to reload, as measured at run time, and
+    besides the quantities selected by |cceom__cachelevel| also admits any
+    quantity that takes at most a sixteenth of the memory. -*/
+    options.add_str("CACHETYPE", "LRU", "LOW LRU COST");
     /*- Number of threads -*/
     options.add_int("CC_NUM_THREADS", 1);
     /*- Type of ABCD algorithm will be used -*/
@@ -2167,8 +2242,13 @@ int read_options(const std::string &name, Options & options, bool suppress_print
     cache used by the libdpd codes. A value of ``LOW`` selects a "low priority"
     scheme in which the deletion of items from the cache is based on
     pre-programmed priorities. A value of LRU selects a "least recently used"
-    scheme in which the oldest item in the cache will be the first one deleted. -*/
-    options.add_str("CACHETYPE", "LOW", "LOW LRU");
+    scheme in which the oldest item in the cache will be the first one deleted.
+    A value of ``COST`` selects a scheme in which the item that is cheapest to
+    bring back (by size, use count, and number of times it has already been
+    re-read from disk) is deleted first, without pre-programmed priorities.
+    ``COST`` also admits to the cache any quantity that takes at most a
+    sixteenth of the memory, on top of those selected by |ccenergy__cachelevel|. -*/
+    options.add_str("CACHETYPE", "LOW", "LOW LRU COST");
     /*- Number of threads -*/
     options.add_int("CC_NUM_THREADS",1);
     /*- Do use DIIS extrapolation to accelerate convergence? -*/
@@ -2251,6 +2331,19 @@ int read_options(const std::string &name, Options & options, bool suppress_print
     options.add_double("MP2_SS_SCALE", 1.0/3.0);
     /*- \% of memory for DF-MP2 three-index buffers -*/
     options.add_double("DFMP2_MEM_FACTOR", 0.9);
+    /*- Algorithm for the DF-MP2 energy. LAPLACE forms the opposite-spin energy
+    from a Laplace-factored denominator at $\mathcal{O}(N^4)$ cost, screening
+    the occupied and virtual orbitals of each quadrature point. The same-spin
+    energy still needs the canonical $\mathcal{O}(N^5)$ algorithm, so LAPLACE
+    only pays off for SOS-MP2 (``energy('sos-mp2')``, which sets
+    |dfmp2__mp2_ss_scale| to 0), where the same-spin energy is skipped, or for the opposite-spin part of UHF references. Energies
+    only; gradients are always canonical. -*/
+    options.add_str("DFMP2_ENERGY_ALGORITHM", "CANONICAL", "CANONICAL LAPLACE");
+    /*- Maximum error norm of the Laplace quadrature of the MP2 denominator -*/
+    options.add_double("DFMP2_LAPLACE_DELTA", 1.0E-6);
+    /*- Schwarz bound on the opposite-spin energy [Eh] neglected per quadrature
+    point by the Laplace orbital screening -*/
+    options.add_double("DFMP2_LAPLACE_CUTOFF", 1.0E-10);
     /*- Minimum absolute value below which integrals are neglected. -*/
     options.add_double("INTS_TOLERANCE", 0.0);
     /*- Minimum error in the 2-norm of the P(2) matrix for corrections to Lia and P. -*/
@@ -2266,6 +2359,43 @@ int read_options(const std::string &name, Options & options, bool suppress_print
     /*- Do compute one-particle density matrix? -*/
     options.add_bool("ONEPDM",false);
   }
+  if(name == "THCMP2"|| options.read_globals()) {
+    /*- MODULEDESCRIPTION Performs least-squares tensor-hypercontracted (LS-THC) MP2 and SOS-MP2 energy
+        computations for RHF reference wavefunctions, with a Laplace-factored denominator.
+        The energy streams the ngrid x ngrid Z tensor from disk when it does not fit in memory,
+        but the LS-THC fit always builds Z in core, so memory must hold at least ngrid^2 doubles. -*/
+
+    /*- Primary basis set -*/
+    options.add_str("BASIS","NONE");
+    /*- Auxiliary basis set for the LS-THC fitting of the MP2 integrals.
+    :ref:`Defaults <apdx:basisFamily>` to a RI basis. -*/
+    options.add_str("DF_BASIS_MP2","");
+    /*- OS Scale -*/
+    options.add_double("MP2_OS_SCALE", 6.0/5.0);
+    /*- SS Scale -*/
+    options.add_double("MP2_SS_SCALE", 1.0/3.0);
+    /*- SOS Scale -*/
+    options.add_double("MP2_SOS_SCALE", 1.3);
+    /*- Do form the $\mathcal{O}(N^4)$ same-spin exchange energy? Without it only
+    the SOS-MP2 energy is complete. Set by ``energy('thc-mp2')``. -*/
+    options.add_bool("THC_SAME_SPIN", false);
+    /*- Maximum error norm of the Laplace quadrature of the MP2 denominator -*/
+    options.add_double("THC_LAPLACE_DELTA", 1.0E-6);
+    /*- Relative eigenvalue cutoff in the inverse square root of the DF metric -*/
+    options.add_double("THC_J_CUTOFF", 1.0E-10);
+    /*- Relative eigenvalue cutoff in the inverse of the THC grid metric -*/
+    options.add_double("THC_S_CUTOFF", 1.0E-10);
+    /*- Do normalize the collocation of each grid point over each orbital space? -*/
+    options.add_bool("THC_BALANCE", false);
+    /*- Number of radial points of the LS-THC grid, a DFTGrid otherwise
+    controlled by the DFT grid options. Much coarser than an SCF grid, as the
+    least-squares fit absorbs the quadrature error. -*/
+    options.add_int("THC_RADIAL_POINTS", 12);
+    /*- Number of spherical points of the LS-THC grid (a Lebedev number) -*/
+    options.add_int("THC_SPHERICAL_POINTS", 38);
+    /*- Minimum absolute value below which integrals are neglected. -*/
+    options.add_double("INTS_TOLERANCE", 0.0);
+  }
   if(name == "PSIMRCC"|| options.read_globals()) {
     /*- MODULEDESCRIPTION Performs multireference coupled cluster computations.  This theory should be used only by
         advanced users with a good working knowledge of multireference techniques. -*/